@@ -0,0 +1,147 @@
+/**
+ * @file    app_config.h
+ * @brief   애플리케이션 컴파일 설정 및 인터럽트 우선순위 계획
+ */
+
+#ifndef __APP_CONFIG_H
+#define __APP_CONFIG_H
+
+/* ============================================================
+ * 인터럽트 우선순위 (NVIC_PRIORITYGROUP_4: 선점 0~15, 서브 0)
+ * ============================================================
+ *
+ *   선점 | 인터럽트              | 비고
+ *  ------+-----------------------+-----------------------------------
+ *     0  | COMP1_2_3, ADC1_2     | 과전류 보호 (제어 루프도 선점)
+ *     1  | TIM6_DAC              | 제어 루프 (SVPWM 갱신)
+ *     2  | TIM3                  | PWM 타이머 (단일 션트 빌드는 0: 반주기마다 CCR 기록)
+ *     5  | DMA1_Channel1         | ADC DMA (인터럽트 비활성 상태)
+ *    14  | SysTick               | HAL tick
+ *    15  | LPUART1, DMA1_Ch2/3   | 통신, 텔레메트리 TX / 명령 RX DMA (가장 낮음)
+ *
+ * CubeMX 생성 코드(stm32g4xx_hal_msp.c, MX_DMA_Init, TICK_INT_PRIORITY)와
+ * .ioc 의 NVIC 설정은 이 표와 동일한 숫자를 사용한다.
+ */
+#define IRQ_PRIO_PROTECT        0u
+#define IRQ_PRIO_CONTROL        1u
+#define IRQ_PRIO_PWM            2u
+#define IRQ_PRIO_PWM_SHUNT      0u      // SVPWM_SINGLE_SHUNT: SVPWM_Init 이 TIM3 를 재설정
+#define IRQ_PRIO_DMA            5u
+#define IRQ_PRIO_SYSTICK        14u
+#define IRQ_PRIO_COMMS          15u
+
+/* ============================================================
+ * 제어 주기 (TIM6)
+ * ============================================================
+ * MX_TIM6_Init: PSC 170-1, ARR 999 → 170MHz / (170 × 1000) = 1 kHz.
+ * 각도/적분 dt 는 이 값으로 고정한다 (PARAM_CTRL_FREQ_HZ 는 읽기 전용 표시값).
+ * .ioc 에서 TIM6 를 바꾸면 여기도 같이 바꾼다 - 불일치 시 MX_TIM6_Init 이 Error_Handler.
+ */
+#define CONTROL_TIM_CLK_HZ      170000000u
+#define CONTROL_FREQ_HZ         1000u
+
+/* ============================================================
+ * 제어 ISR 디스패치
+ * ============================================================
+ * 0: TIM6_DAC_IRQHandler → HAL_TIM_IRQHandler → HAL_TIM_PeriodElapsedCallback
+ *    (CC1~4/COM/BRK/TRG 플래그를 모두 검사한 뒤 Instance 비교)
+ * 1: TIM6_DAC_IRQHandler 에서 UIF 만 확인/클리어 후 OpenLoop_Step 직접 호출
+ *    (TIM6_DAC 벡터를 공유하는 DAC 언더런 인터럽트는 사용하지 않음을 전제)
+ */
+#ifndef CONTROL_DISPATCH_LEAN
+#define CONTROL_DISPATCH_LEAN   1
+#endif
+
+/* ============================================================
+ * 핫패스 배치 (CCM SRAM)
+ * ============================================================
+ * FLASH 는 170MHz 에서 4 wait state (ART 캐시 미스 시 지연).
+ * 1: 제어 ISR, OpenLoop_Step, SVPWM_Run 및 하위 함수, 삼각함수 커널과
+ *    LUT 를 CCM SRAM(0x10000000, I-bus 0-wait)에 배치 → 시작 시 FLASH 에서 복사
+ *    매 스텝 호출되는 getter (Fault_IsOk, Sense_GetState 등) 와 libc memcpy
+ *    (링커 스크립트) 도 포함. 식별 (MotorId/MechId) 은 대기 판정만 CCM, 진행 중 본체는 FLASH
+ * 사이클 비교: LATENCY_MEASURE=1 에서 0/1 빌드의 g_isr_lat.step_max_cyc
+ */
+#ifndef CONTROL_IN_CCMRAM
+#define CONTROL_IN_CCMRAM       1
+#endif
+
+#if CONTROL_IN_CCMRAM
+#define CCMRAM_FUNC             __attribute__((section(".ccmram_text")))
+#define CCMRAM_DATA             __attribute__((section(".ccmram_data")))
+#define CCMRAM_BSS              __attribute__((section(".ccmbss")))
+#else
+#define CCMRAM_FUNC
+#define CCMRAM_DATA
+#define CCMRAM_BSS
+#endif
+
+/* 제어 루프 삼각함수: 1 = LUT (fast_trig), 0 = libm cosf/sinf */
+#ifndef CONTROL_TRIG_LUT
+#define CONTROL_TRIG_LUT        1
+#endif
+
+/* ============================================================
+ * 통신 (LPUART1 DMA, 2 Mbaud)
+ * ============================================================
+ * TX: 텔레메트리 프레임 (telemetry.c), RX: COBS 명령 패킷 (cmd.c)
+ * 호스트: Tools/telem_decode.py, Tools/motor_client.py
+ */
+
+/* 1: 제어 루프 샘플을 텔레메트리 프레임으로 송신 (0 이면 명령 응답만 송신) */
+#ifndef TELEMETRY_ENABLE
+#define TELEMETRY_ENABLE        1
+#endif
+
+/* 제어 샘플 간격 기본값 [스텝] (PARAM_TELEM_DECIM 기본값) */
+#ifndef TELEMETRY_DECIM
+#define TELEMETRY_DECIM         1
+#endif
+
+/* ============================================================
+ * 백그라운드 스케줄러 (sched.c)
+ * ============================================================
+ * 메인 루프 태스크 주기/마감 [ms]. 준비된 태스크가 없으면 WFI 로 대기한다.
+ * 명령 수신은 UART IDLE, 보호 처리는 고장 발생 시 이벤트로도 즉시 릴리스된다.
+ */
+#define SCHED_PROTECT_PERIOD_MS     5u      // HOLDOFF(100ms) 해제 분해능
+#define SCHED_PROTECT_DEADLINE_MS   1u
+#define SCHED_CMD_PERIOD_MS         10u     // IDLE 이벤트 누락/수신 오류 복구용 백업 주기
+#define SCHED_CMD_DEADLINE_MS       1u
+#define SCHED_TELEM_PERIOD_MS       1u      // 유휴 시 DMA 재시작 (전송 중에는 완료 콜백이 이어 보냄)
+#define SCHED_TELEM_DEADLINE_MS     1u
+#define SCHED_SCOPE_PERIOD_MS       1u
+#define SCHED_SCOPE_DEADLINE_MS     5u
+#define SCHED_IDENT_PERIOD_MS       5u      // 기계 식별 샘플 링(32) 비우기
+#define SCHED_IDENT_DEADLINE_MS     10u
+#define SCHED_CONFIG_PERIOD_MS      2u      // FLASH 더블워드 1개/회
+#define SCHED_CONFIG_DEADLINE_MS    20u
+#define SCHED_LATENCY_PERIOD_MS     1u
+#define SCHED_LATENCY_DEADLINE_MS   1u
+#define SCHED_LOAD_DEADLINE_MS      10u     // 주기는 CPU_LOAD_WINDOW_MS
+#define SCHED_BENCH_PERIOD_MS       1u      // BENCH_CHUNK_ITER 회/실행
+#define SCHED_BENCH_DEADLINE_MS     5u
+
+/* ============================================================
+ * 측정 모드
+ * ============================================================ */
+
+/* 1: 제어 ISR 진입 지연/디스패치 사이클 측정 + LPUART1 부하 발생 (g_isr_lat 확인)
+ *    LPUART1 을 부하 발생에 사용하므로 텔레메트리/명령 수신은 시작하지 않는다. */
+#ifndef LATENCY_MEASURE
+#define LATENCY_MEASURE         0
+#endif
+
+/* 1: 문맥별 CPU 점유율 (ISR/메인/WFI) + 제어 오버런 상시 집계 → TELEM_TYPE_LOAD
+ *    ISR 진입/종료마다 약 30 사이클 추가 (PRIMASK 구간 포함) */
+#ifndef CPU_LOAD_MONITOR
+#define CPU_LOAD_MONITOR        1
+#endif
+
+/* 1: 제어 ISR 사이클 벤치마크 (CMD_BENCH 커널 BENCH_CONTROL_ISR) 진입/종료 훅
+ *    측정하지 않을 때는 ISR 진입/종료마다 플래그 확인 1 회 (수 사이클) */
+#ifndef BENCH_ISR_PROBE
+#define BENCH_ISR_PROBE         1
+#endif
+
+#endif /* __APP_CONFIG_H */
@@ -0,0 +1,87 @@
+/**
+ * @file    bench.h
+ * @brief   온타겟 커널 사이클 벤치마크 헤더 (DWT, CMD_BENCH / CMD_BENCH_STATUS)
+ *
+ * 측정은 메인 루프 태스크 (Bench_Process) 에서 나눠 진행하고 결과는 상태 조회로 읽는다
+ * (명령 처리 태스크를 막지 않음). BENCH_CONTROL_ISR 은 실제 TIM6 ISR 을 그 자리에서 잰다.
+ */
+
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#include "app_config.h"
+#include <stdint.h>
+
+/* ============== 커널 ID ============== */
+typedef enum {
+    BENCH_SVPWM_CORE = 0,       // SvpwmCore_Calc (섹터 + T1/T2/T0 + CCR)
+    BENCH_TRIG_LUT,             // FastTrig_SinCos
+    BENCH_TRIG_LIBM,            // sinf + cosf
+    BENCH_OPENLOOP_VECTOR,      // 각도 → SinCos(CONTROL_TRIG_LUT) → SvpwmCore_Calc (SVPWM_Run 계산 경로)
+    BENCH_CONTROL_ISR,          // 실제 제어 ISR (TIM6 디스패치 + OpenLoop_Step), 다음 iter 회 실행
+    BENCH_COUNT
+} Bench_Kernel_t;
+
+typedef enum {
+    BENCH_ST_IDLE = 0,          // 측정 없음
+    BENCH_ST_RUNNING,           // 측정 중
+    BENCH_ST_DONE               // 결과 있음
+} Bench_State_t;
+
+/* 입력 스트림 길이 (2의 거듭제곱, 각도 램프 × 크기, 과변조 1/8) */
+#define BENCH_STREAM_LEN        64u
+
+/* 1회 요청 최대 반복 수 (제어 ISR: 제어 주기 × iter 동안 측정) */
+#define BENCH_MAX_ITER          4096u
+
+/* Bench_Process 1회당 최대 반복 수 (libm 커널도 수십 µs 이내 → 명령/텔레메트리 태스크 지연 없음) */
+#define BENCH_CHUNK_ITER        32u
+
+/* ============== 타입 정의 ============== */
+typedef struct {
+    uint32_t iterations;
+    uint32_t min_cyc;       // 1회 최소 [cycle]
+    uint32_t max_cyc;       // 1회 최대 [cycle]
+    uint32_t total_cyc;     // 합계 [cycle] (평균 = total / iterations)
+    uint32_t overhead_cyc;  // 측정 오버헤드 (빈 호출, 결과에서 이미 뺌)
+} Bench_Result_t;
+
+/* ============== 계측 매크로 (TIM6 ISR 진입 / 종료) ============== */
+#if BENCH_ISR_PROBE
+#define BENCH_ISR_ENTER()       Bench_IsrEnter()
+#define BENCH_ISR_EXIT()        Bench_IsrExit()
+#else
+#define BENCH_ISR_ENTER()       ((void)0)
+#define BENCH_ISR_EXIT()        ((void)0)
+#endif
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 측정 시작 (메인 루프 전용, 진행은 Bench_Process)
+ * @param kernel      Bench_Kernel_t
+ * @param iterations  반복 수 (1 ~ BENCH_MAX_ITER)
+ * @return 1: 시작, 0: 잘못된 인자 / 측정 중 (BENCH_CONTROL_ISR 은 BENCH_ISR_PROBE 필요)
+ */
+uint8_t Bench_Start(uint8_t kernel, uint32_t iterations);
+
+/**
+ * @brief 메인 루프 처리 - 1회 호출당 최대 BENCH_CHUNK_ITER 반복
+ */
+void Bench_Process(void);
+
+/**
+ * @brief 상태 / 결과
+ * @param pKernel  측정 중이거나 마지막으로 측정한 커널
+ * @param pRes     결과 (BENCH_ST_DONE 일 때 유효)
+ * @return Bench_State_t
+ */
+uint8_t Bench_GetResult(uint8_t *pKernel, Bench_Result_t *pRes);
+
+/**
+ * @brief 제어 ISR 최상단 / 최하단 (BENCH_CONTROL_ISR 측정 중일 때만 기록)
+ */
+void Bench_IsrEnter(void);
+void Bench_IsrExit(void);
+
+#endif /* __BENCH_H */
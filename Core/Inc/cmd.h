@@ -0,0 +1,94 @@
+/**
+ * @file    cmd.h
+ * @brief   명령 프로토콜 헤더 - COBS 프레이밍 + CRC16, LPUART1 DMA 원형 수신
+ */
+
+#ifndef __CMD_H
+#define __CMD_H
+
+#include "stm32g4xx_hal.h"
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+/* 패킷 (COBS 복원 후): CMD SEQ PAYLOAD[n] CRC_L CRC_H, 0x00 으로 구분
+ *                      CRC16(CCITT-FALSE) 범위 = CMD ~ PAYLOAD */
+#define CMD_RX_RING_SIZE        512u    // DMA 원형 수신 버퍼 [byte] (2 의 거듭제곱)
+#define CMD_RX_HALF             (CMD_RX_RING_SIZE / 2u)     // DMA HT/TC 간격
+#define CMD_MAX_PACKET          64u     // 복원된 패킷 최대 길이 [byte]
+
+/* 명령 코드 */
+#define CMD_PING                0x01u   // 응답: fault state, first_cause, causes, param layout(u16), version(u32)
+#define CMD_SET_SPEED           0x02u   // float freq_hz, float voltage [0~1]
+#define CMD_SET_SPEED_VOLT      0x03u   // float freq_hz, float volt [V]
+#define CMD_SET_MODE            0x04u   // uint8 mode (CMD_MODE_xxx)
+#define CMD_PARAM_READ          0x05u   // uint16 key → 응답: uint16 key, uint32 value (적용값)
+#define CMD_PARAM_WRITE         0x06u   // uint16 key, uint32 value (float 은 비트 그대로) - 예약만
+#define CMD_FAULT_CLEAR         0x07u
+#define CMD_PARAM_COMMIT        0x08u   // 예약된 변경 일괄 적용 → 응답: uint32 version
+#define CMD_PARAM_DISCARD       0x09u   // 예약된 변경 취소
+#define CMD_PARAM_INFO          0x0Au   // uint16 index → 응답: count key type min max def "name\0unit"
+#define CMD_CONFIG_SAVE         0x0Bu   // 현재 적용값을 FLASH 에 저장 (기록은 메인 루프에서 진행, DEFERRED 가능)
+#define CMD_CONFIG_RESET        0x0Cu   // 기본값 복원 + 저장값 삭제 (DEFERRED 가능)
+#define CMD_CONFIG_STATUS       0x0Du   // 응답: state busy seq(u32) saves(u32) erases(u32) bad(u32)
+#define CMD_ID_START            0x20u   // uint8 spin (1: 오픈루프 회전으로 자속 측정 포함) - 드라이버 활성
+#define CMD_ID_ABORT            0x21u   // 식별 중단/해제 (출력 오픈루프 복귀)
+#define CMD_ID_POLES            0x22u   // uint8 1: 계수 시작 (드라이버 비활성, 손으로 1회전), 0: 종료 → 응답: uint8 pp
+#define CMD_ID_STATUS           0x23u   // 응답: state err spin poles, float rs ld lq flux kp ki
+#define CMD_MECH_START          0x24u   // 기계 파라미터 식별 시작 (전기 상수 필요) - 드라이버 활성
+#define CMD_MECH_STATUS         0x25u   // 응답: state err cycle rsvd samples(u32) dropped(u32), float J B Tc kp ki
+#define CMD_SCOPE_CONFIG        0x10u   // uint8 nch, uint8 pre_pct, uint16 decim, uint8 src[nch]
+#define CMD_SCOPE_TRIGGER       0x11u   // uint8 mode, uint8 ch, float level
+#define CMD_SCOPE_ARM           0x12u
+#define CMD_SCOPE_STOP          0x13u
+#define CMD_SCOPE_STATUS        0x14u   // 응답: state nch depth(u16) pre(u16) start(u16) decim(u32)
+#define CMD_SCOPE_UPLOAD        0x15u   // 응답 후 TELEM_TYPE_SCOPE 프레임 연속 전송
+#define CMD_BENCH               0x30u   // uint8 kernel, uint16 iter - 측정 시작 (메인 루프에서 진행, 측정 중이면 REJECTED)
+#define CMD_BENCH_STATUS        0x31u   // 응답: state kernel flags clk(u32) iter min max total overhead (u32, cycle)
+
+/* 운전 모드 */
+#define CMD_MODE_STOP           0u      // 출력 0, 드라이버 비활성, 식별 중단 (고장 해제 후에도 유지)
+#define CMD_MODE_RUN            1u      // 드라이버 활성 (고장 없을 때만, 고장 해제 후 자동 재활성)
+
+/* 응답 상태 (TELEM_TYPE_REPLY: CMD SEQ STATUS DATA...) */
+#define CMD_ST_OK               0u
+#define CMD_ST_UNKNOWN          1u      // 알 수 없는 명령
+#define CMD_ST_BAD_LEN          2u      // 페이로드 길이 불일치
+#define CMD_ST_BAD_ARG          3u      // 범위 밖 값 / 알 수 없는 파라미터
+#define CMD_ST_REJECTED         4u      // 상태상 수행 불가 (고장 중 등)
+#define CMD_ST_DEFERRED         5u      // 접수했으나 조건 대기 중 (CONFIG_SAVE/RESET: 드라이버 정지 후 페이지 삭제)
+
+/* ============== 타입 정의 ============== */
+typedef struct {
+    uint32_t rx_bytes;      // 수신 바이트
+    uint32_t packets;       // 처리한 패킷
+    uint32_t crc_errors;    // CRC 불일치
+    uint32_t cobs_errors;   // COBS 형식 오류 / 길이 초과
+    uint32_t overruns;      // 읽기 전에 수신 링이 덮어써진 횟수 (DMA HT/TC 통과 횟수로 검출)
+    uint32_t rx_dropped;    // 덮어쓰기로 버린 바이트
+    uint32_t rx_restarts;   // UART 오류 (ORE/FE/NE) 로 인한 수신 재시작
+} Cmd_Stats_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 명령 수신 초기화 (DMA 원형 수신 시작)
+ * @param huart  명령 UART (LPUART1, hdmarx 원형 모드)
+ */
+void Cmd_Init(UART_HandleTypeDef *huart);
+
+/**
+ * @brief 메인 루프 처리 - 수신 링에서 새 바이트를 읽어 패킷 복원/실행
+ */
+void Cmd_Process(void);
+
+/**
+ * @brief UART IDLE 인터럽트 처리 (LPUART1_IRQHandler 에서 HAL 처리 전에 호출)
+ */
+void Cmd_UartIRQHandler(void);
+
+/**
+ * @brief 통계 반환 (디버깅용)
+ */
+Cmd_Stats_t* Cmd_GetStats(void);
+
+#endif /* __CMD_H */
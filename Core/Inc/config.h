@@ -0,0 +1,36 @@
+/**
+ * @file    config.h
+ * @brief   파라미터 영구 저장 헤더 (레지스트리 ↔ FLASH NVM)
+ */
+
+#ifndef __CONFIG_H
+#define __CONFIG_H
+
+#include <stdint.h>
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief NVM 스캔 후 저장된 파라미터 적용 (Param_Init 이후, 제어 ISR 시작 전)
+ * @return 적용한 파라미터 수
+ */
+uint32_t Config_Init(void);
+
+/**
+ * @brief 현재 적용값 전체 저장 요청 (기록은 Nvm_Process 에서 진행)
+ * @return NVM_SAVE_xxx (DEFERRED: 페이지 삭제를 위해 드라이버 출력 정지까지 대기)
+ */
+uint8_t Config_Save(void);
+
+/**
+ * @brief 기본값 복원 + 빈 레코드 저장 (공장 초기화)
+ * @return NVM_SAVE_xxx (REJECTED 이면 기본값 복원도 하지 않음)
+ */
+uint8_t Config_Reset(void);
+
+/**
+ * @brief 메인 루프 처리 (NVM 기록 진행)
+ */
+void Config_Process(void);
+
+#endif /* __CONFIG_H */
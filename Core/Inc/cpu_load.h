@@ -0,0 +1,81 @@
+/**
+ * @file    cpu_load.h
+ * @brief   CPU 부하 / 제어 주기 예산 모니터 헤더 (CPU_LOAD_MONITOR)
+ */
+
+#ifndef __CPU_LOAD_H
+#define __CPU_LOAD_H
+
+#include "stm32g4xx_hal.h"
+#include "app_config.h"
+#include <stdint.h>
+
+/* ============== 실행 문맥 ============== */
+typedef enum {
+    CPU_CTX_MAIN = 0,       // 메인 루프 태스크
+    CPU_CTX_IDLE,           // WFI 대기
+    CPU_CTX_CONTROL,        // TIM6 제어 ISR
+    CPU_CTX_PROTECT,        // COMP/ADC 보호 ISR
+    CPU_CTX_COMMS,          // LPUART1, DMA1_Ch2/3
+    CPU_CTX_SYSTICK,        // HAL tick
+    CPU_CTX_PWM,            // TIM3 업데이트 ISR (주기 확산 / 주기 변경 / 단일 션트 반주기)
+    CPU_CTX_COUNT
+} CpuLoad_Ctx_t;
+
+/* 중첩 깊이 (메인 + 선점 우선순위 단계 수 이상) */
+#define CPU_LOAD_NEST_MAX       8u
+
+/* 집계 창 [ms] (창마다 TELEM_TYPE_LOAD 프레임 1개) */
+#define CPU_LOAD_WINDOW_MS      1000u
+
+/* ============== 타입 정의 ============== */
+/* 창 집계 결과 (TELEM_TYPE_LOAD 페이로드, little-endian, 패딩 없음) */
+typedef struct __attribute__((packed)) {
+    uint32_t window_cyc;                // 창 길이 [cycle]
+    uint16_t load_pm[CPU_CTX_COUNT];    // 문맥별 점유율 [‰] (CpuLoad_Ctx_t 순서)
+    uint32_t period_cyc;                // 제어 주기 [cycle]
+    uint32_t ctrl_max_cyc;              // 창 내 제어 ISR 최대 실행 [cycle] (선점 포함)
+    uint16_t ctrl_budget_pm;            // ctrl_max_cyc / period_cyc [‰]
+    uint16_t ctrl_overruns;             // 창 내 오버런 (다음 트리거 전에 끝나지 못한 스텝)
+    uint32_t overruns_total;            // 누적 오버런
+} CpuLoad_Frame_t;
+
+/* ============== 계측 매크로 ============== */
+#if CPU_LOAD_MONITOR
+#define CPU_LOAD_ENTER(ctx)     CpuLoad_Enter(ctx)
+#define CPU_LOAD_EXIT()         CpuLoad_Exit()
+#else
+#define CPU_LOAD_ENTER(ctx)     ((void)0)
+#define CPU_LOAD_EXIT()         ((void)0)
+#endif
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 모니터 초기화 (DWT 활성화, 제어 주기 계산)
+ * @param htim_ctrl  제어 루프 타이머 (TIM6) 핸들
+ */
+void CpuLoad_Init(TIM_HandleTypeDef *htim_ctrl);
+
+/**
+ * @brief 문맥 진입 (ISR 최상단 / WFI 직전)
+ * @param ctx  CpuLoad_Ctx_t
+ */
+void CpuLoad_Enter(uint8_t ctx);
+
+/**
+ * @brief 문맥 종료 (ISR 끝 / WFI 복귀 직후) - 제어 ISR 이면 실행 시간/오버런 기록
+ */
+void CpuLoad_Exit(void);
+
+/**
+ * @brief 창 마감 (메인 루프 태스크, CPU_LOAD_WINDOW_MS 주기) - 집계 후 텔레메트리 송신
+ */
+void CpuLoad_Process(void);
+
+/**
+ * @brief 최근 창 집계 결과 반환 (디버깅용)
+ */
+const CpuLoad_Frame_t* CpuLoad_GetLast(void);
+
+#endif /* __CPU_LOAD_H */
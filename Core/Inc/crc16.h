@@ -0,0 +1,25 @@
+/**
+ * @file    crc16.h
+ * @brief   CRC-16/CCITT-FALSE 헤더 (통신 프레임 무결성 검사)
+ */
+
+#ifndef __CRC16_H
+#define __CRC16_H
+
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+#define CRC16_INIT          0xFFFFu     // 초기값 (다항식 0x1021, 반사 없음)
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief CRC 누적 계산
+ * @param crc   이전 CRC (처음에는 CRC16_INIT)
+ * @param data  데이터 포인터
+ * @param len   바이트 수
+ * @return 갱신된 CRC
+ */
+uint16_t CRC16_Update(uint16_t crc, const uint8_t *data, uint32_t len);
+
+#endif /* __CRC16_H */
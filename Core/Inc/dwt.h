@@ -0,0 +1,33 @@
+/**
+ * @file    dwt.h
+ * @brief   DWT 사이클 카운터 유틸리티 (Cortex-M4)
+ */
+
+#ifndef __DWT_H
+#define __DWT_H
+
+#include "stm32g4xx_hal.h"
+#include <stdint.h>
+
+/**
+ * @brief DWT CYCCNT 활성화 (중복 호출 가능)
+ */
+static inline void DWT_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0u)
+    {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
+
+/**
+ * @brief 현재 사이클 카운트 (170MHz 기준 약 25초마다 랩어라운드)
+ */
+static inline uint32_t DWT_GetCycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+#endif /* __DWT_H */
@@ -0,0 +1,31 @@
+/**
+ * @file    fast_trig.h
+ * @brief   LUT 기반 sin/cos 커널 헤더 (제어 루프용)
+ */
+
+#ifndef __FAST_TRIG_H
+#define __FAST_TRIG_H
+
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+#define TRIG_LUT_BITS       8
+#define TRIG_LUT_SIZE       (1u << TRIG_LUT_BITS)   // 한 주기 샘플 수 (선형 보간, 최대 오차 ~7.5e-5)
+#define TRIG_TWO_PI         6.28318530f
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief sin LUT 생성 (제어 루프 시작 전 1회)
+ */
+void FastTrig_Init(void);
+
+/**
+ * @brief sin/cos 동시 계산 (LUT + 선형 보간)
+ * @param angle  각도 [rad] (임의 범위, 주기 래핑)
+ * @param pSin   sin(angle) 출력
+ * @param pCos   cos(angle) 출력
+ */
+void FastTrig_SinCos(float angle, float *pSin, float *pCos);
+
+#endif /* __FAST_TRIG_H */
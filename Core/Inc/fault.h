@@ -0,0 +1,83 @@
+/**
+ * @file    fault.h
+ * @brief   고장 관리 상태 머신 헤더
+ *
+ * 하드웨어 의존성이 없는 순수 로직 (HAL 미포함, 원자 구간에 CMSIS PRIMASK 만 사용) - 차단 동작은 콜백으로 주입.
+ */
+
+#ifndef __FAULT_H
+#define __FAULT_H
+
+#include <stdint.h>
+
+/* ============== 고장 원인 (비트마스크) ============== */
+#define FAULT_NONE          (0x0000u)
+#define FAULT_OC_HW         (0x0001u)   // COMP3 과전류 (A상, 하드웨어)
+#define FAULT_OC_SW_A       (0x0002u)   // ADC1 AWD 과전류 (A상)
+#define FAULT_OC_SW_B       (0x0004u)   // ADC2 AWD 과전류 (B상)
+#define FAULT_VBUS_OV       (0x0008u)   // 버스 과전압
+#define FAULT_VBUS_UV       (0x0010u)   // 버스 저전압
+#define FAULT_SYS_ERROR     (0x0020u)   // Error_Handler 진입
+
+/* ============== 타입 정의 ============== */
+typedef enum {
+    FAULT_ST_OK = 0,        // 정상 (출력 허용)
+    FAULT_ST_TRIPPED,       // 고장 래치 (출력 차단)
+    FAULT_ST_HOLDOFF        // 해제 요청됨, 재가동 대기 중
+} Fault_State_t;
+
+typedef struct {
+    Fault_State_t state;
+    uint16_t first_cause;   // 최초 고장 원인 (래치)
+    uint16_t causes;        // 해제 전까지 누적된 원인
+    uint32_t trip_time;     // 최초 고장 시각 [ms]
+    uint32_t clear_time;    // 해제 요청 시각 [ms]
+    uint32_t trip_count;    // 누적 고장 횟수
+} Fault_Info_t;
+
+/* 출력 차단 콜백 (고장 진입 시 1회, ISR 문맥에서 호출될 수 있음) */
+typedef void (*Fault_ShutdownFn_t)(void);
+
+/* 해제 후 재가동까지 대기 시간 [ms] */
+#define FAULT_HOLDOFF_MS    (100u)
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 고장 관리 초기화
+ * @param shutdown  출력 차단 콜백 (NULL 허용)
+ */
+void Fault_Init(Fault_ShutdownFn_t shutdown);
+
+/**
+ * @brief 고장 발생 통보 (ISR 에서 호출 가능)
+ * @param cause  FAULT_xxx 비트
+ * @param now    현재 시각 [ms]
+ */
+void Fault_Raise(uint16_t cause, uint32_t now);
+
+/**
+ * @brief 고장 해제 요청
+ * @param active  현재 여전히 활성인 고장 원인 (있으면 해제 거부)
+ * @param now     현재 시각 [ms]
+ * @return 1: 해제 접수 (HOLDOFF 진입), 0: 거부
+ */
+uint8_t Fault_Clear(uint16_t active, uint32_t now);
+
+/**
+ * @brief 주기 처리 - HOLDOFF 경과 시 OK 로 복귀
+ * @param now  현재 시각 [ms]
+ */
+void Fault_Process(uint32_t now);
+
+/**
+ * @brief 출력 허용 여부 (FAULT_ST_OK 일 때만 1)
+ */
+uint8_t Fault_IsOk(void);
+
+/**
+ * @brief 고장 정보 반환 (디버깅용)
+ */
+const Fault_Info_t* Fault_GetInfo(void);
+
+#endif /* __FAULT_H */
@@ -0,0 +1,70 @@
+/**
+ * @file    isr_latency.h
+ * @brief   제어 ISR 진입 지연 측정 헤더 (LATENCY_MEASURE 모드)
+ */
+
+#ifndef __ISR_LATENCY_H
+#define __ISR_LATENCY_H
+
+#include "stm32g4xx_hal.h"
+#include <stdint.h>
+
+/* ============== 타입 정의 ============== */
+typedef struct {
+    uint32_t count;             // 측정 횟수
+    uint32_t lat_min_cyc;       // 최소 진입 지연 [cycle] (TIM CNT 기반, 분해능 PSC+1)
+    uint32_t lat_max_cyc;       // 최대 진입 지연 [cycle]
+    uint32_t jitter_max_cyc;    // 최대 주기 편차 |Δt - T| [cycle] (DWT, 1 cycle 분해능)
+    uint32_t period_cyc;        // 공칭 제어 주기 [cycle]
+    uint32_t dispatch_cyc;      // ISR 진입 → OpenLoop_Step 진입 [cycle] (최근)
+    uint32_t dispatch_max_cyc;  // ISR 진입 → OpenLoop_Step 진입 [cycle] (최대)
+    uint32_t step_cyc;          // OpenLoop_Step 실행 [cycle] (최근)
+    uint32_t step_max_cyc;      // OpenLoop_Step 실행 [cycle] (최대, FLASH/CCM 비교용)
+    uint32_t flood_bytes;       // 부하 발생으로 송수신한 바이트 수
+} IsrLat_Stats_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 측정 초기화 (DWT 활성화, 공칭 주기 계산)
+ * @param htim_ctrl  제어 루프 타이머 (TIM6) 핸들
+ */
+void IsrLat_Init(TIM_HandleTypeDef *htim_ctrl);
+
+/**
+ * @brief 제어 ISR 최상단에서 호출 - 진입 지연/지터 기록
+ */
+void IsrLat_OnControlEntry(void);
+
+/**
+ * @brief OpenLoop_Step 최상단에서 호출 - 디스패치 사이클 기록 (HAL/lean 비교용)
+ */
+void IsrLat_OnStepEntry(void);
+
+/**
+ * @brief OpenLoop_Step 끝에서 호출 - 스텝 실행 사이클 기록
+ */
+void IsrLat_OnStepExit(void);
+
+/**
+ * @brief 통계 초기화 (부하 조건 변경 후 호출)
+ */
+void IsrLat_Reset(void);
+
+/**
+ * @brief UART 부하 발생 시작 (연속 TX/RX 인터럽트)
+ * @param huart  부하를 걸 UART (LPUART1)
+ */
+void IsrLat_StartFlood(UART_HandleTypeDef *huart);
+
+/**
+ * @brief 메인 루프 처리 - 부하 전송/수신 재시작
+ */
+void IsrLat_Process(void);
+
+/**
+ * @brief 측정 결과 반환 (디버깅용)
+ */
+IsrLat_Stats_t* IsrLat_GetStats(void);
+
+#endif /* __ISR_LATENCY_H */
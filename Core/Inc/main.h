@@ -65,8 +65,8 @@ void Error_Handler(void);
 #define A2C6_RESV_GPIO_Port GPIOC
 #define A1C1_CurrA_Pin GPIO_PIN_0
 #define A1C1_CurrA_GPIO_Port GPIOA
-#define A1C2_RESV_Pin GPIO_PIN_1
-#define A1C2_RESV_GPIO_Port GPIOA
+#define A1C2_Vbus_Pin GPIO_PIN_1
+#define A1C2_Vbus_GPIO_Port GPIOA
 #define LPUART1_TX_Pin GPIO_PIN_2
 #define LPUART1_TX_GPIO_Port GPIOA
 #define LPUART1_RX_Pin GPIO_PIN_3
@@ -0,0 +1,125 @@
+/**
+ * @file    mech_id.h
+ * @brief   기계 파라미터 식별 헤더 (관성, 점성/쿨롱 마찰, 속도 루프 이득)
+ *
+ * 하드웨어 의존성이 없는 순수 로직 (HAL 미포함) - 드라이버 EN 은 콜백으로 주입.
+ * 전기 상수(PARAM_MOTOR_xxx, motor_id)가 먼저 식별되어 있어야 한다.
+ * 최고 속도 PARAM_ID_SPIN_HZ, 정렬 전압 PARAM_ID_V_DC 를 사용한다.
+ */
+
+#ifndef __MECH_ID_H
+#define __MECH_ID_H
+
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+#define MECH_CYCLES         4u          // 가속/정속/관성 정지 반복 횟수
+#define MECH_T_ALIGN        0.5f        // 회전자 정렬 [s]
+#define MECH_T_RAMP         1.0f        // 가속 시간 [s] (홀수 사이클은 2배 → 가속도 다양화)
+#define MECH_T_HOLD         1.0f        // 정속 유지 [s]
+#define MECH_T_STOPPED      0.5f        // Hall 에지가 이 시간 없으면 정지로 판정 [s]
+#define MECH_T_WINDOW       0.01f       // 토크 평균 구간 = RLS 샘플 간격 (구동 중) [s]
+#define MECH_T_COAST_WIN    0.1f        // 속도 평균 구간 = RLS 샘플 간격 (관성 정지 중) [s]
+#define MECH_RLS_LAMBDA     1.0f        // 망각 계수 (실험 중 상수 파라미터)
+#define MECH_RING_SIZE      32u         // ISR → 메인 루프 샘플 링 (2의 거듭제곱)
+
+/* ============== 타입 정의 ============== */
+typedef void (*MechId_DriverFn_t)(uint8_t enable);
+
+typedef enum {
+    MECH_IDLE = 0,
+    MECH_ALIGN,         // DC 정렬 (사이클 시작)
+    MECH_ACCEL,         // 오픈루프 주파수 램프 (동기 회전: 속도/가속도 = 지령)
+    MECH_HOLD,          // 정속 (가속도 0)
+    MECH_COAST,         // 드라이버 비활성, Hall 주기로 감속 측정
+    MECH_FIT,           // 실험 종료, 메인 루프 이득 계산 대기
+    MECH_DONE,
+    MECH_ERROR
+} MechId_State_t;
+
+typedef enum {
+    MECH_ERR_NONE = 0,
+    MECH_ERR_FAULT,     // 측정 중 보호 동작
+    MECH_ERR_NO_MOTOR,  // 전기 상수 없음 (motor_id 먼저)
+    MECH_ERR_RANGE,     // 결과가 레지스트리 범위 밖 / 관성 ≤ 0
+    MECH_ERR_ABORT      // 사용자 중단
+} MechId_Err_t;
+
+/* 스코프 소스 (제어 스텝마다 갱신) */
+typedef struct {
+    float speed;        // 기계 속도 [rad/s] (구동: 지령, 관성 정지: Hall 주기)
+    float iq;           // 토크 전류 추정 [A] (역기전력 방향 성분, 관성 정지 중 0)
+} MechId_Signal_t;
+
+typedef struct {
+    uint8_t  state;     // MechId_State_t
+    uint8_t  err;       // MechId_Err_t
+    uint8_t  cycle;     // 진행 중 사이클 (0 ~ MECH_CYCLES)
+    uint8_t  rsvd;
+    uint32_t samples;   // RLS 갱신 수
+    uint32_t dropped;   // 링 넘침
+    float    J;         // [kg·m²]
+    float    B;         // [N·m·s/rad]
+    float    Tc;        // [N·m]
+    float    kp;        // [A/(rad/s)]
+    float    ki;        // [A/rad]
+} MechId_Result_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 드라이버 EN 콜백 등록 (제어 ISR 시작 전)
+ */
+void MechId_Init(MechId_DriverFn_t driver);
+
+/**
+ * @brief 실험 시작 (메인 루프)
+ * @return 1: 시작, 0: 진행 중
+ */
+uint8_t MechId_Start(void);
+
+/**
+ * @brief 중단/해제 (드라이버 비활성)
+ */
+void MechId_Abort(void);
+
+/**
+ * @brief 출력 점유 여부
+ */
+uint8_t MechId_IsActive(void);
+
+/**
+ * @brief 제어 스텝 (제어 ISR, 고장이 없을 때만 호출)
+ * @param ia, ib    상전류 [A]
+ * @param hall      Hall W 입력 레벨
+ * @param pVa, pVb  출력 α/β 전압 [V]
+ * @return 1: 출력 점유, 0: 오픈루프 출력 유지
+ */
+uint8_t MechId_Step(float ia, float ib, uint8_t hall, float *pVa, float *pVb);
+
+/**
+ * @brief 메인 루프 처리 - 샘플 RLS 갱신, 종료 시 이득 계산/적용
+ */
+void MechId_Process(void);
+
+/**
+ * @brief RLS 1회 갱신 (순수 계산)
+ *        y = θ0·a/a_ref + θ1·ω/ω_ref + θ2   (y: 토크 [N·m])
+ * @param theta  추정값 [3]
+ * @param P      공분산 [3x3] (행 우선)
+ * @param phi    정규화 회귀 벡터 [3]
+ * @param y      관측 토크
+ */
+void MechId_RlsUpdate(float theta[3], float P[9], const float phi[3], float y);
+
+/**
+ * @brief 스코프 소스 반환
+ */
+MechId_Signal_t* MechId_GetSignal(void);
+
+/**
+ * @brief 결과 반환 (디버깅/통신용)
+ */
+const MechId_Result_t* MechId_GetResult(void);
+
+#endif /* __MECH_ID_H */
@@ -0,0 +1,131 @@
+/**
+ * @file    motor_id.h
+ * @brief   모터 파라미터 자동 식별 헤더 (Rs, Ld/Lq, 자속, 극쌍수, 전류 이득)
+ *
+ * 하드웨어 의존성이 없는 순수 로직 (HAL 미포함) - 전류/Hall 입력과
+ * 전압 출력은 OpenLoop_Step 이 연결한다.
+ */
+
+#ifndef __MOTOR_ID_H
+#define __MOTOR_ID_H
+
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+/* 구간 시간 [s] */
+#define MID_T_ALIGN         0.5f        // 회전자 정렬 (α축)
+#define MID_T_SETTLE        0.2f        // 전류 안정 대기
+#define MID_T_MEAS          0.3f        // 평균 구간
+#define MID_T_SPIN_RAMP     2.0f        // 자속 측정 주파수 램프
+
+/* ============== 타입 정의 ============== */
+typedef enum {
+    MID_IDLE = 0,
+    MID_ALIGN,          // DC 전압으로 회전자를 α축에 정렬
+    MID_RS_LO,          // DC V/2 → 전류 평균
+    MID_RS_HI,          // DC V   → 전류 평균 (두 점 차로 데드타임 오프셋 제거)
+    MID_LD,             // α축 교번 전압 → 전류 리플
+    MID_LQ,             // β축 교번 전압 → 전류 리플 (α 바이어스로 회전자 고정)
+    MID_SPIN_RAMP,      // 오픈루프 가속
+    MID_SPIN_MEAS,      // 정속 → 전압 좌표계 전류 평균
+    MID_COMPUTE,        // 측정 완료, 메인 루프 계산 대기
+    MID_DONE,
+    MID_POLES,          // 극쌍수: 출력 없이 손으로 1회전, Hall 상승 에지 계수
+    MID_ERROR
+} MotorId_State_t;
+
+typedef enum {
+    MID_ERR_NONE = 0,
+    MID_ERR_FAULT,      // 측정 중 보호 동작
+    MID_ERR_NO_CURRENT, // 전류 변화 없음 (결선/드라이버 확인)
+    MID_ERR_RANGE,      // 결과가 레지스트리 범위 밖
+    MID_ERR_ABORT       // 사용자 중단
+} MotorId_Err_t;
+
+/* 구간별 누적값 (ISR 기록, 메인 루프 계산) */
+typedef struct {
+    float    dt;            // 스텝 주기 [s]
+    float    v_dc;          // 저항 측정 전압 [V]
+    float    v_hf;          // 교번 전압 [V]
+    float    v_spin;        // 오픈루프 전압 [V]
+    float    w_spin;        // 오픈루프 각속도 [rad/s]
+    float    i_lo;          // 평균 Iα @ v_dc/2 [A]
+    float    i_hi;          // 평균 Iα @ v_dc [A]
+    float    ripple_d;      // 평균 |ΔIα| [A]
+    float    ripple_q;      // 평균 |ΔIβ| [A]
+    float    spin_id;       // 전압 좌표계 평균 전류 (전압과 같은 방향) [A]
+    float    spin_iq;       // 전압 좌표계 평균 전류 (90° 앞선 방향) [A]
+} MotorId_Meas_t;
+
+typedef struct {
+    uint8_t  state;         // MotorId_State_t
+    uint8_t  err;           // MotorId_Err_t
+    uint8_t  spin;          // 1: 자속 측정 포함
+    uint8_t  poles;         // 계수된 Hall 상승 에지 (MID_POLES)
+    float    rs;            // [Ω]
+    float    ld;            // [H]
+    float    lq;            // [H]
+    float    flux;          // [V·s/rad]
+    float    kp;            // [V/A]
+    float    ki;            // [V/(A·s)]
+} MotorId_Result_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 식별 시작 (메인 루프, 드라이버 활성 상태에서)
+ * @param spin  1: 오픈루프 회전으로 자속까지 측정, 0: 정지 측정(Rs, L)만
+ * @return 1: 시작, 0: 진행 중
+ */
+uint8_t MotorId_Start(uint8_t spin);
+
+/**
+ * @brief 극쌍수 계수 시작 (드라이버 비활성 상태에서 회전자를 손으로 1회전)
+ * @return 1: 시작, 0: 진행 중
+ */
+uint8_t MotorId_StartPoles(void);
+
+/**
+ * @brief 극쌍수 계수 종료 → PARAM_MOTOR_POLES 적용
+ * @return 계수된 극쌍수 (0: 계수 중이 아님 / 에지 없음)
+ */
+uint32_t MotorId_FinishPoles(void);
+
+/**
+ * @brief 중단 (출력은 다음 스텝부터 오픈루프로 복귀)
+ */
+void MotorId_Abort(void);
+
+/**
+ * @brief 출력 점유 여부 (제어 ISR)
+ */
+uint8_t MotorId_IsActive(void);
+
+/**
+ * @brief 제어 스텝 (제어 ISR, 고장이 없을 때만 호출)
+ * @param ia, ib    상전류 [A]
+ * @param hall      Hall 입력 레벨 (극쌍수 계수용)
+ * @param pVa, pVb  출력 α/β 전압 [V]
+ * @return 1: 출력 점유 (pVa/pVb 사용), 0: 오픈루프 출력 유지
+ */
+uint8_t MotorId_Step(float ia, float ib, uint8_t hall, float *pVa, float *pVb);
+
+/**
+ * @brief 메인 루프 처리 - 측정 완료 시 계산/적용, 고장 시 중단
+ */
+void MotorId_Process(void);
+
+/**
+ * @brief 누적값 → 모터 상수/전류 이득 계산 (순수 계산)
+ * @param pMeas   측정 누적값
+ * @param cur_bw  전류 루프 목표 대역폭 [Hz]
+ * @param pRes    결과 (rs, ld, lq, flux, kp, ki, err)
+ */
+void MotorId_Estimate(const MotorId_Meas_t *pMeas, float cur_bw, MotorId_Result_t *pRes);
+
+/**
+ * @brief 결과 반환 (디버깅/통신용)
+ */
+const MotorId_Result_t* MotorId_GetResult(void);
+
+#endif /* __MOTOR_ID_H */
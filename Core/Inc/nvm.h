@@ -0,0 +1,87 @@
+/**
+ * @file    nvm.h
+ * @brief   영구 저장 헤더 - 추가 기록(append-only) 로그, 페이지 순환 마모 평준화
+ *
+ * 하드웨어 의존성이 없는 순수 로직 (HAL 미포함) - 플래시 접근은 포트로 주입.
+ */
+
+#ifndef __NVM_H
+#define __NVM_H
+
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+#define NVM_MAX_PAYLOAD     256u        // 레코드 최대 데이터 [byte]
+
+/* Nvm_Save 결과 */
+#define NVM_SAVE_REJECTED   0u          // 기록 중 / 길이 초과
+#define NVM_SAVE_QUEUED     1u          // 접수, Nvm_Process 에서 바로 기록
+#define NVM_SAVE_DEFERRED   2u          // 접수, 페이지 삭제가 허용될 때까지 (erase_allowed) 대기
+
+/* ============== 타입 정의 ============== */
+/* 저장 매체 포트 (주소는 영역 내 오프셋, 쓰기 단위 8 byte) */
+typedef struct {
+    uint32_t page_size;                                     // [byte]
+    uint32_t page_count;                                    // 2 이상
+    uint8_t (*read)(uint32_t ofs, void *dst, uint32_t len); // 1: 성공, 0: ECC 오류
+    uint8_t (*program)(uint32_t ofs, uint64_t dw);          // 1: 성공
+    uint8_t (*erase)(uint32_t page);                        // 1: 성공
+    uint8_t (*erase_allowed)(void);                         // 1: 긴 정지(페이지 삭제) 허용
+} Nvm_Port_t;
+
+typedef enum {
+    NVM_ST_IDLE = 0,        // 대기
+    NVM_ST_ERASE,           // 다음 페이지 삭제 대기/진행
+    NVM_ST_WRITE,           // 레코드 기록 중 (process 1회당 1 double-word)
+    NVM_ST_ERROR            // 포트 오류 (다음 저장 요청 시 재시도)
+} Nvm_State_t;
+
+typedef struct {
+    uint8_t  state;         // Nvm_State_t
+    uint8_t  valid;         // 1: 유효 레코드 있음
+    uint16_t len;           // 최신 레코드 데이터 길이
+    uint32_t seq;           // 최신 레코드 순번
+    uint32_t wr_ofs;        // 다음 기록 위치 (오프셋)
+    uint32_t saves;         // 완료된 저장 수 (부팅 후)
+    uint32_t erases;        // 페이지 삭제 수 (부팅 후)
+    uint32_t bad_records;   // 스캔 중 버린 레코드 (미완료/CRC/ECC)
+} Nvm_Status_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 영역 스캔 후 최신 레코드/기록 위치 결정
+ * @param pPort  저장 매체 포트
+ */
+void Nvm_Init(const Nvm_Port_t *pPort);
+
+/**
+ * @brief 최신 레코드 읽기
+ * @param dst   출력 버퍼
+ * @param max   버퍼 크기
+ * @return 읽은 길이 (유효 레코드 없으면 0)
+ */
+uint32_t Nvm_Load(void *dst, uint32_t max);
+
+/**
+ * @brief 저장 요청 (데이터를 내부 버퍼로 복사, 실제 기록은 Nvm_Process)
+ * @return NVM_SAVE_xxx (DEFERRED: 다음 페이지 삭제가 필요한데 지금은 허용되지 않음)
+ */
+uint8_t Nvm_Save(const void *src, uint32_t len);
+
+/**
+ * @brief 메인 루프 처리 - 1회 호출당 최대 1 double-word 기록 또는 1 페이지 삭제
+ */
+void Nvm_Process(void);
+
+/**
+ * @brief 기록 진행 중 여부
+ */
+uint8_t Nvm_IsBusy(void);
+
+/**
+ * @brief 상태 반환 (디버깅용)
+ */
+const Nvm_Status_t* Nvm_GetStatus(void);
+
+#endif /* __NVM_H */
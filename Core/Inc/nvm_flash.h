@@ -0,0 +1,24 @@
+/**
+ * @file    nvm_flash.h
+ * @brief   영구 저장 포트 - 내장 FLASH 마지막 페이지 (링커 NVM 영역)
+ */
+
+#ifndef __NVM_FLASH_H
+#define __NVM_FLASH_H
+
+#include "nvm.h"
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief FLASH 포트 반환 (Nvm_Init 인자)
+ */
+const Nvm_Port_t* NvmFlash_Port(void);
+
+/**
+ * @brief NMI 에서 호출 - FLASH ECC 2비트 오류가 NVM 영역 읽기에서 발생했는지 확인/처리
+ * @return 1: 처리됨 (NMI 복귀 가능), 0: 다른 원인
+ */
+uint8_t NvmFlash_OnNmi(void);
+
+#endif /* __NVM_FLASH_H */
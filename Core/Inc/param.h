@@ -0,0 +1,151 @@
+/**
+ * @file    param.h
+ * @brief   파라미터 레지스트리 헤더 - 타입/범위/단위/기본값, 이중 뱅크 원자 커밋
+ */
+
+#ifndef __PARAM_H
+#define __PARAM_H
+
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+/* 테이블 구조 버전 (키/타입/의미가 바뀌면 증가, 영구 저장 호환성 판정용) */
+#define PARAM_LAYOUT_VERSION    2u      // 2: 주파수 파라미터가 실제 TIM6 1 kHz 기준 (1 은 10× 스케일)
+
+/* ============== 타입 정의 ============== */
+typedef enum {
+    PARAM_T_U32 = 0,
+    PARAM_T_F32
+} Param_Type_t;
+
+/* 파라미터 인덱스 (테이블 순서, 통신/저장에는 key 사용) */
+typedef enum {
+    PARAM_OL_FREQ_HZ = 0,   // 오픈루프 전기 주파수 [Hz]
+    PARAM_OL_VOLTAGE,       // 오픈루프 전압 [0~1 정규화]
+    PARAM_OL_VOLT_V,        // 오픈루프 전압 [V] (전압 모드)
+    PARAM_OL_VOLT_MODE,     // 1: OL_VOLT_V 를 버스 전압으로 정규화
+    PARAM_V_NORM_MAX,       // 정규화 전압 상한
+    PARAM_V_MOD_MAX,        // 전압 모드 변조 상한 (선형 영역 1/√3)
+    PARAM_CTRL_FREQ_HZ,     // 제어 주파수 [Hz] (읽기 전용, TIM6 = CONTROL_FREQ_HZ)
+    PARAM_PWM_PERIOD,       // TIM3 ARR (중앙정렬: f = 170MHz / 2(ARR+1))
+    PARAM_PWM_SPREAD,       // PWM 주기 확산 폭 [%] (0 = 고정 주기, SVPWM_SPREAD)
+    PARAM_PWM_ARR_LO,       // 저속 TIM3 ARR (SVPWM_PWM_SCHED, 고속은 PARAM_PWM_PERIOD)
+    PARAM_PWM_SCH_F_LO,     // 이 전기 주파수 이하 PARAM_PWM_ARR_LO [Hz]
+    PARAM_PWM_SCH_F_HI,     // 이 전기 주파수 이상 PARAM_PWM_PERIOD [Hz] (F_LO 이하면 스케줄 끔)
+    PARAM_TELEM_DECIM,      // 텔레메트리 제어 샘플 간격 [스텝] (0 = 정지)
+    PARAM_MOTOR_RS,         // 상저항 [Ω] (motor_id 결과)
+    PARAM_MOTOR_LD,         // d축 인덕턴스 [H]
+    PARAM_MOTOR_LQ,         // q축 인덕턴스 [H]
+    PARAM_MOTOR_FLUX,       // 자속 쇄교 (역기전력 상수) [V·s/rad 전기각]
+    PARAM_MOTOR_POLES,      // 극쌍수
+    PARAM_MECH_J,           // 관성 [kg·m²] (mech_id 결과)
+    PARAM_MECH_B,           // 점성 마찰 [N·m·s/rad]
+    PARAM_MECH_TC,          // 쿨롱 마찰 [N·m]
+    PARAM_CUR_KP,           // 전류 루프 비례 이득 [V/A]
+    PARAM_CUR_KI,           // 전류 루프 적분 이득 [V/(A·s)]
+    PARAM_SPD_KP,           // 속도 루프 비례 이득 [A/(rad/s)] (기계각)
+    PARAM_SPD_KI,           // 속도 루프 적분 이득 [A/rad]
+    PARAM_ID_V_DC,          // 식별: 정렬/저항 측정 DC 전압 [V]
+    PARAM_ID_V_HF,          // 식별: 인덕턴스 측정 교번 전압 [V]
+    PARAM_ID_SPIN_HZ,       // 식별: 자속 측정 오픈루프 전기 주파수 [Hz]
+    PARAM_ID_V_SPIN,        // 식별: 자속 측정 오픈루프 전압 [V]
+    PARAM_ID_CUR_BW,        // 식별: 전류 루프 목표 대역폭 [Hz] (이득 자동 계산)
+    PARAM_ID_SPD_BW,        // 식별: 속도 루프 목표 대역폭 [Hz] (이득 자동 계산)
+    PARAM_COUNT
+} Param_Id_t;
+
+typedef union {
+    uint32_t u;
+    float    f;
+} Param_Value_t;
+
+/* 값 뱅크 (ISR 은 Param_Active() 로 받은 뱅크만 읽는다) */
+typedef struct {
+    Param_Value_t v[PARAM_COUNT];
+    uint32_t      version;      // 커밋마다 증가
+} Param_Bank_t;
+
+/* 파라미터 정의 */
+typedef struct {
+    uint16_t      key;          // 통신/저장용 고정 ID
+    uint8_t       type;         // Param_Type_t
+    const char   *name;
+    const char   *unit;
+    Param_Value_t min;
+    Param_Value_t max;
+    Param_Value_t def;
+} Param_Desc_t;
+
+/* 변경 묶음 (Param_Stage/Commit 의 공유 묶음은 통신 PARAM_WRITE 전용,
+ * 내부 설정 경로는 지역 묶음을 써서 호스트가 예약 중인 값을 건드리지 않는다) */
+typedef struct {
+    Param_Value_t v[PARAM_COUNT];
+    uint32_t      mask;         // 예약된 인덱스 비트
+} Param_Batch_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 기본값으로 초기화 (제어 ISR 시작 전)
+ */
+void Param_Init(void);
+
+/**
+ * @brief 현재 적용 뱅크 (ISR: 스텝마다 1회 받아서 사용, 잠금 없음)
+ */
+const Param_Bank_t* Param_Active(void);
+
+/**
+ * @brief 현재 적용값 읽기
+ */
+Param_Value_t Param_Get(Param_Id_t id);
+
+/**
+ * @brief 변경 예약 (통신 PARAM_WRITE 공유 묶음, 범위 검사, 메인 루프 전용)
+ * @return 1: 예약, 0: 범위 밖 / NaN / 잘못된 ID
+ */
+uint8_t Param_Stage(Param_Id_t id, Param_Value_t value);
+uint8_t Param_StageF(Param_Id_t id, float value);
+uint8_t Param_StageU(Param_Id_t id, uint32_t value);
+
+/**
+ * @brief 예약된 변경을 한 번에 적용 (메인 루프 전용)
+ * @return 적용 후 버전
+ */
+uint32_t Param_Commit(void);
+
+/**
+ * @brief 예약된 변경 취소
+ */
+void Param_Discard(void);
+
+/**
+ * @brief 지역 묶음 비우기
+ */
+void Param_BatchInit(Param_Batch_t *pBatch);
+
+/**
+ * @brief 지역 묶음에 변경 예약 (범위 검사는 Param_Stage 와 동일)
+ * @return 1: 예약, 0: 범위 밖 / NaN / 잘못된 ID
+ */
+uint8_t Param_BatchStage(Param_Batch_t *pBatch, Param_Id_t id, Param_Value_t value);
+uint8_t Param_BatchStageF(Param_Batch_t *pBatch, Param_Id_t id, float value);
+uint8_t Param_BatchStageU(Param_Batch_t *pBatch, Param_Id_t id, uint32_t value);
+
+/**
+ * @brief 지역 묶음만 한 번에 적용 (메인 루프 전용, 공유 예약은 유지)
+ * @return 적용 후 버전
+ */
+uint32_t Param_BatchCommit(Param_Batch_t *pBatch);
+
+/**
+ * @brief 정의 조회
+ */
+const Param_Desc_t* Param_GetDesc(Param_Id_t id);
+
+/**
+ * @brief key → 인덱스 (없으면 PARAM_COUNT)
+ */
+Param_Id_t Param_FindKey(uint16_t key);
+
+#endif /* __PARAM_H */
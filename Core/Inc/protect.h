@@ -0,0 +1,69 @@
+/**
+ * @file    protect.h
+ * @brief   과전류 보호 헤더 - COMP3/DAC3 + TIM3 OCREF_CLR, ADC 아날로그 워치독
+ */
+
+#ifndef __PROTECT_H
+#define __PROTECT_H
+
+#include "stm32g4xx_hal.h"
+#include "fault.h"
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+#define PROTECT_OC_HW_A         3.0f        // COMP3 트립 전류 (A상 +방향) [A]
+#define PROTECT_OC_SW_A         2.8f        // ADC AWD 트립 전류 (양방향) [A]
+#define PROTECT_VBUS_OV_V       30.0f       // 버스 과전압 [V]
+#define PROTECT_VBUS_UV_V       6.0f        // 버스 저전압 [V] (드라이버 EN 상태에서만 검사)
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 보호 회로 초기화 (Sense_Init 이전, ADC 변환 시작 전에 호출)
+ * @param htim_pwm  PWM 타이머 (TIM3) 핸들
+ * @param hadc_a    A상 전류 ADC (ADC1) 핸들
+ * @param hadc_b    B상 전류 ADC (ADC2) 핸들
+ */
+void Protect_Init(TIM_HandleTypeDef *htim_pwm, ADC_HandleTypeDef *hadc_a, ADC_HandleTypeDef *hadc_b);
+
+/**
+ * @brief 버스 전압 검사 (제어 주기마다 호출)
+ * @param vbus  버스 전압 [V]
+ */
+void Protect_CheckVbus(float vbus);
+
+/**
+ * @brief 고장 해제 요청 (현재 원인이 남아 있으면 거부)
+ * @return 1: 해제 접수, 0: 거부
+ */
+uint8_t Protect_ClearFault(void);
+
+/**
+ * @brief 운전 지령 설정 (RUN: 드라이버 활성, STOP: 비활성) - 지령은 고장 해제 후에도 유지
+ * @param run  1: RUN, 0: STOP
+ * @return 1: 적용, 0: 거부 (고장 중 RUN)
+ */
+uint8_t Protect_SetRun(uint8_t run);
+
+/**
+ * @brief 운전 지령 반환
+ * @return 1: RUN, 0: STOP
+ */
+uint8_t Protect_IsRun(void);
+
+/**
+ * @brief 주기 처리 (메인 루프) - HOLDOFF 경과 후 보호 재무장, RUN 지령이면 드라이버 재활성
+ */
+void Protect_Process(void);
+
+/**
+ * @brief COMP3 EXTI 인터럽트 처리 (COMP1_2_3_IRQHandler 에서 호출)
+ */
+void Protect_COMP_IRQHandler(void);
+
+/**
+ * @brief 즉시 출력 차단 (Error_Handler 등에서 직접 호출 가능)
+ */
+void Protect_Shutdown(void);
+
+#endif /* __PROTECT_H */
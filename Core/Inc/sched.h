@@ -0,0 +1,81 @@
+/**
+ * @file    sched.h
+ * @brief   협조형 마감 시각 스케줄러 헤더 (메인 루프 백그라운드 태스크)
+ *
+ * 태스크는 끝까지 실행되는 함수 (선점 없음). 제어 ISR 은 영향을 받지 않는다.
+ */
+
+#ifndef __SCHED_H
+#define __SCHED_H
+
+#include <stdint.h>
+
+/* ============== 태스크 ID (main.c 에서 등록) ============== */
+typedef enum {
+    SCHED_TASK_PROTECT = 0,     // 고장 HOLDOFF 처리 (주기 + 고장 이벤트)
+    SCHED_TASK_CMD,             // 명령 수신 (주기 + UART IDLE 이벤트)
+    SCHED_TASK_TELEM,           // 텔레메트리 DMA 시작
+    SCHED_TASK_SCOPE,           // 스코프 업로드
+    SCHED_TASK_IDENT,           // 전기/기계 파라미터 식별 후처리
+    SCHED_TASK_CONFIG,          // FLASH 설정 저장 진행
+    SCHED_TASK_LATENCY,         // ISR 지연 측정 부하 (LATENCY_MEASURE)
+    SCHED_TASK_LOAD,            // CPU 부하 창 마감/송신 (CPU_LOAD_MONITOR)
+    SCHED_TASK_BENCH,           // 사이클 벤치마크 진행 (CMD_BENCH)
+    SCHED_TASK_COUNT
+} Sched_TaskId_t;
+
+/* ============== 타입 정의 ============== */
+typedef void (*Sched_TaskFn_t)(void);
+
+typedef struct {
+    uint32_t runs;          // 실행 횟수
+    uint32_t events;        // 이벤트 릴리스 횟수
+    uint32_t skipped;       // 밀려서 건너뛴 주기 릴리스 수
+    uint32_t late;          // 마감 시각을 넘겨 완료한 횟수
+    uint32_t last_cyc;      // 최근 실행 [cycle]
+    uint32_t max_cyc;       // 최대 실행 [cycle]
+    uint64_t total_cyc;     // 누적 실행 [cycle] (점유율 계산용)
+    uint32_t max_wait_ms;   // 릴리스 → 실행 시작 최대 대기 [ms]
+} Sched_Stats_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 스케줄러 초기화 (DWT 활성화, 태스크 테이블 비우기)
+ */
+void Sched_Init(void);
+
+/**
+ * @brief 태스크 등록
+ * @param id           태스크 ID
+ * @param name         이름 (디버깅용)
+ * @param fn           태스크 함수
+ * @param period_ms    주기 [ms] (0: 이벤트 전용)
+ * @param deadline_ms  릴리스 후 완료 마감 [ms] (준비된 태스크 중 마감이 가장 이른 것부터 실행)
+ */
+void Sched_Register(Sched_TaskId_t id, const char *name, Sched_TaskFn_t fn,
+                    uint32_t period_ms, uint32_t deadline_ms);
+
+/**
+ * @brief 이벤트 릴리스 요청 (ISR 에서 호출 가능)
+ * @param id  태스크 ID
+ */
+void Sched_Signal(Sched_TaskId_t id);
+
+/**
+ * @brief 메인 루프에서 반복 호출 - 준비된 태스크 1개 실행, 없으면 WFI 대기
+ */
+void Sched_Poll(void);
+
+/**
+ * @brief 통계 초기화
+ */
+void Sched_ResetStats(void);
+
+/**
+ * @brief 태스크 통계 반환 (디버깅용)
+ * @param id  태스크 ID
+ */
+Sched_Stats_t* Sched_GetStats(Sched_TaskId_t id);
+
+#endif /* __SCHED_H */
@@ -0,0 +1,117 @@
+/**
+ * @file    scope.h
+ * @brief   온타겟 오실로스코프 헤더 - 제어 틱마다 다채널 캡처 (프리/포스트 트리거)
+ */
+
+#ifndef __SCOPE_H
+#define __SCOPE_H
+
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+#define SCOPE_BUF_WORDS         2048u   // 캡처 버퍼 [word] (8 KB, 채널 수로 나눠 사용)
+#define SCOPE_MAX_CH            8u
+
+/* 신호 소스 ID */
+typedef enum {
+    SCOPE_SRC_ANGLE = 0,    // float  전기각 [rad]
+    SCOPE_SRC_SECTOR,       // uint8  섹터 (1~6)
+    SCOPE_SRC_T1,           // float  활성벡터 1 시간 비율
+    SCOPE_SRC_T2,           // float  활성벡터 2 시간 비율
+    SCOPE_SRC_T0,           // float  영벡터 시간 비율
+    SCOPE_SRC_CCR_A,        // uint16 CH1 비교값
+    SCOPE_SRC_CCR_B,        // uint16 CH2 비교값
+    SCOPE_SRC_CCR_C,        // uint16 CH3 비교값
+    SCOPE_SRC_IA,           // float  A상 전류 [A]
+    SCOPE_SRC_IB,           // float  B상 전류 [A]
+    SCOPE_SRC_VBUS,         // float  버스 전압 [V]
+    SCOPE_SRC_RAW_IA,       // uint16 ADC 원시값
+    SCOPE_SRC_RAW_IB,       // uint16 ADC 원시값
+    SCOPE_SRC_MECH_SPEED,   // float  기계 식별 속도 [rad/s] (기계각)
+    SCOPE_SRC_MECH_IQ,      // float  기계 식별 토크 전류 추정 [A]
+    SCOPE_SRC_COUNT
+} Scope_Src_t;
+
+/* 트리거 모드 */
+typedef enum {
+    SCOPE_TRIG_NONE = 0,    // 프리트리거 채워지면 즉시
+    SCOPE_TRIG_LEVEL,       // 값 >= level
+    SCOPE_TRIG_RISING,      // 이전 < level <= 현재
+    SCOPE_TRIG_FALLING,     // 이전 > level >= 현재
+    SCOPE_TRIG_FAULT        // 고장 래치 (Fault_IsOk() == 0)
+} Scope_TrigMode_t;
+
+/* 캡처 상태 */
+typedef enum {
+    SCOPE_ST_IDLE = 0,      // 정지
+    SCOPE_ST_DONE,          // 캡처 완료 (업로드 가능)
+    SCOPE_ST_ARMED,         // 기록 중, 트리거 대기
+    SCOPE_ST_TRIGGERED      // 트리거 후 포스트 구간 기록 중
+} Scope_State_t;
+
+typedef struct {
+    uint8_t  state;         // Scope_State_t
+    uint8_t  nch;           // 채널 수
+    uint16_t depth;         // 채널당 샘플 수
+    uint16_t pre;           // 프리트리거 샘플 수
+    uint16_t start;         // 완료 시 가장 오래된 샘플 인덱스
+    uint32_t decim;         // N 틱마다 1 샘플
+} Scope_Info_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 소스 주소 테이블 구성 (SVPWM_Init, Sense_Init 이후)
+ */
+void Scope_Init(void);
+
+/**
+ * @brief 채널/간격/프리트리거 설정 (IDLE/DONE 에서만)
+ * @param pSrc     소스 ID 배열 (Scope_Src_t)
+ * @param n        채널 수 (1 ~ SCOPE_MAX_CH)
+ * @param dec      N 틱마다 1 샘플 (1 이상)
+ * @param pre_pct  프리트리거 비율 [%] (0 ~ 100)
+ * @return 1: 적용, 0: 인자 오류 또는 캡처 중
+ */
+uint8_t Scope_Config(const uint8_t *pSrc, uint32_t n, uint32_t dec, uint32_t pre_pct);
+
+/**
+ * @brief 트리거 설정
+ * @param mode   Scope_TrigMode_t
+ * @param ch     트리거 채널 (설정된 채널 순서 인덱스)
+ * @param level  기준값 (채널 단위, 정수 소스는 정수값으로 비교)
+ * @return 1: 적용, 0: 인자 오류
+ */
+uint8_t Scope_SetTrigger(uint32_t mode, uint32_t ch, float level);
+
+/**
+ * @brief 캡처 시작 (ARMED)
+ */
+uint8_t Scope_Arm(void);
+
+/**
+ * @brief 캡처 중지 (IDLE)
+ */
+void Scope_Stop(void);
+
+/**
+ * @brief 제어 틱마다 호출 - 채널 기록 및 트리거 판정 (제어 ISR)
+ */
+void Scope_Record(void);
+
+/**
+ * @brief 캡처 상태 반환
+ */
+void Scope_GetInfo(Scope_Info_t *pInfo);
+
+/**
+ * @brief 캡처 데이터 업로드 시작 (DONE 상태에서, 텔레메트리 프레임으로 전송)
+ */
+uint8_t Scope_StartUpload(void);
+
+/**
+ * @brief 메인 루프 처리 - 업로드 프레임을 텔레메트리 링 여유만큼 전송
+ */
+void Scope_Process(void);
+
+#endif /* __SCOPE_H */
@@ -0,0 +1,88 @@
+/**
+ * @file    sense.h
+ * @brief   ADC 측정 헤더 - 상전류(INA240) 및 DC 버스 전압
+ */
+
+#ifndef __SENSE_H
+#define __SENSE_H
+
+#include "stm32g4xx_hal.h"
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+/* ADC 설정 */
+#define ADC_VREF            3.3f            // ADC 기준 전압 [V]
+#define ADC_FULL_SCALE      4095.0f         // 12bit
+
+/* INA240 전류 측정 (SimpleFOC Shield v2.0.4) */
+#define CURR_SHUNT_OHM      0.01f           // 션트 저항 [Ω]
+#define CURR_AMP_GAIN       50.0f           // INA240A2 이득 [V/V]
+#define CURR_OFFSET_V       (ADC_VREF * 0.5f)   // 0A 출력 전압 [V]
+
+/* 단일 션트 보드 (SVPWM_SINGLE_SHUNT): DC 링크 션트 앰프 → ADC1 주입 그룹 (같은 션트/이득/오프셋) */
+#define SENSE_SHUNT_CHANNEL ADC_CHANNEL_1              // A1C1 핀 (상별 보드의 CurrA)
+#define SENSE_SHUNT_SMP     ADC_SAMPLETIME_6CYCLES_5   // SMPR 공유 - 정규 rank1 도 같은 값
+#define SENSE_SHUNT_STOP_SPIN 128u                     // 주입 정지 (JADSTP) 대기 상한 [회] (≈ 4us, 정상은 수 ADC 클럭)
+
+/* DC 버스 전압 분배 (A1C2_Vbus: 100k / 10k) */
+#define VBUS_DIV_GAIN       11.0f           // Vbus = Vadc * 분배비
+#define VBUS_MIN_V          1.0f            // 정규화 시 0 나누기 방지용 하한 [V]
+
+/* 필터 계수 (제어 주기마다 1회 갱신) */
+#define VBUS_LPF_ALPHA      0.01f           // 표시/제한용 저속 필터
+#define VBUS_FF_ALPHA       0.5f            // 리플 피드포워드용 고속 필터
+
+/* ============== 타입 정의 ============== */
+typedef struct {
+    uint16_t raw_ia;        // ADC1 rank1 (A1C1_CurrA)
+    uint16_t raw_vbus;      // ADC1 rank2 (A1C2_Vbus)
+    uint16_t raw_ib;        // ADC2 rank1 (A2C17_CurrB)
+    uint16_t raw_resv;      // ADC2 rank2 (A2C6_RESV)
+    float    ia;            // A상 전류 [A]
+    float    ib;            // B상 전류 [A]
+    float    vbus;          // 버스 전압 (고속 필터) [V]
+    float    vbus_filt;     // 버스 전압 (저속 필터) [V]
+    float    vbus_inv;      // 1 / vbus (정규화 계수) [1/V]
+} Sense_State_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief ADC 캘리브레이션 및 듀얼 모드 DMA 변환 시작
+ * @param hadc_master  ADC1 (듀얼 모드 마스터) 핸들 포인터
+ * @param hadc_slave   ADC2 (듀얼 모드 슬레이브) 핸들 포인터
+ */
+void Sense_Init(ADC_HandleTypeDef *hadc_master, ADC_HandleTypeDef *hadc_slave);
+
+/**
+ * @brief 최신 DMA 샘플로 전류/전압 갱신 (제어 주기마다 호출)
+ */
+void Sense_Update(void);
+
+/**
+ * @brief 단일 션트 샘플 래치 (TIM3 업데이트 ISR 정점, SVPWM_SINGLE_SHUNT)
+ * @param map  샘플을 만든 PWM 주기의 배치 (SVPWM_Shunt_t.map)
+ */
+void Sense_ShuntLatch(uint8_t map);
+
+/**
+ * @brief 주입 정지 대기 시간 초과 횟수 (SVPWM_SINGLE_SHUNT, 디버깅용)
+ */
+uint32_t Sense_GetShuntStopTimeouts(void);
+
+/**
+ * @brief 버스 전압 [V] (저속 필터)
+ */
+float Sense_GetVbus(void);
+
+/**
+ * @brief 전압[V] → 정규화 변조 계수 (1 / Vbus, 리플 피드포워드 포함)
+ */
+float Sense_GetVbusInv(void);
+
+/**
+ * @brief 현재 측정 상태 반환 (디버깅용)
+ */
+Sense_State_t* Sense_GetState(void);
+
+#endif /* __SENSE_H */
@@ -7,28 +7,17 @@
 #define __SVPWM_H
 
 #include "stm32g4xx_hal.h"
+#include "svpwm_core.h"
 #include <stdint.h>
 
 /* ============== 상수 정의 ============== */
-#define PI              3.14159265f
-#define TWO_PI          6.28318530f
-#define SQRT3           1.7320508f
-#define SQRT3_HALF      0.8660254f     // √3/2
-#define SQRT3_INV       0.57735027f    // 1/√3
+/* 수학 상수, SVPWM_State_t: svpwm_core.h */
 
 /* PWM 설정 */
-#define PWM_PERIOD      (8499)           // ARR 
-
-/* ============== 타입 정의 ============== */
-typedef struct {
-    uint8_t  sector;    // 현재 섹터 (1~6)
-    float    T1;        // 첫 번째 활성벡터 시간 비율
-    float    T2;        // 두 번째 활성벡터 시간 비율
-    float    T0;        // 영벡터 시간 비율
-    uint16_t CCR_A;     // CH1 (A상) 비교값
-    uint16_t CCR_B;     // CH2 (B상) 비교값
-    uint16_t CCR_C;     // CH3 (C상) 비교값
-} SVPWM_State_t;
+#define PWM_PERIOD      SVPWM_ARR        // ARR 기본값 (svpwm_config.h, 런타임 값은 PARAM_PWM_PERIOD)
+
+/* ============== 전역 변수 ============== */
+extern volatile float g_angle;          // 현재 전기각 [rad] (스코프/텔레메트리 소스)
 
 /* ============== 함수 선언 ============== */
 
@@ -58,14 +47,34 @@ void SVPWM_Run(float Valpha, float Vbeta);
  */
 void SVPWM_Stop(void);
 
+/**
+ * @brief 주기 경계 ARR / CCR 갱신 - 확산 / 주기 변경 / 단일 션트 반주기 (TIM3_IRQHandler 에서 호출, SVPWM_PERIOD_ISR)
+ */
+void SVPWM_PeriodIRQHandler(void);
+
 
 
 /**
- * @brief 오픈루프 속도 설정
+ * @brief 오픈루프 속도 설정 (지역 묶음으로 커밋, 메인 루프 전용)
  * @param freq_hz   전기 주파수 [Hz] (모터 극쌍수에 따라 기계 속도 결정)
  * @param voltage   전압 크기 [0.0 ~ 1.0]
+ * @return 1: 적용, 0: 범위 밖 (레지스트리 변경 없음)
+ */
+uint8_t OpenLoop_SetSpeed(float freq_hz, float voltage);
+
+/**
+ * @brief 오픈루프 속도 설정 (전압 단위, 지역 묶음으로 커밋, 메인 루프 전용)
+ * @param freq_hz   전기 주파수 [Hz]
+ * @param volt      상전압 크기 [V] (버스 전압으로 자동 정규화, 최대 Vbus/√3)
+ * @return 1: 적용, 0: 범위 밖 (레지스트리 변경 없음)
+ */
+uint8_t OpenLoop_SetSpeedVolt(float freq_hz, float volt);
+
+/**
+ * @brief 제어 루프 1 스텝 (TIM6 업데이트마다 호출)
+ * @note  CONTROL_DISPATCH_LEAN 에 따라 HAL 콜백 또는 TIM6_DAC_IRQHandler 에서 직접 호출
  */
-void OpenLoop_SetSpeed(float freq_hz, float voltage);
+void OpenLoop_Step(void);
 
 
 
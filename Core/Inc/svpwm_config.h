@@ -0,0 +1,155 @@
+/**
+ * @file    svpwm_config.h
+ * @brief   SVPWM 변조기 컴파일 설정 (타이머 클럭, PWM 주파수, 데드타임, 변조 방식)
+ *
+ * 여기서 정한 값은 모두 컴파일 상수로 펼쳐져 SVPWM_CalcCCR 핫패스에
+ * 런타임 분기를 남기지 않는다. 잘못된 조합은 _Static_assert 로 빌드가 멈춘다.
+ * 삼각함수 백엔드는 app_config.h 의 CONTROL_TRIG_LUT.
+ */
+
+#ifndef __SVPWM_CONFIG_H
+#define __SVPWM_CONFIG_H
+
+/* ============================================================
+ * 타이머 / PWM 주파수
+ * ============================================================
+ * TIM3 중앙정렬: f_pwm = f_tim / (2·(ARR+1))
+ */
+#ifndef SVPWM_TIM_CLK_HZ
+#define SVPWM_TIM_CLK_HZ        170000000u
+#endif
+
+#ifndef SVPWM_PWM_FREQ_HZ
+#define SVPWM_PWM_FREQ_HZ       10000u
+#endif
+
+/* ARR (PWM_PERIOD, PARAM_PWM_PERIOD 기본값) */
+#define SVPWM_ARR               (SVPWM_TIM_CLK_HZ / (2u * SVPWM_PWM_FREQ_HZ) - 1u)
+
+/* 1: 주기를 SVPWM_ARR 로 고정 (PARAM_PWM_PERIOD 무시, CCR 환산/제한이 상수)
+ * 0: PARAM_PWM_PERIOD 로 런타임 변경 가능 (환산 계수는 변경 시에만 재계산) */
+#ifndef SVPWM_FIXED_PERIOD
+#define SVPWM_FIXED_PERIOD      0
+#endif
+
+/* ============================================================
+ * 단일 션트 전류 측정 (DC 링크 션트만 있는 보드)
+ * ============================================================
+ * 1: PWM 주기마다 하강 구간에서 DC 링크 전류를 두 번 샘플한다 (ADC1 주입 그룹, TIM3 CH4 트리거).
+ *      한 상만 HIGH 인 구간 → +i_max,  두 상이 HIGH 인 구간 → -i_min,  나머지 상 = 합 0 으로 복원
+ *    구간이 SVPWM_SHUNT_TMIN_TICKS 보다 짧으면 SVPWM_CalcCCR 이 하강 구간 에지를 밀어 창을 만들고
+ *    상승 구간 에지를 같은 양만큼 반대로 밀어 상별 주기 평균 (CCR_A/B/C) 을 그대로 둔다.
+ *    반주기마다 CCR 을 바꾸므로 TIM3 업데이트 ISR 이 정점과 바닥 모두에서 기록한다 (주기 확산과 배타).
+ * 0: 코드 제거 (상별 션트: ADC1/ADC2 정규 변환)
+ */
+#ifndef SVPWM_SINGLE_SHUNT
+#define SVPWM_SINGLE_SHUNT      0
+#endif
+
+#ifndef SVPWM_SHUNT_TSET_NS
+#define SVPWM_SHUNT_TSET_NS     1000u       // 에지 후 안정 시간 (드라이버 데드타임 + 링잉 + 앰프 슬루)
+#endif
+
+#ifndef SVPWM_SHUNT_TS_NS
+#define SVPWM_SHUNT_TS_NS       250u        // ADC 샘플링 (6.5 cycle @ 42.5MHz) + 트리거 지연
+#endif
+
+#define SVPWM_SHUNT_TS_TICKS    ((SVPWM_SHUNT_TS_NS * (SVPWM_TIM_CLK_HZ / 1000000u) + 999u) / 1000u)
+#define SVPWM_SHUNT_TMIN_TICKS  (((SVPWM_SHUNT_TSET_NS + SVPWM_SHUNT_TS_NS) * (SVPWM_TIM_CLK_HZ / 1000000u) + 999u) / 1000u)
+
+/* ============================================================
+ * 주기 확산 (EMI 저감)
+ * ============================================================
+ * 1: PARAM_PWM_SPREAD [%] 가 0 이 아니면 TIM3 업데이트 ISR 이 PWM 주기마다
+ *    LFSR 로 ARR 을 ±폭 안에서 바꾸고 CCR 을 그 주기에 맞춰 환산한다 (ON 비율 유지).
+ *    제어 주기 (TIM6) 는 영향이 없다.
+ * 0: 코드 제거 (TIM3 업데이트 ISR 미사용). 단일 션트 빌드의 기본값.
+ */
+#ifndef SVPWM_SPREAD
+#define SVPWM_SPREAD            (!SVPWM_SINGLE_SHUNT)
+#endif
+
+#define SVPWM_SPREAD_MAX_PCT    20u         // PARAM_PWM_SPREAD 상한
+#define SVPWM_SPREAD_LFSR_SEED  0xACE1u     // 16bit 갈루아 LFSR 초기값 (0 금지)
+
+/* ============================================================
+ * PWM 주파수 스케줄 (속도 → ARR)
+ * ============================================================
+ * 1: |지령 전기 주파수| 가 PARAM_PWM_SCH_F_LO 이하면 PARAM_PWM_ARR_LO (저속: 스위칭 손실 ↓),
+ *    PARAM_PWM_SCH_F_HI 이상이면 PARAM_PWM_PERIOD (고속: 리플 ↓), 사이는 PWM 주파수 선형 보간.
+ *    F_HI <= F_LO 면 스케줄 끔. SVPWM_FIXED_PERIOD 면 무시.
+ * 0: 코드 제거
+ * 주기 변경 (스케줄 / PARAM_PWM_PERIOD) 은 TIM3 업데이트 ISR 이 정점에서 ARR 과 환산 CCR 을
+ * 함께 기록해 바닥 (주기 경계) 에서 한 번에 옮겨지게 한다.
+ */
+#ifndef SVPWM_PWM_SCHED
+#define SVPWM_PWM_SCHED         1
+#endif
+
+#define SVPWM_SCHED_HYST_TICKS  32u         // 이 이상 바뀔 때만 주기 변경 (끝점은 항상)
+
+/* TIM3 업데이트 ISR 로 ARR/CCR 을 주기 경계에 기록 (확산, 런타임 주기 변경 또는 단일 션트) */
+#define SVPWM_PERIOD_ISR        (SVPWM_SPREAD || !SVPWM_FIXED_PERIOD || SVPWM_SINGLE_SHUNT)
+
+/* ============================================================
+ * 데드타임 / 최소 펄스
+ * ============================================================
+ * TIM3 은 상보 출력이 없어 데드타임은 게이트 드라이버(L6234, 약 300ns)가 만든다.
+ * 0 이 아니면 데드타임보다 짧은 펄스를 0 또는 100% 로 밀어내 드라이버에서
+ * 사라지는 펄스로 인한 전압 오차를 없앤다. 0: 제한 없음 (코드 제거)
+ */
+#ifndef SVPWM_DEADTIME_NS
+#define SVPWM_DEADTIME_NS       0u
+#endif
+
+#define SVPWM_DT_TICKS          ((SVPWM_DEADTIME_NS * (SVPWM_TIM_CLK_HZ / 1000000u) + 999u) / 1000u)
+
+/* 드라이버 실제 데드타임 (위 펄스 제한과 무관하게 항상 존재).
+ * 상 전압 평균 오차 = −sign(i)·Vbus·t_dead / T_pwm - 전압으로 전류를 역산하는 mech_id 가 보정에 쓴다. */
+#ifndef SVPWM_DRIVER_DEADTIME_NS
+#define SVPWM_DRIVER_DEADTIME_NS    300u
+#endif
+
+/* ============================================================
+ * 변조 방식 - 영벡터 시간 T0 중 V7(111) 에 배분하는 비율
+ * ============================================================
+ *  SYMMETRIC : V0/V7 반반 (7 세그먼트, 기본)
+ *  DPWM_MIN  : V0(000) 만 사용 - 가장 낮은 상이 0% 에 고정 (스위칭 1/3 감소)
+ *  DPWM_MAX  : V7(111) 만 사용 - 가장 높은 상이 100% 에 고정
+ */
+#define SVPWM_MOD_SYMMETRIC     0
+#define SVPWM_MOD_DPWM_MIN      1
+#define SVPWM_MOD_DPWM_MAX      2
+
+#ifndef SVPWM_MODULATION
+#define SVPWM_MODULATION        SVPWM_MOD_SYMMETRIC
+#endif
+
+#if SVPWM_MODULATION == SVPWM_MOD_SYMMETRIC
+#define SVPWM_V7_SHARE          0.5f
+#elif SVPWM_MODULATION == SVPWM_MOD_DPWM_MIN
+#define SVPWM_V7_SHARE          0.0f
+#elif SVPWM_MODULATION == SVPWM_MOD_DPWM_MAX
+#define SVPWM_V7_SHARE          1.0f
+#else
+#error "SVPWM_MODULATION: SVPWM_MOD_xxx 중 하나"
+#endif
+
+/* ============================================================
+ * 설정 검증
+ * ============================================================ */
+_Static_assert(SVPWM_PWM_FREQ_HZ > 0u && SVPWM_TIM_CLK_HZ >= 2u * SVPWM_PWM_FREQ_HZ,
+               "SVPWM_PWM_FREQ_HZ out of range");
+_Static_assert(SVPWM_ARR >= 1u && SVPWM_ARR <= 0xFFFFu, "TIM3 ARR must fit 16 bits");
+_Static_assert(SVPWM_TIM_CLK_HZ % (2u * SVPWM_PWM_FREQ_HZ) == 0u,
+               "PWM frequency not exactly reachable with this timer clock");
+_Static_assert(2u * SVPWM_DT_TICKS < SVPWM_ARR, "dead time exceeds half the PWM period");
+_Static_assert(16999u * (100u + SVPWM_SPREAD_MAX_PCT) / 100u <= 0xFFFFu,
+               "spread ARR must fit 16 bits at the largest PARAM_PWM_PERIOD");
+_Static_assert(!(SVPWM_SINGLE_SHUNT && SVPWM_SPREAD), "single-shunt sampling needs a fixed-length period");
+_Static_assert(!SVPWM_SINGLE_SHUNT || SVPWM_SHUNT_TSET_NS + SVPWM_SHUNT_TS_NS >= 500u,
+               "second shunt trigger would arrive during the first ADC conversion");
+_Static_assert(!SVPWM_SINGLE_SHUNT || 4u * SVPWM_SHUNT_TMIN_TICKS < SVPWM_ARR,
+               "shunt sampling windows exceed the PWM period");
+
+#endif /* __SVPWM_CONFIG_H */
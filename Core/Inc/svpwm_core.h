@@ -0,0 +1,117 @@
+/**
+ * @file    svpwm_core.h
+ * @brief   SVPWM 변조 커널 헤더 (HAL 미포함, 호스트 빌드 가능)
+ */
+
+#ifndef __SVPWM_CORE_H
+#define __SVPWM_CORE_H
+
+#include "svpwm_config.h"
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+#define PI              3.14159265f
+#define TWO_PI          6.28318530f
+#define SQRT3           1.7320508f
+#define SQRT3_HALF      0.8660254f     // √3/2
+#define SQRT3_INV       0.57735027f    // 1/√3
+
+/* 입력 제한 (정규화 전압) - 이보다 큰 값/Inf 는 이 값으로, NaN 은 0 으로 */
+#define SVPWM_IN_LIMIT  1000.0f
+
+/* 단일 션트 샘플 배치 (SVPWM_Shunt_t.map) */
+#define SVPWM_SHUNT_VALID       0x80u       // 두 샘플 창 확보 (0: 대칭 출력, 샘플 없음)
+#define SVPWM_SHUNT_TRIG_OFF    0xFFFFu     // CCR4 > ARR: 트리거 없음
+
+/* ============== 타입 정의 ============== */
+/* 단일 션트 반주기 CCR / 샘플 트리거 (SVPWM_SINGLE_SHUNT) */
+typedef struct {
+    uint16_t up[3];     // 상승 구간 CCR (A, B, C)
+    uint16_t dn[3];     // 하강 구간 CCR - up + dn = 2·CCR (주기 평균 유지)
+    uint16_t trig[2];   // 하강 카운트 트리거 CCR4: [0] = +i_max, [1] = -i_min
+    uint8_t  map;       // bit0-1: 샘플 1 상, bit2-3: 샘플 2 상, bit7: SVPWM_SHUNT_VALID
+} SVPWM_Shunt_t;
+
+typedef struct {
+    uint8_t  sector;    // 현재 섹터 (1~6)
+    float    T1;        // 첫 번째 활성벡터 시간 비율
+    float    T2;        // 두 번째 활성벡터 시간 비율
+    float    T0;        // 영벡터 시간 비율
+    uint16_t CCR_A;     // CH1 (A상) 비교값
+    uint16_t CCR_B;     // CH2 (B상) 비교값
+    uint16_t CCR_C;     // CH3 (C상) 비교값
+#if SVPWM_SINGLE_SHUNT
+    SVPWM_Shunt_t shunt; // 단일 션트 반주기 배치 (CCR_A/B/C 는 주기 평균)
+#endif
+} SVPWM_State_t;
+
+/* 다음 PWM 주기 기록값 (제어 루프 → TIM3 업데이트 ISR) */
+typedef struct {
+    uint32_t arr;       // 기준 ARR (제어 루프 CCR 이 가정한 주기)
+    uint32_t span;      // 확산 폭 [tick] (0 = 고정 주기)
+    uint16_t lfsr;      // 확산 LFSR 상태
+    uint16_t ccr[3];    // 기준 주기 CCR (A, B, C)
+#if SVPWM_SINGLE_SHUNT
+    SVPWM_Shunt_t shunt; // 반주기 CCR / 트리거 (기준 주기)
+#endif
+} SVPWM_Period_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 전압 벡터 → 섹터, T1/T2/T0, CCR_A/B/C
+ * @param Valpha   α축 전압 (정규화: -1 ~ +1)
+ * @param Vbeta    β축 전압 (정규화: -1 ~ +1)
+ * @param scale    ON 비율 → CCR 환산 계수 (ARR + 1)
+ * @param ccr_max  CCR 상한 (ARR + 1 = 100% ON)
+ * @param pState   결과
+ */
+void SvpwmCore_Calc(float Valpha, float Vbeta, float scale, uint32_t ccr_max,
+                    SVPWM_State_t *pState);
+
+/**
+ * @brief 단일 션트: 하강 구간 샘플 창 확보 (에지 이동 + 상승 구간 보상)
+ * @param ccr      주기 평균 CCR (A, B, C)
+ * @param ccr_max  CCR 상한 (ARR + 1)
+ * @param pSh      [out] 반주기 CCR, 트리거, 샘플 상 배치
+ */
+void SvpwmCore_ShuntShift(const uint16_t ccr[3], uint32_t ccr_max, SVPWM_Shunt_t *pSh);
+
+/**
+ * @brief 주기 확산: LFSR 을 진행시켜 이번 PWM 주기의 ARR 선택
+ * @param pLfsr  16bit 갈루아 LFSR 상태 (0 금지)
+ * @param arr    기준 ARR
+ * @param span   최대 편차 [tick]
+ * @return arr - span ~ arr + span (균등 분포)
+ */
+uint32_t SvpwmCore_SpreadArr(uint16_t *pLfsr, uint32_t arr, uint32_t span);
+
+/**
+ * @brief 기준 주기 CCR → 확산 주기 CCR (ON 비율 유지)
+ * @param ccr    기준 CCR (0 ~ arr+1)
+ * @param arr    기준 ARR
+ * @param ratio  (arr_k + 1) / (arr + 1) [Q16]
+ * @param arr_k  이번 주기 ARR
+ */
+uint16_t SvpwmCore_SpreadCcr(uint16_t ccr, uint32_t arr, uint32_t ratio, uint32_t arr_k);
+
+/**
+ * @brief 다음 PWM 주기의 ARR / CCR (정점 UEV 에서 프리로드에 기록할 값)
+ * @param pPer  기준 주기 / CCR / 확산 상태
+ * @param ccr   [out] 이번 주기 CCR (A, B, C)
+ * @return 이번 주기 ARR
+ */
+uint32_t SvpwmCore_NextPeriod(SVPWM_Period_t *pPer, uint16_t ccr[3]);
+
+/**
+ * @brief PWM 주파수 스케줄: 전기 주파수 → ARR
+ * @param f       |전기 주파수| [Hz]
+ * @param f_lo    이하: arr_lo
+ * @param f_hi    이상: arr_hi (f_hi <= f_lo 면 항상 arr_hi)
+ * @param arr_lo  저속 ARR
+ * @param arr_hi  고속 ARR
+ * @return 사이 구간은 PWM 주파수 (1 / (ARR+1)) 선형 보간
+ */
+uint32_t SvpwmCore_SchedArr(float f, float f_lo, float f_hi, uint32_t arr_lo, uint32_t arr_hi);
+
+#endif /* __SVPWM_CORE_H */
@@ -0,0 +1,91 @@
+/**
+ * @file    telemetry.h
+ * @brief   텔레메트리 헤더 - 제어 ISR → 링 버퍼 → LPUART1 DMA 전송
+ */
+
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#include "stm32g4xx_hal.h"
+#include <stdint.h>
+
+/* ============== 상수 정의 ============== */
+/* 프레임: SYNC0 SYNC1 TYPE SEQ LEN PAYLOAD[LEN] CRC_L CRC_H
+ *         CRC16(CCITT-FALSE) 범위 = TYPE ~ PAYLOAD */
+#define TELEM_SYNC0             0xA5u
+#define TELEM_SYNC1             0x5Au
+#define TELEM_HDR_SIZE          5u
+#define TELEM_CRC_SIZE          2u
+#define TELEM_MAX_PAYLOAD       64u
+
+/* 링 버퍼 크기 (2의 거듭제곱) */
+#define TELEM_RING_SIZE         2048u
+
+/* 프레임 타입 */
+#define TELEM_TYPE_CTRL         0x01u   // 제어 루프 샘플 (Telem_Ctrl_t)
+#define TELEM_TYPE_REPLY        0x02u   // 명령 응답 (cmd.c: CMD SEQ STATUS DATA...)
+#define TELEM_TYPE_SCOPE        0x03u   // 스코프 업로드 (scope.c: uint16 word_offset, uint32 data...)
+#define TELEM_TYPE_LOAD         0x04u   // CPU 부하 / 제어 오버런 (cpu_load.c: CpuLoad_Frame_t, 1초마다)
+
+/* ============== 타입 정의 ============== */
+/* 제어 루프 샘플 (little-endian, 패딩 없음) */
+typedef struct __attribute__((packed)) {
+    uint32_t tick;          // 제어 스텝 카운터
+    float    angle;         // 전기각 [rad]
+    float    ia;            // A상 전류 [A]
+    float    ib;            // B상 전류 [A]
+    float    vbus;          // 버스 전압 [V]
+    uint16_t ccr_a;         // CH1 비교값
+    uint16_t ccr_b;         // CH2 비교값
+    uint16_t ccr_c;         // CH3 비교값
+} Telem_Ctrl_t;
+
+typedef struct {
+    uint32_t frames;        // 링에 기록한 프레임 수
+    uint32_t dropped;       // 링 가득 참으로 버린 프레임 수
+    uint32_t tx_bytes;      // DMA 전송 완료 바이트 수
+    uint32_t ring_max;      // 링 최대 사용량 [byte]
+} Telem_Stats_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 텔레메트리 초기화
+ * @param huart  출력 UART (LPUART1, hdmatx 연결 필요)
+ */
+void Telem_Init(UART_HandleTypeDef *huart);
+
+/**
+ * @brief 프레임 기록 (단일 생산자: 제어 ISR, 논블로킹)
+ * @param type     TELEM_TYPE_xxx
+ * @param payload  페이로드 포인터
+ * @param len      페이로드 길이 (최대 TELEM_MAX_PAYLOAD)
+ * @return 1: 기록, 0: 공간 부족으로 버림
+ */
+uint8_t Telem_Push(uint8_t type, const void *payload, uint32_t len);
+
+/**
+ * @brief 프레임 기록 (메인 루프용)
+ *
+ * 제어 ISR 과 같은 링에 쓰므로 기록 동안 BASEPRI 로 제어 ISR 이하만 마스킹한다
+ * (보호 인터럽트는 계속 선점 가능).
+ */
+uint8_t Telem_Send(uint8_t type, const void *payload, uint32_t len);
+
+/**
+ * @brief 제어 루프 샘플 기록 (PARAM_TELEM_DECIM 스텝마다 1회)
+ * @param pSample  샘플 (tick 은 내부에서 채움)
+ */
+void Telem_PushCtrl(Telem_Ctrl_t *pSample);
+
+/**
+ * @brief 메인 루프 처리 - 유휴 시 DMA 전송 시작
+ */
+void Telem_Process(void);
+
+/**
+ * @brief 통계 반환 (디버깅용)
+ */
+Telem_Stats_t* Telem_GetStats(void);
+
+#endif /* __TELEMETRY_H */
@@ -0,0 +1,247 @@
+/**
+ * @file    bench.c
+ * @brief   온타겟 커널 사이클 벤치마크 구현
+ *
+ * 제어 경로 커널을 실제 배치(CONTROL_IN_CCMRAM)와 FPU/wait state 조건에서
+ * DWT 사이클로 측정한다. 호스트 ns/op(Tools/svpwm_bench.c)는 상대 비교용이고
+ * 커밋별 사이클 예산은 이 값(Tools/bench_target.py → JSON)으로 관리한다. 보드 없이
+ * 커밋마다 보는 값은 Tools/emu (Unicorn 모델 추정, 같은 JSON 형식) 이고 이 측정이 그 교차 확인.
+ *
+ * - 계산 커널: 각 호출을 PRIMASK 로 감싸 제어 ISR 선점이 측정에 섞이지 않게 한다
+ *   (1회 수백 사이클 → 제어 ISR 지연 수 µs 이하). Bench_Process 1회에 BENCH_CHUNK_ITER
+ *   번까지만 돌려 명령 / 텔레메트리 태스크가 밀리지 않는다. 출력 레지스터는 건드리지 않는다.
+ * - BENCH_CONTROL_ISR: 스텝을 따로 호출하지 않고 실제 TIM6 ISR (HAL 디스패치 →
+ *   HAL_TIM_PeriodElapsedCallback → OpenLoop_Step, 또는 CONTROL_DISPATCH_LEAN 경로) 을
+ *   진입 / 종료 훅 사이에서 잰다. 예외 진입 / 복귀 (각 약 12 사이클) 와 CPU_LOAD 훅은
+ *   포함하지 않고, 보호 ISR 선점은 포함한다. 측정값은 그때의 운전 상태 경로
+ *   (정지 / 고장이면 조기 복귀 경로) 이므로 구동 중에 측정한다.
+ */
+
+#include "bench.h"
+#include "svpwm.h"
+#include "fast_trig.h"
+#include "app_config.h"
+#include "dwt.h"
+#include "stm32g4xx_hal.h"
+#include <math.h>
+#include <string.h>
+
+/* 제어 ISR 훅 무장 상태 */
+#define BENCH_ARM_OFF           0u
+#define BENCH_ARM_CALIB         1u      // 훅 자체 오버헤드 측정
+#define BENCH_ARM_ISR           2u      // 실제 ISR 측정
+
+static float in_angle[BENCH_STREAM_LEN];
+static float in_va[BENCH_STREAM_LEN];
+static float in_vb[BENCH_STREAM_LEN];
+static uint8_t stream_ready = 0;
+
+static volatile uint32_t sink_u;
+static volatile float    sink_f;
+
+/* 진행 중 측정 (ISR 측정 중에는 bench_res 를 제어 ISR 이 갱신)
+ * .ccmbss 는 시작 시 0 으로 채워지지 않으므로 무장 플래그는 일반 .bss 에 둔다 */
+static volatile uint8_t bench_state = BENCH_ST_IDLE;
+static uint8_t          bench_kernel = 0;
+static uint32_t         bench_target = 0;
+static Bench_Result_t   bench_res;
+
+static volatile uint8_t isr_arm = BENCH_ARM_OFF;
+static uint32_t         isr_t0 = 0;
+
+/**
+ * @brief 입력 스트림 생성 (최초 1회) - 섹터를 고르게 지나는 각도 증분
+ */
+static void Bench_MakeStream(void)
+{
+    float angle = 0.0f;
+    for (uint32_t i = 0; i < BENCH_STREAM_LEN; i++)
+    {
+        angle += TWO_PI * 0.146f;
+        if (angle >= TWO_PI) angle -= TWO_PI;
+
+        float amp = ((i & 7u) == 7u) ? 0.8f : 0.05f + 0.5f * (float)(i % 13u) / 13.0f;
+        in_angle[i] = angle;
+        in_va[i] = amp * cosf(angle);
+        in_vb[i] = amp * sinf(angle);
+    }
+    stream_ready = 1;
+}
+
+/**
+ * @brief 커널 1회 실행
+ */
+static inline void Bench_Call(uint8_t kernel, uint32_t k)
+{
+    SVPWM_State_t st;
+    float s, c;
+
+    switch (kernel)
+    {
+    case BENCH_SVPWM_CORE:
+        SvpwmCore_Calc(in_va[k], in_vb[k], (float)(PWM_PERIOD + 1u), PWM_PERIOD + 1u, &st);
+        sink_u = st.CCR_A;
+        break;
+
+    case BENCH_TRIG_LUT:
+        FastTrig_SinCos(in_angle[k], &s, &c);
+        sink_f = s + c;
+        break;
+
+    case BENCH_TRIG_LIBM:
+        sink_f = sinf(in_angle[k]) + cosf(in_angle[k]);
+        break;
+
+    case BENCH_OPENLOOP_VECTOR:
+#if CONTROL_TRIG_LUT
+        FastTrig_SinCos(in_angle[k], &s, &c);
+#else
+        s = sinf(in_angle[k]);
+        c = cosf(in_angle[k]);
+#endif
+        SvpwmCore_Calc(0.5f * c, 0.5f * s, (float)(PWM_PERIOD + 1u), PWM_PERIOD + 1u, &st);
+        sink_u = st.CCR_B;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 측정 1회 [cycle] (PRIMASK 구간)
+ */
+static uint32_t Bench_Measure(uint8_t kernel, uint32_t k)
+{
+    __disable_irq();
+    uint32_t t0 = DWT_GetCycles();
+    Bench_Call(kernel, k);
+    uint32_t cyc = DWT_GetCycles() - t0;
+    __enable_irq();
+    return cyc;
+}
+
+/**
+ * @brief 1회 결과 누적
+ */
+CCMRAM_FUNC static inline void Bench_Accumulate(uint32_t cyc)
+{
+    cyc = (cyc > bench_res.overhead_cyc) ? cyc - bench_res.overhead_cyc : 0u;
+
+    if (cyc < bench_res.min_cyc) bench_res.min_cyc = cyc;
+    if (cyc > bench_res.max_cyc) bench_res.max_cyc = cyc;
+    bench_res.total_cyc += cyc;
+    bench_res.iterations++;
+}
+
+/**
+ * @brief 측정 시작 (메인 루프 전용, 진행은 Bench_Process)
+ * @param kernel      Bench_Kernel_t
+ * @param iterations  반복 수 (1 ~ BENCH_MAX_ITER)
+ * @return 1: 시작, 0: 잘못된 인자 / 측정 중 (BENCH_CONTROL_ISR 은 BENCH_ISR_PROBE 필요)
+ */
+uint8_t Bench_Start(uint8_t kernel, uint32_t iterations)
+{
+    if (kernel >= BENCH_COUNT || iterations == 0u || iterations > BENCH_MAX_ITER) return 0;
+    if (bench_state == BENCH_ST_RUNNING) return 0;
+#if !BENCH_ISR_PROBE
+    if (kernel == BENCH_CONTROL_ISR) return 0;
+#endif
+
+    DWT_Init();
+    if (!stream_ready) Bench_MakeStream();
+
+    memset(&bench_res, 0, sizeof(bench_res));
+    bench_res.min_cyc = 0xFFFFFFFFu;
+    bench_kernel = kernel;
+    bench_target = iterations;
+
+    // 측정 오버헤드 최소값 (빈 커널 ID / 빈 훅 쌍)
+    uint32_t overhead = 0xFFFFFFFFu;
+    if (kernel != BENCH_CONTROL_ISR)
+    {
+        for (uint32_t i = 0; i < 16u; i++)
+        {
+            uint32_t cyc = Bench_Measure(BENCH_COUNT, 0);
+            if (cyc < overhead) overhead = cyc;
+        }
+        bench_res.overhead_cyc = overhead;
+        bench_state = BENCH_ST_RUNNING;
+        return 1;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    bench_res.overhead_cyc = 0xFFFFFFFFu;
+    isr_arm = BENCH_ARM_CALIB;
+    for (uint32_t i = 0; i < 16u; i++)
+    {
+        Bench_IsrEnter();
+        Bench_IsrExit();
+    }
+    bench_state = BENCH_ST_RUNNING;
+    isr_arm = BENCH_ARM_ISR;                        // 다음 TIM6 ISR 부터
+    __set_PRIMASK(primask);
+    return 1;
+}
+
+/**
+ * @brief 메인 루프 처리 - 1회 호출당 최대 BENCH_CHUNK_ITER 반복
+ */
+void Bench_Process(void)
+{
+    if (bench_state != BENCH_ST_RUNNING) return;
+
+    if (bench_kernel == BENCH_CONTROL_ISR)
+    {
+        if (isr_arm == BENCH_ARM_OFF) bench_state = BENCH_ST_DONE;     // ISR 이 목표 도달 시 해제
+        return;
+    }
+
+    for (uint32_t n = 0; n < BENCH_CHUNK_ITER && bench_res.iterations < bench_target; n++)
+        Bench_Accumulate(Bench_Measure(bench_kernel, bench_res.iterations & (BENCH_STREAM_LEN - 1u)));
+
+    if (bench_res.iterations >= bench_target) bench_state = BENCH_ST_DONE;
+}
+
+/**
+ * @brief 상태 / 결과
+ * @param pKernel  측정 중이거나 마지막으로 측정한 커널
+ * @param pRes     결과 (BENCH_ST_DONE 일 때 유효)
+ * @return Bench_State_t
+ */
+uint8_t Bench_GetResult(uint8_t *pKernel, Bench_Result_t *pRes)
+{
+    uint8_t st = bench_state;
+    *pKernel = bench_kernel;
+    if (st == BENCH_ST_DONE) *pRes = bench_res;
+    else memset(pRes, 0, sizeof(*pRes));
+    return st;
+}
+
+/**
+ * @brief 제어 ISR 최상단 (BENCH_CONTROL_ISR 측정 중일 때만 기록)
+ */
+CCMRAM_FUNC void Bench_IsrEnter(void)
+{
+    if (isr_arm != BENCH_ARM_OFF) isr_t0 = DWT_GetCycles();
+}
+
+/**
+ * @brief 제어 ISR 최하단 - 목표 횟수에 도달하면 스스로 해제
+ */
+CCMRAM_FUNC void Bench_IsrExit(void)
+{
+    uint8_t arm = isr_arm;
+    if (arm == BENCH_ARM_OFF) return;
+
+    uint32_t cyc = DWT_GetCycles() - isr_t0;
+    if (arm == BENCH_ARM_CALIB)
+    {
+        if (cyc < bench_res.overhead_cyc) bench_res.overhead_cyc = cyc;
+        return;
+    }
+
+    Bench_Accumulate(cyc);
+    if (bench_res.iterations >= bench_target) isr_arm = BENCH_ARM_OFF;
+}
@@ -0,0 +1,609 @@
+/**
+ * @file    cmd.c
+ * @brief   명령 프로토콜 구현 - COBS 스트림 복원, CRC 검사, 명령 실행
+ *
+ * LPUART1 RX 는 DMA 원형 모드로 rx_ring 에 계속 기록된다.
+ * Cmd_Process() 는 DMA 남은 카운트(CNDTR)로 쓰기 위치를 구해
+ * 마지막 읽기 위치부터 바이트 단위로 COBS 복원기에 넣는다.
+ * DMA HT/TC 인터럽트는 반 링 통과 횟수만 센다 - 쓰기 위치만으로는 한 바퀴 이상
+ * 밀린 것을 구분할 수 없으므로, 누적 수신 수와 읽은 수의 차가 링보다 크면 덮어쓰기로 본다.
+ * 링 → 선형 버퍼 복사 없이 복원 결과만 pkt[] 에 쌓이고, 0x00 에서 패킷이 끝난다.
+ *
+ * 응답은 텔레메트리 프레임(TELEM_TYPE_REPLY)으로 보낸다.
+ */
+
+#include "cmd.h"
+#include "crc16.h"
+#include "telemetry.h"
+#include "svpwm.h"
+#include "protect.h"
+#include "fault.h"
+#include "scope.h"
+#include "param.h"
+#include "config.h"
+#include "nvm.h"
+#include "motor_id.h"
+#include "mech_id.h"
+#include "sched.h"
+#include "bench.h"
+#include "app_config.h"
+#include "main.h"
+#include <string.h>
+
+#define CMD_REPLY_MAX           48u     // 응답 DATA 최대 길이 [byte]
+
+/* 수신 링 (DMA 원형) */
+static uint8_t rx_ring[CMD_RX_RING_SIZE];
+static uint32_t rx_tail = 0;
+static uint32_t rx_read = 0;            // 누적 읽은 바이트 (mod 2^32)
+static volatile uint32_t rx_halves = 0; // DMA 반 링 통과 횟수 (HT/TC 인터럽트)
+static UART_HandleTypeDef *pUart = NULL;
+
+/* COBS 복원 상태 */
+static uint8_t  pkt[CMD_MAX_PACKET];
+static uint32_t pkt_len = 0;
+static uint8_t  cobs_left = 0;      // 현재 블록 남은 데이터 바이트
+static uint8_t  cobs_code = 0;      // 현재 블록 코드 (0 = 패킷 시작 전)
+static uint8_t  cobs_err = 0;
+
+static Cmd_Stats_t cmd_stats;
+
+static void Cmd_RxStart(void);
+static void Cmd_FeedByte(uint8_t b);
+static void Cmd_Dispatch(const uint8_t *p, uint32_t len);
+static void Cmd_Reply(uint8_t cmd, uint8_t seq, uint8_t status, const void *data, uint32_t len);
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+/**
+ * @brief 명령 수신 초기화 (DMA 원형 수신 시작)
+ * @param huart  명령 UART (LPUART1, hdmarx 원형 모드)
+ */
+void Cmd_Init(UART_HandleTypeDef *huart)
+{
+    pUart = huart;
+    memset(&cmd_stats, 0, sizeof(cmd_stats));
+
+    pkt_len = 0;
+    cobs_left = 0;
+    cobs_code = 0;
+    cobs_err = 0;
+
+    Cmd_RxStart();
+}
+
+/**
+ * @brief 메인 루프 처리 - 수신 링에서 새 바이트를 읽어 패킷 복원/실행
+ */
+void Cmd_Process(void)
+{
+    if (pUart == NULL) return;
+
+    // UART 오류(ORE/FE/NE) 시 HAL 이 DMA 수신을 중단하므로 재시작
+    if (pUart->RxState == HAL_UART_STATE_READY)
+    {
+        cmd_stats.rx_restarts++;
+        Cmd_RxStart();
+        return;
+    }
+
+    // 쓰기 위치와 반 링 통과 횟수를 함께 읽는다 (사이에 HT/TC 가 끼면 다시)
+    uint32_t halves, head;
+    do
+    {
+        halves = rx_halves;
+        head = CMD_RX_RING_SIZE - __HAL_DMA_GET_COUNTER(pUart->hdmarx);
+    } while (halves != rx_halves);
+    if (head >= CMD_RX_RING_SIZE) head = 0;
+
+    // 경계는 넘었지만 HT/TC 인터럽트가 아직 처리 전이면 (홀수 = 뒤쪽 반) 하나 보정
+    if (((halves ^ (head / CMD_RX_HALF)) & 1u) != 0u) halves++;
+
+    uint32_t written = halves * CMD_RX_HALF + (head & (CMD_RX_HALF - 1u));
+    uint32_t unread = written - rx_read;
+
+    if (unread > CMD_RX_RING_SIZE)
+    {
+        // 읽기 전에 덮어써졌다: 남은 내용은 어느 패킷 중간이므로 버리고 다음 구분자부터
+        cmd_stats.overruns++;
+        cmd_stats.rx_dropped += unread;
+        rx_tail = head;
+        rx_read = written;
+        pkt_len = 0;
+        cobs_code = 1;
+        cobs_left = 0;
+        cobs_err = 1;
+        return;
+    }
+
+    // unread == 링 크기 (꽉 참) 이면 head == tail 이라 개수로 돈다
+    for (; unread != 0u; unread--)
+    {
+        Cmd_FeedByte(rx_ring[rx_tail]);
+        rx_tail = (rx_tail + 1u) & (CMD_RX_RING_SIZE - 1u);
+        rx_read++;
+        cmd_stats.rx_bytes++;
+    }
+}
+
+/**
+ * @brief UART IDLE 인터럽트 처리 (LPUART1_IRQHandler 에서 HAL 처리 전에 호출)
+ *
+ * 패킷 뒤 수신선이 1 프레임 이상 유휴가 되면 명령 태스크를 즉시 릴리스한다.
+ * HAL 은 일반 수신 모드에서 IDLE 플래그를 처리하지 않으므로 여기서 지운다.
+ */
+void Cmd_UartIRQHandler(void)
+{
+    if (pUart == NULL) return;
+
+    if (__HAL_UART_GET_FLAG(pUart, UART_FLAG_IDLE))
+    {
+        __HAL_UART_CLEAR_FLAG(pUart, UART_CLEAR_IDLEF);
+        Sched_Signal(SCHED_TASK_CMD);
+    }
+}
+
+/**
+ * @brief 통계 반환 (디버깅용)
+ */
+Cmd_Stats_t* Cmd_GetStats(void)
+{
+    return &cmd_stats;
+}
+
+/**
+ * @brief 수신 DMA 반 링 도달 (HT) - 덮어쓰기 검출용 통과 횟수
+ */
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart == pUart) rx_halves++;
+}
+
+/**
+ * @brief 수신 DMA 링 끝 도달 (TC, 원형 모드라 수신은 계속됨)
+ */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart == pUart) rx_halves++;
+}
+
+/* ============================================================
+ * 수신 / COBS 복원
+ * ============================================================ */
+
+/**
+ * @brief DMA 원형 수신 시작 (HT/TC 인터럽트는 통과 횟수만, IDLE 인터럽트로 수신 통보)
+ */
+static void Cmd_RxStart(void)
+{
+    rx_tail = 0;
+    rx_read = 0;
+    rx_halves = 0;
+    pkt_len = 0;
+    cobs_code = 0;
+    cobs_left = 0;
+    cobs_err = 0;
+
+    // HAL_UART_Receive_DMA 가 HT/TC 인터럽트를 켠다 (HAL_UART_RxHalfCpltCallback / RxCpltCallback)
+    if (HAL_UART_Receive_DMA(pUart, rx_ring, CMD_RX_RING_SIZE) == HAL_OK)
+    {
+        __HAL_UART_CLEAR_FLAG(pUart, UART_CLEAR_IDLEF);
+        __HAL_UART_ENABLE_IT(pUart, UART_IT_IDLE);
+    }
+}
+
+/**
+ * @brief COBS 스트림 복원 (1 바이트)
+ *
+ * 블록 = [code][code-1 바이트], code < 0xFF 인 블록 뒤에는 0x00 이 생략되어 있다.
+ * 패킷 끝(0x00)에서는 마지막 생략 0 을 붙이지 않는다.
+ */
+static void Cmd_FeedByte(uint8_t b)
+{
+    if (b == 0x00u)
+    {
+        if (cobs_code != 0 && cobs_left == 0 && !cobs_err)
+            Cmd_Dispatch(pkt, pkt_len);
+        else if (cobs_code != 0)
+            cmd_stats.cobs_errors++;
+
+        pkt_len = 0;
+        cobs_code = 0;
+        cobs_left = 0;
+        cobs_err = 0;
+        return;
+    }
+
+    if (cobs_err) return;   // 다음 구분자까지 버림
+
+    if (cobs_left == 0)
+    {
+        // 새 블록: 이전 블록이 0xFF 가 아니면 생략된 0 복원
+        if (cobs_code != 0 && cobs_code != 0xFFu)
+        {
+            if (pkt_len >= CMD_MAX_PACKET) { cobs_err = 1; return; }
+            pkt[pkt_len++] = 0x00u;
+        }
+        cobs_code = b;
+        cobs_left = (uint8_t)(b - 1u);
+    }
+    else
+    {
+        if (pkt_len >= CMD_MAX_PACKET) { cobs_err = 1; return; }
+        pkt[pkt_len++] = b;
+        cobs_left--;
+    }
+}
+
+/* ============================================================
+ * 명령 실행
+ * ============================================================ */
+
+/**
+ * @brief 복원된 패킷 검사 및 명령 실행
+ * @param p    패킷 (CMD SEQ PAYLOAD CRC_L CRC_H)
+ * @param len  패킷 길이
+ */
+static void Cmd_Dispatch(const uint8_t *p, uint32_t len)
+{
+    if (len < 4u)
+    {
+        cmd_stats.cobs_errors++;
+        return;
+    }
+
+    uint32_t body = len - 2u;
+    uint16_t crc_rx = (uint16_t)(p[body] | ((uint16_t)p[body + 1u] << 8));
+    if (CRC16_Update(CRC16_INIT, p, body) != crc_rx)
+    {
+        cmd_stats.crc_errors++;
+        return;
+    }
+    cmd_stats.packets++;
+
+    uint8_t cmd = p[0];
+    uint8_t seq = p[1];
+    const uint8_t *arg = &p[2];
+    uint32_t arg_len = body - 2u;
+
+    switch (cmd)
+    {
+    case CMD_PING:
+    {
+        const Fault_Info_t *pInfo = Fault_GetInfo();
+        uint16_t layout = PARAM_LAYOUT_VERSION;
+        uint32_t version = Param_Active()->version;
+        uint8_t data[11];
+        data[0] = (uint8_t)pInfo->state;
+        data[1] = (uint8_t)(pInfo->first_cause & 0xFFu);
+        data[2] = (uint8_t)(pInfo->first_cause >> 8);
+        data[3] = (uint8_t)(pInfo->causes & 0xFFu);
+        data[4] = (uint8_t)(pInfo->causes >> 8);
+        memcpy(&data[5], &layout, 2);
+        memcpy(&data[7], &version, 4);
+        Cmd_Reply(cmd, seq, CMD_ST_OK, data, sizeof(data));
+        break;
+    }
+
+    case CMD_SET_SPEED:
+    case CMD_SET_SPEED_VOLT:
+    {
+        if (arg_len != 8u) { Cmd_Reply(cmd, seq, CMD_ST_BAD_LEN, NULL, 0); break; }
+
+        float f, v;
+        memcpy(&f, &arg[0], 4);
+        memcpy(&v, &arg[4], 4);
+        uint8_t volt_mode = (cmd == CMD_SET_SPEED_VOLT);
+
+        // 레지스트리 범위 검사 (NaN 거부) 후 지역 묶음으로 함께 커밋
+        // (PARAM_WRITE 로 예약 중인 값은 그대로 둔다)
+        Param_Batch_t b;
+        Param_BatchInit(&b);
+        uint8_t ok = Param_BatchStageF(&b, PARAM_OL_FREQ_HZ, f) &&
+                     Param_BatchStageF(&b, volt_mode ? PARAM_OL_VOLT_V : PARAM_OL_VOLTAGE, v) &&
+                     Param_BatchStageU(&b, PARAM_OL_VOLT_MODE, volt_mode);
+        if (!ok)
+        {
+            Cmd_Reply(cmd, seq, CMD_ST_BAD_ARG, NULL, 0);
+            break;
+        }
+        Param_BatchCommit(&b);
+        Cmd_Reply(cmd, seq, CMD_ST_OK, NULL, 0);
+        break;
+    }
+
+    case CMD_SET_MODE:
+    {
+        if (arg_len != 1u) { Cmd_Reply(cmd, seq, CMD_ST_BAD_LEN, NULL, 0); break; }
+
+        if (arg[0] == CMD_MODE_STOP)
+        {
+            // 식별은 드라이버 출력이 있어야 하므로 함께 중단 (식별이 EN 을 다시 켜지 않게)
+            MotorId_Abort();
+            MechId_Abort();
+            Protect_SetRun(0);
+            Cmd_Reply(cmd, seq, CMD_ST_OK, NULL, 0);
+        }
+        else if (arg[0] == CMD_MODE_RUN)
+        {
+            Cmd_Reply(cmd, seq, Protect_SetRun(1) ? CMD_ST_OK : CMD_ST_REJECTED, NULL, 0);
+        }
+        else
+        {
+            Cmd_Reply(cmd, seq, CMD_ST_BAD_ARG, NULL, 0);
+        }
+        break;
+    }
+
+    case CMD_PARAM_READ:
+    {
+        if (arg_len != 2u) { Cmd_Reply(cmd, seq, CMD_ST_BAD_LEN, NULL, 0); break; }
+
+        uint16_t key = (uint16_t)(arg[0] | ((uint16_t)arg[1] << 8));
+        Param_Id_t id = Param_FindKey(key);
+        if (id >= PARAM_COUNT) { Cmd_Reply(cmd, seq, CMD_ST_BAD_ARG, NULL, 0); break; }
+
+        Param_Value_t value = Param_Get(id);
+        uint8_t data[6];
+        memcpy(&data[0], &key, 2);
+        memcpy(&data[2], &value.u, 4);
+        Cmd_Reply(cmd, seq, CMD_ST_OK, data, sizeof(data));
+        break;
+    }
+
+    case CMD_PARAM_WRITE:
+    {
+        if (arg_len != 6u) { Cmd_Reply(cmd, seq, CMD_ST_BAD_LEN, NULL, 0); break; }
+
+        uint16_t key = (uint16_t)(arg[0] | ((uint16_t)arg[1] << 8));
+        Param_Value_t value;
+        memcpy(&value.u, &arg[2], 4);
+        Cmd_Reply(cmd, seq, Param_Stage(Param_FindKey(key), value) ? CMD_ST_OK : CMD_ST_BAD_ARG, NULL, 0);
+        break;
+    }
+
+    case CMD_PARAM_COMMIT:
+    {
+        uint32_t version = Param_Commit();
+        Cmd_Reply(cmd, seq, CMD_ST_OK, &version, 4);
+        break;
+    }
+
+    case CMD_PARAM_DISCARD:
+        Param_Discard();
+        Cmd_Reply(cmd, seq, CMD_ST_OK, NULL, 0);
+        break;
+
+    case CMD_CONFIG_SAVE:
+    case CMD_CONFIG_RESET:
+    {
+        // 페이지 삭제가 필요한데 드라이버가 켜져 있으면 OK 대신 DEFERRED (STOP 후 기록)
+        uint8_t r = (cmd == CMD_CONFIG_SAVE) ? Config_Save() : Config_Reset();
+        Cmd_Reply(cmd, seq, (r == NVM_SAVE_QUEUED) ? CMD_ST_OK :
+                            (r == NVM_SAVE_DEFERRED) ? CMD_ST_DEFERRED : CMD_ST_REJECTED, NULL, 0);
+        break;
+    }
+
+    case CMD_CONFIG_STATUS:
+    {
+        const Nvm_Status_t *st = Nvm_GetStatus();
+        uint8_t data[18];
+        data[0] = st->state;
+        data[1] = Nvm_IsBusy();
+        memcpy(&data[2], &st->seq, 4);
+        memcpy(&data[6], &st->saves, 4);
+        memcpy(&data[10], &st->erases, 4);
+        memcpy(&data[14], &st->bad_records, 4);
+        Cmd_Reply(cmd, seq, CMD_ST_OK, data, sizeof(data));
+        break;
+    }
+
+    case CMD_PARAM_INFO:
+    {
+        if (arg_len != 2u) { Cmd_Reply(cmd, seq, CMD_ST_BAD_LEN, NULL, 0); break; }
+
+        uint16_t index = (uint16_t)(arg[0] | ((uint16_t)arg[1] << 8));
+        const Param_Desc_t *d = Param_GetDesc((Param_Id_t)index);
+        if (d == NULL) { Cmd_Reply(cmd, seq, CMD_ST_BAD_ARG, NULL, 0); break; }
+
+        // count key type min max def "name\0unit"
+        uint8_t data[CMD_REPLY_MAX];
+        uint16_t count = PARAM_COUNT;
+        memcpy(&data[0], &count, 2);
+        memcpy(&data[2], &d->key, 2);
+        data[4] = d->type;
+        memcpy(&data[5], &d->min.u, 4);
+        memcpy(&data[9], &d->max.u, 4);
+        memcpy(&data[13], &d->def.u, 4);
+
+        uint32_t n = 17u;
+        for (const char *c = d->name; *c && n < CMD_REPLY_MAX - 1u; c++) data[n++] = (uint8_t)*c;
+        data[n++] = 0;
+        for (const char *c = d->unit; *c && n < CMD_REPLY_MAX; c++) data[n++] = (uint8_t)*c;
+        Cmd_Reply(cmd, seq, CMD_ST_OK, data, n);
+        break;
+    }
+
+    case CMD_FAULT_CLEAR:
+        Cmd_Reply(cmd, seq, Protect_ClearFault() ? CMD_ST_OK : CMD_ST_REJECTED, NULL, 0);
+        break;
+
+    case CMD_ID_START:
+    {
+        if (arg_len != 1u) { Cmd_Reply(cmd, seq, CMD_ST_BAD_LEN, NULL, 0); break; }
+        if (!Fault_IsOk() || MechId_IsActive() || !MotorId_Start(arg[0])) { Cmd_Reply(cmd, seq, CMD_ST_REJECTED, NULL, 0); break; }
+
+        Protect_SetRun(1);
+        Cmd_Reply(cmd, seq, CMD_ST_OK, NULL, 0);
+        break;
+    }
+
+    case CMD_ID_ABORT:
+        MotorId_Abort();
+        MechId_Abort();
+        Cmd_Reply(cmd, seq, CMD_ST_OK, NULL, 0);
+        break;
+
+    case CMD_ID_POLES:
+    {
+        if (arg_len != 1u) { Cmd_Reply(cmd, seq, CMD_ST_BAD_LEN, NULL, 0); break; }
+
+        if (arg[0])
+        {
+            // 출력이 회전자를 붙잡지 않도록 STOP (고장 해제로 다시 켜지지 않게 지령으로)
+            Protect_SetRun(0);
+            Cmd_Reply(cmd, seq, MotorId_StartPoles() ? CMD_ST_OK : CMD_ST_REJECTED, NULL, 0);
+        }
+        else
+        {
+            uint8_t pp = (uint8_t)MotorId_FinishPoles();
+            Cmd_Reply(cmd, seq, pp ? CMD_ST_OK : CMD_ST_REJECTED, &pp, 1);
+        }
+        break;
+    }
+
+    case CMD_ID_STATUS:
+    {
+        const MotorId_Result_t *r = MotorId_GetResult();
+        uint8_t data[28];
+        data[0] = r->state;
+        data[1] = r->err;
+        data[2] = r->spin;
+        data[3] = r->poles;
+        memcpy(&data[4],  &r->rs, 4);
+        memcpy(&data[8],  &r->ld, 4);
+        memcpy(&data[12], &r->lq, 4);
+        memcpy(&data[16], &r->flux, 4);
+        memcpy(&data[20], &r->kp, 4);
+        memcpy(&data[24], &r->ki, 4);
+        Cmd_Reply(cmd, seq, CMD_ST_OK, data, sizeof(data));
+        break;
+    }
+
+    case CMD_MECH_START:
+        // 드라이버 활성은 MechId_Start 가 콜백으로 수행
+        if (!Fault_IsOk() || MotorId_IsActive() || !MechId_Start()) { Cmd_Reply(cmd, seq, CMD_ST_REJECTED, NULL, 0); break; }
+        Cmd_Reply(cmd, seq, CMD_ST_OK, NULL, 0);
+        break;
+
+    case CMD_MECH_STATUS:
+    {
+        const MechId_Result_t *r = MechId_GetResult();
+        uint8_t data[32];
+        data[0] = r->state;
+        data[1] = r->err;
+        data[2] = r->cycle;
+        data[3] = r->rsvd;
+        memcpy(&data[4],  &r->samples, 4);
+        memcpy(&data[8],  &r->dropped, 4);
+        memcpy(&data[12], &r->J, 4);
+        memcpy(&data[16], &r->B, 4);
+        memcpy(&data[20], &r->Tc, 4);
+        memcpy(&data[24], &r->kp, 4);
+        memcpy(&data[28], &r->ki, 4);
+        Cmd_Reply(cmd, seq, CMD_ST_OK, data, sizeof(data));
+        break;
+    }
+
+    case CMD_SCOPE_CONFIG:
+    {
+        if (arg_len < 5u || arg_len != 4u + arg[0]) { Cmd_Reply(cmd, seq, CMD_ST_BAD_LEN, NULL, 0); break; }
+
+        uint32_t decim = (uint32_t)arg[2] | ((uint32_t)arg[3] << 8);
+        uint8_t ok = Scope_Config(&arg[4], arg[0], decim, arg[1]);
+        Cmd_Reply(cmd, seq, ok ? CMD_ST_OK : CMD_ST_BAD_ARG, NULL, 0);
+        break;
+    }
+
+    case CMD_SCOPE_TRIGGER:
+    {
+        if (arg_len != 6u) { Cmd_Reply(cmd, seq, CMD_ST_BAD_LEN, NULL, 0); break; }
+
+        float level;
+        memcpy(&level, &arg[2], 4);
+        uint8_t ok = (level == level) && Scope_SetTrigger(arg[0], arg[1], level);
+        Cmd_Reply(cmd, seq, ok ? CMD_ST_OK : CMD_ST_BAD_ARG, NULL, 0);
+        break;
+    }
+
+    case CMD_SCOPE_ARM:
+        Cmd_Reply(cmd, seq, Scope_Arm() ? CMD_ST_OK : CMD_ST_REJECTED, NULL, 0);
+        break;
+
+    case CMD_SCOPE_STOP:
+        Scope_Stop();
+        Cmd_Reply(cmd, seq, CMD_ST_OK, NULL, 0);
+        break;
+
+    case CMD_SCOPE_STATUS:
+    {
+        Scope_Info_t info;
+        Scope_GetInfo(&info);
+
+        uint8_t data[12];
+        data[0] = info.state;
+        data[1] = info.nch;
+        memcpy(&data[2], &info.depth, 2);
+        memcpy(&data[4], &info.pre, 2);
+        memcpy(&data[6], &info.start, 2);
+        memcpy(&data[8], &info.decim, 4);
+        Cmd_Reply(cmd, seq, CMD_ST_OK, data, sizeof(data));
+        break;
+    }
+
+    case CMD_SCOPE_UPLOAD:
+        Cmd_Reply(cmd, seq, Scope_StartUpload() ? CMD_ST_OK : CMD_ST_REJECTED, NULL, 0);
+        break;
+
+    case CMD_BENCH:
+    {
+        // 시작만 하고 바로 응답 - 반복은 Bench_Process 가 나눠 실행
+        if (arg_len != 3u) { Cmd_Reply(cmd, seq, CMD_ST_BAD_LEN, NULL, 0); break; }
+
+        uint32_t iter = (uint32_t)arg[1] | ((uint32_t)arg[2] << 8);
+        if (arg[0] >= BENCH_COUNT || iter == 0u || iter > BENCH_MAX_ITER)
+            Cmd_Reply(cmd, seq, CMD_ST_BAD_ARG, NULL, 0);
+        else
+            Cmd_Reply(cmd, seq, Bench_Start(arg[0], iter) ? CMD_ST_OK : CMD_ST_REJECTED, NULL, 0);
+        break;
+    }
+
+    case CMD_BENCH_STATUS:
+    {
+        Bench_Result_t r;
+        uint8_t data[27];
+        data[0] = Bench_GetResult(&data[1], &r);
+        data[2] = (uint8_t)((CONTROL_IN_CCMRAM ? 0x01u : 0u) | (CONTROL_TRIG_LUT ? 0x02u : 0u));
+        memcpy(&data[3],  &SystemCoreClock, 4);
+        memcpy(&data[7],  &r.iterations, 4);
+        memcpy(&data[11], &r.min_cyc, 4);
+        memcpy(&data[15], &r.max_cyc, 4);
+        memcpy(&data[19], &r.total_cyc, 4);
+        memcpy(&data[23], &r.overhead_cyc, 4);
+        Cmd_Reply(cmd, seq, CMD_ST_OK, data, sizeof(data));
+        break;
+    }
+
+    default:
+        Cmd_Reply(cmd, seq, CMD_ST_UNKNOWN, NULL, 0);
+        break;
+    }
+}
+
+/**
+ * @brief 응답 전송 (TELEM_TYPE_REPLY: CMD SEQ STATUS DATA...)
+ */
+static void Cmd_Reply(uint8_t cmd, uint8_t seq, uint8_t status, const void *data, uint32_t len)
+{
+    uint8_t buf[3u + CMD_REPLY_MAX];
+    if (len > CMD_REPLY_MAX) len = CMD_REPLY_MAX;
+
+    buf[0] = cmd;
+    buf[1] = seq;
+    buf[2] = status;
+    if (len) memcpy(&buf[3], data, len);
+
+    Telem_Send(TELEM_TYPE_REPLY, buf, 3u + len);
+}
@@ -0,0 +1,126 @@
+/**
+ * @file    config.c
+ * @brief   파라미터 영구 저장 구현
+ *
+ * 레코드 데이터 (little endian):
+ *   uint16 layout (PARAM_LAYOUT_VERSION), uint16 count,
+ *   { uint16 key, uint16 rsvd, uint32 value } × count
+ *
+ * - key 로 저장하므로 테이블 순서가 바뀌어도 유지된다.
+ * - 모르는 key, 범위 밖 값은 무시 (해당 파라미터는 기본값).
+ * - layout 이 다르면 레코드 전체를 무시한다 (키 의미가 바뀐 경우).
+ */
+
+#include "config.h"
+#include "param.h"
+#include "nvm.h"
+#include "nvm_flash.h"
+#include <string.h>
+
+typedef struct {
+    uint16_t layout;
+    uint16_t count;
+} Config_Hdr_t;
+
+typedef struct {
+    uint16_t key;
+    uint16_t rsvd;
+    uint32_t value;
+} Config_Entry_t;
+
+#define CONFIG_MAX_SIZE     (sizeof(Config_Hdr_t) + PARAM_COUNT * sizeof(Config_Entry_t))
+
+_Static_assert(CONFIG_MAX_SIZE <= NVM_MAX_PAYLOAD, "parameter table exceeds NVM record");
+
+static uint8_t cfg_buf[CONFIG_MAX_SIZE];
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+/**
+ * @brief NVM 스캔 후 저장된 파라미터 적용 (Param_Init 이후, 제어 ISR 시작 전)
+ * @return 적용한 파라미터 수
+ */
+uint32_t Config_Init(void)
+{
+    Nvm_Init(NvmFlash_Port());
+    Nvm_Process();                      // 출력 비활성 상태 - 필요하면 다음 페이지 미리 삭제
+
+    uint32_t len = Nvm_Load(cfg_buf, sizeof(cfg_buf));
+    if (len < sizeof(Config_Hdr_t)) return 0;
+
+    Config_Hdr_t hdr;
+    memcpy(&hdr, cfg_buf, sizeof(hdr));
+    if (hdr.layout != PARAM_LAYOUT_VERSION) return 0;
+    if (len < sizeof(hdr) + hdr.count * sizeof(Config_Entry_t)) return 0;
+
+    Param_Batch_t b;
+    Param_BatchInit(&b);
+    uint32_t applied = 0;
+    for (uint32_t i = 0; i < hdr.count; i++)
+    {
+        Config_Entry_t e;
+        memcpy(&e, &cfg_buf[sizeof(hdr) + i * sizeof(e)], sizeof(e));
+
+        Param_Id_t id = Param_FindKey(e.key);
+        if (id >= PARAM_COUNT) continue;
+
+        Param_Value_t v = { .u = e.value };
+        if (Param_BatchStage(&b, id, v)) applied++;
+    }
+    Param_BatchCommit(&b);
+
+    return applied;
+}
+
+/**
+ * @brief 현재 적용값 전체 저장 요청 (기록은 Nvm_Process 에서 진행)
+ * @return NVM_SAVE_xxx (DEFERRED: 페이지 삭제를 위해 드라이버 출력 정지까지 대기)
+ */
+uint8_t Config_Save(void)
+{
+    Config_Hdr_t hdr = { PARAM_LAYOUT_VERSION, PARAM_COUNT };
+    memcpy(cfg_buf, &hdr, sizeof(hdr));
+
+    for (uint32_t i = 0; i < PARAM_COUNT; i++)
+    {
+        Config_Entry_t e = {
+            .key   = Param_GetDesc((Param_Id_t)i)->key,
+            .rsvd  = 0xFFFFu,
+            .value = Param_Get((Param_Id_t)i).u,
+        };
+        memcpy(&cfg_buf[sizeof(hdr) + i * sizeof(e)], &e, sizeof(e));
+    }
+
+    return Nvm_Save(cfg_buf, CONFIG_MAX_SIZE);
+}
+
+/**
+ * @brief 기본값 복원 + 빈 레코드 저장 (공장 초기화)
+ * @return NVM_SAVE_xxx (REJECTED 이면 기본값 복원도 하지 않음)
+ */
+uint8_t Config_Reset(void)
+{
+    if (Nvm_IsBusy()) return NVM_SAVE_REJECTED;
+
+    // 공장 초기화는 호스트가 예약 중이던 PARAM_WRITE 도 폐기
+    Param_Discard();
+    Param_Batch_t b;
+    Param_BatchInit(&b);
+    for (uint32_t i = 0; i < PARAM_COUNT; i++)
+        Param_BatchStage(&b, (Param_Id_t)i, Param_GetDesc((Param_Id_t)i)->def);
+    Param_BatchCommit(&b);
+
+    Config_Hdr_t hdr = { PARAM_LAYOUT_VERSION, 0 };
+    memcpy(cfg_buf, &hdr, sizeof(hdr));
+    return Nvm_Save(cfg_buf, sizeof(hdr));
+}
+
+/**
+ * @brief 메인 루프 처리 (NVM 기록 진행)
+ */
+void Config_Process(void)
+{
+    Nvm_Process();
+}
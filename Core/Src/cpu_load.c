@@ -0,0 +1,177 @@
+/**
+ * @file    cpu_load.c
+ * @brief   CPU 부하 / 제어 주기 예산 모니터 구현
+ *
+ * 문맥 스택으로 선점을 추적한다. 문맥이 바뀔 때마다 직전 문맥에 경과
+ * 사이클(DWT)을 더하므로, 선점당한 ISR 의 시간에는 선점한 ISR 의 시간이
+ * 포함되지 않는다 (자기 시간만 집계).
+ *
+ *   메인 ─▶ [LPUART1 ─▶ [TIM6] ─▶ LPUART1] ─▶ 메인 ─▶ [IDLE(WFI)] ─▶ ...
+ *
+ * 제어 오버런: 제어 ISR 종료 시점에 TIM6 UIF 가 이미 다시 세트되어 있으면
+ * 스텝이 다음 트리거 전에 끝나지 못한 것이다 (진입 시 UIF 는 클리어됨).
+ * 제어 ISR 실행 시간은 진입~종료 전체 (보호 ISR 선점 포함) - 주기 예산 비교용.
+ */
+
+#include "cpu_load.h"
+#include "dwt.h"
+#include "telemetry.h"
+#include <string.h>
+
+static TIM_TypeDef *pCtrlTim = NULL;
+static uint32_t period_cyc = 1;
+
+/* 문맥 스택 (0 번은 항상 메인)
+ * .ccmbss 는 시작 시 0 으로 채워지지 않는다. SysTick 은 HAL_Init 부터 Enter/Exit 를
+ * 부르므로 인덱스로 쓰이는 상태는 일반 .bss 에 둔다 (0 초기화 보장). */
+static uint8_t  ctx_stack[CPU_LOAD_NEST_MAX];
+static uint32_t ctx_entry[CPU_LOAD_NEST_MAX];
+static uint32_t depth;
+static uint32_t last_cyc;
+static uint8_t  inited = 0;             // CpuLoad_Init 전에는 Enter/Exit 무시
+
+/* 창 누적값 (1 창 < 2^32 cycle) */
+static uint32_t acc_cyc[CPU_CTX_COUNT];
+static uint32_t ctrl_max_cyc;
+static uint32_t ctrl_overruns;
+static uint32_t overruns_total;
+static uint32_t window_start;
+
+static CpuLoad_Frame_t last_frame;
+
+/**
+ * @brief 현재 문맥에 경과 사이클 누적 (PRIMASK=1 상태에서 호출)
+ */
+CCMRAM_FUNC static inline uint32_t CpuLoad_Charge(void)
+{
+    uint32_t now = DWT_GetCycles();
+    acc_cyc[ctx_stack[depth]] += now - last_cyc;
+    last_cyc = now;
+    return now;
+}
+
+/**
+ * @brief 모니터 초기화 (DWT 활성화, 제어 주기 계산)
+ * @param htim_ctrl  제어 루프 타이머 (TIM6) 핸들
+ */
+void CpuLoad_Init(TIM_HandleTypeDef *htim_ctrl)
+{
+    DWT_Init();
+
+    pCtrlTim = htim_ctrl->Instance;
+    period_cyc = (pCtrlTim->PSC + 1u) * (pCtrlTim->ARR + 1u);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    depth = 0;
+    ctx_stack[0] = CPU_CTX_MAIN;
+    memset(acc_cyc, 0, sizeof(acc_cyc));
+    ctrl_max_cyc = 0;
+    ctrl_overruns = 0;
+    overruns_total = 0;
+    last_cyc = DWT_GetCycles();
+    window_start = last_cyc;
+    inited = 1;
+
+    __set_PRIMASK(primask);
+
+    memset(&last_frame, 0, sizeof(last_frame));
+}
+
+/**
+ * @brief 문맥 진입 (ISR 최상단 / WFI 직전)
+ * @param ctx  CpuLoad_Ctx_t
+ */
+CCMRAM_FUNC void CpuLoad_Enter(uint8_t ctx)
+{
+    if (!inited) return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t now = CpuLoad_Charge();
+    if (depth < CPU_LOAD_NEST_MAX - 1u)
+    {
+        depth++;
+        ctx_stack[depth] = ctx;
+        ctx_entry[depth] = now;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 문맥 종료 (ISR 끝 / WFI 복귀 직후) - 제어 ISR 이면 실행 시간/오버런 기록
+ */
+CCMRAM_FUNC void CpuLoad_Exit(void)
+{
+    if (!inited) return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t now = CpuLoad_Charge();
+    if (depth > 0u)
+    {
+        if (ctx_stack[depth] == CPU_CTX_CONTROL)
+        {
+            uint32_t cyc = now - ctx_entry[depth];
+            if (cyc > ctrl_max_cyc) ctrl_max_cyc = cyc;
+
+            if (pCtrlTim != NULL && (pCtrlTim->SR & TIM_SR_UIF))
+            {
+                ctrl_overruns++;
+                overruns_total++;
+            }
+        }
+        depth--;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 창 마감 (메인 루프 태스크, CPU_LOAD_WINDOW_MS 주기) - 집계 후 텔레메트리 송신
+ */
+void CpuLoad_Process(void)
+{
+    if (pCtrlTim == NULL) return;
+
+    uint32_t acc[CPU_CTX_COUNT];
+    CpuLoad_Frame_t *f = &last_frame;
+
+    // 누적값 스냅샷 후 새 창 시작
+    __disable_irq();
+    uint32_t now = CpuLoad_Charge();
+    memcpy(acc, acc_cyc, sizeof(acc));
+    memset(acc_cyc, 0, sizeof(acc_cyc));
+    f->ctrl_max_cyc = ctrl_max_cyc;
+    f->ctrl_overruns = (ctrl_overruns > 0xFFFFu) ? 0xFFFFu : (uint16_t)ctrl_overruns;
+    f->overruns_total = overruns_total;
+    ctrl_max_cyc = 0;
+    ctrl_overruns = 0;
+    uint32_t window = now - window_start;
+    window_start = now;
+    __enable_irq();
+
+    if (window == 0u) return;
+
+    f->window_cyc = window;
+    f->period_cyc = period_cyc;
+    for (uint32_t i = 0; i < CPU_CTX_COUNT; i++)
+        f->load_pm[i] = (uint16_t)(((uint64_t)acc[i] * 1000u) / window);
+
+    uint64_t budget = ((uint64_t)f->ctrl_max_cyc * 1000u) / period_cyc;
+    f->ctrl_budget_pm = (budget > 0xFFFFu) ? 0xFFFFu : (uint16_t)budget;
+
+    Telem_Send(TELEM_TYPE_LOAD, f, sizeof(*f));
+}
+
+/**
+ * @brief 최근 창 집계 결과 반환 (디버깅용)
+ */
+const CpuLoad_Frame_t* CpuLoad_GetLast(void)
+{
+    return &last_frame;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file    fast_trig.c
+ * @brief   LUT 기반 sin/cos 커널 구현
+ *
+ * sin 한 주기를 TRIG_LUT_SIZE 구간으로 나눈 테이블 (+1 가드 샘플).
+ * cos 는 1/4 주기 오프셋으로 같은 테이블을 사용한다.
+ * 테이블과 커널은 CCM SRAM 에 배치된다 (CONTROL_IN_CCMRAM).
+ */
+
+#include "fast_trig.h"
+#include "app_config.h"
+#include <math.h>
+
+/* sin LUT - 런타임 생성 (FLASH 초기값 없음) */
+static float sin_lut[TRIG_LUT_SIZE + 1] CCMRAM_BSS;
+
+/**
+ * @brief sin LUT 생성 (제어 루프 시작 전 1회)
+ */
+void FastTrig_Init(void)
+{
+    for (uint32_t i = 0; i <= TRIG_LUT_SIZE; i++)
+    {
+        sin_lut[i] = sinf(TRIG_TWO_PI * (float)i / (float)TRIG_LUT_SIZE);
+    }
+}
+
+/**
+ * @brief sin/cos 동시 계산 (LUT + 선형 보간)
+ * @param angle  각도 [rad] (임의 범위, 주기 래핑)
+ * @param pSin   sin(angle) 출력
+ * @param pCos   cos(angle) 출력
+ */
+CCMRAM_FUNC void FastTrig_SinCos(float angle, float *pSin, float *pCos)
+{
+    float pos = angle * ((float)TRIG_LUT_SIZE / TRIG_TWO_PI);
+
+    // floor (음수 각도 지원)
+    int32_t idx = (int32_t)pos;
+    if (pos < (float)idx) idx--;
+    float frac = pos - (float)idx;
+
+    // 2의 보수 마스킹으로 주기 래핑
+    uint32_t i_s = (uint32_t)idx & (TRIG_LUT_SIZE - 1u);
+    uint32_t i_c = (i_s + (TRIG_LUT_SIZE / 4u)) & (TRIG_LUT_SIZE - 1u);
+
+    *pSin = sin_lut[i_s] + frac * (sin_lut[i_s + 1u] - sin_lut[i_s]);
+    *pCos = sin_lut[i_c] + frac * (sin_lut[i_c + 1u] - sin_lut[i_c]);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file    fault.c
+ * @brief   고장 관리 상태 머신 구현
+ *
+ *            Raise              Clear(active == 0)
+ *   [OK] ───────────▶ [TRIPPED] ─────────────────▶ [HOLDOFF]
+ *     ▲                  ▲                             │
+ *     │                  └──────── Raise ──────────────┤
+ *     └──────────── FAULT_HOLDOFF_MS 경과 ─────────────┘
+ *
+ * - 최초 원인/시각은 해제 전까지 덮어쓰지 않는다 (래치).
+ * - 차단 콜백은 OK/HOLDOFF → TRIPPED 전이 시에만 호출된다.
+ * - Raise 는 여러 우선순위의 ISR (TIM6, COMP3, ADC AWD) 에서 겹쳐 올 수 있으므로
+ *   상태 검사와 래치, HOLDOFF → OK 전이는 PRIMASK 구간에서 한다.
+ */
+
+#include "fault.h"
+#include "app_config.h"
+#include "stm32g4xx.h"      // CMSIS PRIMASK (HAL 미사용)
+#include <stddef.h>
+
+static volatile Fault_Info_t fault_info;
+static Fault_ShutdownFn_t pShutdown = NULL;
+
+/**
+ * @brief 고장 관리 초기화
+ * @param shutdown  출력 차단 콜백 (NULL 허용)
+ */
+void Fault_Init(Fault_ShutdownFn_t shutdown)
+{
+    pShutdown = shutdown;
+
+    fault_info.state = FAULT_ST_OK;
+    fault_info.first_cause = FAULT_NONE;
+    fault_info.causes = FAULT_NONE;
+    fault_info.trip_time = 0;
+    fault_info.clear_time = 0;
+    fault_info.trip_count = 0;
+}
+
+/**
+ * @brief 고장 발생 통보 (ISR 에서 호출 가능)
+ * @param cause  FAULT_xxx 비트
+ * @param now    현재 시각 [ms]
+ */
+void Fault_Raise(uint16_t cause, uint32_t now)
+{
+    if (cause == FAULT_NONE) return;
+
+    // 검사~래치 사이에 더 높은 우선순위의 Raise 가 끼면 first_cause 를 덮고 trip_count 가 두 번 오른다
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    fault_info.causes |= cause;
+
+    if (fault_info.state != FAULT_ST_TRIPPED)
+    {
+        // 차단을 가장 먼저 수행
+        if (pShutdown != NULL) pShutdown();
+
+        fault_info.state = FAULT_ST_TRIPPED;
+        fault_info.first_cause = cause;
+        fault_info.trip_time = now;
+        fault_info.trip_count++;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 고장 해제 요청
+ * @param active  현재 여전히 활성인 고장 원인 (있으면 해제 거부)
+ * @param now     현재 시각 [ms]
+ * @return 1: 해제 접수 (HOLDOFF 진입), 0: 거부
+ */
+uint8_t Fault_Clear(uint16_t active, uint32_t now)
+{
+    if (fault_info.state != FAULT_ST_TRIPPED) return 0;
+    if (active != FAULT_NONE) return 0;
+
+    fault_info.state = FAULT_ST_HOLDOFF;
+    fault_info.clear_time = now;
+    return 1;
+}
+
+/**
+ * @brief 주기 처리 - HOLDOFF 경과 시 OK 로 복귀
+ * @param now  현재 시각 [ms]
+ */
+void Fault_Process(uint32_t now)
+{
+    // 검사 뒤 ISR 의 Raise 가 끼면 그 원인을 지우고 OK 로 되돌리게 된다
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // 부호 없는 뺄셈으로 tick 랩어라운드 처리
+    if (fault_info.state == FAULT_ST_HOLDOFF &&
+        (uint32_t)(now - fault_info.clear_time) >= FAULT_HOLDOFF_MS)
+    {
+        fault_info.state = FAULT_ST_OK;
+        fault_info.first_cause = FAULT_NONE;
+        fault_info.causes = FAULT_NONE;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 출력 허용 여부 (FAULT_ST_OK 일 때만 1)
+ */
+CCMRAM_FUNC uint8_t Fault_IsOk(void)
+{
+    return (fault_info.state == FAULT_ST_OK) ? 1 : 0;
+}
+
+/**
+ * @brief 고장 정보 반환 (디버깅용)
+ */
+const Fault_Info_t* Fault_GetInfo(void)
+{
+    return (const Fault_Info_t *)&fault_info;
+}
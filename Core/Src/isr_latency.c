@@ -0,0 +1,165 @@
+/**
+ * @file    isr_latency.c
+ * @brief   제어 ISR 진입 지연 측정 구현
+ *
+ * TIM6 과 DWT 는 같은 SYSCLK(170MHz) 에서 동작하므로 드리프트가 없다.
+ *
+ *  - 진입 지연  : ISR 진입 시점의 TIM6->CNT (업데이트 이후 경과 tick) × (PSC+1)
+ *                 → 절대값, 분해능 PSC+1 사이클
+ *  - 주기 지터  : 연속 진입 간격 Δt 와 공칭 주기 T 의 차이 (DWT)
+ *                 → 1 사이클 분해능, 선점/블로킹에 의한 최악 지연 변동
+ *
+ *  - 디스패치  : ISR 진입 ~ OpenLoop_Step 진입 사이클 (DWT)
+ *                 → CONTROL_DISPATCH_LEAN 0/1 빌드 간 비교
+ *  - 스텝 실행  : OpenLoop_Step 진입 ~ 종료 사이클 (DWT)
+ *                 → CONTROL_IN_CCMRAM 0/1 빌드 간 비교 (FLASH 4WS vs CCM 0WS)
+ *
+ * 결정성 확인 절차: LATENCY_MEASURE=1 빌드 → g_isr_lat 감시
+ *   1) 부하 없이 IsrLat_Reset() 후 수 초 측정
+ *   2) IsrLat_StartFlood() + 호스트에서 연속 송신 → 다시 측정
+ *   두 경우 jitter_max_cyc 가 같은 수준이면 통신이 제어 루프를 지연시키지 않음.
+ */
+
+#include "isr_latency.h"
+#include "dwt.h"
+
+/* 측정 결과 (디버거 Live Expression 용) */
+IsrLat_Stats_t g_isr_lat;
+
+static TIM_TypeDef *pCtrlTim = NULL;
+static uint32_t tick_cyc = 1;          // TIM CNT 1 tick 당 사이클
+static uint32_t last_entry = 0;
+static uint32_t step_entry = 0;
+static uint8_t  has_last = 0;
+
+/* 부하 발생 */
+static UART_HandleTypeDef *pFloodUart = NULL;
+static uint8_t flood_tx_buf[64];
+static uint8_t flood_rx_buf[1];
+
+/**
+ * @brief 측정 초기화 (DWT 활성화, 공칭 주기 계산)
+ * @param htim_ctrl  제어 루프 타이머 (TIM6) 핸들
+ */
+void IsrLat_Init(TIM_HandleTypeDef *htim_ctrl)
+{
+    DWT_Init();
+
+    pCtrlTim = htim_ctrl->Instance;
+    tick_cyc = pCtrlTim->PSC + 1u;
+    g_isr_lat.period_cyc = tick_cyc * (pCtrlTim->ARR + 1u);
+
+    for (uint32_t i = 0; i < sizeof(flood_tx_buf); i++)
+        flood_tx_buf[i] = (uint8_t)(0x55u ^ i);
+
+    IsrLat_Reset();
+}
+
+/**
+ * @brief 제어 ISR 최상단에서 호출 - 진입 지연/지터 기록
+ */
+void IsrLat_OnControlEntry(void)
+{
+    uint32_t now = DWT_GetCycles();
+    uint32_t cnt = pCtrlTim->CNT;
+
+    uint32_t lat = cnt * tick_cyc;
+    if (lat > g_isr_lat.lat_max_cyc) g_isr_lat.lat_max_cyc = lat;
+    if (lat < g_isr_lat.lat_min_cyc) g_isr_lat.lat_min_cyc = lat;
+
+    if (has_last)
+    {
+        int32_t err = (int32_t)(now - last_entry) - (int32_t)g_isr_lat.period_cyc;
+        uint32_t jitter = (uint32_t)((err < 0) ? -err : err);
+        if (jitter > g_isr_lat.jitter_max_cyc) g_isr_lat.jitter_max_cyc = jitter;
+    }
+
+    last_entry = now;
+    has_last = 1;
+    g_isr_lat.count++;
+}
+
+/**
+ * @brief OpenLoop_Step 최상단에서 호출 - 디스패치 사이클 기록 (HAL/lean 비교용)
+ */
+void IsrLat_OnStepEntry(void)
+{
+    step_entry = DWT_GetCycles();
+    uint32_t cyc = step_entry - last_entry;
+
+    g_isr_lat.dispatch_cyc = cyc;
+    if (cyc > g_isr_lat.dispatch_max_cyc) g_isr_lat.dispatch_max_cyc = cyc;
+}
+
+/**
+ * @brief OpenLoop_Step 끝에서 호출 - 스텝 실행 사이클 기록
+ */
+void IsrLat_OnStepExit(void)
+{
+    uint32_t cyc = DWT_GetCycles() - step_entry;
+
+    g_isr_lat.step_cyc = cyc;
+    if (cyc > g_isr_lat.step_max_cyc) g_isr_lat.step_max_cyc = cyc;
+}
+
+/**
+ * @brief 통계 초기화 (부하 조건 변경 후 호출)
+ */
+void IsrLat_Reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    g_isr_lat.count = 0;
+    g_isr_lat.lat_min_cyc = 0xFFFFFFFFu;
+    g_isr_lat.lat_max_cyc = 0;
+    g_isr_lat.jitter_max_cyc = 0;
+    g_isr_lat.dispatch_cyc = 0;
+    g_isr_lat.dispatch_max_cyc = 0;
+    g_isr_lat.step_cyc = 0;
+    g_isr_lat.step_max_cyc = 0;
+    g_isr_lat.flood_bytes = 0;
+    has_last = 0;
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief UART 부하 발생 시작 (연속 TX/RX 인터럽트)
+ * @param huart  부하를 걸 UART (LPUART1)
+ */
+void IsrLat_StartFlood(UART_HandleTypeDef *huart)
+{
+    pFloodUart = huart;
+    IsrLat_Process();
+}
+
+/**
+ * @brief 메인 루프 처리 - 부하 전송/수신 재시작
+ *
+ * IT 전송은 TX FIFO 임계값(1/8)마다 LPUART1 인터럽트를 발생시킨다.
+ */
+void IsrLat_Process(void)
+{
+    if (pFloodUart == NULL) return;
+
+    if (pFloodUart->gState == HAL_UART_STATE_READY)
+    {
+        if (HAL_UART_Transmit_IT(pFloodUart, flood_tx_buf, sizeof(flood_tx_buf)) == HAL_OK)
+            g_isr_lat.flood_bytes += sizeof(flood_tx_buf);
+    }
+
+    if (pFloodUart->RxState == HAL_UART_STATE_READY)
+    {
+        if (HAL_UART_Receive_IT(pFloodUart, flood_rx_buf, sizeof(flood_rx_buf)) == HAL_OK)
+            g_isr_lat.flood_bytes += sizeof(flood_rx_buf);
+    }
+}
+
+/**
+ * @brief 측정 결과 반환 (디버깅용)
+ */
+IsrLat_Stats_t* IsrLat_GetStats(void)
+{
+    return &g_isr_lat;
+}
@@ -22,6 +22,20 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "svpwm.h"
+#include "sense.h"
+#include "protect.h"
+#include "app_config.h"
+#include "isr_latency.h"
+#include "telemetry.h"
+#include "cmd.h"
+#include "scope.h"
+#include "param.h"
+#include "config.h"
+#include "motor_id.h"
+#include "mech_id.h"
+#include "sched.h"
+#include "cpu_load.h"
+#include "bench.h"
 #include <math.h>
 /* USER CODE END Includes */
 
@@ -48,6 +62,8 @@ DMA_HandleTypeDef hdma_adc1;
 UART_HandleTypeDef hlpuart1;
 UART_HandleTypeDef huart1;
 UART_HandleTypeDef huart3;
+DMA_HandleTypeDef hdma_lpuart1_rx;
+DMA_HandleTypeDef hdma_lpuart1_tx;
 
 TIM_HandleTypeDef htim3;
 TIM_HandleTypeDef htim6;
@@ -74,12 +90,31 @@ static void MX_USART3_UART_Init(void);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-// 주파수 200hrz / V: 0.05  -> 최초로 모터 돌아감
-// 주파수 400hrz / V: 0.08  -> 위에보다 더 빨리 돌아감
+// 시험 속도/전압은 파라미터 레지스트리 (param.c, PARAM_OL_xxx) 기본값
 
-static float g_test_hrz = 200.0f;
-static float g_test_v = 0.03f;
-static uint8_t g_spd_set = 0;
+static uint8_t g_fault_clr = 0;      // 1: 고장 해제 요청
+
+/**
+ * @brief 보호 태스크 - 디버거 해제 요청 처리 + HOLDOFF 경과 확인
+ */
+static void Task_Protect(void)
+{
+  if (g_fault_clr != 0)
+  {
+    g_fault_clr = 0;
+    Protect_ClearFault();
+  }
+  Protect_Process();
+}
+
+/**
+ * @brief 식별 태스크 - 전기/기계 파라미터 식별 후처리
+ */
+static void Task_Ident(void)
+{
+  MotorId_Process();
+  MechId_Process();
+}
 /* USER CODE END 0 */
 
 /**
@@ -99,7 +134,7 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-
+  Param_Init();
   /* USER CODE END Init */
 
   /* Configure the system clock */
@@ -151,26 +186,58 @@ int main(void)
 
   HAL_Delay(1000);
 
+#if LATENCY_MEASURE
+  IsrLat_Init(&htim6);
+  IsrLat_StartFlood(&hlpuart1);
+#else
+  Telem_Init(&hlpuart1);
+  Cmd_Init(&hlpuart1);
+#endif
+  Config_Init();
+  Protect_Init(&htim3, &hadc1, &hadc2);
+  Sense_Init(&hadc1, &hadc2);
   SVPWM_Init(&htim3);
+  Scope_Init();
   HAL_TIM_Base_Start_IT(&htim6);
-  HAL_GPIO_WritePin(GPO_DRIVER_EN_GPIO_Port, GPO_DRIVER_EN_Pin, 1);
-
-  OpenLoop_SetSpeed(g_test_hrz, g_test_v);
+  Protect_SetRun(1);
+
+  Sched_Init();
+#if CPU_LOAD_MONITOR
+  CpuLoad_Init(&htim6);
+  Sched_Register(SCHED_TASK_LOAD, "load", CpuLoad_Process,
+                 CPU_LOAD_WINDOW_MS, SCHED_LOAD_DEADLINE_MS);
+#endif
+  Sched_Register(SCHED_TASK_PROTECT, "protect", Task_Protect,
+                 SCHED_PROTECT_PERIOD_MS, SCHED_PROTECT_DEADLINE_MS);
+#if LATENCY_MEASURE
+  Sched_Register(SCHED_TASK_LATENCY, "latency", IsrLat_Process,
+                 SCHED_LATENCY_PERIOD_MS, SCHED_LATENCY_DEADLINE_MS);
+#else
+  Sched_Register(SCHED_TASK_CMD, "cmd", Cmd_Process,
+                 SCHED_CMD_PERIOD_MS, SCHED_CMD_DEADLINE_MS);
+  Sched_Register(SCHED_TASK_TELEM, "telem", Telem_Process,
+                 SCHED_TELEM_PERIOD_MS, SCHED_TELEM_DEADLINE_MS);
+  Sched_Register(SCHED_TASK_SCOPE, "scope", Scope_Process,
+                 SCHED_SCOPE_PERIOD_MS, SCHED_SCOPE_DEADLINE_MS);
+  Sched_Register(SCHED_TASK_BENCH, "bench", Bench_Process,
+                 SCHED_BENCH_PERIOD_MS, SCHED_BENCH_DEADLINE_MS);
+#endif
+  Sched_Register(SCHED_TASK_IDENT, "ident", Task_Ident,
+                 SCHED_IDENT_PERIOD_MS, SCHED_IDENT_DEADLINE_MS);
+  Sched_Register(SCHED_TASK_CONFIG, "config", Config_Process,
+                 SCHED_CONFIG_PERIOD_MS, SCHED_CONFIG_DEADLINE_MS);
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-	 if(g_spd_set != 0){
-		 g_spd_set = 0;
-		 OpenLoop_SetSpeed(g_test_hrz, g_test_v);
-	 }
+	 // 준비된 태스크 1개 실행 (없으면 WFI)
+	 Sched_Poll();
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
 	//HAL_GPIO_TogglePin(GPO_DRIVER_EN_GPIO_Port, GPO_DRIVER_EN_Pin);
-	HAL_Delay(2);
   }
   /* USER CODE END 3 */
 }
@@ -382,7 +449,7 @@ static void MX_LPUART1_UART_Init(void)
 
   /* USER CODE END LPUART1_Init 1 */
   hlpuart1.Instance = LPUART1;
-  hlpuart1.Init.BaudRate = 115200;
+  hlpuart1.Init.BaudRate = 2000000;
   hlpuart1.Init.WordLength = UART_WORDLENGTH_8B;
   hlpuart1.Init.StopBits = UART_STOPBITS_1;
   hlpuart1.Init.Parity = UART_PARITY_NONE;
@@ -403,7 +470,7 @@ static void MX_LPUART1_UART_Init(void)
   {
     Error_Handler();
   }
-  if (HAL_UARTEx_DisableFifoMode(&hlpuart1) != HAL_OK)
+  if (HAL_UARTEx_EnableFifoMode(&hlpuart1) != HAL_OK)
   {
     Error_Handler();
   }
@@ -532,7 +599,7 @@ static void MX_TIM3_Init(void)
   htim3.Init.CounterMode = TIM_COUNTERMODE_CENTERALIGNED1;
   htim3.Init.Period = 8499;
   htim3.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
-  htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
   if (HAL_TIM_PWM_Init(&htim3) != HAL_OK)
   {
     Error_Handler();
@@ -599,6 +666,11 @@ static void MX_TIM6_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN TIM6_Init 2 */
+  /* 제어 dt (CONTROL_FREQ_HZ) 와 실제 TIM6 갱신 주기 일치 확인 */
+  if (CONTROL_TIM_CLK_HZ / ((htim6.Init.Prescaler + 1u) * (htim6.Init.Period + 1u)) != CONTROL_FREQ_HZ)
+  {
+    Error_Handler();
+  }
 
   /* USER CODE END TIM6_Init 2 */
 
@@ -616,8 +688,14 @@ static void MX_DMA_Init(void)
 
   /* DMA interrupt init */
   /* DMA1_Channel1_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 0, 0);
+  HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 5, 0);
   HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+  /* DMA1_Channel2_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel2_IRQn, 15, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+  /* DMA1_Channel3_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, 15, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
 
 }
 
@@ -676,6 +754,8 @@ void Error_Handler(void)
 {
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
+  Protect_Shutdown();
+  Fault_Raise(FAULT_SYS_ERROR, HAL_GetTick());
   __disable_irq();
   while (1)
   {
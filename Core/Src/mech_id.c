@@ -0,0 +1,624 @@
+/**
+ * @file    mech_id.c
+ * @brief   기계 파라미터 식별 구현 - 가속/정속/관성 정지 반복 + RLS
+ *
+ * 운동 방정식 (한 방향 회전):  T = J·dω/dt + B·ω + Tc
+ *
+ *   가속/정속 : 오픈루프 주파수 램프로 회전자를 동기 구동 → ω, dω/dt = 지령값
+ *               토크 = Kt·iq,  Kt = 1.5·pp·ψ
+ *               iq = 직전 스텝 평균 전류의 역기전력 방향 성분 (동기 좌표계 이산 모델)
+ *               전압 |V| = ωψ + 작은 여유 → d축 전류를 줄여 iq 분해능 확보
+ *
+ *   이산 모델 : 스텝 [t_k, t_k+1] 동안 정지 좌표계 전압 V 유지 (영차), 동기 좌표계에서
+ *               역기전력 E 일정, s = R/L + jω, a = e^{−R·T/L}, z = e^{jωT}
+ *               z·I_k+1 = a·I_k + (1−a)·V/R − E·(z−a)/(R+jωL)      → E
+ *               Ī·T = I_k·c1 + V/R·(c2 − c1) − E·(T − c1)/(L·s),
+ *               c1 = (1 − a/z)/s,  c2 = (1 − 1/z)/(jω)                → iq = Re(E·Ī*)/|E|
+ *               (T = 1 ms 는 τe = L/R 보다 길고 전기 주기당 20 스텝 남짓이라
+ *                샘플 사이 사다리꼴 근사로는 iq 부호조차 틀린다)
+ *               V 는 지령에 드라이버 데드타임 오차 −sign(i)·Vbus·t_dead/T_pwm 을 더한 값,
+ *               I_k 는 주기 경계 샘플을 PWM 리플 비대칭만큼 주기 평균으로 옮긴 값
+ *               (둘 다 iq 의 수 % - 보정하지 않으면 J 가 수십 % 틀린다)
+ *   관성 정지 : 드라이버 비활성 (토크 0) → Hall W 에지 수를 MECH_T_COAST_WIN 구간마다
+ *               세어 구간 평균 ω, 인접 구간 차로 dω/dt (연속 주기 차는 1 ms 타이밍
+ *               잡음이 회귀 변수에 그대로 들어가 J 를 작게 끌어내린다)
+ *
+ * 가속 구간만으로는 dω/dt 가 상수라 J 와 Tc 를 분리할 수 없으므로
+ * 정속(dω/dt = 0)과 관성 정지, 사이클별로 다른 가속도를 함께 쓴다.
+ *
+ * 회귀는 크기를 맞추기 위해 정규화한다: φ = [a/a_ref, ω/ω_ref, 1]
+ *   θ = [J·a_ref, B·ω_ref, Tc]  (모두 토크 단위)
+ *
+ * ISR 은 구간 평균 샘플만 링에 넣고 RLS 는 메인 루프에서 갱신한다 (온라인 추정).
+ * 속도 루프 이득: 전류 루프가 충분히 빠르다고 보고 ωs = 2π·bw 에서
+ *   Kp = J·ωs / Kt,  Ki = Kp·ωs / 4
+ */
+
+#include "mech_id.h"
+#include "param.h"
+#include "fault.h"
+#include "app_config.h"
+#include "sense.h"
+#include "svpwm.h"
+#include <math.h>
+#include <string.h>
+
+#define MECH_TWO_PI     6.28318530f
+#define MECH_SQRT3_INV  0.57735027f
+#define MECH_P0         100.0f          // RLS 초기 공분산 (정규화 θ 는 수 N·m 이하)
+#define MECH_W_MIN      0.2f            // 토크 샘플 사용 하한 (최고 속도 대비)
+
+typedef struct {
+    float re, im;
+} MechId_Cplx_t;
+
+typedef struct {
+    float a;            // dω/dt [rad/s²] (기계)
+    float w;            // ω [rad/s] (기계)
+    float t;            // 토크 [N·m]
+} MechId_Sample_t;
+
+static MechId_DriverFn_t pDriver = NULL;
+static volatile uint8_t  mech_state = MECH_IDLE;
+static MechId_Result_t   mech_result;
+static MechId_Signal_t   mech_sig;
+
+/* 실험 설정 (Start 에서 고정) */
+static float dt, rs, ls, a_rl, kt, pp_inv, flux;
+static float arr1_inv, k_rip, dead_frac;             // PWM 주기 보정 (리플 샘플 편차, 데드타임)
+static float v_dc, w_e_max;
+static float a_ref, w_ref;
+static uint32_t n_align, n_ramp, n_hold, n_stop, n_win, n_cwin;
+
+/* ISR 진행 상태 */
+static uint32_t n_step = 0;
+static uint32_t n_ramp_cur = 1;
+static float    a_cur = 0.0f;           // 현재 사이클 가속도 [rad/s²] (기계)
+static float    angle = 0.0f, w_e = 0.0f;
+static float    v_prev = 0.0f, w_prev = 0.0f;                       // 직전 스텝 출력 (전압 크기, ω_e)
+static float    angle_prev = 0.0f;                                  // 직전 스텝 전압 좌표계
+static float    ia_prev = 0.0f, ib_prev = 0.0f;                     // 직전 스텝 시작 상전류 (데드타임 부호)
+static MechId_Cplx_t i_prev = { 0.0f, 0.0f };                       // 직전 스텝 전류 (그 스텝 전압 좌표계)
+static MechId_Cplx_t win_e = { 0.0f, 0.0f }, win_i = { 0.0f, 0.0f };  // 토크 구간 합 (E, Ī)
+static float    win_w = 0.0f;
+static uint32_t win_n = 0;
+
+/* Hall 주기 */
+static uint8_t  hall_prev = 0xFFu;
+static uint32_t gap = 0;                // 에지 간격 [스텝]
+static uint32_t n_edges = 0;
+
+/* 관성 정지 속도 구간 (n_cwin 스텝 이상, 에지 경계) */
+static uint32_t gap_sum = 0, blk_edges = 0, blk_t0 = 0, n_blk = 0;
+static float    w_blk_prev = 0.0f, t_blk_prev = 0.0f;
+
+/* ISR → 메인 루프 */
+static MechId_Sample_t ring[MECH_RING_SIZE];
+static volatile uint32_t ring_head = 0;
+static volatile uint32_t ring_tail = 0;
+
+/* RLS (메인 루프) */
+static float theta[3];
+static float P[9];
+
+/* 메인 루프 설정 기록을 ISR 이 보기 전에 완료 (단일 코어: 컴파일러 재배치만 방지) */
+#define MECH_BARRIER()  __asm volatile ("" ::: "memory")
+
+static void MechId_Next(uint8_t state)
+{
+    n_step = 0;
+    mech_state = state;
+}
+
+static void MechId_StartCycle(void);
+
+/* ============================================================
+ * Public 함수 (메인 루프)
+ * ============================================================ */
+
+/**
+ * @brief 드라이버 EN 콜백 등록 (제어 ISR 시작 전)
+ */
+void MechId_Init(MechId_DriverFn_t driver)
+{
+    pDriver = driver;
+}
+
+/**
+ * @brief 실험 시작 (메인 루프)
+ * @return 1: 시작, 0: 진행 중 / 전기 상수 없음 (err 확인)
+ */
+uint8_t MechId_Start(void)
+{
+    uint8_t st = mech_state;
+    if (st != MECH_IDLE && st != MECH_DONE && st != MECH_ERROR)
+        return 0;
+
+    memset(&mech_result, 0, sizeof(mech_result));
+
+    uint32_t pp = Param_Get(PARAM_MOTOR_POLES).u;
+    flux = Param_Get(PARAM_MOTOR_FLUX).f;
+    rs = Param_Get(PARAM_MOTOR_RS).f;
+    ls = 0.5f * (Param_Get(PARAM_MOTOR_LD).f + Param_Get(PARAM_MOTOR_LQ).f);
+    if (pp == 0 || flux <= 0.0f || rs <= 0.0f || ls <= 0.0f)
+    {
+        mech_result.err = MECH_ERR_NO_MOTOR;
+        mech_state = MECH_ERROR;
+        return 0;
+    }
+
+    dt      = 1.0f / (float)CONTROL_FREQ_HZ;            // MechId_Step 호출 주기 = TIM6
+    kt      = 1.5f * (float)pp * flux;
+    pp_inv  = 1.0f / (float)pp;
+    v_dc    = Param_Get(PARAM_ID_V_DC).f;
+    w_e_max = MECH_TWO_PI * Param_Get(PARAM_ID_SPIN_HZ).f;
+    w_ref   = w_e_max * pp_inv;
+    a_ref   = w_ref / MECH_T_RAMP;
+
+    a_rl    = expf(-rs * dt / ls);
+
+    // PWM 주기 (스케줄/확산 없는 PARAM_PWM_PERIOD 기준)
+    uint32_t arr = Param_Get(PARAM_PWM_PERIOD).u;
+    float t_pwm = 2.0f * (float)(arr + 1u) / (float)SVPWM_TIM_CLK_HZ;
+    arr1_inv  = 1.0f / (float)(arr + 1u);
+    k_rip     = rs / (ls * ls) * t_pwm * t_pwm;
+    dead_frac = (float)SVPWM_DRIVER_DEADTIME_NS * 1e-9f / t_pwm;
+
+    float fs = 1.0f / dt;
+    n_align = (uint32_t)(MECH_T_ALIGN * fs) + 1u;
+    n_ramp  = (uint32_t)(MECH_T_RAMP * fs) + 1u;
+    n_hold  = (uint32_t)(MECH_T_HOLD * fs) + 1u;
+    n_stop  = (uint32_t)(MECH_T_STOPPED * fs) + 1u;
+    n_win   = (uint32_t)(MECH_T_WINDOW * fs) + 1u;
+    n_cwin  = (uint32_t)(MECH_T_COAST_WIN * fs);
+
+    memset(theta, 0, sizeof(theta));
+    memset(P, 0, sizeof(P));
+    P[0] = P[4] = P[8] = MECH_P0;
+    ring_head = ring_tail = 0;
+    mech_sig.speed = 0.0f;
+    mech_sig.iq = 0.0f;
+    hall_prev = 0xFFu;
+
+    MECH_BARRIER();
+    MechId_StartCycle();
+    if (pDriver != NULL) pDriver(1);
+    return 1;
+}
+
+/**
+ * @brief 중단/해제 (드라이버 비활성)
+ */
+void MechId_Abort(void)
+{
+    uint8_t st = mech_state;
+    if (st == MECH_IDLE) return;
+
+    if (st != MECH_DONE && st != MECH_ERROR)
+        mech_result.err = MECH_ERR_ABORT;
+    mech_state = MECH_IDLE;
+    if (pDriver != NULL) pDriver(0);
+}
+
+/**
+ * @brief 출력 점유 여부
+ */
+uint8_t MechId_IsActive(void)
+{
+    return (mech_state != MECH_IDLE) ? 1u : 0u;
+}
+
+/**
+ * @brief RLS 1회 갱신 (순수 계산)
+ *        y = θ0·a/a_ref + θ1·ω/ω_ref + θ2   (y: 토크 [N·m])
+ * @param theta  추정값 [3]
+ * @param P      공분산 [3x3] (행 우선)
+ * @param phi    정규화 회귀 벡터 [3]
+ * @param y      관측 토크
+ */
+void MechId_RlsUpdate(float theta[3], float P[9], const float phi[3], float y)
+{
+    float Pphi[3];
+    for (uint32_t i = 0; i < 3u; i++)
+        Pphi[i] = P[3u * i] * phi[0] + P[3u * i + 1u] * phi[1] + P[3u * i + 2u] * phi[2];
+
+    float den = MECH_RLS_LAMBDA + phi[0] * Pphi[0] + phi[1] * Pphi[1] + phi[2] * Pphi[2];
+    float err = y - (theta[0] * phi[0] + theta[1] * phi[1] + theta[2] * phi[2]);
+
+    float K[3];
+    for (uint32_t i = 0; i < 3u; i++)
+    {
+        K[i] = Pphi[i] / den;
+        theta[i] += K[i] * err;
+    }
+
+    // P = (P − K·(Pφ)ᵀ) / λ  (P 대칭 → φᵀP = (Pφ)ᵀ)
+    for (uint32_t i = 0; i < 3u; i++)
+        for (uint32_t j = 0; j < 3u; j++)
+            P[3u * i + j] = (P[3u * i + j] - K[i] * Pphi[j]) * (1.0f / MECH_RLS_LAMBDA);
+}
+
+/**
+ * @brief 메인 루프 처리 - 샘플 RLS 갱신, 종료 시 이득 계산/적용
+ */
+void MechId_Process(void)
+{
+    uint8_t st = mech_state;
+
+    if (st >= MECH_ALIGN && st <= MECH_COAST && !Fault_IsOk())
+    {
+        mech_result.err = MECH_ERR_FAULT;
+        mech_state = MECH_ERROR;
+        return;
+    }
+
+    // 샘플 소비 → 온라인 추정
+    uint32_t head = ring_head;
+    while (ring_tail != head)
+    {
+        const MechId_Sample_t *s = &ring[ring_tail];
+        float phi[3] = { s->a / a_ref, s->w / w_ref, 1.0f };
+        MechId_RlsUpdate(theta, P, phi, s->t);
+        ring_tail = (ring_tail + 1u) & (MECH_RING_SIZE - 1u);
+        mech_result.samples++;
+    }
+    if (mech_result.samples != 0)
+    {
+        mech_result.J  = theta[0] / a_ref;
+        mech_result.B  = theta[1] / w_ref;
+        mech_result.Tc = theta[2];
+    }
+
+    if (st != MECH_FIT) return;
+
+    // 잡음으로 음수가 된 마찰은 0 으로
+    if (mech_result.B < 0.0f) mech_result.B = 0.0f;
+    if (mech_result.Tc < 0.0f) mech_result.Tc = 0.0f;
+
+    float ws = MECH_TWO_PI * Param_Get(PARAM_ID_SPD_BW).f;
+    mech_result.kp = mech_result.J * ws / kt;
+    mech_result.ki = mech_result.kp * ws * 0.25f;
+
+    Param_Batch_t b;
+    Param_BatchInit(&b);
+    uint8_t ok = (mech_result.J > 0.0f) &&
+                 Param_BatchStageF(&b, PARAM_MECH_J, mech_result.J) &&
+                 Param_BatchStageF(&b, PARAM_MECH_B, mech_result.B) &&
+                 Param_BatchStageF(&b, PARAM_MECH_TC, mech_result.Tc) &&
+                 Param_BatchStageF(&b, PARAM_SPD_KP, mech_result.kp) &&
+                 Param_BatchStageF(&b, PARAM_SPD_KI, mech_result.ki);
+    if (ok)
+    {
+        Param_BatchCommit(&b);
+        mech_state = MECH_DONE;
+    }
+    else
+    {
+        mech_result.err = MECH_ERR_RANGE;
+        mech_state = MECH_ERROR;
+    }
+}
+
+/**
+ * @brief 스코프 소스 반환
+ */
+MechId_Signal_t* MechId_GetSignal(void)
+{
+    return &mech_sig;
+}
+
+/**
+ * @brief 결과 반환 (디버깅/통신용)
+ */
+const MechId_Result_t* MechId_GetResult(void)
+{
+    mech_result.state = mech_state;
+    return &mech_result;
+}
+
+/* ============================================================
+ * 제어 ISR
+ * ============================================================ */
+
+static inline MechId_Cplx_t MechId_CMul(MechId_Cplx_t x, MechId_Cplx_t y)
+{
+    return (MechId_Cplx_t){ x.re * y.re - x.im * y.im, x.re * y.im + x.im * y.re };
+}
+
+static inline MechId_Cplx_t MechId_CDiv(MechId_Cplx_t x, MechId_Cplx_t y)
+{
+    float d = 1.0f / (y.re * y.re + y.im * y.im);
+    return (MechId_Cplx_t){ (x.re * y.re + x.im * y.im) * d, (x.im * y.re - x.re * y.im) * d };
+}
+
+/* 상 량 → αβ (영상분 제거) */
+static inline MechId_Cplx_t MechId_Clarke(float a, float b, float c)
+{
+    return (MechId_Cplx_t){ (2.0f * a - b - c) * (1.0f / 3.0f), (b - c) * MECH_SQRT3_INV };
+}
+
+/* 스텝 평균 전류 부호 (영점 교차는 두 샘플 사이 선형 보간) */
+static inline float MechId_SignAvg(float i0, float i1)
+{
+    if ((i0 >= 0.0f) == (i1 >= 0.0f)) return (i0 >= 0.0f) ? 1.0f : -1.0f;
+    float f = i0 / (i0 - i1);
+    return (i0 > 0.0f) ? (2.0f * f - 1.0f) : (1.0f - 2.0f * f);
+}
+
+/* 중앙정렬 상 ON 구간 (주기 양끝) 의 리플 모멘트 h(d) = d(1−d)(2−d)/24 */
+static inline float MechId_RippleH(uint16_t ccr)
+{
+    float d = (float)ccr * arr1_inv;
+    if (d > 1.0f) d = 1.0f;
+    return d * (1.0f - d) * (2.0f - d) * (1.0f / 24.0f);
+}
+
+/**
+ * @brief 직전 스텝 역기전력 / 평균 전류 (파일 머리말의 이산 모델, 직전 스텝 전압 좌표계)
+ * @param v     직전 스텝 평균 전압 [V] (지령은 실수축)
+ * @param w     직전 스텝 전기 각속도 [rad/s]
+ * @param i0    직전 스텝 시작 전류
+ * @param i1    이번 스텝 시작 전류 (직전 좌표계 + ω·dt)
+ * @param pE    역기전력 E [V]
+ * @param pI    평균 전류 Ī [A]
+ */
+static void MechId_StepEI(MechId_Cplx_t v, float w, MechId_Cplx_t i0, MechId_Cplx_t i1,
+                          MechId_Cplx_t *pE, MechId_Cplx_t *pI)
+{
+    const MechId_Cplx_t z  = { cosf(w * dt), sinf(w * dt) };
+    const MechId_Cplx_t zi = { z.re, -z.im };                   // 1/z
+    const MechId_Cplx_t sl = { rs / ls, w };                    // s
+    const MechId_Cplx_t zl = { rs, w * ls };                    // R + jωL
+    const float a = a_rl;
+
+    // E = [(1−a)·V/R + a·I_k − z·I_k+1]·(R + jωL) / (z − a)
+    MechId_Cplx_t zi1 = MechId_CMul(z, i1);
+    const float g = (1.0f - a) / rs;
+    MechId_Cplx_t n = { g * v.re + a * i0.re - zi1.re, g * v.im + a * i0.im - zi1.im };
+    MechId_Cplx_t e = MechId_CDiv(MechId_CMul(n, zl), (MechId_Cplx_t){ z.re - a, z.im });
+
+    // Ī·T = I_k·c1 + V/R·(c2 − c1) − E·(T − c1)/(L·s)
+    MechId_Cplx_t c1 = MechId_CDiv((MechId_Cplx_t){ 1.0f - a * zi.re, -a * zi.im }, sl);
+    MechId_Cplx_t c2 = MechId_CDiv((MechId_Cplx_t){ 1.0f - zi.re, -zi.im }, (MechId_Cplx_t){ 0.0f, w });
+    MechId_Cplx_t ib = MechId_CMul(i0, c1);
+    MechId_Cplx_t vc = MechId_CMul(v, (MechId_Cplx_t){ (c2.re - c1.re) / rs, (c2.im - c1.im) / rs });
+    ib.re += vc.re;
+    ib.im += vc.im;
+    MechId_Cplx_t ie = MechId_CDiv(MechId_CMul(e, (MechId_Cplx_t){ dt - c1.re, -c1.im }),
+                                   (MechId_Cplx_t){ ls * sl.re, ls * sl.im });
+    *pE = e;
+    pI->re = (ib.re - ie.re) / dt;
+    pI->im = (ib.im - ie.im) / dt;
+}
+
+/* iq = Re(E·Ī*) / |E| */
+static inline float MechId_Iq(MechId_Cplx_t e, MechId_Cplx_t i)
+{
+    float em = sqrtf(e.re * e.re + e.im * e.im);
+    return (em > 0.0f) ? (e.re * i.re + e.im * i.im) / em : 0.0f;
+}
+
+static inline void MechId_Push(float a, float w, float t)
+{
+    uint32_t next = (ring_head + 1u) & (MECH_RING_SIZE - 1u);
+    if (next == ring_tail)
+    {
+        mech_result.dropped++;
+        return;
+    }
+    ring[ring_head] = (MechId_Sample_t){ a, w, t };
+    ring_head = next;
+}
+
+/* 토크 평균 구간 초기화 */
+static inline void MechId_WinReset(void)
+{
+    win_n = 0;
+    win_e.re = win_e.im = win_i.re = win_i.im = 0.0f;
+    win_w = 0.0f;
+}
+
+/* 사이클 시작: 정렬 → 가속 (홀수 사이클은 가속 시간 2배) */
+static void MechId_StartCycle(void)
+{
+    angle = 0.0f;
+    w_e = 0.0f;
+    v_prev = w_prev = angle_prev = 0.0f;
+    ia_prev = ib_prev = 0.0f;
+    i_prev.re = i_prev.im = 0.0f;
+    MechId_WinReset();
+    n_ramp_cur = n_ramp * (1u + (mech_result.cycle & 1u));
+    a_cur = w_ref / ((float)n_ramp_cur * dt);
+    MechId_Next(MECH_ALIGN);
+}
+
+/* 식별 진행 중 스텝 본체 (FLASH, 대기 중에는 호출되지 않음) */
+__attribute__((noinline)) static uint8_t MechId_StepActive(float ia, float ib, uint8_t hall, float *pVa, float *pVb)
+{
+    uint8_t st = mech_state;
+
+    float va = 0.0f, vb = 0.0f;
+    uint8_t edge = (hall_prev == 0u && hall != 0u) ? 1u : 0u;
+    hall_prev = hall;
+    gap++;
+    n_step++;
+
+    switch (st)
+    {
+    case MECH_ALIGN:
+    {
+        float k = (float)n_step / (float)(n_align / 2u + 1u);
+        va = v_dc * ((k > 1.0f) ? 1.0f : k);
+        if (n_step >= n_align) MechId_Next(MECH_ACCEL);
+        break;
+    }
+
+    case MECH_ACCEL:
+    case MECH_HOLD:
+    {
+        float k = 1.0f, a = 0.0f;
+        if (st == MECH_ACCEL)
+        {
+            k = (float)n_step / (float)n_ramp_cur;
+            a = a_cur;
+            if (n_step >= n_ramp_cur) MechId_Next(MECH_HOLD);
+        }
+        else if (n_step >= n_hold)
+        {
+            // 관성 정지: 토크 0, Hall 주기 측정 시작
+            if (pDriver != NULL) pDriver(0);
+            n_edges = 0;
+            gap = 0;
+            gap_sum = blk_edges = blk_t0 = n_blk = 0;
+            mech_sig.iq = 0.0f;
+            MechId_Next(MECH_COAST);
+            break;
+        }
+
+        // 주기 경계 샘플 → 직전 PWM 주기 평균: τe 가 PWM 주기의 몇 배뿐이라 리플이 비대칭,
+        // 평균 − 샘플 = −(R/L²)·Vbus·T_pwm²·Σ h(d)  (직전 스텝 CCR, 영상분 제거)
+        const float vbus = Sense_GetState()->vbus;
+        const SVPWM_State_t *pw = SVPWM_GetState();
+        MechId_Cplx_t rip = MechId_Clarke(MechId_RippleH(pw->CCR_A), MechId_RippleH(pw->CCR_B),
+                                          MechId_RippleH(pw->CCR_C));
+        float kr = -k_rip * vbus;
+        float i_al = ia + kr * rip.re;
+        float i_be = (ia + 2.0f * ib) * MECH_SQRT3_INV + kr * rip.im;
+
+        // 이번 스텝 시작 전류 → 이번 스텝 전압 좌표계 (= 직전 좌표계 + ω·dt)
+        float c = cosf(angle), sn = sinf(angle);
+        MechId_Cplx_t i_k = { i_al * c + i_be * sn, -i_al * sn + i_be * c };
+
+        MechId_Cplx_t e = { 0.0f, 0.0f }, ibar = { 0.0f, 0.0f };
+        if (w_prev > 0.0f)
+        {
+            // 직전 스텝 평균 전압 = 지령 + 데드타임 오차 (−sign(i)·Vbus·t_dead/T_pwm, 직전 좌표계)
+            float kd = -vbus * dead_frac;
+            MechId_Cplx_t dv = MechId_Clarke(kd * MechId_SignAvg(ia_prev, ia), kd * MechId_SignAvg(ib_prev, ib),
+                                             kd * MechId_SignAvg(-ia_prev - ib_prev, -ia - ib));
+            float cp = cosf(angle_prev), sp = sinf(angle_prev);
+            MechId_Cplx_t v = { v_prev + dv.re * cp + dv.im * sp, -dv.re * sp + dv.im * cp };
+            MechId_StepEI(v, w_prev, i_prev, i_k, &e, &ibar);
+        }
+        i_prev = i_k;
+        ia_prev = ia;
+        ib_prev = ib;
+
+        mech_sig.iq = MechId_Iq(e, ibar);
+        mech_sig.speed = w_e * pp_inv;
+
+        // 저속에서는 역기전력이 작아 방향이 불확실 → 제외
+        // 구간 투영은 E, Ī 를 따로 합한 뒤 한 번: 스텝마다 곱하면 둘에 같이 들어간
+        // 전류 잡음의 곱이 평균에 남는다 (경부하 정속 토크의 수 %)
+        if (w_e > MECH_W_MIN * w_e_max)
+        {
+            win_e.re += e.re;
+            win_e.im += e.im;
+            win_i.re += ibar.re;
+            win_i.im += ibar.im;
+            win_w += mech_sig.speed;
+            if (++win_n >= n_win)
+            {
+                float inv = 1.0f / (float)win_n;
+                MechId_Push(a, win_w * inv, kt * MechId_Iq(win_e, win_i) * inv);
+                MechId_WinReset();
+            }
+        }
+
+        // |V| = ωψ + 여유 전압: 저속은 정렬 전압, 고속은 그 1/10 로 줄여 d축 전류를 최소화
+        // (경부하 오픈루프에서 여유 전압은 대부분 d축 전류가 되어 iq 분해능을 떨어뜨린다)
+        w_e = k * w_e_max;
+        float v_margin = v_dc * (1.0f - 0.9f * k);
+        float v = w_e * flux + v_margin;
+        va = v * c;
+        vb = v * sn;
+        v_prev = v;
+        w_prev = w_e;
+        angle_prev = angle;
+
+        angle += w_e * dt;
+        if (angle >= MECH_TWO_PI) angle -= MECH_TWO_PI;
+        break;
+    }
+
+    case MECH_COAST:
+    {
+        if (edge)
+        {
+            // 첫 에지는 구간 기준점만 (관성 정지 시작 시점과 무관)
+            if (n_edges >= 1u)
+            {
+                mech_sig.speed = MECH_TWO_PI / ((float)gap * dt) * pp_inv;
+                blk_edges++;
+                if (gap_sum + gap >= n_cwin)
+                {
+                    // 구간 평균 속도: 에지 시각이 스텝 단위라 에지 하나 간격의 속도는
+                    // 수 % 양자화되고, 그 차분인 dω/dt 잡음은 회귀의 J 를 0 쪽으로 끌어당긴다
+                    uint32_t span = gap_sum + gap;
+                    float wb = (float)blk_edges * MECH_TWO_PI * pp_inv / ((float)span * dt);
+                    float tm = ((float)blk_t0 + 0.5f * (float)span) * dt;
+                    if (n_blk >= 1u)
+                        MechId_Push((wb - w_blk_prev) / (tm - t_blk_prev), 0.5f * (wb + w_blk_prev), 0.0f);
+                    w_blk_prev = wb;
+                    t_blk_prev = tm;
+                    n_blk++;
+                    blk_t0 += span;
+                    blk_edges = 0;
+                    gap_sum = 0;
+                }
+                else
+                {
+                    gap_sum += gap;
+                }
+            }
+            n_edges++;
+            gap = 0;
+        }
+        else if (n_edges >= 2u)
+        {
+            // 에지 사이: 마지막 주기보다 느려지는 중이면 상한으로 표시
+            float w_max = MECH_TWO_PI / ((float)gap * dt) * pp_inv;
+            if (w_max < mech_sig.speed) mech_sig.speed = w_max;
+        }
+
+        if (gap >= n_stop)
+        {
+            mech_sig.speed = 0.0f;
+            if (++mech_result.cycle >= MECH_CYCLES)
+            {
+                MechId_Next(MECH_FIT);
+            }
+            else
+            {
+                MechId_StartCycle();
+                if (pDriver != NULL) pDriver(1);
+            }
+        }
+        break;
+    }
+
+    default:
+        // FIT/DONE/ERROR: 드라이버 비활성 상태 유지 (Abort 로 해제)
+        break;
+    }
+
+    *pVa = va;
+    *pVb = vb;
+    return 1;
+}
+
+/**
+ * @brief 제어 스텝 (제어 ISR, 고장이 없을 때만 호출)
+ *
+ * 대기 중에는 CCM 에서 바로 돌아오고, 식별 중일 때만 FLASH 본체를 부른다.
+ *
+ * @param ia, ib    상전류 [A]
+ * @param hall      Hall W 입력 레벨
+ * @param pVa, pVb  출력 α/β 전압 [V]
+ * @return 1: 출력 점유, 0: 오픈루프 출력 유지
+ */
+CCMRAM_FUNC uint8_t MechId_Step(float ia, float ib, uint8_t hall, float *pVa, float *pVb)
+{
+    if (mech_state == MECH_IDLE) return 0;
+    return MechId_StepActive(ia, ib, hall, pVa, pVb);
+}
@@ -0,0 +1,437 @@
+/**
+ * @file    motor_id.c
+ * @brief   모터 파라미터 자동 식별 구현
+ *
+ * 모든 측정은 α/β 전압 벡터 주입 → SVPWM_Run, 상전류 Clarke 변환으로 수행한다
+ * (진폭 불변 변환: Vα, Iα 는 A상 상전압/상전류와 같은 크기).
+ *
+ *   정렬    : Vα = V_dc 램프          → 회전자 d축 = α축
+ *   Rs      : Vα = V_dc/2, V_dc 두 점 → Rs = ΔV / ΔIα (데드타임 전압 오차 상쇄)
+ *   Ld      : Vα = V_dc/2 ± V_hf (스텝마다 부호 반전)
+ *   Lq      : Vα = V_dc/2, Vβ = ± V_hf
+ *             1차 RL 이산 응답의 정상 상태 리플 ΔI = 2V/R · tanh(R·T / 2L)
+ *             → L = R·T / (2·atanh(ΔI·R / 2V))
+ *             교번 토크 평균은 0 이고 바이어스 전류가 회전자를 붙잡는다.
+ *   자속    : 오픈루프 ω, |V| 정속 → 전압 좌표계 평균 전류 (id, iq)
+ *             스텝 동안 유지되는 전압 (영차 유지) 과 스텝 시작 전류 샘플 사이의 이산 모델
+ *             E = G·V − (Rs + jωLs)·I,  G = (1−a)(1 + jωLs/Rs) / (e^{jωT} − a),  a = e^{−Rs·T/Ls}
+ *             ψ = |E| / ω   (Ls = (Ld+Lq)/2, T ≫ Ls/Rs 에서 연속 모델 G = 1 과 크게 다름)
+ *             Ld ≠ Lq 이면 E 방향 (회전자 q축) 으로 전류를 나눠 jω(Ld·id + Lq·iq) 로 반복 보정
+ *   전류 이득: 극점-영점 상쇄 PI, ωc = 2π·bw → Kp = Ls·ωc, Ki = Rs·ωc
+ *   극쌍수  : 출력 없이 회전자를 손으로 정확히 1회전 → Hall W 상승 에지 수
+ *
+ * 누적은 제어 ISR, 계산(atanh, sqrt)과 파라미터 커밋은 메인 루프에서 한다.
+ * 측정 결과는 레지스트리(PARAM_MOTOR_xxx, PARAM_CUR_xxx)에 적용되며
+ * CONFIG_SAVE 로 영구 저장된다.
+ */
+
+#include "motor_id.h"
+#include "param.h"
+#include "fault.h"
+#include "app_config.h"
+#include <math.h>
+#include <string.h>
+
+#define MID_TWO_PI      6.28318530f
+#define MID_SQRT3_INV   0.57735027f
+#define MID_I_MIN       1.0e-3f         // 유효 전류 변화 하한 [A]
+#define MID_SALIENT_ITER 3u             // 자속 계산 돌극성 보정 반복
+
+static volatile uint8_t mid_state = MID_IDLE;
+static MotorId_Meas_t   mid_meas;
+static MotorId_Result_t mid_result;
+
+/* ISR 진행 상태 */
+static uint32_t n_step = 0;             // 현재 구간 경과 스텝
+static uint32_t n_align, n_settle, n_meas, n_ramp;
+static float    acc_a = 0.0f, acc_b = 0.0f;
+static uint32_t acc_n = 0;
+static float    i_prev = 0.0f;
+static float    hf_sign = 1.0f;
+static float    spin_angle = 0.0f, spin_w = 0.0f;
+static uint8_t  hall_prev = 0xFFu;
+
+/* 다음 구간으로 (누적 초기화) */
+static void MotorId_Next(uint8_t state)
+{
+    n_step = 0;
+    acc_a = acc_b = 0.0f;
+    acc_n = 0;
+    mid_state = state;
+}
+
+/* 메인 루프 설정 기록을 ISR 이 보기 전에 완료 (단일 코어: 컴파일러 재배치만 방지) */
+#define MID_BARRIER()   __asm volatile ("" ::: "memory")
+
+/* ============================================================
+ * Public 함수 (메인 루프)
+ * ============================================================ */
+
+/**
+ * @brief 식별 시작 (메인 루프, 드라이버 활성 상태에서)
+ * @param spin  1: 오픈루프 회전으로 자속까지 측정, 0: 정지 측정(Rs, L)만
+ * @return 1: 시작, 0: 진행 중
+ */
+uint8_t MotorId_Start(uint8_t spin)
+{
+    if (mid_state != MID_IDLE && mid_state != MID_DONE && mid_state != MID_ERROR)
+        return 0;
+
+    memset(&mid_meas, 0, sizeof(mid_meas));
+    memset(&mid_result, 0, sizeof(mid_result));
+
+    mid_meas.dt     = 1.0f / (float)CONTROL_FREQ_HZ;     // MotorId_Step 호출 주기 = TIM6
+    mid_meas.v_dc   = Param_Get(PARAM_ID_V_DC).f;
+    mid_meas.v_hf   = Param_Get(PARAM_ID_V_HF).f;
+    mid_meas.v_spin = Param_Get(PARAM_ID_V_SPIN).f;
+    mid_meas.w_spin = MID_TWO_PI * Param_Get(PARAM_ID_SPIN_HZ).f;
+    mid_result.spin = spin ? 1u : 0u;
+
+    float fs = 1.0f / mid_meas.dt;
+    n_align  = (uint32_t)(MID_T_ALIGN * fs);
+    n_settle = (uint32_t)(MID_T_SETTLE * fs);
+    n_meas   = (uint32_t)(MID_T_MEAS * fs);
+    n_ramp   = (uint32_t)(MID_T_SPIN_RAMP * fs);
+    if (n_align == 0) n_align = 1;
+    if (n_meas == 0) n_meas = 1;
+    if (n_ramp == 0) n_ramp = 1;
+
+    spin_angle = 0.0f;
+    spin_w = 0.0f;
+    hf_sign = 1.0f;
+
+    MID_BARRIER();
+    MotorId_Next(MID_ALIGN);
+    return 1;
+}
+
+/**
+ * @brief 극쌍수 계수 시작 (드라이버 비활성 상태에서 회전자를 손으로 1회전)
+ * @return 1: 시작, 0: 진행 중
+ */
+uint8_t MotorId_StartPoles(void)
+{
+    if (mid_state != MID_IDLE && mid_state != MID_DONE && mid_state != MID_ERROR)
+        return 0;
+
+    mid_result.poles = 0;
+    mid_result.err = MID_ERR_NONE;
+    hall_prev = 0xFFu;
+
+    MID_BARRIER();
+    MotorId_Next(MID_POLES);
+    return 1;
+}
+
+/**
+ * @brief 극쌍수 계수 종료 → PARAM_MOTOR_POLES 적용
+ * @return 계수된 극쌍수 (0: 계수 중이 아님 / 에지 없음)
+ */
+uint32_t MotorId_FinishPoles(void)
+{
+    if (mid_state != MID_POLES) return 0;
+
+    mid_state = MID_IDLE;
+    uint32_t pp = mid_result.poles;
+    if (pp == 0) return 0;
+
+    Param_Batch_t b;
+    Param_BatchInit(&b);
+    if (!Param_BatchStageU(&b, PARAM_MOTOR_POLES, pp))
+    {
+        mid_result.err = MID_ERR_RANGE;
+        return 0;
+    }
+    Param_BatchCommit(&b);
+    return pp;
+}
+
+/**
+ * @brief 중단/해제 (출력은 다음 스텝부터 오픈루프로 복귀)
+ */
+void MotorId_Abort(void)
+{
+    uint8_t st = mid_state;
+    if (st != MID_IDLE && st != MID_DONE && st != MID_ERROR)
+        mid_result.err = MID_ERR_ABORT;
+    mid_state = MID_IDLE;
+}
+
+/**
+ * @brief 출력 점유 여부 (제어 ISR)
+ */
+uint8_t MotorId_IsActive(void)
+{
+    return (mid_state != MID_IDLE) ? 1u : 0u;
+}
+
+/**
+ * @brief 메인 루프 처리 - 측정 완료 시 계산/적용, 고장 시 중단
+ */
+void MotorId_Process(void)
+{
+    uint8_t st = mid_state;
+
+    if (st >= MID_ALIGN && st <= MID_COMPUTE && !Fault_IsOk())
+    {
+        mid_result.err = MID_ERR_FAULT;
+        mid_state = MID_ERROR;
+        return;
+    }
+
+    if (st != MID_COMPUTE) return;
+
+    MotorId_Estimate(&mid_meas, Param_Get(PARAM_ID_CUR_BW).f, &mid_result);
+
+    if (mid_result.err == MID_ERR_NONE)
+    {
+        Param_Batch_t b;
+        Param_BatchInit(&b);
+        uint8_t ok = Param_BatchStageF(&b, PARAM_MOTOR_RS, mid_result.rs) &&
+                     Param_BatchStageF(&b, PARAM_MOTOR_LD, mid_result.ld) &&
+                     Param_BatchStageF(&b, PARAM_MOTOR_LQ, mid_result.lq) &&
+                     Param_BatchStageF(&b, PARAM_CUR_KP, mid_result.kp) &&
+                     Param_BatchStageF(&b, PARAM_CUR_KI, mid_result.ki);
+        if (ok && mid_result.spin)
+            ok = Param_BatchStageF(&b, PARAM_MOTOR_FLUX, mid_result.flux);
+
+        if (ok)
+            Param_BatchCommit(&b);
+        else
+            mid_result.err = MID_ERR_RANGE;
+    }
+
+    mid_state = (mid_result.err == MID_ERR_NONE) ? MID_DONE : MID_ERROR;
+}
+
+/**
+ * @brief 교번 전압 리플 → 인덕턴스
+ * @return L [H], 0: 계산 불가
+ */
+static float MotorId_Inductance(float ripple, float rs, float v_hf, float dt)
+{
+    if (ripple < MID_I_MIN || v_hf <= 0.0f) return 0.0f;
+    if (rs <= 0.0f) return v_hf * dt / ripple;
+
+    float x = ripple * rs / (2.0f * v_hf);
+    if (x >= 1.0f) return 0.0f;         // 주기 대비 시정수가 너무 짧음 (분해 불가)
+
+    return rs * dt / (2.0f * atanhf(x));
+}
+
+/**
+ * @brief 누적값 → 모터 상수/전류 이득 계산 (순수 계산)
+ * @param pMeas   측정 누적값
+ * @param cur_bw  전류 루프 목표 대역폭 [Hz]
+ * @param pRes    결과 (rs, ld, lq, flux, kp, ki, err)
+ */
+void MotorId_Estimate(const MotorId_Meas_t *pMeas, float cur_bw, MotorId_Result_t *pRes)
+{
+    pRes->err = MID_ERR_NONE;
+
+    float di = pMeas->i_hi - pMeas->i_lo;
+    if (di < MID_I_MIN)
+    {
+        pRes->err = MID_ERR_NO_CURRENT;
+        return;
+    }
+    pRes->rs = 0.5f * pMeas->v_dc / di;
+
+    pRes->ld = MotorId_Inductance(pMeas->ripple_d, pRes->rs, pMeas->v_hf, pMeas->dt);
+    pRes->lq = MotorId_Inductance(pMeas->ripple_q, pRes->rs, pMeas->v_hf, pMeas->dt);
+    if (pRes->ld <= 0.0f || pRes->lq <= 0.0f)
+    {
+        pRes->err = (pMeas->ripple_d < MID_I_MIN || pMeas->ripple_q < MID_I_MIN) ?
+                    MID_ERR_NO_CURRENT : MID_ERR_RANGE;
+        return;
+    }
+    float ls = 0.5f * (pRes->ld + pRes->lq);
+
+    if (pRes->spin)
+    {
+        // G = (1−a)(1 + jωL/R) / (e^{jωT} − a)
+        float w = pMeas->w_spin;
+        float a = expf(-pRes->rs * pMeas->dt / ls);
+        float nr = 1.0f - a, ni = nr * w * ls / pRes->rs;
+        float zr = cosf(w * pMeas->dt) - a, zi = sinf(w * pMeas->dt);
+        float zz = zr * zr + zi * zi;
+        float gr = (nr * zr + ni * zi) / zz;
+        float gi = (ni * zr - nr * zi) / zz;
+
+        // 돌극성: E 방향 = 회전자 q축 → 전류를 d/q 로 나눠 jω(Ld·id + Lq·iq) 로 다시 계산
+        float id = pMeas->spin_id, iq = pMeas->spin_iq;
+        float ed = gr * pMeas->v_spin - pRes->rs * id + w * ls * iq;
+        float eq = gi * pMeas->v_spin - pRes->rs * iq - w * ls * id;
+        for (uint32_t k = 0; k < MID_SALIENT_ITER; k++)
+        {
+            float e = sqrtf(ed * ed + eq * eq);
+            if (e <= 0.0f) break;
+            float qr = ed / e, qi = eq / e;             // q축 단위 벡터 (전압 좌표계)
+            float i_q = id * qr + iq * qi;              // 회전자 q축 전류
+            float i_d = id * qi - iq * qr;              // 회전자 d축 전류 (d = q − 90°)
+            float psr = pRes->ld * i_d * qi + pRes->lq * i_q * qr;
+            float psi = -pRes->ld * i_d * qr + pRes->lq * i_q * qi;
+            ed = gr * pMeas->v_spin - pRes->rs * id + w * psi;
+            eq = gi * pMeas->v_spin - pRes->rs * iq - w * psr;
+        }
+        pRes->flux = sqrtf(ed * ed + eq * eq) / w;
+    }
+
+    float wc = MID_TWO_PI * cur_bw;
+    pRes->kp = ls * wc;
+    pRes->ki = pRes->rs * wc;
+}
+
+/**
+ * @brief 결과 반환 (디버깅/통신용)
+ */
+const MotorId_Result_t* MotorId_GetResult(void)
+{
+    mid_result.state = mid_state;
+    return &mid_result;
+}
+
+/* ============================================================
+ * 제어 ISR
+ * ============================================================ */
+
+/* 안정 대기 후 평균 구간이 끝나면 1 */
+static inline uint8_t MotorId_Accumulate(float a, float b)
+{
+    if (n_step > n_settle)
+    {
+        acc_a += a;
+        acc_b += b;
+        acc_n++;
+    }
+    return (n_step >= n_settle + n_meas) ? 1u : 0u;
+}
+
+/* 식별 진행 중 스텝 본체 (FLASH, 대기 중에는 호출되지 않음) */
+__attribute__((noinline)) static uint8_t MotorId_StepActive(float ia, float ib, uint8_t hall, float *pVa, float *pVb)
+{
+    const MotorId_Meas_t *m = &mid_meas;
+    float i_al = ia;
+    float i_be = (ia + 2.0f * ib) * MID_SQRT3_INV;
+    float va = 0.0f, vb = 0.0f;
+
+    n_step++;
+
+    switch (mid_state)
+    {
+    case MID_ALIGN:
+    {
+        float k = (float)n_step / (float)(n_align / 2u + 1u);
+        va = m->v_dc * ((k > 1.0f) ? 1.0f : k);
+        if (n_step >= n_align) MotorId_Next(MID_RS_LO);
+        break;
+    }
+
+    case MID_RS_LO:
+        va = 0.5f * m->v_dc;
+        if (MotorId_Accumulate(i_al, 0.0f))
+        {
+            mid_meas.i_lo = acc_a / (float)acc_n;
+            MotorId_Next(MID_RS_HI);
+        }
+        break;
+
+    case MID_RS_HI:
+        va = m->v_dc;
+        if (MotorId_Accumulate(i_al, 0.0f))
+        {
+            mid_meas.i_hi = acc_a / (float)acc_n;
+            i_prev = i_al;
+            MotorId_Next(MID_LD);
+        }
+        break;
+
+    case MID_LD:
+        hf_sign = -hf_sign;
+        va = 0.5f * m->v_dc + hf_sign * m->v_hf;
+        if (MotorId_Accumulate(fabsf(i_al - i_prev), 0.0f))
+        {
+            mid_meas.ripple_d = acc_a / (float)acc_n;
+            MotorId_Next(MID_LQ);
+        }
+        i_prev = i_al;                  // LQ 첫 차분은 안정 대기 구간에서 버려짐
+        break;
+
+    case MID_LQ:
+        hf_sign = -hf_sign;
+        va = 0.5f * m->v_dc;
+        vb = hf_sign * m->v_hf;
+        if (MotorId_Accumulate(fabsf(i_be - i_prev), 0.0f))
+        {
+            mid_meas.ripple_q = acc_a / (float)acc_n;
+            MotorId_Next(mid_result.spin ? MID_SPIN_RAMP : MID_COMPUTE);
+        }
+        i_prev = i_be;
+        break;
+
+    case MID_SPIN_RAMP:
+    case MID_SPIN_MEAS:
+    {
+        // 정렬 전압에서 출발해 주파수에 비례해 V_spin 까지 (저속에서 동기 유지)
+        float k = 1.0f;
+        if (mid_state == MID_SPIN_RAMP)
+        {
+            k = (float)n_step / (float)n_ramp;
+            if (n_step >= n_ramp) MotorId_Next(MID_SPIN_MEAS);
+        }
+        spin_w = k * m->w_spin;
+        float v = m->v_dc + k * (m->v_spin - m->v_dc);
+
+        // 이번 스텝 시작 전류를 이번 스텝 전압 좌표계로 투영 (전압 방향 / 90° 앞선 방향)
+        // 영차 유지 / 샘플 지연은 MotorId_Estimate 의 이산 모델이 반영한다
+        float c = cosf(spin_angle), s = sinf(spin_angle);
+        if (mid_state == MID_SPIN_MEAS &&
+            MotorId_Accumulate(i_al * c + i_be * s, -i_al * s + i_be * c))
+        {
+            mid_meas.spin_id = acc_a / (float)acc_n;
+            mid_meas.spin_iq = acc_b / (float)acc_n;
+            MotorId_Next(MID_COMPUTE);
+        }
+        else
+        {
+            va = v * c;
+            vb = v * s;
+        }
+
+        spin_angle += spin_w * m->dt;
+        if (spin_angle >= MID_TWO_PI) spin_angle -= MID_TWO_PI;
+        break;
+    }
+
+    case MID_POLES:
+        if (hall_prev == 0u && hall != 0u && mid_result.poles < 0xFFu)
+            mid_result.poles++;
+        hall_prev = hall;
+        break;
+
+    default:
+        // COMPUTE/DONE/ERROR: 영벡터 유지 (Abort 로 오픈루프 복귀)
+        break;
+    }
+
+    *pVa = va;
+    *pVb = vb;
+    return 1;
+}
+
+/**
+ * @brief 제어 스텝 (제어 ISR, 고장이 없을 때만 호출)
+ *
+ * 대기 중에는 CCM 에서 바로 돌아오고, 식별 중일 때만 FLASH 본체를 부른다
+ * (매 제어 주기 FLASH 접근 없음).
+ *
+ * @param ia, ib    상전류 [A]
+ * @param hall      Hall 입력 레벨 (극쌍수 계수용)
+ * @param pVa, pVb  출력 α/β 전압 [V]
+ * @return 1: 출력 점유 (pVa/pVb 사용), 0: 오픈루프 출력 유지
+ */
+CCMRAM_FUNC uint8_t MotorId_Step(float ia, float ib, uint8_t hall, float *pVa, float *pVb)
+{
+    if (mid_state == MID_IDLE) return 0;
+    return MotorId_StepActive(ia, ib, hall, pVa, pVb);
+}
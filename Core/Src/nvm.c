@@ -0,0 +1,334 @@
+/**
+ * @file    nvm.c
+ * @brief   영구 저장 구현 - 추가 기록 로그
+ *
+ * 영역 = page_count 개 페이지의 원형 배열. 레코드는 8 byte(double-word) 단위:
+ *
+ *   DW0        : magic(16) | len(16) , seq(32)
+ *   DW1..DWn   : 데이터 (남는 부분 0xFF)
+ *   DWn+1      : 0xFFFF | crc(16) , NVM_COMMIT(32)     ← 마지막에 기록
+ *
+ * - 최신 = 커밋 워드와 CRC 가 맞는 레코드 중 seq 최대.
+ * - 전원 차단: 커밋 워드 이전에 끊기면 그 레코드는 무시되고 직전 레코드가 유효.
+ * - 페이지가 차면 다음 페이지(가장 오래된 기록)를 삭제하고 넘어간다.
+ *   최신 레코드는 항상 현재 페이지에 있으므로 삭제 중 차단되어도 잃지 않는다.
+ * - 깨진 헤더 / CRC 오류 뒤에서는 레코드 경계를 믿을 수 없으므로 double-word 단위로
+ *   다음 헤더를 찾는다 (CRC 와 커밋 워드가 맞아야 유효). 한 페이지가 손상되어도 그 뒤의
+ *   레코드와 다른 페이지는 모두 살핀다. 기록은 마지막 사용 위치 뒤가 페이지 끝까지
+ *   삭제 상태일 때만 이어 쓴다 (아니면 다음 기록부터 페이지 이동).
+ * - 페이지 삭제(수십 ms 정지)는 erase_allowed() 가 1 일 때만 수행한다. 허용되지 않으면
+ *   저장은 NVM_SAVE_DEFERRED 로 접수되고 상태가 NVM_ST_ERASE 로 남는다.
+ */
+
+#include "nvm.h"
+#include "crc16.h"
+#include <string.h>
+#include <stddef.h>
+
+#define NVM_MAGIC       0xC0F1u
+#define NVM_COMMIT      0x600DC0DEu
+#define NVM_DW          8u
+
+/* 레코드 전체 크기 [byte] (헤더 + 데이터 + 커밋) */
+#define NVM_REC_SIZE(len)   (NVM_DW + (((len) + NVM_DW - 1u) & ~(NVM_DW - 1u)) + NVM_DW)
+
+static const Nvm_Port_t *pNvm = NULL;
+static Nvm_Status_t nvm_status;
+
+static uint32_t rd_ofs = 0;             // 최신 레코드 위치
+static uint32_t wr_page = 0;            // 기록 중인 페이지
+static uint32_t wr_in = 0;              // 페이지 내 다음 기록 위치 (page_size = 가득 참)
+static uint8_t  next_erased = 0;        // 1: 다음 페이지 삭제 완료 (미리 삭제)
+
+/* 기록 작업 (부팅 시 스캔 버퍼로도 사용) */
+static uint8_t  wr_buf[NVM_REC_SIZE(NVM_MAX_PAYLOAD)];
+static uint32_t wr_size = 0;            // 레코드 전체 크기
+static uint32_t wr_len = 0;             // 데이터 길이
+static uint32_t wr_seq = 0;             // 기록 중인 레코드 순번
+static uint32_t wr_pos = 0;             // 기록한 바이트 수
+
+static uint32_t Nvm_ScanRecord(uint32_t ofs, uint32_t room, uint32_t *pSeq, uint32_t *pLen);
+static uint8_t  Nvm_IsErased(uint32_t ofs, uint32_t len);
+static uint8_t  Nvm_EraseNext(void);
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+/**
+ * @brief 영역 스캔 후 최신 레코드/기록 위치 결정
+ * @param pPort  저장 매체 포트
+ */
+void Nvm_Init(const Nvm_Port_t *pPort)
+{
+    pNvm = pPort;
+    memset(&nvm_status, 0, sizeof(nvm_status));
+    wr_page = 0;
+    wr_size = 0;
+
+    uint32_t page_size = pNvm->page_size;
+    uint32_t best_end = 0;              // 최신 레코드가 있는 페이지의 사용 끝
+
+    for (uint32_t pg = 0; pg < pNvm->page_count; pg++)
+    {
+        uint32_t base = pg * page_size;
+        uint32_t ofs = 0;
+        uint8_t  has_best = 0;
+        uint8_t  resync = 0;                        // 1: 경계 불명, double-word 단위로 헤더 탐색
+
+        while (ofs + 2u * NVM_DW <= page_size)
+        {
+            uint32_t seq, len;
+            uint32_t size = Nvm_ScanRecord(base + ofs, page_size - ofs, &seq, &len);
+
+            if (size == 0)
+            {
+                // 미사용 영역: 페이지 끝까지 삭제 상태면 끝, 아니면 손상 구간의 빈 칸
+                if (Nvm_IsErased(base + ofs, page_size - ofs)) break;
+                ofs += NVM_DW;
+                continue;
+            }
+            if (size == 0xFFFFFFFFu || len == 0xFFFFFFFFu)
+            {
+                // 헤더 손상 / ECC / 미완료 기록 / CRC 오류 - 손상 구간마다 1 회만 센다
+                if (!resync) nvm_status.bad_records++;
+                resync = 1;
+                ofs += NVM_DW;
+                continue;
+            }
+
+            resync = 0;
+            if (!nvm_status.valid || (int32_t)(seq - nvm_status.seq) > 0)
+            {
+                nvm_status.valid = 1;
+                nvm_status.seq = seq;
+                nvm_status.len = (uint16_t)len;
+                rd_ofs = base + ofs;
+                has_best = 1;
+            }
+            ofs += size;
+        }
+
+        if (has_best)
+        {
+            wr_page = pg;
+            best_end = ofs;
+        }
+    }
+
+    // 기록 위치: 최신 레코드 페이지의 사용 끝 (나머지가 삭제 상태일 때만)
+    uint32_t base = wr_page * page_size;
+    if (best_end < page_size && Nvm_IsErased(base + best_end, page_size - best_end))
+        wr_in = best_end;
+    else
+        wr_in = page_size;                          // 다음 기록 시 페이지 이동
+
+    uint32_t next = ((wr_page + 1u) % pNvm->page_count) * page_size;
+    next_erased = Nvm_IsErased(next, page_size);
+
+    nvm_status.wr_ofs = base + wr_in;
+    nvm_status.state = NVM_ST_IDLE;
+}
+
+/**
+ * @brief 최신 레코드 읽기
+ * @param dst   출력 버퍼
+ * @param max   버퍼 크기
+ * @return 읽은 길이 (유효 레코드 없으면 0)
+ */
+uint32_t Nvm_Load(void *dst, uint32_t max)
+{
+    if (pNvm == NULL || !nvm_status.valid) return 0;
+
+    uint32_t len = nvm_status.len;
+    if (len > max) len = max;
+    if (!pNvm->read(rd_ofs + NVM_DW, dst, len)) return 0;
+    return len;
+}
+
+/**
+ * @brief 저장 요청 (데이터를 내부 버퍼로 복사, 실제 기록은 Nvm_Process)
+ * @return NVM_SAVE_xxx (DEFERRED: 다음 페이지 삭제가 필요한데 지금은 허용되지 않음)
+ */
+uint8_t Nvm_Save(const void *src, uint32_t len)
+{
+    if (pNvm == NULL || len > NVM_MAX_PAYLOAD) return NVM_SAVE_REJECTED;
+    if (Nvm_IsBusy()) return NVM_SAVE_REJECTED;
+
+    uint32_t size = NVM_REC_SIZE(len);
+    uint32_t seq = nvm_status.valid ? nvm_status.seq + 1u : 1u;
+
+    memset(wr_buf, 0xFF, size);
+    uint32_t hdr[2] = { ((uint32_t)NVM_MAGIC << 16) | len, seq };
+    memcpy(&wr_buf[0], hdr, NVM_DW);
+    memcpy(&wr_buf[NVM_DW], src, len);
+
+    uint16_t crc = CRC16_Update(CRC16_INIT, wr_buf, size - NVM_DW);
+    uint32_t tail[2] = { 0xFFFF0000u | crc, NVM_COMMIT };
+    memcpy(&wr_buf[size - NVM_DW], tail, NVM_DW);
+
+    wr_size = size;
+    wr_len = len;
+    wr_seq = seq;
+    wr_pos = 0;
+
+    // 현재 페이지 남은 공간이 부족하면 다음 페이지로 (삭제 필요)
+    if (wr_in + size <= pNvm->page_size)
+    {
+        nvm_status.state = NVM_ST_WRITE;
+        return NVM_SAVE_QUEUED;
+    }
+    nvm_status.state = NVM_ST_ERASE;
+    return (next_erased || pNvm->erase_allowed()) ? NVM_SAVE_QUEUED : NVM_SAVE_DEFERRED;
+}
+
+/**
+ * @brief 메인 루프 처리 - 1회 호출당 최대 1 double-word 기록 또는 1 페이지 삭제
+ *
+ * double-word 기록 1회 ≈ 85 us 동안 FLASH 읽기(벡터 fetch 포함)가 정지된다.
+ * 페이지 삭제는 ≈ 22 ms 정지하므로 erase_allowed() (출력 비활성) 일 때만 수행.
+ * 대기 중에는 페이지가 거의 찼을 때 다음 페이지를 미리 삭제해 둔다.
+ */
+void Nvm_Process(void)
+{
+    if (pNvm == NULL) return;
+
+    switch (nvm_status.state)
+    {
+    case NVM_ST_IDLE:
+        if (!next_erased && pNvm->page_size - wr_in < NVM_REC_SIZE(NVM_MAX_PAYLOAD) &&
+            pNvm->erase_allowed())
+        {
+            if (!Nvm_EraseNext()) nvm_status.state = NVM_ST_ERROR;
+        }
+        break;
+
+    case NVM_ST_ERASE:
+        if (!next_erased)
+        {
+            if (!pNvm->erase_allowed()) break;      // 출력 비활성까지 대기
+            if (!Nvm_EraseNext())
+            {
+                nvm_status.state = NVM_ST_ERROR;
+                break;
+            }
+        }
+        wr_page = (wr_page + 1u) % pNvm->page_count;
+        wr_in = 0;
+        next_erased = 0;
+        nvm_status.wr_ofs = wr_page * pNvm->page_size;
+        nvm_status.state = NVM_ST_WRITE;
+        break;
+
+    case NVM_ST_WRITE:
+    {
+        uint64_t dw;
+        memcpy(&dw, &wr_buf[wr_pos], NVM_DW);
+        if (!pNvm->program(nvm_status.wr_ofs + wr_pos, dw))
+        {
+            // 기록 실패 - 이 페이지는 더 쓰지 않음 (다음 저장은 새 페이지)
+            wr_in = pNvm->page_size;
+            nvm_status.wr_ofs = wr_page * pNvm->page_size + wr_in;
+            nvm_status.state = NVM_ST_ERROR;
+            break;
+        }
+        wr_pos += NVM_DW;
+
+        if (wr_pos >= wr_size)
+        {
+            // 커밋 워드 기록 완료 → 이 레코드가 최신
+            rd_ofs = nvm_status.wr_ofs;
+            nvm_status.seq = wr_seq;
+            nvm_status.len = (uint16_t)wr_len;
+            nvm_status.valid = 1;
+            wr_in += wr_size;
+            nvm_status.wr_ofs += wr_size;
+            nvm_status.saves++;
+            nvm_status.state = NVM_ST_IDLE;
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 기록 진행 중 여부
+ */
+uint8_t Nvm_IsBusy(void)
+{
+    return (nvm_status.state == NVM_ST_ERASE || nvm_status.state == NVM_ST_WRITE) ? 1u : 0u;
+}
+
+/**
+ * @brief 상태 반환 (디버깅용)
+ */
+const Nvm_Status_t* Nvm_GetStatus(void)
+{
+    return &nvm_status;
+}
+
+/* ============================================================
+ * Private 함수
+ * ============================================================ */
+
+/**
+ * @brief 레코드 1개 검사
+ * @param ofs   레코드 시작 오프셋
+ * @param room  페이지 내 남은 공간 [byte]
+ * @param pSeq  순번 출력
+ * @param pLen  데이터 길이 출력 (0xFFFFFFFF: 미완료/CRC 오류)
+ * @return 레코드 크기, 0: 미사용 영역, 0xFFFFFFFF: 헤더 손상
+ */
+static uint32_t Nvm_ScanRecord(uint32_t ofs, uint32_t room, uint32_t *pSeq, uint32_t *pLen)
+{
+    uint32_t hdr[2];
+    if (!pNvm->read(ofs, hdr, NVM_DW)) return 0xFFFFFFFFu;
+    if (hdr[0] == 0xFFFFFFFFu && hdr[1] == 0xFFFFFFFFu) return 0;
+
+    uint32_t len = hdr[0] & 0xFFFFu;
+    if ((hdr[0] >> 16) != NVM_MAGIC || len > NVM_MAX_PAYLOAD) return 0xFFFFFFFFu;
+
+    uint32_t size = NVM_REC_SIZE(len);
+    if (size > room) return 0xFFFFFFFFu;
+
+    *pSeq = hdr[1];
+    *pLen = 0xFFFFFFFFu;
+
+    if (!pNvm->read(ofs, wr_buf, size)) return size;    // 데이터 ECC 오류 - 레코드만 버림
+
+    uint32_t tail[2];
+    memcpy(tail, &wr_buf[size - NVM_DW], NVM_DW);
+    uint16_t crc = CRC16_Update(CRC16_INIT, wr_buf, size - NVM_DW);
+    if (tail[1] == NVM_COMMIT && tail[0] == (0xFFFF0000u | crc))
+        *pLen = len;
+
+    return size;
+}
+
+/**
+ * @brief 구간이 삭제 상태(0xFF)인지 확인
+ */
+static uint8_t Nvm_IsErased(uint32_t ofs, uint32_t len)
+{
+    uint32_t w[2];
+    for (uint32_t i = 0; i < len; i += NVM_DW)
+    {
+        if (!pNvm->read(ofs + i, w, NVM_DW)) return 0;
+        if (w[0] != 0xFFFFFFFFu || w[1] != 0xFFFFFFFFu) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief 다음 페이지 삭제 (가장 오래된 기록)
+ */
+static uint8_t Nvm_EraseNext(void)
+{
+    if (!pNvm->erase((wr_page + 1u) % pNvm->page_count)) return 0;
+    nvm_status.erases++;
+    next_erased = 1;
+    return 1;
+}
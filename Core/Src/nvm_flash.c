@@ -0,0 +1,119 @@
+/**
+ * @file    nvm_flash.c
+ * @brief   영구 저장 포트 구현 - STM32G431 내장 FLASH (bank 1, 2 KB 페이지)
+ *
+ * 영역은 링커 스크립트의 NVM 메모리(_snvm ~ _envm)로 코드 영역과 분리된다.
+ * 기록/삭제 중에는 FLASH 읽기가 정지되므로 (벡터 테이블 fetch 포함)
+ * nvm.c 가 메인 루프에서 double-word 단위로 나누어 호출하고,
+ * 페이지 삭제는 드라이버 출력이 꺼져 있을 때만 허용한다.
+ *
+ * 읽기 중 ECC 2비트 오류는 NMI 로 전달된다 → NvmFlash_OnNmi() 가 플래그를
+ * 세우고 복귀하며, read() 는 해당 읽기를 실패로 보고한다.
+ */
+
+#include "nvm_flash.h"
+#include "main.h"
+#include <string.h>
+
+/* 링커 심볼 */
+extern uint32_t _snvm;
+extern uint32_t _envm;
+
+#define NVM_BASE        ((uint32_t)(uintptr_t)&_snvm)
+#define NVM_SIZE        ((uint32_t)((uintptr_t)&_envm - (uintptr_t)&_snvm))
+
+static volatile uint8_t ecc_error = 0;
+
+static uint8_t NvmFlash_Read(uint32_t ofs, void *dst, uint32_t len);
+static uint8_t NvmFlash_Program(uint32_t ofs, uint64_t dw);
+static uint8_t NvmFlash_Erase(uint32_t page);
+static uint8_t NvmFlash_EraseAllowed(void);
+
+static Nvm_Port_t flash_port = {
+    .page_size     = FLASH_PAGE_SIZE,
+    .page_count    = 0,                 // NvmFlash_Port() 에서 링커 영역으로 계산
+    .read          = NvmFlash_Read,
+    .program       = NvmFlash_Program,
+    .erase         = NvmFlash_Erase,
+    .erase_allowed = NvmFlash_EraseAllowed,
+};
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+/**
+ * @brief FLASH 포트 반환 (Nvm_Init 인자)
+ */
+const Nvm_Port_t* NvmFlash_Port(void)
+{
+    flash_port.page_count = NVM_SIZE / FLASH_PAGE_SIZE;
+    return &flash_port;
+}
+
+/**
+ * @brief NMI 에서 호출 - FLASH ECC 2비트 오류가 NVM 영역 읽기에서 발생했는지 확인/처리
+ * @return 1: 처리됨 (NMI 복귀 가능), 0: 다른 원인
+ */
+uint8_t NvmFlash_OnNmi(void)
+{
+    uint32_t eccr = FLASH->ECCR;
+    if ((eccr & FLASH_ECCR_ECCD) == 0) return 0;
+
+    // ADDR_ECC: bank 내 바이트 오프셋
+    uint32_t addr = FLASH_BASE + (eccr & FLASH_ECCR_ADDR_ECC);
+    if (addr < NVM_BASE || addr >= NVM_BASE + NVM_SIZE) return 0;
+
+    FLASH->ECCR = eccr | FLASH_ECCR_ECCD;   // write 1 to clear
+    ecc_error = 1;
+    return 1;
+}
+
+/* ============================================================
+ * Private 함수 (Nvm_Port_t)
+ * ============================================================ */
+
+static uint8_t NvmFlash_Read(uint32_t ofs, void *dst, uint32_t len)
+{
+    ecc_error = 0;
+    memcpy(dst, (const void *)(uintptr_t)(NVM_BASE + ofs), len);
+    __DSB();
+    return ecc_error ? 0u : 1u;
+}
+
+static uint8_t NvmFlash_Program(uint32_t ofs, uint64_t dw)
+{
+    HAL_StatusTypeDef st;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    st = HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, NVM_BASE + ofs, dw);
+    HAL_FLASH_Lock();
+
+    return (st == HAL_OK) ? 1u : 0u;
+}
+
+static uint8_t NvmFlash_Erase(uint32_t page)
+{
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_PAGES,
+        .Banks     = FLASH_BANK_1,
+        .Page      = (NVM_BASE - FLASH_BASE) / FLASH_PAGE_SIZE + page,
+        .NbPages   = 1,
+    };
+    uint32_t page_err = 0;
+    HAL_StatusTypeDef st;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    st = HAL_FLASHEx_Erase(&erase, &page_err);
+    HAL_FLASH_Lock();
+
+    return (st == HAL_OK) ? 1u : 0u;
+}
+
+/* 페이지 삭제(≈22 ms 정지)는 드라이버 출력이 꺼져 있을 때만 */
+static uint8_t NvmFlash_EraseAllowed(void)
+{
+    return (HAL_GPIO_ReadPin(GPO_DRIVER_EN_GPIO_Port, GPO_DRIVER_EN_Pin) == GPIO_PIN_RESET) ? 1u : 0u;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file    param.c
+ * @brief   파라미터 레지스트리 구현
+ *
+ *   메인 루프: Param_Stage() ×N → Param_Commit()         (통신 PARAM_WRITE)
+ *              Param_BatchStage() ×N → Param_BatchCommit() (내부 설정, 지역 묶음)
+ *                 1) bank[!active] ← bank[active] + 예약된 값
+ *                 2) version++, active 전환 (단일 워드 쓰기)
+ *   제어 ISR : p = Param_Active() 를 스텝 시작에 1회 읽고 p->v[] 사용
+ *
+ * 제어 ISR 은 메인 루프를 선점하므로 스텝 도중 active 가 바뀌지 않고,
+ * 메인 루프는 ISR 이 보지 않는 뱅크에만 쓴다. 따라서 잠금이 필요 없다.
+ * 커밋은 메인 루프(단일 문맥)에서만 호출한다.
+ */
+
+#include "param.h"
+#include "app_config.h"
+#include "svpwm_config.h"
+#include "stm32g4xx_hal.h"
+#include <stddef.h>
+
+_Static_assert(SVPWM_ARR >= 4249u && SVPWM_ARR <= 16999u, "SVPWM_ARR outside PARAM_PWM_PERIOD range");
+
+#define F(x)    { .f = (x) }
+#define U(x)    { .u = (x) }
+
+/* 정의 테이블 (Param_Id_t 순서) */
+static const Param_Desc_t param_desc[PARAM_COUNT] = {
+    // 주파수 20hrz / V: 0.05  -> 최초로 모터 돌아감 (dt 가 1/10000 이던 시절 설정값 200)
+    // 주파수 40hrz / V: 0.08  -> 위에보다 더 빨리 돌아감 (설정값 400)
+    [PARAM_OL_FREQ_HZ]   = { 0x0010, PARAM_T_F32, "ol_freq",    "Hz",   F(-2000.0f), F(2000.0f),   F(20.0f)    },
+    [PARAM_OL_VOLTAGE]   = { 0x0011, PARAM_T_F32, "ol_voltage", "pu",   F(0.0f),     F(1.0f),      F(0.03f)    },
+    [PARAM_OL_VOLT_V]    = { 0x0012, PARAM_T_F32, "ol_volt",    "V",    F(0.0f),     F(100.0f),    F(0.5f)     },
+    [PARAM_OL_VOLT_MODE] = { 0x0013, PARAM_T_U32, "ol_vmode",   "",     U(0),        U(1),         U(0)        },
+    [PARAM_V_NORM_MAX]   = { 0x0020, PARAM_T_F32, "v_norm_max", "pu",   F(0.0f),     F(1.0f),      F(1.0f)     },
+    [PARAM_V_MOD_MAX]    = { 0x0021, PARAM_T_F32, "v_mod_max",  "pu",   F(0.0f),     F(0.57735027f), F(0.57735027f) },
+    // 읽기 전용: min = max = TIM6 주기 → 다른 값은 Param_Stage 가 거부
+    [PARAM_CTRL_FREQ_HZ] = { 0x0030, PARAM_T_F32, "ctrl_freq",  "Hz",   F((float)CONTROL_FREQ_HZ), F((float)CONTROL_FREQ_HZ), F((float)CONTROL_FREQ_HZ) },
+    [PARAM_PWM_PERIOD]   = { 0x0031, PARAM_T_U32, "pwm_arr",    "tick", U(4249),     U(16999),     U(SVPWM_ARR) },
+    [PARAM_PWM_SPREAD]   = { 0x0032, PARAM_T_U32, "pwm_spread", "%",    U(0),        U(SVPWM_SPREAD_MAX_PCT), U(0) },
+    [PARAM_PWM_ARR_LO]   = { 0x0033, PARAM_T_U32, "pwm_arr_lo", "tick", U(4249),     U(16999),     U(SVPWM_ARR) },
+    [PARAM_PWM_SCH_F_LO] = { 0x0034, PARAM_T_F32, "pwm_sch_lo", "Hz",   F(0.0f),     F(2000.0f),   F(0.0f)     },
+    [PARAM_PWM_SCH_F_HI] = { 0x0035, PARAM_T_F32, "pwm_sch_hi", "Hz",   F(0.0f),     F(2000.0f),   F(0.0f)     },
+    [PARAM_TELEM_DECIM]  = { 0x0001, PARAM_T_U32, "telem_decim","step", U(0),        U(1000),      U(TELEMETRY_DECIM) },
+    [PARAM_MOTOR_RS]     = { 0x0040, PARAM_T_F32, "motor_rs",   "ohm",  F(0.0f),     F(100.0f),    F(0.0f)     },
+    [PARAM_MOTOR_LD]     = { 0x0041, PARAM_T_F32, "motor_ld",   "H",    F(0.0f),     F(1.0f),      F(0.0f)     },
+    [PARAM_MOTOR_LQ]     = { 0x0042, PARAM_T_F32, "motor_lq",   "H",    F(0.0f),     F(1.0f),      F(0.0f)     },
+    [PARAM_MOTOR_FLUX]   = { 0x0043, PARAM_T_F32, "motor_flux", "Wb",   F(0.0f),     F(1.0f),      F(0.0f)     },
+    [PARAM_MOTOR_POLES]  = { 0x0044, PARAM_T_U32, "motor_pp",   "",     U(0),        U(64),        U(0)        },
+    [PARAM_MECH_J]       = { 0x0045, PARAM_T_F32, "mech_j",     "kgm2", F(0.0f),     F(1.0f),      F(0.0f)     },
+    [PARAM_MECH_B]       = { 0x0046, PARAM_T_F32, "mech_b",     "Nms",  F(0.0f),     F(1.0f),      F(0.0f)     },
+    [PARAM_MECH_TC]      = { 0x0047, PARAM_T_F32, "mech_tc",    "Nm",   F(0.0f),     F(10.0f),     F(0.0f)     },
+    [PARAM_CUR_KP]       = { 0x0050, PARAM_T_F32, "cur_kp",     "V/A",  F(0.0f),     F(1000.0f),   F(0.0f)     },
+    [PARAM_CUR_KI]       = { 0x0051, PARAM_T_F32, "cur_ki",     "V/As", F(0.0f),     F(1.0e6f),    F(0.0f)     },
+    [PARAM_SPD_KP]       = { 0x0052, PARAM_T_F32, "spd_kp",     "As",   F(0.0f),     F(1000.0f),   F(0.0f)     },
+    [PARAM_SPD_KI]       = { 0x0053, PARAM_T_F32, "spd_ki",     "A",    F(0.0f),     F(1.0e6f),    F(0.0f)     },
+    [PARAM_ID_V_DC]      = { 0x0060, PARAM_T_F32, "id_v_dc",    "V",    F(0.0f),     F(12.0f),     F(0.5f)     },
+    [PARAM_ID_V_HF]      = { 0x0061, PARAM_T_F32, "id_v_hf",    "V",    F(0.0f),     F(12.0f),     F(0.5f)     },
+    [PARAM_ID_SPIN_HZ]   = { 0x0062, PARAM_T_F32, "id_spin",    "Hz",   F(1.0f),     F(500.0f),    F(50.0f)    },
+    [PARAM_ID_V_SPIN]    = { 0x0063, PARAM_T_F32, "id_v_spin",  "V",    F(0.0f),     F(12.0f),     F(1.0f)     },
+    [PARAM_ID_CUR_BW]    = { 0x0064, PARAM_T_F32, "id_cur_bw",  "Hz",   F(1.0f),     F(5000.0f),   F(50.0f)    },
+    [PARAM_ID_SPD_BW]    = { 0x0065, PARAM_T_F32, "id_spd_bw",  "Hz",   F(0.1f),     F(500.0f),    F(5.0f)     },
+};
+
+/* Param_Batch_t.mask 비트 수 */
+_Static_assert(PARAM_COUNT <= 32, "Param_Batch_t.mask holds at most 32 parameters");
+
+/* 이중 뱅크 */
+static Param_Bank_t bank[2];
+static volatile uint32_t active = 0;
+
+/* 통신 PARAM_WRITE 예약 (내부 설정 경로는 지역 Param_Batch_t 사용) */
+static Param_Batch_t host_batch;
+
+/**
+ * @brief 기본값으로 초기화 (제어 ISR 시작 전)
+ */
+void Param_Init(void)
+{
+    for (uint32_t i = 0; i < PARAM_COUNT; i++)
+        bank[0].v[i] = param_desc[i].def;
+
+    bank[0].version = 0;
+    bank[1] = bank[0];
+    active = 0;
+    host_batch.mask = 0;
+}
+
+/**
+ * @brief 현재 적용 뱅크 (ISR: 스텝마다 1회 받아서 사용, 잠금 없음)
+ */
+CCMRAM_FUNC const Param_Bank_t* Param_Active(void)
+{
+    return &bank[active];
+}
+
+/**
+ * @brief 현재 적용값 읽기
+ */
+Param_Value_t Param_Get(Param_Id_t id)
+{
+    return bank[active].v[id];
+}
+
+/**
+ * @brief 지역 묶음 비우기
+ */
+void Param_BatchInit(Param_Batch_t *pBatch)
+{
+    pBatch->mask = 0;
+}
+
+/**
+ * @brief 지역 묶음에 변경 예약 (범위 검사)
+ * @return 1: 예약, 0: 범위 밖 / NaN / 잘못된 ID
+ */
+uint8_t Param_BatchStage(Param_Batch_t *pBatch, Param_Id_t id, Param_Value_t value)
+{
+    if ((uint32_t)id >= PARAM_COUNT) return 0;
+
+    const Param_Desc_t *d = &param_desc[id];
+    if (d->type == PARAM_T_F32)
+    {
+        // NaN 은 모든 비교가 거짓
+        if (!(value.f >= d->min.f && value.f <= d->max.f)) return 0;
+    }
+    else
+    {
+        if (value.u < d->min.u || value.u > d->max.u) return 0;
+    }
+
+    pBatch->v[id] = value;
+    pBatch->mask |= (1u << id);
+    return 1;
+}
+
+uint8_t Param_BatchStageF(Param_Batch_t *pBatch, Param_Id_t id, float value)
+{
+    Param_Value_t v = { .f = value };
+    return Param_BatchStage(pBatch, id, v);
+}
+
+uint8_t Param_BatchStageU(Param_Batch_t *pBatch, Param_Id_t id, uint32_t value)
+{
+    Param_Value_t v = { .u = value };
+    return Param_BatchStage(pBatch, id, v);
+}
+
+/**
+ * @brief 묶음을 한 번에 적용 (메인 루프 전용)
+ * @return 적용 후 버전
+ */
+uint32_t Param_BatchCommit(Param_Batch_t *pBatch)
+{
+    uint32_t cur = active;
+    if (pBatch->mask == 0) return bank[cur].version;
+
+    uint32_t next = cur ^ 1u;
+    bank[next] = bank[cur];
+    for (uint32_t i = 0; i < PARAM_COUNT; i++)
+    {
+        if (pBatch->mask & (1u << i))
+            bank[next].v[i] = pBatch->v[i];
+    }
+    bank[next].version = bank[cur].version + 1u;
+    pBatch->mask = 0;
+
+    // 뱅크 기록 완료 후 전환
+    __DMB();
+    active = next;
+
+    return bank[next].version;
+}
+
+/**
+ * @brief 변경 예약 (통신 PARAM_WRITE, 메인 루프 전용)
+ * @return 1: 예약, 0: 범위 밖 / NaN / 잘못된 ID
+ */
+uint8_t Param_Stage(Param_Id_t id, Param_Value_t value)
+{
+    return Param_BatchStage(&host_batch, id, value);
+}
+
+uint8_t Param_StageF(Param_Id_t id, float value)
+{
+    return Param_BatchStageF(&host_batch, id, value);
+}
+
+uint8_t Param_StageU(Param_Id_t id, uint32_t value)
+{
+    return Param_BatchStageU(&host_batch, id, value);
+}
+
+/**
+ * @brief 예약된 변경을 한 번에 적용 (메인 루프 전용)
+ * @return 적용 후 버전
+ */
+uint32_t Param_Commit(void)
+{
+    return Param_BatchCommit(&host_batch);
+}
+
+/**
+ * @brief 예약된 변경 취소
+ */
+void Param_Discard(void)
+{
+    host_batch.mask = 0;
+}
+
+/**
+ * @brief 정의 조회
+ */
+const Param_Desc_t* Param_GetDesc(Param_Id_t id)
+{
+    if ((uint32_t)id >= PARAM_COUNT) return NULL;
+    return &param_desc[id];
+}
+
+/**
+ * @brief key → 인덱스 (없으면 PARAM_COUNT)
+ */
+Param_Id_t Param_FindKey(uint16_t key)
+{
+    for (uint32_t i = 0; i < PARAM_COUNT; i++)
+    {
+        if (param_desc[i].key == key) return (Param_Id_t)i;
+    }
+    return PARAM_COUNT;
+}
@@ -0,0 +1,307 @@
+/**
+ * @file    protect.c
+ * @brief   과전류 보호 구현
+ *
+ * 1) 하드웨어 경로 (수십 ns)
+ *    PA0 (A1C1_CurrA, INA240) ─▶ COMP3 INP
+ *    DAC3_CH1 (내부 전용)     ─▶ COMP3 INM   (트립 임계값)
+ *    COMP3 OUT ─▶ TIM3 OCREF_CLR : CH1~3 출력을 다음 업데이트까지 즉시 LOW
+ *              └▶ EXTI29       : 고장 래치 + 드라이버 EN 차단
+ *
+ *    TIM3 는 범용 타이머라 Break 입력이 없으므로 OCREF_CLR 로 대신한다.
+ *
+ * 2) 소프트웨어 경로 (수 us)
+ *    ADC1 AWD1 (CurrA), ADC2 AWD1 (CurrB) 양방향 윈도우 ─▶ ADC1_2 IRQ
+ *    → B상 및 음(-)방향 과전류 검출 (COMP 비반전 입력이 PA4 를 지원하지 않음)
+ *
+ * 3) 운전 지령 래치
+ *    드라이버 EN 은 Protect_SetRun() 으로 정한 운전 지령 (RUN/STOP) 을 따른다.
+ *    고장은 지령을 바꾸지 않고 출력만 끊으며, 해제 후 HOLDOFF 가 지나면
+ *    RUN 지령일 때만 드라이버를 다시 켠다 (STOP 중 해제되어도 꺼진 채 유지).
+ */
+
+#include "protect.h"
+#include "sense.h"
+#include "svpwm.h"
+#include "main.h"
+#include "app_config.h"
+#include "sched.h"
+
+/* COMP3 출력 EXTI 라인 */
+#define COMP3_EXTI_LINE     EXTI_IMR1_IM29
+
+/* COMP CSR 필드 값 */
+#define COMP_INMSEL_DAC3_CH1    (0x4UL << COMP_CSR_INMSEL_Pos)
+#define COMP_INPSEL_INP0        (0x0UL << COMP_CSR_INPSEL_Pos)     // COMP3: PA0
+#define COMP_HYST_20MV          (COMP_CSR_HYST_1)
+
+/* 전류 [A] → INA240 출력 ADC 코드 */
+#define CURR_TO_CODE(i)     ((uint32_t)(((CURR_OFFSET_V + (i) * CURR_SHUNT_OHM * CURR_AMP_GAIN) \
+                                         / ADC_VREF) * ADC_FULL_SCALE))
+
+static TIM_HandleTypeDef *pHTimPwm = NULL;
+static ADC_HandleTypeDef *pHAdcA = NULL;
+static ADC_HandleTypeDef *pHAdcB = NULL;
+static volatile uint8_t run_cmd = 0;    // 운전 지령 (1: RUN, 0: STOP) - 고장과 무관하게 유지
+
+/* 드라이버 EN 출력 상태 (ODR 기준) */
+#define DRIVER_IS_ENABLED() (READ_BIT(GPO_DRIVER_EN_GPIO_Port->ODR, GPO_DRIVER_EN_Pin) != 0u)
+
+/* ============================================================
+ * 하드웨어 설정
+ * ============================================================ */
+
+/**
+ * @brief DAC3_CH1 내부 기준 출력 (COMP3 반전 입력)
+ */
+static void Protect_InitDAC(uint32_t code)
+{
+    __HAL_RCC_DAC3_CLK_ENABLE();
+
+    // MODE1 = 011: 내부 연결 전용, 버퍼 없음 / HFSEL = 10: AHB > 160MHz
+    MODIFY_REG(DAC3->MCR, DAC_MCR_MODE1_Msk | DAC_MCR_HFSEL_Msk,
+               DAC_MCR_MODE1_0 | DAC_MCR_MODE1_1 | DAC_MCR_HFSEL_1);
+
+    DAC3->DHR12R1 = code & 0xFFFu;
+    SET_BIT(DAC3->CR, DAC_CR_EN1);
+
+    // 출력 준비 대기 (수 us)
+    for (uint32_t i = 0; i < 10000u; i++)
+    {
+        if (READ_BIT(DAC3->SR, DAC_SR_DAC1RDY)) break;
+    }
+}
+
+/**
+ * @brief COMP3 설정 및 EXTI 상승엣지 인터럽트
+ */
+static void Protect_InitCOMP(void)
+{
+    // COMP 는 SYSCFG 클록 사용 (HAL_MspInit 에서 활성화됨)
+    COMP3->CSR = COMP_INMSEL_DAC3_CH1 | COMP_INPSEL_INP0 | COMP_HYST_20MV;
+    SET_BIT(COMP3->CSR, COMP_CSR_EN);
+
+    // 비교기 기동 시간 대기 (~5us)
+    for (volatile uint32_t i = 0; i < 1000u; i++) { }
+
+    WRITE_REG(EXTI->PR1, COMP3_EXTI_LINE);
+    SET_BIT(EXTI->RTSR1, COMP3_EXTI_LINE);
+    SET_BIT(EXTI->IMR1, COMP3_EXTI_LINE);
+
+    HAL_NVIC_SetPriority(COMP1_2_3_IRQn, IRQ_PRIO_PROTECT, 0);
+    HAL_NVIC_EnableIRQ(COMP1_2_3_IRQn);
+}
+
+/**
+ * @brief TIM3 CH1~3 OCREF_CLR 입력을 COMP3 출력으로 연결
+ */
+static void Protect_InitOCrefClear(void)
+{
+    TIM_ClearInputConfigTypeDef sClearInputConfig = {0};
+
+    sClearInputConfig.ClearInputState = ENABLE;
+    sClearInputConfig.ClearInputSource = TIM_CLEARINPUTSOURCE_COMP3;
+
+    if (HAL_TIM_ConfigOCrefClear(pHTimPwm, &sClearInputConfig, TIM_CHANNEL_1) != HAL_OK ||
+        HAL_TIM_ConfigOCrefClear(pHTimPwm, &sClearInputConfig, TIM_CHANNEL_2) != HAL_OK ||
+        HAL_TIM_ConfigOCrefClear(pHTimPwm, &sClearInputConfig, TIM_CHANNEL_3) != HAL_OK)
+    {
+        Error_Handler();
+    }
+}
+
+/**
+ * @brief ADC AWD1 양방향 윈도우 설정 (변환 시작 전)
+ */
+static void Protect_InitAWD(ADC_HandleTypeDef *hadc, uint32_t channel)
+{
+    ADC_AnalogWDGConfTypeDef sAwd = {0};
+
+    sAwd.WatchdogNumber = ADC_ANALOGWATCHDOG_1;
+    sAwd.WatchdogMode = ADC_ANALOGWATCHDOG_SINGLE_REG;
+    sAwd.Channel = channel;
+    sAwd.ITMode = ENABLE;
+    sAwd.HighThreshold = CURR_TO_CODE(PROTECT_OC_SW_A);
+    sAwd.LowThreshold = CURR_TO_CODE(-PROTECT_OC_SW_A);
+    sAwd.FilteringConfig = ADC_AWD_FILTERING_2SAMPLES;
+
+    if (HAL_ADC_AnalogWDGConfig(hadc, &sAwd) != HAL_OK)
+    {
+        Error_Handler();
+    }
+}
+
+/* ============================================================
+ * 고장 원인 판정
+ * ============================================================ */
+
+/**
+ * @brief 현재도 유지 중인 고장 원인 (해제 가능 여부 판단용)
+ */
+static uint16_t Protect_GetActive(void)
+{
+    uint16_t active = FAULT_NONE;
+    Sense_State_t *pSense = Sense_GetState();
+
+    if (READ_BIT(COMP3->CSR, COMP_CSR_VALUE)) active |= FAULT_OC_HW;
+
+    if (pSense->raw_ia >= CURR_TO_CODE(PROTECT_OC_SW_A) ||
+        pSense->raw_ia <= CURR_TO_CODE(-PROTECT_OC_SW_A))
+        active |= FAULT_OC_SW_A;
+
+    if (pSense->raw_ib >= CURR_TO_CODE(PROTECT_OC_SW_A) ||
+        pSense->raw_ib <= CURR_TO_CODE(-PROTECT_OC_SW_A))
+        active |= FAULT_OC_SW_B;
+
+    if (pSense->vbus_filt > PROTECT_VBUS_OV_V) active |= FAULT_VBUS_OV;
+
+    return active;
+}
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+/**
+ * @brief 즉시 출력 차단 (Error_Handler 등에서 직접 호출 가능)
+ */
+void Protect_Shutdown(void)
+{
+    // 드라이버 EN 을 가장 먼저 LOW (BSRR 단일 쓰기)
+    GPO_DRIVER_EN_GPIO_Port->BSRR = (uint32_t)GPO_DRIVER_EN_Pin << 16;
+
+    SVPWM_Stop();
+
+    // 보호 태스크 즉시 릴리스
+    Sched_Signal(SCHED_TASK_PROTECT);
+}
+
+/**
+ * @brief 보호 회로 초기화 (Sense_Init 이전, ADC 변환 시작 전에 호출)
+ * @param htim_pwm  PWM 타이머 (TIM3) 핸들
+ * @param hadc_a    A상 전류 ADC (ADC1) 핸들
+ * @param hadc_b    B상 전류 ADC (ADC2) 핸들
+ */
+void Protect_Init(TIM_HandleTypeDef *htim_pwm, ADC_HandleTypeDef *hadc_a, ADC_HandleTypeDef *hadc_b)
+{
+    pHTimPwm = htim_pwm;
+    pHAdcA = hadc_a;
+    pHAdcB = hadc_b;
+    run_cmd = 0;
+
+    Fault_Init(Protect_Shutdown);
+
+    Protect_InitDAC(CURR_TO_CODE(PROTECT_OC_HW_A));
+    Protect_InitCOMP();
+    Protect_InitOCrefClear();
+
+    Protect_InitAWD(pHAdcA, ADC_CHANNEL_1);
+    Protect_InitAWD(pHAdcB, ADC_CHANNEL_17);
+}
+
+/**
+ * @brief 버스 전압 검사 (제어 주기마다 호출)
+ * @param vbus  버스 전압 [V]
+ */
+CCMRAM_FUNC void Protect_CheckVbus(float vbus)
+{
+    if (vbus > PROTECT_VBUS_OV_V)
+        Fault_Raise(FAULT_VBUS_OV, HAL_GetTick());
+    else if (DRIVER_IS_ENABLED() && vbus < PROTECT_VBUS_UV_V)
+        Fault_Raise(FAULT_VBUS_UV, HAL_GetTick());
+}
+
+/**
+ * @brief 고장 해제 요청 (현재 원인이 남아 있으면 거부)
+ * @return 1: 해제 접수, 0: 거부
+ */
+uint8_t Protect_ClearFault(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint8_t ret = Fault_Clear(Protect_GetActive(), HAL_GetTick());
+    __set_PRIMASK(primask);
+
+    return ret;
+}
+
+/**
+ * @brief 운전 지령 설정 (RUN: 드라이버 활성, STOP: 비활성) - 지령은 고장 해제 후에도 유지
+ * @param run  1: RUN, 0: STOP
+ * @return 1: 적용, 0: 거부 (고장 중 RUN)
+ */
+uint8_t Protect_SetRun(uint8_t run)
+{
+    // 검사와 EN 쓰기 사이에 고장 ISR 이 끼어들어 차단을 되돌리지 않도록
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint8_t ok = (!run || Fault_IsOk()) ? 1u : 0u;
+    if (ok)
+    {
+        run_cmd = run ? 1u : 0u;
+        HAL_GPIO_WritePin(GPO_DRIVER_EN_GPIO_Port, GPO_DRIVER_EN_Pin, run ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    }
+    __set_PRIMASK(primask);
+
+    return ok;
+}
+
+/**
+ * @brief 운전 지령 반환
+ * @return 1: RUN, 0: STOP
+ */
+uint8_t Protect_IsRun(void)
+{
+    return run_cmd;
+}
+
+/**
+ * @brief 주기 처리 (메인 루프) - HOLDOFF 경과 후 보호 재무장, RUN 지령이면 드라이버 재활성
+ */
+void Protect_Process(void)
+{
+    // HOLDOFF → OK 검사, 전이, EN 쓰기를 한 구간에서 (사이에 트립하면 EN 을 다시 켜게 됨)
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint8_t was_ok = Fault_IsOk();
+
+    Fault_Process(HAL_GetTick());
+
+    if (!was_ok && Fault_IsOk())
+    {
+        // AWD 재무장 (트립 시 인터럽트 반복을 막기 위해 꺼 두었음)
+        __HAL_ADC_CLEAR_FLAG(pHAdcA, ADC_FLAG_AWD1);
+        __HAL_ADC_CLEAR_FLAG(pHAdcB, ADC_FLAG_AWD1);
+        __HAL_ADC_ENABLE_IT(pHAdcA, ADC_IT_AWD1);
+        __HAL_ADC_ENABLE_IT(pHAdcB, ADC_IT_AWD1);
+
+        if (run_cmd)
+            HAL_GPIO_WritePin(GPO_DRIVER_EN_GPIO_Port, GPO_DRIVER_EN_Pin, GPIO_PIN_SET);
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief COMP3 EXTI 인터럽트 처리 (COMP1_2_3_IRQHandler 에서 호출)
+ */
+void Protect_COMP_IRQHandler(void)
+{
+    if (READ_BIT(EXTI->PR1, COMP3_EXTI_LINE))
+    {
+        WRITE_REG(EXTI->PR1, COMP3_EXTI_LINE);
+        Fault_Raise(FAULT_OC_HW, HAL_GetTick());
+    }
+}
+
+/**
+ * @brief ADC 아날로그 워치독 콜백 (ADC1_2 IRQ)
+ */
+void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef *hadc)
+{
+    // 연속 변환 중에는 매 샘플마다 재발생하므로 해제 전까지 끈다
+    __HAL_ADC_DISABLE_IT(hadc, ADC_IT_AWD1);
+
+    Fault_Raise((hadc == pHAdcA) ? FAULT_OC_SW_A : FAULT_OC_SW_B, HAL_GetTick());
+}
@@ -0,0 +1,211 @@
+/**
+ * @file    sched.c
+ * @brief   협조형 마감 시각 스케줄러 구현
+ *
+ *  - 릴리스  : 주기 태스크는 release 시각 도달 시, 이벤트 태스크는 Sched_Signal 시
+ *              준비 상태가 되고 마감 시각 due = 릴리스 + deadline_ms 가 정해진다.
+ *  - 선택    : 준비된 태스크 중 due 가 가장 이른 것 1개를 실행 (EDF, 비선점)
+ *  - 대기    : 준비된 태스크가 없으면 WFI. SysTick(1ms)/UART/DMA 인터럽트로 깨어난다.
+ *              이벤트 확인과 WFI 사이의 경합은 PRIMASK 로 막는다
+ *              (PRIMASK=1 에서도 대기 중인 인터럽트가 있으면 WFI 는 즉시 복귀).
+ *
+ * 시간 기준은 HAL tick [ms], 실행 시간은 DWT 사이클. 제어 ISR(TIM6)은 항상
+ * 메인 루프를 선점하므로 태스크 실행 시간은 ISR 시간을 포함한다.
+ * WFI 구간은 cpu_load 의 IDLE 문맥으로 집계된다.
+ */
+
+#include "sched.h"
+#include "dwt.h"
+#include "cpu_load.h"
+#include <stddef.h>
+#include <string.h>
+
+typedef struct {
+    const char     *name;
+    Sched_TaskFn_t  fn;
+    uint32_t        period_ms;
+    uint32_t        deadline_ms;
+    uint32_t        release_ms;     // 다음 주기 릴리스 시각
+    uint32_t        ready_ms;       // 준비 상태가 된 시각
+    uint32_t        due_ms;         // 현재 릴리스의 마감 시각
+    volatile uint8_t event;         // ISR → 메인 루프 (바이트 쓰기, 경합 없음)
+    uint8_t         ready;
+} Sched_Task_t;
+
+static Sched_Task_t  tasks[SCHED_TASK_COUNT];
+static Sched_Stats_t stats[SCHED_TASK_COUNT];
+
+/* ============================================================
+ * Private 함수
+ * ============================================================ */
+
+/**
+ * @brief 준비 상태로 전환 (이미 준비된 경우 마감 시각 유지)
+ */
+static inline void Sched_Ready(Sched_Task_t *t, uint32_t now)
+{
+    if (t->ready) return;
+    t->ready = 1;
+    t->ready_ms = now;
+    t->due_ms = now + t->deadline_ms;
+}
+
+/**
+ * @brief 주기/이벤트 릴리스 처리
+ */
+static void Sched_Release(uint32_t now)
+{
+    for (uint32_t i = 0; i < SCHED_TASK_COUNT; i++)
+    {
+        Sched_Task_t *t = &tasks[i];
+        if (t->fn == NULL) continue;
+
+        if (t->event)
+        {
+            t->event = 0;
+            stats[i].events++;
+            Sched_Ready(t, now);
+        }
+
+        if (t->period_ms != 0u && (int32_t)(now - t->release_ms) >= 0)
+        {
+            Sched_Ready(t, now);
+            t->release_ms += t->period_ms;
+
+            // 한 주기 이상 밀렸으면 누적 실행하지 않고 다음 주기로 재정렬
+            if ((int32_t)(now - t->release_ms) >= 0)
+            {
+                stats[i].skipped += (now - t->release_ms) / t->period_ms + 1u;
+                t->release_ms = now + t->period_ms;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 대기 중인 이벤트 존재 여부 (PRIMASK=1 상태에서 호출)
+ */
+static uint8_t Sched_EventPending(void)
+{
+    for (uint32_t i = 0; i < SCHED_TASK_COUNT; i++)
+    {
+        if (tasks[i].event) return 1;
+    }
+    return 0;
+}
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+/**
+ * @brief 스케줄러 초기화 (DWT 활성화, 태스크 테이블 비우기)
+ */
+void Sched_Init(void)
+{
+    DWT_Init();
+    memset(tasks, 0, sizeof(tasks));
+    Sched_ResetStats();
+}
+
+/**
+ * @brief 태스크 등록
+ * @param id           태스크 ID
+ * @param name         이름 (디버깅용)
+ * @param fn           태스크 함수
+ * @param period_ms    주기 [ms] (0: 이벤트 전용)
+ * @param deadline_ms  릴리스 후 완료 마감 [ms] (준비된 태스크 중 마감이 가장 이른 것부터 실행)
+ */
+void Sched_Register(Sched_TaskId_t id, const char *name, Sched_TaskFn_t fn,
+                    uint32_t period_ms, uint32_t deadline_ms)
+{
+    if (id >= SCHED_TASK_COUNT) return;
+
+    Sched_Task_t *t = &tasks[id];
+    t->name = name;
+    t->period_ms = period_ms;
+    t->deadline_ms = deadline_ms;
+    t->release_ms = HAL_GetTick();
+    t->ready = 0;
+    t->fn = fn;
+}
+
+/**
+ * @brief 이벤트 릴리스 요청 (ISR 에서 호출 가능)
+ * @param id  태스크 ID
+ */
+void Sched_Signal(Sched_TaskId_t id)
+{
+    if (id < SCHED_TASK_COUNT)
+        tasks[id].event = 1;
+}
+
+/**
+ * @brief 메인 루프에서 반복 호출 - 준비된 태스크 1개 실행, 없으면 WFI 대기
+ */
+void Sched_Poll(void)
+{
+    uint32_t now = HAL_GetTick();
+    Sched_Release(now);
+
+    // 마감 시각이 가장 이른 준비 태스크
+    Sched_Task_t *pick = NULL;
+    uint32_t pick_id = 0;
+    for (uint32_t i = 0; i < SCHED_TASK_COUNT; i++)
+    {
+        Sched_Task_t *t = &tasks[i];
+        if (!t->ready) continue;
+        if (pick == NULL || (int32_t)(t->due_ms - pick->due_ms) < 0)
+        {
+            pick = t;
+            pick_id = i;
+        }
+    }
+
+    if (pick == NULL)
+    {
+        // 다음 인터럽트까지 대기 (최대 SysTick 1ms)
+        __disable_irq();
+        if (!Sched_EventPending())
+        {
+            CPU_LOAD_ENTER(CPU_CTX_IDLE);
+            __DSB();
+            __WFI();
+            CPU_LOAD_EXIT();
+        }
+        __enable_irq();
+        return;
+    }
+
+    Sched_Stats_t *s = &stats[pick_id];
+    uint32_t wait = now - pick->ready_ms;
+    if (wait > s->max_wait_ms) s->max_wait_ms = wait;
+
+    pick->ready = 0;
+    uint32_t t0 = DWT_GetCycles();
+    pick->fn();
+    uint32_t cyc = DWT_GetCycles() - t0;
+
+    s->runs++;
+    s->last_cyc = cyc;
+    s->total_cyc += cyc;
+    if (cyc > s->max_cyc) s->max_cyc = cyc;
+    if ((int32_t)(HAL_GetTick() - pick->due_ms) > 0) s->late++;
+}
+
+/**
+ * @brief 통계 초기화
+ */
+void Sched_ResetStats(void)
+{
+    memset(stats, 0, sizeof(stats));
+}
+
+/**
+ * @brief 태스크 통계 반환 (디버깅용)
+ * @param id  태스크 ID
+ */
+Sched_Stats_t* Sched_GetStats(Sched_TaskId_t id)
+{
+    return (id < SCHED_TASK_COUNT) ? &stats[id] : NULL;
+}
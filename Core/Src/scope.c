@@ -0,0 +1,317 @@
+/**
+ * @file    scope.c
+ * @brief   온타겟 오실로스코프 구현
+ *
+ * 기록: 채널마다 (정렬 워드 주소, shift, mask) 를 미리 계산해 두고
+ *       ISR 에서는 dst[i] = (*addr[i] >> shift[i]) & mask[i] 만 수행한다
+ *       (분기 없음, 채널당 수 사이클). float 은 비트 그대로 저장한다.
+ *
+ * 버퍼: scope_buf 를 depth × nch 원형 버퍼로 사용 (샘플 단위 인덱스).
+ *
+ *   ARMED ── pre 샘플 채움 + 트리거 ──▶ TRIGGERED ── depth-pre 샘플 ──▶ DONE
+ *
+ * 업로드: Scope_StartUpload() 후 메인 루프에서 TELEM_TYPE_SCOPE 프레임
+ *         (uint16 word_offset + 최대 14 word, 가장 오래된 샘플부터 채널 순)
+ */
+
+#include "scope.h"
+#include "svpwm.h"
+#include "sense.h"
+#include "fault.h"
+#include "mech_id.h"
+#include "telemetry.h"
+#include "app_config.h"
+#include <string.h>
+
+#define UPLOAD_WORDS    14u
+
+/* 소스 정의 (Scope_Init 에서 주소 채움) */
+typedef struct {
+    const volatile void *addr;
+    uint8_t size;           // 1, 2, 4 [byte]
+    uint8_t is_float;
+} Scope_SrcDef_t;
+
+static Scope_SrcDef_t src_def[SCOPE_SRC_COUNT];
+
+/* 캡처 버퍼 */
+static uint32_t scope_buf[SCOPE_BUF_WORDS];
+
+/* 채널 설정 (ISR 에서 읽음, IDLE/DONE 에서만 변경) */
+static const volatile uint32_t *ch_addr[SCOPE_MAX_CH];
+static uint32_t ch_shift[SCOPE_MAX_CH];
+static uint32_t ch_mask[SCOPE_MAX_CH];
+static uint8_t  ch_src[SCOPE_MAX_CH];
+static uint32_t nch = 0;
+static uint32_t depth = 0;
+static uint32_t pre = 0;
+static uint32_t decim = 1;
+
+/* 트리거 */
+static uint32_t trig_mode = SCOPE_TRIG_NONE;
+static uint32_t trig_ch = 0;
+static float    trig_level = 0.0f;
+static float    trig_prev = 0.0f;
+
+/* 기록 상태 */
+static volatile uint32_t state = SCOPE_ST_IDLE;
+static uint32_t wr_idx = 0;
+static uint32_t filled = 0;
+static uint32_t post_left = 0;
+static uint32_t decim_cnt = 0;
+static volatile uint32_t start_idx = 0;
+
+/* 업로드 */
+static uint8_t  uploading = 0;
+static uint32_t up_word = 0;
+
+static float Scope_ToFloat(uint32_t ch, uint32_t raw);
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+/**
+ * @brief 소스 주소 테이블 구성 (SVPWM_Init, Sense_Init 이후)
+ */
+void Scope_Init(void)
+{
+    SVPWM_State_t *pPwm = SVPWM_GetState();
+    Sense_State_t *pSense = Sense_GetState();
+    MechId_Signal_t *pMech = MechId_GetSignal();
+
+    src_def[SCOPE_SRC_ANGLE]  = (Scope_SrcDef_t){ &g_angle,        4, 1 };
+    src_def[SCOPE_SRC_SECTOR] = (Scope_SrcDef_t){ &pPwm->sector,   1, 0 };
+    src_def[SCOPE_SRC_T1]     = (Scope_SrcDef_t){ &pPwm->T1,       4, 1 };
+    src_def[SCOPE_SRC_T2]     = (Scope_SrcDef_t){ &pPwm->T2,       4, 1 };
+    src_def[SCOPE_SRC_T0]     = (Scope_SrcDef_t){ &pPwm->T0,       4, 1 };
+    src_def[SCOPE_SRC_CCR_A]  = (Scope_SrcDef_t){ &pPwm->CCR_A,    2, 0 };
+    src_def[SCOPE_SRC_CCR_B]  = (Scope_SrcDef_t){ &pPwm->CCR_B,    2, 0 };
+    src_def[SCOPE_SRC_CCR_C]  = (Scope_SrcDef_t){ &pPwm->CCR_C,    2, 0 };
+    src_def[SCOPE_SRC_IA]     = (Scope_SrcDef_t){ &pSense->ia,     4, 1 };
+    src_def[SCOPE_SRC_IB]     = (Scope_SrcDef_t){ &pSense->ib,     4, 1 };
+    src_def[SCOPE_SRC_VBUS]   = (Scope_SrcDef_t){ &pSense->vbus,   4, 1 };
+    src_def[SCOPE_SRC_RAW_IA] = (Scope_SrcDef_t){ &pSense->raw_ia, 2, 0 };
+    src_def[SCOPE_SRC_RAW_IB] = (Scope_SrcDef_t){ &pSense->raw_ib, 2, 0 };
+    src_def[SCOPE_SRC_MECH_SPEED] = (Scope_SrcDef_t){ &pMech->speed, 4, 1 };
+    src_def[SCOPE_SRC_MECH_IQ]    = (Scope_SrcDef_t){ &pMech->iq,    4, 1 };
+
+    // 기본: CCR_A/B/C, 섹터, 전류 A/B
+    static const uint8_t def_ch[] = {
+        SCOPE_SRC_CCR_A, SCOPE_SRC_CCR_B, SCOPE_SRC_CCR_C,
+        SCOPE_SRC_SECTOR, SCOPE_SRC_IA, SCOPE_SRC_IB
+    };
+    Scope_Config(def_ch, sizeof(def_ch), 1, 25);
+}
+
+/**
+ * @brief 채널/간격/프리트리거 설정 (IDLE/DONE 에서만)
+ * @param pSrc     소스 ID 배열 (Scope_Src_t)
+ * @param n        채널 수 (1 ~ SCOPE_MAX_CH)
+ * @param dec      N 틱마다 1 샘플 (1 이상)
+ * @param pre_pct  프리트리거 비율 [%] (0 ~ 100)
+ * @return 1: 적용, 0: 인자 오류 또는 캡처 중
+ */
+uint8_t Scope_Config(const uint8_t *pSrc, uint32_t n, uint32_t dec, uint32_t pre_pct)
+{
+    if (state >= SCOPE_ST_ARMED) return 0;
+    if (n == 0 || n > SCOPE_MAX_CH || dec == 0 || pre_pct > 100u) return 0;
+
+    for (uint32_t i = 0; i < n; i++)
+        if (pSrc[i] >= SCOPE_SRC_COUNT) return 0;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const Scope_SrcDef_t *d = &src_def[pSrc[i]];
+        uintptr_t a = (uintptr_t)d->addr;
+
+        // 정렬 워드를 읽고 필드 위치만큼 shift (little-endian)
+        ch_addr[i]  = (const volatile uint32_t *)(a & ~(uintptr_t)3u);
+        ch_shift[i] = (uint32_t)(a & 3u) * 8u;
+        ch_mask[i]  = (d->size >= 4u) ? 0xFFFFFFFFu : ((1u << (d->size * 8u)) - 1u);
+        ch_src[i]   = pSrc[i];
+    }
+
+    nch = n;
+    depth = SCOPE_BUF_WORDS / n;
+    pre = (depth - 1u) * pre_pct / 100u;
+    decim = dec;
+    if (trig_ch >= n) trig_ch = 0;
+
+    state = SCOPE_ST_IDLE;
+    uploading = 0;
+    return 1;
+}
+
+/**
+ * @brief 트리거 설정
+ * @param mode   Scope_TrigMode_t
+ * @param ch     트리거 채널 (설정된 채널 순서 인덱스)
+ * @param level  기준값 (채널 단위, 정수 소스는 정수값으로 비교)
+ * @return 1: 적용, 0: 인자 오류
+ */
+uint8_t Scope_SetTrigger(uint32_t mode, uint32_t ch, float level)
+{
+    if (state >= SCOPE_ST_ARMED) return 0;
+    if (mode > SCOPE_TRIG_FAULT || ch >= nch) return 0;
+
+    trig_mode = mode;
+    trig_ch = ch;
+    trig_level = level;
+    return 1;
+}
+
+/**
+ * @brief 캡처 시작 (ARMED)
+ */
+uint8_t Scope_Arm(void)
+{
+    if (nch == 0) return 0;
+
+    state = SCOPE_ST_IDLE;      // ISR 기록 정지 후 초기화
+    uploading = 0;
+    wr_idx = 0;
+    filled = 0;
+    decim_cnt = 0;
+    post_left = 0;
+    trig_prev = trig_level;     // 첫 샘플에서 에지 오검출 방지
+    __DMB();
+    state = SCOPE_ST_ARMED;
+    return 1;
+}
+
+/**
+ * @brief 캡처 중지 (IDLE)
+ */
+void Scope_Stop(void)
+{
+    state = SCOPE_ST_IDLE;
+    uploading = 0;
+}
+
+/**
+ * @brief 제어 틱마다 호출 - 채널 기록 및 트리거 판정 (제어 ISR)
+ */
+CCMRAM_FUNC void Scope_Record(void)
+{
+    if (state < SCOPE_ST_ARMED) return;
+    if (++decim_cnt < decim) return;
+    decim_cnt = 0;
+
+    uint32_t *dst = &scope_buf[wr_idx * nch];
+    for (uint32_t i = 0; i < nch; i++)
+        dst[i] = (*ch_addr[i] >> ch_shift[i]) & ch_mask[i];
+
+    uint32_t cur = wr_idx;
+    wr_idx = (wr_idx + 1u >= depth) ? 0 : wr_idx + 1u;
+
+    if (state == SCOPE_ST_TRIGGERED)
+    {
+        if (--post_left == 0) state = SCOPE_ST_DONE;
+        return;
+    }
+
+    // ARMED: 프리트리거 구간이 채워진 뒤에만 트리거 판정
+    if (filled < pre)
+    {
+        filled++;
+        if (trig_mode == SCOPE_TRIG_RISING || trig_mode == SCOPE_TRIG_FALLING)
+            trig_prev = Scope_ToFloat(trig_ch, dst[trig_ch]);
+        return;
+    }
+
+    uint8_t hit = 0;
+    switch (trig_mode)
+    {
+    case SCOPE_TRIG_NONE:
+        hit = 1;
+        break;
+    case SCOPE_TRIG_FAULT:
+        hit = !Fault_IsOk();
+        break;
+    default:
+    {
+        float v = Scope_ToFloat(trig_ch, dst[trig_ch]);
+        if (trig_mode == SCOPE_TRIG_LEVEL)        hit = (v >= trig_level);
+        else if (trig_mode == SCOPE_TRIG_RISING)  hit = (trig_prev < trig_level) && (v >= trig_level);
+        else                                      hit = (trig_prev > trig_level) && (v <= trig_level);
+        trig_prev = v;
+        break;
+    }
+    }
+
+    if (!hit) return;
+
+    start_idx = (cur + depth - pre) % depth;
+    post_left = depth - pre - 1u;
+    state = (post_left == 0) ? SCOPE_ST_DONE : SCOPE_ST_TRIGGERED;
+}
+
+/**
+ * @brief 캡처 상태 반환
+ */
+void Scope_GetInfo(Scope_Info_t *pInfo)
+{
+    pInfo->state = (uint8_t)state;
+    pInfo->nch   = (uint8_t)nch;
+    pInfo->depth = (uint16_t)depth;
+    pInfo->pre   = (uint16_t)pre;
+    pInfo->start = (uint16_t)start_idx;
+    pInfo->decim = decim;
+}
+
+/**
+ * @brief 캡처 데이터 업로드 시작 (DONE 상태에서, 텔레메트리 프레임으로 전송)
+ */
+uint8_t Scope_StartUpload(void)
+{
+    if (state != SCOPE_ST_DONE) return 0;
+
+    up_word = 0;
+    uploading = 1;
+    return 1;
+}
+
+/**
+ * @brief 메인 루프 처리 - 업로드 프레임을 텔레메트리 링 여유만큼 전송
+ */
+void Scope_Process(void)
+{
+    if (!uploading) return;
+
+    uint32_t total = depth * nch;
+    while (up_word < total)
+    {
+        uint8_t frame[2u + UPLOAD_WORDS * 4u];
+        uint32_t n = total - up_word;
+        if (n > UPLOAD_WORDS) n = UPLOAD_WORDS;
+
+        frame[0] = (uint8_t)(up_word & 0xFFu);
+        frame[1] = (uint8_t)(up_word >> 8);
+        for (uint32_t k = 0; k < n; k++)
+        {
+            uint32_t w = up_word + k;
+            uint32_t s = (start_idx + w / nch) % depth;
+            memcpy(&frame[2u + k * 4u], &scope_buf[s * nch + w % nch], 4);
+        }
+
+        if (!Telem_Send(TELEM_TYPE_SCOPE, frame, 2u + n * 4u))
+            return;     // 링 가득 참 - 다음 루프에서 이어서
+
+        up_word += n;
+    }
+    uploading = 0;
+}
+
+/* ============================================================
+ * Private 함수
+ * ============================================================ */
+
+/**
+ * @brief 기록값 → float (트리거 비교용)
+ */
+CCMRAM_FUNC static float Scope_ToFloat(uint32_t ch, uint32_t raw)
+{
+    union { uint32_t u; float f; } v = { raw };
+    return src_def[ch_src[ch]].is_float ? v.f : (float)raw;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file    sense.c
+ * @brief   ADC 측정 구현 - 듀얼 ADC DMA 샘플 변환 및 버스 전압 필터
+ *
+ * ADC1/ADC2 는 Regular Simultaneous 듀얼 모드, 연속 변환으로 동작하며
+ * DMA(원형)가 공통 데이터 레지스터(CDR)를 2워드 버퍼에 계속 덮어쓴다.
+ *
+ *   adc_dma_buf[0] = ADC1 rank1 (CurrA) | ADC2 rank1 (CurrB) << 16
+ *   adc_dma_buf[1] = ADC1 rank2 (Vbus)  | ADC2 rank2 (RESV)  << 16
+ *
+ * 제어 루프는 Sense_Update()로 최신 값을 읽기만 하므로 변환 완료 인터럽트는 쓰지 않는다.
+ *
+ * 단일 션트 (SVPWM_SINGLE_SHUNT): A1C1 은 DC 링크 전류. ADC1 주입 그룹 2 랭크 (불연속) 가
+ * TIM3 CC4 에서 PWM 주기마다 두 번 변환하고 (정규 변환은 그동안 중단 후 재개), TIM3 업데이트
+ * ISR 이 Sense_ShuntLatch 로 그 주기 상 배치와 함께 한 워드에 묶어 둔다.
+ */
+
+#include "sense.h"
+#include "svpwm_core.h"
+#include "app_config.h"
+#include "main.h"
+
+/* DMA 대상 버퍼 */
+static volatile uint32_t adc_dma_buf[2];
+
+#if SVPWM_SINGLE_SHUNT
+/* 단일 션트 래치: 샘플 1 (12bit) | 샘플 2 << 12 | 배치 << 24 (제어 루프가 한 번에 읽음) */
+static ADC_HandleTypeDef *pHAdcShunt = NULL;
+static volatile uint32_t shunt_latch = 0;
+static uint8_t  shunt_restart = 0;              // 정지 대기 초과 - 다음 래치에서 재시작
+static volatile uint32_t shunt_stop_timeouts = 0;
+#endif
+
+/* 측정 상태 */
+static Sense_State_t sense_state;
+
+/* ADC 카운트 → 전압 [V] */
+#define ADC_TO_VOLT     (ADC_VREF / ADC_FULL_SCALE)
+
+#if SVPWM_SINGLE_SHUNT
+/**
+ * @brief 단일 션트 주입 그룹: 션트 채널 2 랭크, 트리거마다 1 랭크 (TIM3 CC4 상승)
+ */
+static void Sense_ShuntInit(ADC_HandleTypeDef *hadc)
+{
+    ADC_InjectionConfTypeDef sInj = {0};
+
+    sInj.InjectedChannel = SENSE_SHUNT_CHANNEL;
+    sInj.InjectedSamplingTime = SENSE_SHUNT_SMP;
+    sInj.InjectedSingleDiff = ADC_SINGLE_ENDED;
+    sInj.InjectedOffsetNumber = ADC_OFFSET_NONE;
+    sInj.InjectedOffset = 0;
+    sInj.InjectedNbrOfConversion = 2;
+    sInj.InjectedDiscontinuousConvMode = ENABLE;
+    sInj.AutoInjectedConv = DISABLE;
+    sInj.QueueInjectedContext = DISABLE;
+    sInj.ExternalTrigInjecConv = ADC_EXTERNALTRIGINJEC_T3_CC4;
+    sInj.ExternalTrigInjecConvEdge = ADC_EXTERNALTRIGINJECCONV_EDGE_RISING;
+    sInj.InjecOversamplingMode = DISABLE;
+
+    sInj.InjectedRank = ADC_INJECTED_RANK_1;
+    if (HAL_ADCEx_InjectedConfigChannel(hadc, &sInj) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    sInj.InjectedRank = ADC_INJECTED_RANK_2;
+    if (HAL_ADCEx_InjectedConfigChannel(hadc, &sInj) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    pHAdcShunt = hadc;
+}
+#endif
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+/**
+ * @brief ADC 캘리브레이션 및 듀얼 모드 DMA 변환 시작
+ * @param hadc_master  ADC1 (듀얼 모드 마스터) 핸들 포인터
+ * @param hadc_slave   ADC2 (듀얼 모드 슬레이브) 핸들 포인터
+ */
+void Sense_Init(ADC_HandleTypeDef *hadc_master, ADC_HandleTypeDef *hadc_slave)
+{
+    sense_state.ia = 0;
+    sense_state.ib = 0;
+    sense_state.vbus = 0;
+    sense_state.vbus_filt = 0;
+    sense_state.vbus_inv = 1.0f / VBUS_MIN_V;
+
+    // 변환 시작 전 캘리브레이션 (ADC 비활성 상태에서만 가능)
+    HAL_ADCEx_Calibration_Start(hadc_master, ADC_SINGLE_ENDED);
+    HAL_ADCEx_Calibration_Start(hadc_slave, ADC_SINGLE_ENDED);
+
+#if SVPWM_SINGLE_SHUNT
+    Sense_ShuntInit(hadc_master);
+#endif
+
+    HAL_ADCEx_MultiModeStart_DMA(hadc_master, (uint32_t *)adc_dma_buf, 2);
+#if SVPWM_SINGLE_SHUNT
+    // 듀얼 정규 동시 모드에서도 주입 변환은 ADC 별로 독립 (TIM3 CC4 대기)
+    HAL_ADCEx_InjectedStart(hadc_master);
+#endif
+
+    // 연속 변환이라 HT/TC 인터럽트가 수 us 마다 발생 → 폴링 방식이므로 끈다
+    __HAL_DMA_DISABLE_IT(hadc_master->DMA_Handle, DMA_IT_TC | DMA_IT_HT);
+
+    // 첫 샘플로 필터 초기값 설정 (시동 시 램프 방지)
+    HAL_Delay(1);
+    Sense_Update();
+    sense_state.vbus = sense_state.vbus_filt =
+        (float)sense_state.raw_vbus * ADC_TO_VOLT * VBUS_DIV_GAIN;
+}
+
+/**
+ * @brief 최신 DMA 샘플로 전류/전압 갱신 (제어 주기마다 호출)
+ */
+CCMRAM_FUNC void Sense_Update(void)
+{
+    uint32_t w0 = adc_dma_buf[0];
+    uint32_t w1 = adc_dma_buf[1];
+
+    sense_state.raw_ia   = (uint16_t)(w0 & 0xFFFFu);
+    sense_state.raw_ib   = (uint16_t)(w0 >> 16);
+    sense_state.raw_vbus = (uint16_t)(w1 & 0xFFFFu);
+    sense_state.raw_resv = (uint16_t)(w1 >> 16);
+
+    // 상전류: (Vout - Voffset) / (Rshunt * Gain)
+    const float amp_per_volt = 1.0f / (CURR_SHUNT_OHM * CURR_AMP_GAIN);
+#if SVPWM_SINGLE_SHUNT
+    // DC 링크: 샘플 1 = +i(p1), 샘플 2 = -i(p2), 나머지 상 = -(합). 유효 샘플이 없으면 직전 값 유지
+    uint32_t s = shunt_latch;
+    if (s & ((uint32_t)SVPWM_SHUNT_VALID << 24))
+    {
+        float i1 = ((float)(s & 0xFFFu) * ADC_TO_VOLT - CURR_OFFSET_V) * amp_per_volt;
+        float i2 = ((float)((s >> 12) & 0xFFFu) * ADC_TO_VOLT - CURR_OFFSET_V) * amp_per_volt;
+        uint32_t p1 = (s >> 24) & 3u, p2 = (s >> 26) & 3u;
+        float iph[3];
+        iph[p1] = i1;
+        iph[p2] = -i2;
+        iph[3u - p1 - p2] = i2 - i1;
+        sense_state.ia = iph[0];
+        sense_state.ib = iph[1];
+    }
+#else
+    sense_state.ia = ((float)sense_state.raw_ia * ADC_TO_VOLT - CURR_OFFSET_V) * amp_per_volt;
+    sense_state.ib = ((float)sense_state.raw_ib * ADC_TO_VOLT - CURR_OFFSET_V) * amp_per_volt;
+#endif
+
+    // 버스 전압: 고속(피드포워드) / 저속(표시) 1차 IIR
+    float vbus_raw = (float)sense_state.raw_vbus * ADC_TO_VOLT * VBUS_DIV_GAIN;
+    sense_state.vbus      += VBUS_FF_ALPHA  * (vbus_raw - sense_state.vbus);
+    sense_state.vbus_filt += VBUS_LPF_ALPHA * (vbus_raw - sense_state.vbus_filt);
+
+    float v = (sense_state.vbus < VBUS_MIN_V) ? VBUS_MIN_V : sense_state.vbus;
+    sense_state.vbus_inv = 1.0f / v;
+}
+
+#if SVPWM_SINGLE_SHUNT
+/**
+ * @brief 단일 션트 샘플 래치 (TIM3 업데이트 ISR 정점, SVPWM_SINGLE_SHUNT)
+ * @param map  샘플을 만든 PWM 주기의 배치 (SVPWM_Shunt_t.map)
+ *
+ * 두 랭크가 모두 끝났을 때 (JEOS) 만 유효. 트리거가 하나만 변환돼 시퀀스가 어긋났으면
+ * 주입 변환을 멈췄다 다시 시작해 다음 주기를 랭크 1 부터 받는다.
+ * 우선순위 0 ISR 이라 정지 대기는 SENSE_SHUNT_STOP_SPIN 회로 제한하고, 넘기면 세어 두고
+ * 다음 정점에서 JADSTP 가 풀렸을 때 재시작한다 (그 사이 샘플은 무효).
+ */
+CCMRAM_FUNC void Sense_ShuntLatch(uint8_t map)
+{
+    if (pHAdcShunt == NULL) return;
+    ADC_TypeDef *adc = pHAdcShunt->Instance;
+    uint32_t isr = adc->ISR;
+
+    if (shunt_restart)
+    {
+        if (!LL_ADC_INJ_IsStopConversionOngoing(adc))
+        {
+            LL_ADC_INJ_StartConversion(adc);
+            shunt_restart = 0;
+        }
+    }
+    else if ((isr & ADC_ISR_JEOS) && (map & SVPWM_SHUNT_VALID))
+    {
+        shunt_latch = (adc->JDR1 & 0xFFFu) | ((adc->JDR2 & 0xFFFu) << 12) | ((uint32_t)map << 24);
+    }
+    else if ((isr & (ADC_ISR_JEOC | ADC_ISR_JEOS)) == ADC_ISR_JEOC)
+    {
+        LL_ADC_INJ_StopConversion(adc);
+        uint32_t spin = SENSE_SHUNT_STOP_SPIN;
+        while (LL_ADC_INJ_IsStopConversionOngoing(adc) && --spin != 0u) {}
+        if (spin != 0u)
+        {
+            LL_ADC_INJ_StartConversion(adc);
+        }
+        else
+        {
+            shunt_stop_timeouts++;
+            shunt_restart = 1;
+        }
+    }
+    adc->ISR = ADC_ISR_JEOC | ADC_ISR_JEOS;     // rc_w1
+}
+
+/**
+ * @brief 주입 정지 대기 시간 초과 횟수 (디버깅용)
+ */
+uint32_t Sense_GetShuntStopTimeouts(void)
+{
+    return shunt_stop_timeouts;
+}
+#endif
+
+/**
+ * @brief 버스 전압 [V] (저속 필터)
+ */
+CCMRAM_FUNC float Sense_GetVbus(void)
+{
+    return sense_state.vbus_filt;
+}
+
+/**
+ * @brief 전압[V] → 정규화 변조 계수 (1 / Vbus, 리플 피드포워드 포함)
+ *
+ * SVPWM_Run 의 정규화 전압은 Vdc 기준이므로 (선형 영역 |V| ≤ 1/√3)
+ * V_norm = V_volt / Vbus. 고속 필터 값을 써서 버스 리플을 매 주기 보상한다.
+ */
+CCMRAM_FUNC float Sense_GetVbusInv(void)
+{
+    return sense_state.vbus_inv;
+}
+
+/**
+ * @brief 현재 측정 상태 반환 (디버깅용)
+ */
+CCMRAM_FUNC Sense_State_t* Sense_GetState(void)
+{
+    return &sense_state;
+}
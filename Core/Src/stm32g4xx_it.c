@@ -22,6 +22,14 @@
 #include "stm32g4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "protect.h"
+#include "app_config.h"
+#include "isr_latency.h"
+#include "svpwm.h"
+#include "nvm_flash.h"
+#include "cmd.h"
+#include "cpu_load.h"
+#include "bench.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -46,7 +54,8 @@
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN PFP */
-
+/* 제어 ISR 은 CCM SRAM 에 배치 (CONTROL_IN_CCMRAM) */
+CCMRAM_FUNC void TIM6_DAC_IRQHandler(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -56,6 +65,8 @@
 
 /* External variables --------------------------------------------------------*/
 extern DMA_HandleTypeDef hdma_adc1;
+extern DMA_HandleTypeDef hdma_lpuart1_rx;
+extern DMA_HandleTypeDef hdma_lpuart1_tx;
 extern ADC_HandleTypeDef hadc1;
 extern ADC_HandleTypeDef hadc2;
 extern UART_HandleTypeDef hlpuart1;
@@ -74,7 +85,9 @@ extern TIM_HandleTypeDef htim6;
 void NMI_Handler(void)
 {
   /* USER CODE BEGIN NonMaskableInt_IRQn 0 */
-
+  // NVM 영역 읽기 중 ECC 2비트 오류 → 읽기 실패로 처리하고 복귀
+  if (NvmFlash_OnNmi())
+    return;
   /* USER CODE END NonMaskableInt_IRQn 0 */
   /* USER CODE BEGIN NonMaskableInt_IRQn 1 */
    while (1)
@@ -188,11 +201,11 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
-
+  CPU_LOAD_ENTER(CPU_CTX_SYSTICK);
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
-
+  CPU_LOAD_EXIT();
   /* USER CODE END SysTick_IRQn 1 */
 }
 
@@ -217,18 +230,46 @@ void DMA1_Channel1_IRQHandler(void)
   /* USER CODE END DMA1_Channel1_IRQn 1 */
 }
 
+/**
+  * @brief This function handles DMA1 channel2 global interrupt.
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel2_IRQn 0 */
+  CPU_LOAD_ENTER(CPU_CTX_COMMS);
+  /* USER CODE END DMA1_Channel2_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_lpuart1_tx);
+  /* USER CODE BEGIN DMA1_Channel2_IRQn 1 */
+  CPU_LOAD_EXIT();
+  /* USER CODE END DMA1_Channel2_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA1 channel3 global interrupt.
+  */
+void DMA1_Channel3_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel3_IRQn 0 */
+  CPU_LOAD_ENTER(CPU_CTX_COMMS);
+  /* USER CODE END DMA1_Channel3_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_lpuart1_rx);
+  /* USER CODE BEGIN DMA1_Channel3_IRQn 1 */
+  CPU_LOAD_EXIT();
+  /* USER CODE END DMA1_Channel3_IRQn 1 */
+}
+
 /**
   * @brief This function handles ADC1 and ADC2 global interrupt.
   */
 void ADC1_2_IRQHandler(void)
 {
   /* USER CODE BEGIN ADC1_2_IRQn 0 */
-
+  CPU_LOAD_ENTER(CPU_CTX_PROTECT);
   /* USER CODE END ADC1_2_IRQn 0 */
   HAL_ADC_IRQHandler(&hadc1);
   HAL_ADC_IRQHandler(&hadc2);
   /* USER CODE BEGIN ADC1_2_IRQn 1 */
-
+  CPU_LOAD_EXIT();
   /* USER CODE END ADC1_2_IRQn 1 */
 }
 
@@ -238,7 +279,15 @@ void ADC1_2_IRQHandler(void)
 void TIM3_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM3_IRQn 0 */
-
+#if SVPWM_PERIOD_ISR
+  // 주기 확산 / 주기 변경 / 단일 션트: 업데이트 플래그를 직접 처리 (HAL 콜백 경로에는 남기지 않음)
+  // 제어 문맥으로 잡으면 TIM6 오버런 검사와 제어 실행 시간에 섞이므로 따로 집계
+  CPU_LOAD_ENTER(CPU_CTX_PWM);
+  SVPWM_PeriodIRQHandler();
+  CPU_LOAD_EXIT();
+  // TIM3 에서 켜는 인터럽트는 업데이트뿐 → 반주기마다 모든 플래그를 훑는 HAL 디스패치 생략
+  return;
+#endif
   /* USER CODE END TIM3_IRQn 0 */
   HAL_TIM_IRQHandler(&htim3);
   /* USER CODE BEGIN TIM3_IRQn 1 */
@@ -252,11 +301,28 @@ void TIM3_IRQHandler(void)
 void TIM6_DAC_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM6_DAC_IRQn 0 */
+#if LATENCY_MEASURE
+  IsrLat_OnControlEntry();
+#endif
+  CPU_LOAD_ENTER(CPU_CTX_CONTROL);
+  BENCH_ISR_ENTER();
+#if CONTROL_DISPATCH_LEAN
+  // 업데이트 플래그만 확인/클리어 (rc_w0: 0 을 쓴 비트만 클리어)
+  if (TIM6->SR & TIM_SR_UIF)
+  {
+    TIM6->SR = ~(uint32_t)TIM_SR_UIF;
+    OpenLoop_Step();
+  }
+  BENCH_ISR_EXIT();
+  CPU_LOAD_EXIT();
+  return;
+#endif
 
   /* USER CODE END TIM6_DAC_IRQn 0 */
   HAL_TIM_IRQHandler(&htim6);
   /* USER CODE BEGIN TIM6_DAC_IRQn 1 */
-
+  BENCH_ISR_EXIT();
+  CPU_LOAD_EXIT();
   /* USER CODE END TIM6_DAC_IRQn 1 */
 }
 
@@ -266,14 +332,26 @@ void TIM6_DAC_IRQHandler(void)
 void LPUART1_IRQHandler(void)
 {
   /* USER CODE BEGIN LPUART1_IRQn 0 */
+  CPU_LOAD_ENTER(CPU_CTX_COMMS);
+  Cmd_UartIRQHandler();
 
   /* USER CODE END LPUART1_IRQn 0 */
   HAL_UART_IRQHandler(&hlpuart1);
   /* USER CODE BEGIN LPUART1_IRQn 1 */
-
+  CPU_LOAD_EXIT();
   /* USER CODE END LPUART1_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles COMP1, COMP2 and COMP3 interrupts through EXTI lines 21, 22 and 29.
+  */
+void COMP1_2_3_IRQHandler(void)
+{
+  CPU_LOAD_ENTER(CPU_CTX_PROTECT);
+  Protect_COMP_IRQHandler();
+  CPU_LOAD_EXIT();
+}
+
 /* USER CODE END 1 */
@@ -1,19 +1,39 @@
 /**
  * @file    svpwm.c
- * @brief   SVPWM 구현 - 6섹터 스위칭 시간 계산 및 중앙정렬 PWM 출력
+ * @brief   SVPWM 출력 - 오픈루프 제어 스텝, 변조 커널(svpwm_core.c) 호출, 중앙정렬 PWM 갱신
  */
 
 #include "svpwm.h"
+#include "sense.h"
+#include "protect.h"
+#include "app_config.h"
+#include "isr_latency.h"
+#include "fast_trig.h"
+#include "telemetry.h"
+#include "scope.h"
+#include "param.h"
+#include "motor_id.h"
+#include "mech_id.h"
+#include "main.h"
 #include <math.h>
 
 
-/* 오픈루프 제어 변수 */
+/* 오픈루프 제어 변수 (설정값은 파라미터 레지스트리: PARAM_OL_xxx) */
 volatile float g_angle = 0.0f;           // 현재 전기각 [rad]
-volatile float g_omega = 0.0f;           // 목표 각속도 [rad/s]
-volatile float g_voltage = 0.0f;         // 출력 전압 크기 [0~1 정규화]
+volatile float g_omega = 0.0f;           // 목표 각속도 [rad/s] (PARAM_OL_FREQ_HZ 에서 유도)
 
-#define CONTROL_FREQ    10000.0f         // 제어 루프 주파수 [Hz]
-#define DT              (1.0f / CONTROL_FREQ)
+/* 제어 주기 (TIM6 고정, PARAM_CTRL_FREQ_HZ 는 읽기 전용 표시값) */
+#define step_dt         (1.0f / (float)CONTROL_FREQ_HZ)
+
+/* 파라미터에서 유도한 값 (버전이 바뀔 때만 재계산) */
+static uint32_t applied_ver = 0xFFFFFFFFu;
+#if SVPWM_FIXED_PERIOD
+#define pwm_period      ((uint32_t)PWM_PERIOD)              // 고정 주기 (PARAM_PWM_PERIOD 무시)
+#define pwm_scale       ((float)(PWM_PERIOD + 1u))
+#else
+static uint32_t pwm_period = PWM_PERIOD;            // PARAM_PWM_PERIOD (ARR)
+static float    pwm_scale  = (float)(PWM_PERIOD + 1u);   // ON 비율 → CCR 환산 (ARR + 1)
+#endif
 
 
 
@@ -23,6 +43,32 @@ static TIM_HandleTypeDef *pHTim = NULL;
 /* SVPWM 상태 */
 static SVPWM_State_t svpwm_state;
 
+#if SVPWM_PERIOD_ISR
+/* 주기 경계 기록 (확산 / 주기 변경) - 제어 루프가 채우고 TIM3 업데이트 ISR 이 정점에서 기록 */
+static SVPWM_Period_t pwm_next = { .arr = PWM_PERIOD, .span = 0, .lfsr = SVPWM_SPREAD_LFSR_SEED };
+static volatile uint8_t pwm_isr_own = 0;            // 1: ARR/CCR 레지스터는 업데이트 ISR 만 기록
+#if SVPWM_SPREAD
+static uint32_t spread_pct = 0;                     // PARAM_PWM_SPREAD [%]
+#endif
+#if SVPWM_SINGLE_SHUNT
+/* 단일 션트 - 정점에서 다음 주기 배치를 받아 (shunt_nxt) 바닥에서 이번 주기로 (shunt_cur) */
+static const SVPWM_Shunt_t shunt_off = {
+    .trig = { SVPWM_SHUNT_TRIG_OFF, SVPWM_SHUNT_TRIG_OFF }, .map = 0u
+};
+static SVPWM_Shunt_t shunt_nxt, shunt_cur;
+static uint8_t  shunt_smp_map = 0u;                 // 샘플이 끝난 주기의 배치 (다음 정점에서 래치)
+static volatile uint32_t shunt_trig2 = SVPWM_SHUNT_TRIG_OFF;    // DMA → CCR4 (첫 트리거 일치 시)
+static DMA_HandleTypeDef hdma_shunt;
+
+static void SVPWM_ShuntInit(void);
+#endif
+
+static void SVPWM_PeriodArm(void);
+#endif
+#if !SVPWM_FIXED_PERIOD
+static void SVPWM_SetPeriod(uint32_t arr);
+#endif
+
 
 
 
@@ -30,279 +76,319 @@ static SVPWM_State_t svpwm_state;
  * @brief 오픈루프 속도 설정
  * @param freq_hz   전기 주파수 [Hz] (모터 극쌍수에 따라 기계 속도 결정)
  * @param voltage   전압 크기 [0.0 ~ 1.0]
+ * @return 1: 적용, 0: 범위 밖 (레지스트리 변경 없음)
  */
-void OpenLoop_SetSpeed(float freq_hz, float voltage)
+uint8_t OpenLoop_SetSpeed(float freq_hz, float voltage)
 {
-    g_omega = 2.0f * PI * freq_hz;
-    g_voltage = (voltage > 1.0f) ? 1.0f : ((voltage < 0.0f) ? 0.0f : voltage);
+    voltage = (voltage > 1.0f) ? 1.0f : ((voltage < 0.0f) ? 0.0f : voltage);
+
+    Param_Batch_t b;
+    Param_BatchInit(&b);
+    if (!(Param_BatchStageF(&b, PARAM_OL_FREQ_HZ, freq_hz) &&
+          Param_BatchStageF(&b, PARAM_OL_VOLTAGE, voltage) &&
+          Param_BatchStageU(&b, PARAM_OL_VOLT_MODE, 0)))
+        return 0;
+    Param_BatchCommit(&b);
+    return 1;
 }
 
 /**
- * @brief TIM6 인터럽트 콜백 (제어 루프)
+ * @brief 오픈루프 속도 설정 (전압 단위)
+ * @param freq_hz   전기 주파수 [Hz]
+ * @param volt      상전압 크기 [V] (매 주기 버스 전압으로 정규화)
+ * @return 1: 적용, 0: 범위 밖 (레지스트리 변경 없음)
  */
-void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+uint8_t OpenLoop_SetSpeedVolt(float freq_hz, float volt)
 {
-    if (htim->Instance == TIM6)
-    {
-        // 각도 업데이트
-        g_angle += g_omega * DT;
-        
-        // 각도 범위 제한 [0, 2π)
-        if (g_angle >= TWO_PI)
-            g_angle -= TWO_PI;
-        else if (g_angle < 0.0f)
-            g_angle += TWO_PI;
-        
-        // α-β 전압 계산
-        float Valpha = g_voltage * cosf(g_angle);
-        float Vbeta  = g_voltage * sinf(g_angle);
-        
-        // SVPWM 실행
-        SVPWM_Run(Valpha, Vbeta);
-    }
+    volt = (volt < 0.0f) ? 0.0f : volt;
+
+    Param_Batch_t b;
+    Param_BatchInit(&b);
+    if (!(Param_BatchStageF(&b, PARAM_OL_FREQ_HZ, freq_hz) &&
+          Param_BatchStageF(&b, PARAM_OL_VOLT_V, volt) &&
+          Param_BatchStageU(&b, PARAM_OL_VOLT_MODE, 1)))
+        return 0;
+    Param_BatchCommit(&b);
+    return 1;
 }
 
+/**
+ * @brief 파라미터 변경 반영 (버전이 바뀐 첫 스텝에서 1회)
+ * @param pPar  적용 뱅크
+ */
+static void OpenLoop_ApplyParams(const Param_Bank_t *pPar)
+{
+    g_omega = TWO_PI * pPar->v[PARAM_OL_FREQ_HZ].f;
 
+#if SVPWM_SPREAD
+    // 확산 폭은 현재 주기 기준 (주기가 바뀌면 SVPWM_SetPeriod 가 다시 계산)
+    spread_pct = pPar->v[PARAM_PWM_SPREAD].u;
+    uint32_t span = pwm_period * spread_pct / 100u;
+    if (span != pwm_next.span)
+    {
+        pwm_next.span = span;
+        SVPWM_PeriodArm();
+    }
+#endif
 
+    applied_ver = pPar->version;
+}
 
+#if !SVPWM_FIXED_PERIOD
+/**
+ * @brief PWM 주기 선택 (매 스텝) - PARAM_PWM_PERIOD, 스케줄이 켜져 있으면 지령 전기 주파수로 보간
+ * @param pPar  적용 뱅크
+ */
+CCMRAM_FUNC static void OpenLoop_PwmSchedule(const Param_Bank_t *pPar)
+{
+    uint32_t arr = pPar->v[PARAM_PWM_PERIOD].u;
+#if SVPWM_PWM_SCHED
+    const uint32_t arr_hi = arr, arr_lo = pPar->v[PARAM_PWM_ARR_LO].u;
+    arr = SvpwmCore_SchedArr(fabsf(g_omega) * (1.0f / TWO_PI),
+                             pPar->v[PARAM_PWM_SCH_F_LO].f, pPar->v[PARAM_PWM_SCH_F_HI].f, arr_lo, arr_hi);
 
+    // 보간 구간에서는 히스테리시스 (주기 변경 빈도 제한), 끝점은 정확히
+    uint32_t d = (arr > pwm_period) ? arr - pwm_period : pwm_period - arr;
+    if (d < SVPWM_SCHED_HYST_TICKS && arr != arr_lo && arr != arr_hi) return;
+#endif
+    SVPWM_SetPeriod(arr);
+}
+#endif
 
+/**
+ * @brief 제어 스텝 종료 시 기록 (텔레메트리, 스코프, 실행 사이클)
+ * @note  고장 중에도 호출되어 차단 전후 파형을 남긴다
+ */
+static inline void OpenLoop_Trace(void)
+{
+#if TELEMETRY_ENABLE
+    const Sense_State_t *pSense = Sense_GetState();
+    Telem_Ctrl_t sample;
+    sample.angle = g_angle;
+    sample.ia    = pSense->ia;
+    sample.ib    = pSense->ib;
+    sample.vbus  = pSense->vbus;
+    sample.ccr_a = svpwm_state.CCR_A;
+    sample.ccr_b = svpwm_state.CCR_B;
+    sample.ccr_c = svpwm_state.CCR_C;
+    Telem_PushCtrl(&sample);
+#endif
 
+    Scope_Record();
+
+#if LATENCY_MEASURE
+    IsrLat_OnStepExit();
+#endif
+}
 
-/* ============================================================
- * 섹터 판별
- * ============================================================ */
 /**
- * @brief Vα, Vβ로부터 섹터 판별 (1~6)
- * 
- *              β축
- *               |
- *        섹터2  |  섹터1
- *          \    |    /
- *           \   |   /
- *            \  |  /
- *   섹터3 -----(0,0)----- 섹터6  → α축
- *            /  |  \
- *           /   |   \
- *          /    |    \
- *        섹터4  |  섹터5
- *               |
+ * @brief 전압 벡터 [V] 출력 - 버스 전압으로 정규화, 선형 영역으로 크기 제한
+ * @param va    α축 전압 [V]
+ * @param vb    β축 전압 [V]
+ * @param vmax  정규화 크기 상한 (PARAM_V_MOD_MAX)
  */
-static uint8_t SVPWM_GetSector(float Valpha, float Vbeta)
+CCMRAM_FUNC static void OpenLoop_RunVolt(float va, float vb, float vmax)
 {
-    uint8_t sector;
-    
-    // 3개 기준선 판별
-    float Vref1 = Vbeta;
-    float Vref2 = (SQRT3_HALF * Valpha) - (0.5f * Vbeta);
-    float Vref3 = (-SQRT3_HALF * Valpha) - (0.5f * Vbeta);
-    
-    uint8_t A = (Vref1 > 0) ? 1 : 0;
-    uint8_t B = (Vref2 > 0) ? 1 : 0;
-    uint8_t C = (Vref3 > 0) ? 1 : 0;
-    
-    // 섹터 매핑 테이블
-    // N = A + 2B + 4C
-    static const uint8_t sector_table[8] = {0, 2, 6, 1, 4, 3, 5, 0};
-    sector = sector_table[A + (B << 1) + (C << 2)];
-    
-    return sector;
+    float k = Sense_GetVbusInv();
+    va *= k;
+    vb *= k;
+    float mag2 = va * va + vb * vb;
+    if (mag2 > vmax * vmax)
+    {
+        float scale = vmax / sqrtf(mag2);
+        va *= scale;
+        vb *= scale;
+    }
+    SVPWM_Run(va, vb);
 }
 
-/* ============================================================
- * 스위칭 시간 계산 (6섹터)
- * ============================================================ */
 /**
- * @brief 섹터별 T1, T2, T0 시간 비율 계산
- * 
- * 입력: 정규화된 Vα, Vβ (범위 약 -1 ~ +1)
- * 
- * 각 섹터의 인접 활성벡터:
- *   섹터1: V1(100), V2(110)   0° ~ 60°
- *   섹터2: V2(110), V3(010)  60° ~ 120°
- *   섹터3: V3(010), V4(011) 120° ~ 180°
- *   섹터4: V4(011), V5(001) 180° ~ 240°
- *   섹터5: V5(001), V6(101) 240° ~ 300°
- *   섹터6: V6(101), V1(100) 300° ~ 360°
+ * @brief 제어 루프 1 스텝 (TIM6 업데이트마다 호출)
  */
-static void SVPWM_CalcTimes(float Valpha, float Vbeta, SVPWM_State_t *pState)
+CCMRAM_FUNC void OpenLoop_Step(void)
 {
-    float T1, T2, T0;
+#if LATENCY_MEASURE
+    IsrLat_OnStepEntry();
+#endif
+
+    const Param_Bank_t *pPar = Param_Active();
+    if (pPar->version != applied_ver)
+        OpenLoop_ApplyParams(pPar);
+#if !SVPWM_FIXED_PERIOD
+    OpenLoop_PwmSchedule(pPar);
+#endif
+
+    // 각도 업데이트
+    g_angle += g_omega * step_dt;
     
-    // 섹터 판별
-    pState->sector = SVPWM_GetSector(Valpha, Vbeta);
+    // 각도 범위 제한 [0, 2π)
+    if (g_angle >= TWO_PI)
+        g_angle -= TWO_PI;
+    else if (g_angle < 0.0f)
+        g_angle += TWO_PI;
     
-    // 공통 중간값 계산
-    // X = √3 * Vβ
-    // Y = (3/2)*Vα + (√3/2)*Vβ  
-    // Z = -(3/2)*Vα + (√3/2)*Vβ
-    float X = SQRT3 * Vbeta;
-    float Y = (1.5f * Valpha) + (SQRT3_HALF * Vbeta);
-    float Z = (-1.5f * Valpha) + (SQRT3_HALF * Vbeta);
+    // 전류/버스 전압 샘플 갱신
+    Sense_Update();
     
-    // 섹터별 T1, T2 계산
-    switch (pState->sector)
+    // 버스 전압 보호, 고장 중에는 출력 갱신 금지 (SVPWM_Stop 상태 유지)
+    Protect_CheckVbus(Sense_GetState()->vbus);
+    if (!Fault_IsOk())
     {
-        case 1:  // 0° ~ 60°: V1(100) → V2(110)
-            T1 = Y;      // T1 ∝ sin(60° - θ)
-            T2 = X;      // T2 ∝ sin(θ)
-            break;
-            
-        case 2:  // 60° ~ 120°: V2(110) → V3(010)
-            T1 = -Z;     // T1 ∝ sin(120° - θ)
-            T2 = Y;      // T2 ∝ sin(θ - 60°)
-            break;
-            
-        case 3:  // 120° ~ 180°: V3(010) → V4(011)
-            T1 = X;      // T1 ∝ sin(180° - θ)
-            T2 = Z;      // T2 ∝ sin(θ - 120°)
-            break;
-            
-        case 4:  // 180° ~ 240°: V4(011) → V5(001)
-            T1 = -Y;     // T1 ∝ sin(240° - θ)
-            T2 = -X;     // T2 ∝ sin(θ - 180°)
-            break;
-            
-        case 5:  // 240° ~ 300°: V5(001) → V6(101)
-            T1 = Z;      // T1 ∝ sin(300° - θ)
-            T2 = -Y;     // T2 ∝ sin(θ - 240°)
-            break;
-            
-        case 6:  // 300° ~ 360°: V6(101) → V1(100)
-            T1 = -X;     // T1 ∝ sin(360° - θ)
-            T2 = -Z;     // T2 ∝ sin(θ - 300°)
-            break;
-            
-        default:
-            T1 = 0;
-            T2 = 0;
-            break;
+        OpenLoop_Trace();
+        return;
     }
-    
-    // 음수 방지
-    if (T1 < 0) T1 = 0;
-    if (T2 < 0) T2 = 0;
-    
-    // 과변조 처리 (T1 + T2 > 1 일 때)
-    float Tsum = T1 + T2;
-    if (Tsum > 1.0f)
+
+    // 파라미터 식별 중: 식별 전압 벡터 [V] → 정규화, 선형 영역으로 제한
+    float id_va, id_vb;
+    uint8_t hall = (GPE_HALL_W_GPIO_Port->IDR & GPE_HALL_W_Pin) ? 1u : 0u;
+    if (MotorId_Step(Sense_GetState()->ia, Sense_GetState()->ib, hall, &id_va, &id_vb) ||
+        MechId_Step(Sense_GetState()->ia, Sense_GetState()->ib, hall, &id_va, &id_vb))
     {
-        T1 = T1 / Tsum;
-        T2 = T2 / Tsum;
-        T0 = 0;
+        OpenLoop_RunVolt(id_va, id_vb, pPar->v[PARAM_V_MOD_MAX].f);
+        OpenLoop_Trace();
+        return;
     }
-    else
+    
+    // 전압 모드: [V] → 정규화 (버스 리플 피드포워드), 선형 영역으로 제한
+    float voltage = pPar->v[PARAM_OL_VOLTAGE].f;
+    if (voltage > pPar->v[PARAM_V_NORM_MAX].f) voltage = pPar->v[PARAM_V_NORM_MAX].f;
+    if (pPar->v[PARAM_OL_VOLT_MODE].u)
     {
-        T0 = 1.0f - Tsum;
+        voltage = pPar->v[PARAM_OL_VOLT_V].f * Sense_GetVbusInv();
+        if (voltage > pPar->v[PARAM_V_MOD_MAX].f) voltage = pPar->v[PARAM_V_MOD_MAX].f;
     }
     
-    pState->T1 = T1;
-    pState->T2 = T2;
-    pState->T0 = T0;
+    // α-β 전압 계산
+#if CONTROL_TRIG_LUT
+    float s, c;
+    FastTrig_SinCos(g_angle, &s, &c);
+    float Valpha = voltage * c;
+    float Vbeta  = voltage * s;
+#else
+    float Valpha = voltage * cosf(g_angle);
+    float Vbeta  = voltage * sinf(g_angle);
+#endif
+    
+    // SVPWM 실행
+    SVPWM_Run(Valpha, Vbeta);
+
+    OpenLoop_Trace();
 }
 
-/* ============================================================
- * CCR 값 계산 (중앙정렬 PWM)
- * ============================================================ */
+#if !CONTROL_DISPATCH_LEAN
 /**
- * @brief 섹터별 CCR 값 계산
- * 
- * 중앙정렬 PWM 대칭 패턴:
- * 
- *     |<-------- Ts -------->|
- *     |                      |
- *     |  T0/2  T1  T2  T0/2  |
- *     | (V0) (Vx)(Vy) (V7)   |
- *     
- * 카운터:  0 → ARR → 0
- *          ↑ CCR 비교로 HIGH/LOW 결정
- * 
- * CCR 값이 클수록 HIGH 구간이 길어짐
+ * @brief TIM6 인터럽트 콜백 (HAL 디스패치 경로)
  */
-static void SVPWM_CalcCCR(SVPWM_State_t *pState)
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
-    float Ta, Tb, Tc;  // 각 상의 ON 시간 비율 (0~1)
-    
-    float T0_half = pState->T0 * 0.5f;
-    float T1 = pState->T1;
-    float T2 = pState->T2;
-    
-    /**
-     * 섹터별 스위칭 시퀀스 및 ON 시간 계산
-     * 
-     * 예) 섹터1: 000 → 100 → 110 → 111 → 110 → 100 → 000
-     *     - A상: V1, V2, V7에서 HIGH → Ta = T1 + T2 + T0/2
-     *     - B상: V2, V7에서 HIGH     → Tb = T2 + T0/2
-     *     - C상: V7에서만 HIGH       → Tc = T0/2
-     */
-    switch (pState->sector)
+    if (htim->Instance == TIM6)
     {
-        case 1:  // 000 → 100 → 110 → 111
-            Ta = T1 + T2 + T0_half;
-            Tb = T2 + T0_half;
-            Tc = T0_half;
-            break;
-            
-        case 2:  // 000 → 010 → 110 → 111
-            Ta = T1 + T0_half;
-            Tb = T1 + T2 + T0_half;
-            Tc = T0_half;
-            break;
-            
-        case 3:  // 000 → 010 → 011 → 111
-            Ta = T0_half;
-            Tb = T1 + T2 + T0_half;
-            Tc = T2 + T0_half;
-            break;
-            
-        case 4:  // 000 → 001 → 011 → 111
-            Ta = T0_half;
-            Tb = T1 + T0_half;
-            Tc = T1 + T2 + T0_half;
-            break;
-            
-        case 5:  // 000 → 001 → 101 → 111
-            Ta = T2 + T0_half;
-            Tb = T0_half;
-            Tc = T1 + T2 + T0_half;
-            break;
-            
-        case 6:  // 000 → 100 → 101 → 111
-            Ta = T1 + T2 + T0_half;
-            Tb = T0_half;
-            Tc = T1 + T0_half;
-            break;
-            
-        default:
-            Ta = Tb = Tc = 0.5f;
-            break;
+        OpenLoop_Step();
     }
-    
-    // CCR = ON비율 * (ARR + 1)
-    float period_f = (float)(PWM_PERIOD + 1);
-    
-    pState->CCR_A = (uint16_t)(Ta * period_f);
-    pState->CCR_B = (uint16_t)(Tb * period_f);
-    pState->CCR_C = (uint16_t)(Tc * period_f);
-    
-    // 범위 제한
-    if (pState->CCR_A > PWM_PERIOD) pState->CCR_A = PWM_PERIOD;
-    if (pState->CCR_B > PWM_PERIOD) pState->CCR_B = PWM_PERIOD;
-    if (pState->CCR_C > PWM_PERIOD) pState->CCR_C = PWM_PERIOD;
 }
+#endif
+
+
+
+
+
+
+
 
 /* ============================================================
  * PWM 출력 업데이트
  * ============================================================ */
-static void SVPWM_UpdatePWM(SVPWM_State_t *pState)
+CCMRAM_FUNC static void SVPWM_UpdatePWM(SVPWM_State_t *pState)
 {
     if (pHTim == NULL) return;
+
+#if SVPWM_SINGLE_SHUNT
+    // 업데이트 ISR 이 제어 루프를 선점하므로 반주기 배치를 한 번에 넘긴다 (레지스터는 ISR 만 기록)
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    pwm_next.ccr[0] = pState->CCR_A;
+    pwm_next.ccr[1] = pState->CCR_B;
+    pwm_next.ccr[2] = pState->CCR_C;
+    pwm_next.shunt = pState->shunt;
+    __set_PRIMASK(primask);
+    return;
+#elif SVPWM_PERIOD_ISR
+    pwm_next.ccr[0] = pState->CCR_A;
+    pwm_next.ccr[1] = pState->CCR_B;
+    pwm_next.ccr[2] = pState->CCR_C;
+    if (pwm_isr_own) return;        // 업데이트 ISR 이 이번 주기 ARR 에 맞춰 기록
+#endif
     
     __HAL_TIM_SET_COMPARE(pHTim, TIM_CHANNEL_1, pState->CCR_A);
     __HAL_TIM_SET_COMPARE(pHTim, TIM_CHANNEL_2, pState->CCR_B);
     __HAL_TIM_SET_COMPARE(pHTim, TIM_CHANNEL_3, pState->CCR_C);
 }
 
+#if SVPWM_PERIOD_ISR
+/**
+ * @brief ARR/CCR 기록을 TIM3 업데이트 ISR 로 넘김 (다음 정점부터)
+ *
+ * 확산이 꺼져 있으면 ISR 이 한 번 기록한 뒤 스스로 인터럽트를 끄고 제어 루프에 돌려준다.
+ */
+CCMRAM_FUNC static void SVPWM_PeriodArm(void)
+{
+    if (pHTim == NULL || pwm_isr_own) return;
+    pwm_isr_own = 1;
+    __HAL_TIM_CLEAR_FLAG(pHTim, TIM_FLAG_UPDATE);
+    __HAL_TIM_ENABLE_IT(pHTim, TIM_IT_UPDATE);
+}
+#endif
+
+#if !SVPWM_FIXED_PERIOD
+/**
+ * @brief PWM 주기 변경 (제어 루프 문맥)
+ * @param arr  새 ARR
+ *
+ * ARR 을 바로 쓰면 ARR 과 CCR 기록 사이에 UEV 가 끼어 한 주기가 옛 CCR / 새 ARR 로 나가거나,
+ * 정점 UEV 에서 옮겨져 상승/하강 구간 주기가 달라진다. 그래서 기준 CCR 만 새 주기로
+ * 환산해 두고 (이번 스텝에 SVPWM_Run 이 없어도 ON 비율 유지) 기록은 업데이트 ISR 에 맡긴다.
+ */
+CCMRAM_FUNC static void SVPWM_SetPeriod(uint32_t arr)
+{
+    if (arr == pwm_period) return;
+
+#if SVPWM_SINGLE_SHUNT
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+#endif
+    // ARR ≤ 16999 (PARAM_PWM_PERIOD 범위) → 곱이 32비트에 들어가 하드웨어 UDIV 로 끝난다
+    // (64비트 나눗셈은 FLASH 의 libgcc __aeabi_uldivmod 호출)
+    const uint32_t a1 = pwm_period + 1u;
+    for (uint32_t k = 0; k < 3u; k++)
+    {
+        uint32_t c = pwm_next.ccr[k];
+        pwm_next.ccr[k] = (c >= a1) ? (uint16_t)(arr + 1u)
+                                    : (uint16_t)((c * (arr + 1u) + a1 / 2u) / a1);
+    }
+    pwm_period = arr;
+    pwm_scale = (float)(arr + 1u);
+    pwm_next.arr = arr;
+#if SVPWM_SPREAD
+    pwm_next.span = arr * spread_pct / 100u;
+#endif
+#if SVPWM_SINGLE_SHUNT
+    // 창 길이는 tick 단위라 환산하지 않고 새 주기에서 다시 배치
+    SvpwmCore_ShuntShift(pwm_next.ccr, arr + 1u, &pwm_next.shunt);
+    __set_PRIMASK(primask);
+#endif
+    SVPWM_PeriodArm();
+}
+#endif
+
+/**
+ * @brief 게이트 드라이버 활성/비활성 (기계 파라미터 식별 관성 구간 제어)
+ * @param enable  1: RUN (고장 상태면 무시), 0: STOP - 운전 지령 래치와 함께 바꾼다
+ */
+static void OpenLoop_Driver(uint8_t enable)
+{
+    (void)Protect_SetRun(enable);
+}
+
 /* ============================================================
  * Public 함수
  * ============================================================ */
@@ -315,6 +401,15 @@ void SVPWM_Init(TIM_HandleTypeDef *htim)
 {
     pHTim = htim;
     
+    // 제어 루프 삼각함수 LUT
+    FastTrig_Init();
+
+    // CubeMX 초기 ARR 대신 svpwm_config.h / PARAM_PWM_PERIOD 주기
+    __HAL_TIM_SET_AUTORELOAD(pHTim, pwm_period);
+
+    // 기계 파라미터 식별 - 관성 구간에서 드라이버 비활성
+    MechId_Init(OpenLoop_Driver);
+    
     // 상태 초기화
     svpwm_state.sector = 1;
     svpwm_state.T1 = 0;
@@ -331,6 +426,10 @@ void SVPWM_Init(TIM_HandleTypeDef *htim)
     
     // TIM1은 Advanced Timer이므로 MOE 비트 활성화 필요
     //__HAL_TIM_MOE_ENABLE(pHTim);
+
+#if SVPWM_SINGLE_SHUNT
+    SVPWM_ShuntInit();
+#endif
 }
 
 /**
@@ -342,13 +441,10 @@ void SVPWM_Init(TIM_HandleTypeDef *htim)
  *   float angle = omega * t;
  *   SVPWM_Run(V * cosf(angle), V * sinf(angle));
  */
-void SVPWM_Run(float Valpha, float Vbeta)
+CCMRAM_FUNC void SVPWM_Run(float Valpha, float Vbeta)
 {
-    // 1. T1, T2, T0 계산 (섹터 판별 포함)
-    SVPWM_CalcTimes(Valpha, Vbeta, &svpwm_state);
-    
-    // 2. CCR 값 계산
-    SVPWM_CalcCCR(&svpwm_state);
+    // 1~2. 섹터, T1/T2/T0, CCR 계산 (svpwm_core.c)
+    SvpwmCore_Calc(Valpha, Vbeta, pwm_scale, pwm_period + 1u, &svpwm_state);
     
     // 3. PWM 레지스터 업데이트
     SVPWM_UpdatePWM(&svpwm_state);
@@ -361,10 +457,143 @@ void SVPWM_Stop(void)
 {
     if (pHTim == NULL) return;
     
+#if SVPWM_SINGLE_SHUNT
+    // 업데이트 ISR 이 다음 반주기에 옛 배치를 다시 쓰지 않도록 대기 중인 배치도 모두 0
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    pwm_next.shunt = shunt_off;
+    shunt_nxt = shunt_off;
+    shunt_cur = shunt_off;
+#endif
     __HAL_TIM_SET_COMPARE(pHTim, TIM_CHANNEL_1, 0);
     __HAL_TIM_SET_COMPARE(pHTim, TIM_CHANNEL_2, 0);
     __HAL_TIM_SET_COMPARE(pHTim, TIM_CHANNEL_3, 0);
+#if SVPWM_PERIOD_ISR
+    pwm_next.ccr[0] = 0;
+    pwm_next.ccr[1] = 0;
+    pwm_next.ccr[2] = 0;
+#endif
+#if SVPWM_SINGLE_SHUNT
+    __set_PRIMASK(primask);
+#endif
+}
+
+#if SVPWM_SINGLE_SHUNT
+/**
+ * @brief 단일 션트 - TIM3 CH4 (ADC 트리거), CCR4 DMA, 업데이트 ISR 설정
+ *
+ * CH4 는 출력 없이 OC4REF 만 쓴다 (PWM1, 프리로드 없음). 중앙정렬 모드 1 이라 CC4 일치는
+ * 하강 카운트에서만 나며, 첫 일치 (trig0) 에서 ADC1 주입 랭크 1 을 트리거하고 DMA 가
+ * CCR4 에 trig1 을 써 두 번째 일치 (랭크 2) 를 만든다. 반주기 CCR 을 제때 기록하도록
+ * 업데이트 ISR 을 제어 루프보다 높은 우선순위로 올리고 레지스터 기록을 계속 맡긴다.
+ */
+static void SVPWM_ShuntInit(void)
+{
+    pwm_next.shunt = shunt_off;
+    shunt_nxt = shunt_off;
+    shunt_cur = shunt_off;
+
+    TIM_OC_InitTypeDef sOc = {0};
+    sOc.OCMode = TIM_OCMODE_PWM1;
+    sOc.Pulse = SVPWM_SHUNT_TRIG_OFF;
+    sOc.OCPolarity = TIM_OCPOLARITY_HIGH;
+    sOc.OCFastMode = TIM_OCFAST_DISABLE;
+    if (HAL_TIM_PWM_ConfigChannel(pHTim, &sOc, TIM_CHANNEL_4) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    pHTim->Instance->CCMR2 &= ~(uint32_t)TIM_CCMR2_OC4PE;      // DMA 기록이 바로 비교에 반영
+
+    hdma_shunt.Instance = DMA1_Channel4;
+    hdma_shunt.Init.Request = DMA_REQUEST_TIM3_CH4;
+    hdma_shunt.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_shunt.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_shunt.Init.MemInc = DMA_MINC_DISABLE;
+    hdma_shunt.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    hdma_shunt.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    hdma_shunt.Init.Mode = DMA_CIRCULAR;
+    hdma_shunt.Init.Priority = DMA_PRIORITY_VERY_HIGH;
+    if (HAL_DMA_Init(&hdma_shunt) != HAL_OK ||
+        HAL_DMA_Start(&hdma_shunt, (uint32_t)(uintptr_t)&shunt_trig2, (uint32_t)(uintptr_t)&pHTim->Instance->CCR4, 1) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    __HAL_TIM_ENABLE_DMA(pHTim, TIM_DMA_CC4);
+
+    HAL_NVIC_SetPriority(TIM3_IRQn, IRQ_PRIO_PWM_SHUNT, 0);
+    SVPWM_PeriodArm();
+}
+
+/**
+ * @brief 단일 션트 반주기 기록 (TIM3 업데이트 ISR, 정점과 바닥 모두)
+ *
+ *   정점 (하강 시작): 지난 주기 샘플 래치, 다음 주기 ARR / 상승 구간 CCR → 바닥 UEV 에서 옮겨짐
+ *   바닥 (상승 시작): 이번 주기 하강 구간 CCR → 정점 UEV 에서 옮겨짐, 트리거 CCR4 / DMA 값
+ *
+ * 샘플은 하강 구간 끝 근처에서 변환되므로 바닥이 아니라 다음 정점에서 읽는다.
+ * 각 반주기 (ARR 최소값에서 약 25us) 안에 끝나야 한다.
+ */
+CCMRAM_FUNC static inline void SVPWM_ShuntIRQ(TIM_TypeDef *tim)
+{
+    if (tim->CR1 & TIM_CR1_DIR)
+    {
+        Sense_ShuntLatch(shunt_smp_map);
+        shunt_nxt = pwm_next.shunt;
+        tim->ARR  = pwm_next.arr;
+        tim->CCR1 = shunt_nxt.up[0];
+        tim->CCR2 = shunt_nxt.up[1];
+        tim->CCR3 = shunt_nxt.up[2];
+    }
+    else
+    {
+        shunt_smp_map = shunt_cur.map;
+        shunt_cur = shunt_nxt;
+        tim->CCR1 = shunt_cur.dn[0];
+        tim->CCR2 = shunt_cur.dn[1];
+        tim->CCR3 = shunt_cur.dn[2];
+        shunt_trig2 = shunt_cur.trig[1];
+        tim->CCR4 = shunt_cur.trig[0];      // 상승 카운트 중에는 일치 / 트리거 없음
+    }
+}
+#endif
+
+#if SVPWM_PERIOD_ISR
+/**
+ * @brief 다음 PWM 주기의 ARR / CCR 기록 (TIM3 업데이트 ISR)
+ *
+ * 중앙정렬이라 UEV 는 정점과 바닥에서 두 번 온다. 정점 (하강 시작, DIR=1) 에서만
+ * 기록하면 프리로드가 바닥 UEV 에서 ARR 과 CCR 을 함께 옮겨 한 주기 전체가 같은 값으로
+ * 대칭을 유지한다. CCR 은 기준 주기 값을 ON 비율이 같도록 환산하므로 제어 루프 (TIM6) 는
+ * 확산 / 주기 변경 시점을 몰라도 된다. 하강 구간 (반주기) 안에 끝나야 한다.
+ */
+CCMRAM_FUNC void SVPWM_PeriodIRQHandler(void)
+{
+    TIM_TypeDef *tim = TIM3;
+
+    if (!(tim->SR & TIM_SR_UIF) || !(tim->DIER & TIM_DIER_UIE)) return;
+    tim->SR = ~(uint32_t)TIM_SR_UIF;    // rc_w0
+#if SVPWM_SINGLE_SHUNT
+    SVPWM_ShuntIRQ(tim);
+    return;
+#endif
+    if (!(tim->CR1 & TIM_CR1_DIR)) return;
+
+    uint16_t ccr[3];
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    tim->ARR  = SvpwmCore_NextPeriod(&pwm_next, ccr);
+    tim->CCR1 = ccr[0];
+    tim->CCR2 = ccr[1];
+    tim->CCR3 = ccr[2];
+    if (pwm_next.span == 0u)
+    {
+        // 고정 주기 - 이후 CCR 은 제어 루프가 직접 기록 (ARR 은 이미 같은 값)
+        tim->DIER &= ~(uint32_t)TIM_DIER_UIE;
+        pwm_isr_own = 0;
+    }
+    __set_PRIMASK(primask);
 }
+#endif
 
 /**
  * @brief 현재 상태 반환 (디버깅용)
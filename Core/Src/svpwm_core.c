@@ -0,0 +1,419 @@
+/**
+ * @file    svpwm_core.c
+ * @brief   SVPWM 변조 커널 구현 (섹터 판별, 스위칭 시간, CCR 환산)
+ *
+ * 하드웨어 의존성이 없는 순수 로직 (HAL 미포함) - 타이머 쓰기는 svpwm.c.
+ * 호스트에서 그대로 빌드되므로 Tools/svpwm_golden.py 가 골든 벡터와 비교한다.
+ */
+
+#include "svpwm_core.h"
+#include "app_config.h"
+
+/* ============================================================
+ * 섹터 판별
+ * ============================================================ */
+/**
+ * @brief Vα, Vβ로부터 섹터 판별 (1~6)
+ * 
+ *              β축
+ *               |
+ *        섹터2  |  섹터1
+ *          \    |    /
+ *           \   |   /
+ *            \  |  /
+ *   섹터3 -----(0,0)----- 섹터6  → α축
+ *            /  |  \
+ *           /   |   \
+ *          /    |    \
+ *        섹터4  |  섹터5
+ *               |
+ */
+CCMRAM_FUNC static uint8_t SVPWM_GetSector(float Valpha, float Vbeta)
+{
+    uint8_t sector;
+    
+    // 3개 기준선 판별
+    float Vref1 = Vbeta;
+    float Vref2 = (SQRT3_HALF * Valpha) - (0.5f * Vbeta);
+    float Vref3 = (-SQRT3_HALF * Valpha) - (0.5f * Vbeta);
+    
+    uint8_t A = (Vref1 > 0) ? 1 : 0;
+    uint8_t B = (Vref2 > 0) ? 1 : 0;
+    uint8_t C = (Vref3 > 0) ? 1 : 0;
+    
+    // 섹터 매핑 테이블
+    // N = A + 2B + 4C
+    static const uint8_t sector_table[8] CCMRAM_DATA = {0, 2, 6, 1, 4, 3, 5, 0};
+    sector = sector_table[A + (B << 1) + (C << 2)];
+    
+    return sector;
+}
+
+/* ============================================================
+ * 스위칭 시간 계산 (6섹터)
+ * ============================================================ */
+/**
+ * @brief 섹터별 T1, T2, T0 시간 비율 계산
+ * 
+ * 입력: 정규화된 Vα, Vβ (범위 약 -1 ~ +1)
+ * 
+ * 각 섹터의 인접 활성벡터:
+ *   섹터1: V1(100), V2(110)   0° ~ 60°
+ *   섹터2: V2(110), V3(010)  60° ~ 120°
+ *   섹터3: V3(010), V4(011) 120° ~ 180°
+ *   섹터4: V4(011), V5(001) 180° ~ 240°
+ *   섹터5: V5(001), V6(101) 240° ~ 300°
+ *   섹터6: V6(101), V1(100) 300° ~ 360°
+ */
+CCMRAM_FUNC static void SVPWM_CalcTimes(float Valpha, float Vbeta, SVPWM_State_t *pState)
+{
+    float T1, T2, T0;
+    
+    // 비정상 입력: NaN → 0 (영벡터), ±Inf/과대값 → ±SVPWM_IN_LIMIT (과변조로 포화)
+    // 비교가 거짓이 되는 NaN 을 같은 분기에서 거른다 (-ffast-math 금지)
+    if (!(Valpha <= SVPWM_IN_LIMIT))  Valpha = (Valpha > 0.0f) ? SVPWM_IN_LIMIT : 0.0f;
+    if (!(Valpha >= -SVPWM_IN_LIMIT)) Valpha = (Valpha < 0.0f) ? -SVPWM_IN_LIMIT : 0.0f;
+    if (!(Vbeta <= SVPWM_IN_LIMIT))   Vbeta = (Vbeta > 0.0f) ? SVPWM_IN_LIMIT : 0.0f;
+    if (!(Vbeta >= -SVPWM_IN_LIMIT))  Vbeta = (Vbeta < 0.0f) ? -SVPWM_IN_LIMIT : 0.0f;
+    
+    // 섹터 판별
+    pState->sector = SVPWM_GetSector(Valpha, Vbeta);
+    
+    // 공통 중간값 계산
+    // X = √3 * Vβ
+    // Y = (3/2)*Vα + (√3/2)*Vβ  
+    // Z = -(3/2)*Vα + (√3/2)*Vβ
+    float X = SQRT3 * Vbeta;
+    float Y = (1.5f * Valpha) + (SQRT3_HALF * Vbeta);
+    float Z = (-1.5f * Valpha) + (SQRT3_HALF * Vbeta);
+    
+    // 섹터별 T1, T2 계산
+    switch (pState->sector)
+    {
+        case 1:  // 0° ~ 60°: V1(100) → V2(110)
+            T1 = -Z;     // T1 ∝ sin(60° - θ)
+            T2 = X;      // T2 ∝ sin(θ)
+            break;
+            
+        case 2:  // 60° ~ 120°: V2(110) → V3(010)
+            T1 = Y;      // T1 ∝ sin(120° - θ)
+            T2 = Z;      // T2 ∝ sin(θ - 60°)
+            break;
+            
+        case 3:  // 120° ~ 180°: V3(010) → V4(011)
+            T1 = X;      // T1 ∝ sin(180° - θ)
+            T2 = -Y;     // T2 ∝ sin(θ - 120°)
+            break;
+            
+        case 4:  // 180° ~ 240°: V4(011) → V5(001)
+            T1 = Z;      // T1 ∝ sin(240° - θ)
+            T2 = -X;     // T2 ∝ sin(θ - 180°)
+            break;
+            
+        case 5:  // 240° ~ 300°: V5(001) → V6(101)
+            T1 = -Y;     // T1 ∝ sin(300° - θ)
+            T2 = -Z;     // T2 ∝ sin(θ - 240°)
+            break;
+            
+        case 6:  // 300° ~ 360°: V6(101) → V1(100)
+            T1 = -X;     // T1 ∝ sin(360° - θ)
+            T2 = Y;      // T2 ∝ sin(θ - 300°)
+            break;
+            
+        default:
+            T1 = 0;
+            T2 = 0;
+            break;
+    }
+    
+    // 음수 방지
+    if (T1 < 0) T1 = 0;
+    if (T2 < 0) T2 = 0;
+    
+    // 과변조 처리 (T1 + T2 > 1 일 때)
+    float Tsum = T1 + T2;
+    if (Tsum > 1.0f)
+    {
+        T1 = T1 / Tsum;
+        T2 = T2 / Tsum;
+        T0 = 0;
+    }
+    else
+    {
+        T0 = 1.0f - Tsum;
+    }
+    
+    pState->T1 = T1;
+    pState->T2 = T2;
+    pState->T0 = T0;
+}
+
+/* ============================================================
+ * CCR 값 계산 (중앙정렬 PWM)
+ * ============================================================ */
+/**
+ * @brief ON 시간 [tick] → CCR (범위/최소 펄스 제한)
+ *
+ * 상한 ARR+1 = 100% ON (PWM1, CNT < CCR 동안 활성) - DPWM_MAX 고정 상이
+ * 주기마다 스위칭하지 않도록 ARR 이 아닌 ARR+1 까지 허용한다.
+ */
+CCMRAM_FUNC static inline uint16_t SVPWM_ToCCR(float on_ticks, uint32_t ccr_max)
+{
+    uint32_t ccr = (uint32_t)on_ticks;      // on_ticks >= 0 (T1, T2, T0 >= 0)
+
+    if (ccr > ccr_max) ccr = ccr_max;
+#if SVPWM_DT_TICKS > 0
+    // 데드타임보다 짧은 ON/OFF 펄스는 드라이버에서 사라지므로 끝으로 밀어냄
+    if (ccr < SVPWM_DT_TICKS) ccr = 0;
+    else if (ccr > ccr_max - SVPWM_DT_TICKS) ccr = ccr_max;
+#endif
+    return (uint16_t)ccr;
+}
+
+/**
+ * @brief 섹터별 CCR 값 계산
+ * 
+ * 중앙정렬 PWM 대칭 패턴:
+ * 
+ *     |<-------- Ts -------->|
+ *     |                      |
+ *     |  T0/2  T1  T2  T0/2  |
+ *     | (V0) (Vx)(Vy) (V7)   |
+ *     
+ * 카운터:  0 → ARR → 0
+ *          ↑ CCR 비교로 HIGH/LOW 결정
+ * 
+ * CCR 값이 클수록 HIGH 구간이 길어짐
+ *
+ * 영벡터 배분은 SVPWM_V7_SHARE (svpwm_config.h 변조 방식, 컴파일 상수):
+ *   T0_half = T0 · share 가 각 상에 공통으로 더해지는 V7 구간이다.
+ */
+CCMRAM_FUNC static void SVPWM_CalcCCR(SVPWM_State_t *pState, float scale, uint32_t ccr_max)
+{
+    float Ta, Tb, Tc;  // 각 상의 ON 시간 비율 (0~1)
+    
+    float T0_half = pState->T0 * SVPWM_V7_SHARE;
+    float T1 = pState->T1;
+    float T2 = pState->T2;
+    
+    /**
+     * 섹터별 스위칭 시퀀스 및 ON 시간 계산
+     * 
+     * 예) 섹터1: 000 → 100 → 110 → 111 → 110 → 100 → 000
+     *     - A상: V1, V2, V7에서 HIGH → Ta = T1 + T2 + T0/2
+     *     - B상: V2, V7에서 HIGH     → Tb = T2 + T0/2
+     *     - C상: V7에서만 HIGH       → Tc = T0/2
+     */
+    switch (pState->sector)
+    {
+        case 1:  // 000 → 100 → 110 → 111
+            Ta = T1 + T2 + T0_half;
+            Tb = T2 + T0_half;
+            Tc = T0_half;
+            break;
+            
+        case 2:  // 000 → 010 → 110 → 111
+            Ta = T1 + T0_half;
+            Tb = T1 + T2 + T0_half;
+            Tc = T0_half;
+            break;
+            
+        case 3:  // 000 → 010 → 011 → 111
+            Ta = T0_half;
+            Tb = T1 + T2 + T0_half;
+            Tc = T2 + T0_half;
+            break;
+            
+        case 4:  // 000 → 001 → 011 → 111
+            Ta = T0_half;
+            Tb = T1 + T0_half;
+            Tc = T1 + T2 + T0_half;
+            break;
+            
+        case 5:  // 000 → 001 → 101 → 111
+            Ta = T2 + T0_half;
+            Tb = T0_half;
+            Tc = T1 + T2 + T0_half;
+            break;
+            
+        case 6:  // 000 → 100 → 101 → 111
+            Ta = T1 + T2 + T0_half;
+            Tb = T0_half;
+            Tc = T1 + T0_half;
+            break;
+            
+        default:  // 섹터 0: Vα = Vβ = 0 (T0 = 1) - 변조 방식의 영벡터 배분 그대로
+            Ta = Tb = Tc = T0_half;
+            break;
+    }
+    
+    // CCR = ON비율 * (ARR + 1)
+    pState->CCR_A = SVPWM_ToCCR(Ta * scale, ccr_max);
+    pState->CCR_B = SVPWM_ToCCR(Tb * scale, ccr_max);
+    pState->CCR_C = SVPWM_ToCCR(Tc * scale, ccr_max);
+
+#if SVPWM_SINGLE_SHUNT
+    // 단일 션트: 반주기 CCR 로 샘플 창 확보 (주기 평균은 위 CCR 그대로)
+    const uint16_t ccr[3] = { pState->CCR_A, pState->CCR_B, pState->CCR_C };
+    SvpwmCore_ShuntShift(ccr, ccr_max, &pState->shunt);
+#endif
+}
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+/**
+ * @brief 전압 벡터 → 섹터, T1/T2/T0, CCR_A/B/C
+ * @param Valpha   α축 전압 (정규화: -1 ~ +1)
+ * @param Vbeta    β축 전압 (정규화: -1 ~ +1)
+ * @param scale    ON 비율 → CCR 환산 계수 (ARR + 1)
+ * @param ccr_max  CCR 상한 (ARR + 1 = 100% ON)
+ * @param pState   결과
+ */
+CCMRAM_FUNC void SvpwmCore_Calc(float Valpha, float Vbeta, float scale, uint32_t ccr_max,
+                                SVPWM_State_t *pState)
+{
+    SVPWM_CalcTimes(Valpha, Vbeta, pState);
+    SVPWM_CalcCCR(pState, scale, ccr_max);
+}
+
+/**
+ * @brief 단일 션트: 하강 구간 샘플 창 확보 (에지 이동 + 상승 구간 보상)
+ *
+ * 하강 카운트에서는 CNT < CCR 이 되는 순간 HIGH 가 되므로 CCR 이 큰 상부터 켜진다.
+ *
+ *   CNT   ARR ──────────────────────────────────▶ 0
+ *   hi    ___|‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾
+ *   md    ________________|‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾
+ *   lo    _______________________________|‾‾‾‾‾‾‾‾
+ *            dn_hi    ↑trig0   c_md     ↑trig1  dn_lo
+ *              (hi 만: +i_hi)     (hi+md: -i_lo)
+ *
+ * dn_hi - c_md 와 c_md - dn_lo 가 SVPWM_SHUNT_TMIN_TICKS 이상이 되도록 hi 를 위로, lo 를 아래로
+ * 밀고 상승 구간을 2·CCR - dn 으로 보상한다. 트리거는 다음 에지 + TS 에 둬 안정 시간을 최대로 쓴다.
+ * 범위를 벗어나면 세 상에 공통 오프셋 (하강 +o, 상승 -o) 을 줘 선간 전압과 창 길이를 유지한 채
+ * [0, ARR+1] 안으로 옮기고, 그래도 안 되면 (과변조, 0%/100% 근처 고정 상) 대칭 출력에 샘플 없음.
+ * 이동된 반주기 펄스는 SVPWM_DT_TICKS 최소 펄스 제한을 다시 거치지 않는다.
+ */
+CCMRAM_FUNC void SvpwmCore_ShuntShift(const uint16_t ccr[3], uint32_t ccr_max, SVPWM_Shunt_t *pSh)
+{
+    // 상 정렬: hi >= md >= lo
+    uint32_t hi = 0u, md = 1u, lo = 2u, t;
+    if (ccr[hi] < ccr[md]) { t = hi; hi = md; md = t; }
+    if (ccr[md] < ccr[lo]) { t = md; md = lo; lo = t; }
+    if (ccr[hi] < ccr[md]) { t = hi; hi = md; md = t; }
+
+    const int32_t P = (int32_t)ccr_max;
+    const int32_t c_hi = ccr[hi], c_md = ccr[md], c_lo = ccr[lo];
+    int32_t s_hi = (int32_t)SVPWM_SHUNT_TMIN_TICKS - (c_hi - c_md);
+    int32_t s_lo = (int32_t)SVPWM_SHUNT_TMIN_TICKS - (c_md - c_lo);
+    if (s_hi < 0) s_hi = 0;
+    if (s_lo < 0) s_lo = 0;
+
+    // 공통 오프셋 범위: 하강 dn ∈ [0, P], 상승 2·CCR - dn ∈ [0, P],
+    // trig0 <= ARR - TMIN (정점 ISR 이 지난 주기 결과를 읽기 전에 새 변환이 덮어쓰지 않도록)
+    const int32_t up_hi = c_hi - s_hi, up_lo = c_lo + s_lo;
+    int32_t up_min = (up_hi < up_lo) ? up_hi : up_lo;
+    int32_t up_max = (up_hi > up_lo) ? up_hi : up_lo;
+    if (c_md < up_min) up_min = c_md;
+    if (c_md > up_max) up_max = c_md;
+
+    int32_t o_min = s_lo - c_lo;
+    int32_t o_max = P - c_hi - s_hi;
+    if (up_max - P > o_min) o_min = up_max - P;
+    if (up_min < o_max) o_max = up_min;
+    const int32_t o_trig = P - 1 - (int32_t)(SVPWM_SHUNT_TMIN_TICKS + SVPWM_SHUNT_TS_TICKS) - c_md;
+    if (o_trig < o_max) o_max = o_trig;
+
+    if (o_min > o_max)
+    {
+        for (uint32_t k = 0; k < 3u; k++)
+            pSh->up[k] = pSh->dn[k] = ccr[k];
+        pSh->trig[0] = pSh->trig[1] = SVPWM_SHUNT_TRIG_OFF;
+        pSh->map = 0u;
+        return;
+    }
+    const int32_t o = (o_min > 0) ? o_min : ((o_max < 0) ? o_max : 0);
+
+    pSh->dn[hi] = (uint16_t)(c_hi + s_hi + o);
+    pSh->dn[md] = (uint16_t)(c_md + o);
+    pSh->dn[lo] = (uint16_t)(c_lo - s_lo + o);
+    pSh->up[hi] = (uint16_t)(up_hi - o);
+    pSh->up[md] = (uint16_t)(c_md - o);
+    pSh->up[lo] = (uint16_t)(up_lo - o);
+    pSh->trig[0] = (uint16_t)(c_md + o + (int32_t)SVPWM_SHUNT_TS_TICKS);
+    pSh->trig[1] = (uint16_t)(c_lo - s_lo + o + (int32_t)SVPWM_SHUNT_TS_TICKS);
+    pSh->map = (uint8_t)(hi | (lo << 2) | SVPWM_SHUNT_VALID);
+}
+
+/**
+ * @brief 주기 확산: LFSR 을 진행시켜 이번 PWM 주기의 ARR 선택
+ *
+ * x^16 + x^14 + x^13 + x^11 + 1 (탭 0xB400, 주기 65535). 한 주기에 8 비트를
+ * 새로 밀어 넣어 연속 주기의 편차가 서로 독립이 되도록 한다.
+ */
+CCMRAM_FUNC uint32_t SvpwmCore_SpreadArr(uint16_t *pLfsr, uint32_t arr, uint32_t span)
+{
+    uint16_t l = *pLfsr;
+    for (uint32_t i = 0; i < 8u; i++)
+        l = (uint16_t)((l >> 1) ^ ((l & 1u) ? 0xB400u : 0u));
+    *pLfsr = l;
+
+    int32_t r = (int32_t)(l & 0xFFu) - 128;            // -128 ~ 127
+    return (uint32_t)((int32_t)arr + r * (int32_t)span / 128);
+}
+
+/**
+ * @brief 기준 주기 CCR → 확산 주기 CCR (ON 비율 유지)
+ *
+ * 0 과 100% (arr+1) 는 반올림 없이 그대로 옮겨 고정 상이 스위칭하지 않게 한다.
+ */
+CCMRAM_FUNC uint16_t SvpwmCore_SpreadCcr(uint16_t ccr, uint32_t arr, uint32_t ratio, uint32_t arr_k)
+{
+    if (ccr >= arr + 1u) return (uint16_t)(arr_k + 1u);
+    return (uint16_t)(((uint32_t)ccr * ratio + 0x8000u) >> 16);
+}
+
+/**
+ * @brief 다음 PWM 주기의 ARR / CCR
+ *
+ * 확산이 꺼져 있으면 기준 값 그대로. 제어 루프는 항상 기준 주기로 CCR 을 계산하므로
+ * 확산 / 주기 변경 중에도 ON 비율은 이 한 곳에서만 환산된다.
+ */
+CCMRAM_FUNC uint32_t SvpwmCore_NextPeriod(SVPWM_Period_t *pPer, uint16_t ccr[3])
+{
+    const uint32_t arr = pPer->arr;
+    if (pPer->span == 0u)
+    {
+        ccr[0] = pPer->ccr[0];
+        ccr[1] = pPer->ccr[1];
+        ccr[2] = pPer->ccr[2];
+        return arr;
+    }
+
+    uint32_t arr_k = SvpwmCore_SpreadArr(&pPer->lfsr, arr, pPer->span);
+    uint32_t ratio = ((arr_k + 1u) << 16) / (arr + 1u);
+    ccr[0] = SvpwmCore_SpreadCcr(pPer->ccr[0], arr, ratio, arr_k);
+    ccr[1] = SvpwmCore_SpreadCcr(pPer->ccr[1], arr, ratio, arr_k);
+    ccr[2] = SvpwmCore_SpreadCcr(pPer->ccr[2], arr, ratio, arr_k);
+    return arr_k;
+}
+
+/**
+ * @brief PWM 주파수 스케줄: 전기 주파수 → ARR
+ */
+CCMRAM_FUNC uint32_t SvpwmCore_SchedArr(float f, float f_lo, float f_hi, uint32_t arr_lo, uint32_t arr_hi)
+{
+    if (!(f_hi > f_lo) || !(f < f_hi)) return arr_hi;     // 끔 / 고속 (NaN 포함)
+    if (f <= f_lo) return arr_lo;
+
+    float x = (f - f_lo) / (f_hi - f_lo);
+    float inv_lo = 1.0f / (float)(arr_lo + 1u);
+    float inv_hi = 1.0f / (float)(arr_hi + 1u);
+    uint32_t arr = (uint32_t)(1.0f / (inv_lo + x * (inv_hi - inv_lo)) + 0.5f) - 1u;
+
+    uint32_t a_min = (arr_lo < arr_hi) ? arr_lo : arr_hi;
+    uint32_t a_max = (arr_lo < arr_hi) ? arr_hi : arr_lo;
+    return (arr < a_min) ? a_min : ((arr > a_max) ? a_max : arr);
+}
@@ -0,0 +1,210 @@
+/**
+ * @file    telemetry.c
+ * @brief   텔레메트리 구현 - lock-free SPSC 링 버퍼 + UART DMA 드레인
+ *
+ *   생산자 (제어 ISR)          소비자 (메인 루프 / UART TX 완료 콜백)
+ *   Telem_Push ──▶ ring[head]   ring[tail] ──▶ HAL_UART_Transmit_DMA
+ *
+ * - head 는 생산자만, tail 은 소비자만 갱신한다 (free-running, 마스크로 인덱싱).
+ * - 메인 루프 생산자(Telem_Send)는 제어 ISR 을 BASEPRI 로 잠시 막아 단일 생산자를 유지한다.
+ * - 생산자는 공간이 부족하면 프레임을 버리고 dropped 를 증가시킨다 (대기 없음).
+ * - DMA 는 링의 연속 구간만 전송하고, 완료 콜백에서 tail 을 전진시킨 뒤
+ *   남은 데이터를 이어서 전송한다. 메인 루프는 유휴 상태일 때만 시작시킨다.
+ *
+ * 대역폭: 2 Mbaud ≈ 200 kB/s, Telem_Ctrl_t 프레임 33 byte × 1 kHz ≈ 33 kB/s
+ */
+
+#include "telemetry.h"
+#include "crc16.h"
+#include "app_config.h"
+#include "param.h"
+#include <string.h>
+
+#define RING_MASK       (TELEM_RING_SIZE - 1u)
+
+/* 링 버퍼 */
+static uint8_t ring[TELEM_RING_SIZE];
+static volatile uint32_t ring_head = 0;     // 생산자 쓰기 위치
+static volatile uint32_t ring_tail = 0;     // 소비자 읽기 위치
+static volatile uint32_t tx_len = 0;        // DMA 진행 중 길이 (0 = 유휴)
+
+static UART_HandleTypeDef *pUart = NULL;
+static uint8_t tx_seq = 0;
+
+/* 제어 샘플 간격 (PARAM_TELEM_DECIM) */
+static uint32_t ctrl_cnt = 0;
+static uint32_t ctrl_tick = 0;
+
+/* 통계 */
+static Telem_Stats_t telem_stats;
+
+static void Telem_Kick(void);
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+/**
+ * @brief 텔레메트리 초기화
+ * @param huart  출력 UART (LPUART1, hdmatx 연결 필요)
+ */
+void Telem_Init(UART_HandleTypeDef *huart)
+{
+    pUart = huart;
+
+    ring_head = 0;
+    ring_tail = 0;
+    tx_len = 0;
+    memset(&telem_stats, 0, sizeof(telem_stats));
+}
+
+/**
+ * @brief 프레임 기록 (단일 생산자: 제어 ISR, 논블로킹)
+ * @param type     TELEM_TYPE_xxx
+ * @param payload  페이로드 포인터
+ * @param len      페이로드 길이 (최대 TELEM_MAX_PAYLOAD)
+ * @return 1: 기록, 0: 공간 부족으로 버림
+ */
+CCMRAM_FUNC uint8_t Telem_Push(uint8_t type, const void *payload, uint32_t len)
+{
+    if (len > TELEM_MAX_PAYLOAD) return 0;
+
+    uint32_t frame_len = TELEM_HDR_SIZE + len + TELEM_CRC_SIZE;
+    uint32_t head = ring_head;
+    uint32_t used = head - ring_tail;
+
+    if (TELEM_RING_SIZE - used < frame_len)
+    {
+        telem_stats.dropped++;
+        return 0;
+    }
+
+    // 프레임을 임시 버퍼에서 조립 후 링으로 복사 (래핑은 복사 시에만 처리)
+    uint8_t frame[TELEM_HDR_SIZE + TELEM_MAX_PAYLOAD + TELEM_CRC_SIZE];
+    frame[0] = TELEM_SYNC0;
+    frame[1] = TELEM_SYNC1;
+    frame[2] = type;
+    frame[3] = tx_seq++;
+    frame[4] = (uint8_t)len;
+    memcpy(&frame[TELEM_HDR_SIZE], payload, len);
+
+    uint16_t crc = CRC16_Update(CRC16_INIT, &frame[2], 3u + len);
+    frame[TELEM_HDR_SIZE + len]      = (uint8_t)(crc & 0xFFu);
+    frame[TELEM_HDR_SIZE + len + 1u] = (uint8_t)(crc >> 8);
+
+    uint32_t idx = head & RING_MASK;
+    uint32_t first = TELEM_RING_SIZE - idx;
+    if (first >= frame_len)
+    {
+        memcpy(&ring[idx], frame, frame_len);
+    }
+    else
+    {
+        memcpy(&ring[idx], frame, first);
+        memcpy(&ring[0], &frame[first], frame_len - first);
+    }
+
+    // 데이터 기록 완료 후 head 공개
+    __DMB();
+    ring_head = head + frame_len;
+
+    telem_stats.frames++;
+    if (used + frame_len > telem_stats.ring_max) telem_stats.ring_max = used + frame_len;
+    return 1;
+}
+
+/**
+ * @brief 프레임 기록 (메인 루프용)
+ *
+ * 제어 ISR 과 같은 링에 쓰므로 기록 동안 BASEPRI 로 제어 ISR 이하만 마스킹한다
+ * (보호 인터럽트는 계속 선점 가능).
+ */
+uint8_t Telem_Send(uint8_t type, const void *payload, uint32_t len)
+{
+    uint32_t basepri = __get_BASEPRI();
+    __set_BASEPRI_MAX(IRQ_PRIO_CONTROL << (8u - __NVIC_PRIO_BITS));
+
+    uint8_t ok = Telem_Push(type, payload, len);
+
+    __set_BASEPRI(basepri);
+    return ok;
+}
+
+/**
+ * @brief 제어 루프 샘플 기록 (PARAM_TELEM_DECIM 스텝마다 1회)
+ * @param pSample  샘플 (tick 은 내부에서 채움)
+ */
+CCMRAM_FUNC void Telem_PushCtrl(Telem_Ctrl_t *pSample)
+{
+    ctrl_tick++;
+
+    uint32_t decim = Param_Active()->v[PARAM_TELEM_DECIM].u;
+    if (decim == 0) return;
+    if (++ctrl_cnt < decim) return;
+    ctrl_cnt = 0;
+
+    pSample->tick = ctrl_tick;
+    Telem_Push(TELEM_TYPE_CTRL, pSample, sizeof(Telem_Ctrl_t));
+}
+
+/**
+ * @brief 메인 루프 처리 - 유휴 시 DMA 전송 시작
+ *
+ * tx_len == 0 이면 진행 중인 전송이 없으므로 완료 콜백과 경합하지 않는다.
+ */
+void Telem_Process(void)
+{
+    if (pUart == NULL) return;
+    if (tx_len != 0) return;
+
+    Telem_Kick();
+}
+
+/**
+ * @brief 통계 반환 (디버깅용)
+ */
+Telem_Stats_t* Telem_GetStats(void)
+{
+    return &telem_stats;
+}
+
+/* ============================================================
+ * Private 함수
+ * ============================================================ */
+
+/**
+ * @brief 링의 연속 구간을 DMA 로 전송 시작
+ */
+static void Telem_Kick(void)
+{
+    uint32_t tail = ring_tail;
+    uint32_t avail = ring_head - tail;
+    if (avail == 0) return;
+
+    uint32_t idx = tail & RING_MASK;
+    uint32_t chunk = TELEM_RING_SIZE - idx;
+    if (chunk > avail) chunk = avail;
+
+    // 완료 콜백이 전송 직후 바로 올 수 있으므로 길이를 먼저 기록
+    tx_len = chunk;
+    if (HAL_UART_Transmit_DMA(pUart, &ring[idx], (uint16_t)chunk) != HAL_OK)
+        tx_len = 0;
+}
+
+/* ============================================================
+ * HAL 콜백
+ * ============================================================ */
+
+/**
+ * @brief UART 전송 완료 - tail 전진 후 남은 데이터 이어서 전송
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart != pUart) return;
+
+    ring_tail += tx_len;
+    telem_stats.tx_bytes += tx_len;
+    tx_len = 0;
+
+    Telem_Kick();
+}
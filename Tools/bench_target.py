@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""
+bench_target.py - 온타겟 커널 사이클 측정 및 예산 비교 (Core/Src/bench.c, CMD_BENCH)
+
+DWT 사이클은 실제 배치(CCM/FLASH), FPU, wait state 를 반영한다.
+control_isr 은 실제 제어 ISR (TIM6 → HAL_TIM_PeriodElapsedCallback → OpenLoop_Step) 을
+제어 주기마다 1 회 재므로 그때의 운전 경로가 측정된다 - 구동 중에 실행할 것.
+JSON 은 Tools/svpwm_bench.c 와 같은 Google Benchmark 형식 (+ cycle 필드).
+보드 없는 커밋별 추정은 Tools/emu/isr_cycles.py (control_isr_emu) - 이 실측으로 모델을 확인한다.
+
+사용 예:
+    python3 bench_target.py /dev/ttyACM0
+    python3 bench_target.py /dev/ttyACM0 --json cyc.json --label $(git rev-parse --short HEAD)
+
+    # 이전 커밋 결과 대비 평균 사이클이 5% 넘게 늘면 종료 코드 1
+    python3 bench_target.py /dev/ttyACM0 --baseline cyc_prev.json --tolerance 5
+"""
+
+import argparse
+import json
+import sys
+import time
+
+from motor_client import MotorClient, CommandError
+
+
+def main():
+    ap = argparse.ArgumentParser(description="온타겟 커널 사이클 벤치마크")
+    ap.add_argument("port")
+    ap.add_argument("--baud", type=int, default=2000000)
+    ap.add_argument("-n", "--iterations", type=int, default=1024)
+    ap.add_argument("--ctrl-hz", type=float, default=1000.0, help="제어 주기 (control_isr 예산 비율 계산)")
+    ap.add_argument("--json", help="결과 JSON 저장 경로")
+    ap.add_argument("--label", default="", help="JSON context 라벨 (예: 커밋 해시)")
+    ap.add_argument("--baseline", help="비교할 이전 JSON")
+    ap.add_argument("--tolerance", type=float, default=5.0, help="평균 사이클 증가 허용치 [%%]")
+    a = ap.parse_args()
+
+    results = []
+    with MotorClient(a.port, a.baud, timeout=1.0) as m:
+        for k in range(len(MotorClient.BENCH_KERNELS)):
+            try:
+                results.append(m.bench(k, a.iterations))
+            except (CommandError, TimeoutError) as e:
+                print(e, file=sys.stderr)
+                sys.exit(1)
+
+    clk = results[0]["clk_hz"]
+    print("clk %.0f MHz  ccmram %d  trig_lut %d" % (clk / 1e6, results[0]["ccmram"], results[0]["trig_lut"]))
+    print("%-20s %8s %8s %8s %10s" % ("kernel", "min", "avg", "max", "ns/op"))
+    for r in results:
+        print("%-20s %8d %8.1f %8d %10.1f" % (r["kernel"], r["min_cyc"], r["avg_cyc"], r["max_cyc"],
+                                              r["avg_cyc"] * 1e9 / clk))
+        if r["kernel"] == "control_isr":
+            period = clk / a.ctrl_hz
+            print("%-20s max %.1f%% / avg %.1f%% of the %.0f Hz control period" % (
+                "", r["max_cyc"] * 100.0 / period, r["avg_cyc"] * 100.0 / period, a.ctrl_hz))
+
+    if a.json:
+        doc = {"context": {"date": time.strftime("%Y-%m-%dT%H:%M:%S"), "label": a.label,
+                           "target": "STM32G431", "clk_hz": clk,
+                           "ccmram": results[0]["ccmram"], "trig_lut": results[0]["trig_lut"]},
+               "benchmarks": [{"name": r["kernel"], "iterations": r["iterations"],
+                               "real_time": r["avg_cyc"] * 1e9 / clk, "time_unit": "ns",
+                               "cpu_cycles": r["avg_cyc"], "min_cycles": r["min_cyc"],
+                               "max_cycles": r["max_cyc"],
+                               "items_per_second": clk / r["avg_cyc"] if r["avg_cyc"] else 0.0}
+                              for r in results]}
+        with open(a.json, "w") as f:
+            json.dump(doc, f, indent=2)
+
+    if a.baseline:
+        with open(a.baseline) as f:
+            base = {b["name"]: b["cpu_cycles"] for b in json.load(f)["benchmarks"]}
+        over = 0
+        for r in results:
+            if r["kernel"] not in base or base[r["kernel"]] <= 0:
+                continue
+            pct = (r["avg_cyc"] / base[r["kernel"]] - 1.0) * 100.0
+            flag = "  OVER" if pct > a.tolerance else ""
+            print("%-20s %8.1f → %8.1f cyc (%+.1f%%)%s" % (r["kernel"], base[r["kernel"]], r["avg_cyc"], pct, flag))
+            over += bool(flag)
+        sys.exit(1 if over else 0)
+
+
+if __name__ == "__main__":
+    main()
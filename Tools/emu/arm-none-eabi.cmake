@@ -0,0 +1,22 @@
+# arm-none-eabi 크로스 툴체인 (Tools/emu 전용, STM32CubeIDE 프로젝트 설정과 같은 코어 옵션)
+#   cmake -S Tools/emu -B build/emu     (CMakeLists.txt 가 이 파일을 기본 툴체인으로 지정)
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR arm)
+
+set(CMAKE_C_COMPILER   arm-none-eabi-gcc)
+set(CMAKE_ASM_COMPILER arm-none-eabi-gcc)
+set(CMAKE_OBJCOPY      arm-none-eabi-objcopy CACHE FILEPATH "")
+set(CMAKE_SIZE         arm-none-eabi-size    CACHE FILEPATH "")
+
+# 링크 없는 컴파일러 검사 (링커 스크립트 없이는 실행 파일을 만들 수 없음)
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+set(MCU_FLAGS "-mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard")
+set(CMAKE_C_FLAGS_INIT   "${MCU_FLAGS} -ffunction-sections -fdata-sections")
+set(CMAKE_ASM_FLAGS_INIT "${MCU_FLAGS} -x assembler-with-cpp")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "${MCU_FLAGS} --specs=nano.specs -Wl,--gc-sections")
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
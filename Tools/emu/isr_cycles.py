@@ -0,0 +1,673 @@
+#!/usr/bin/env python3
+"""
+isr_cycles.py - 제어 ISR 명령어 수 / Cortex-M4 사이클 추정 (Unicorn, 보드 없이 커밋마다)
+
+Tools/emu 의 isr_emu.elf (arm-none-eabi, 실제 링커 스크립트 / 스타트업 / -O 설정) 를
+리셋 벡터부터 실행하고 TIM6_DAC_IRQHandler 진입 ~ 복귀를 매 회 센다.
+
+사이클 모델 (Cortex-M4 TRM 표 3-1 기준, 0-wait 메모리 가정 위에 보정):
+  - 하한 lo : 분기 재적재 P=1, 인접 LDR/STR 파이프라인 1 cycle, FLASH 는 ART 캐시 적중
+  - 상한 hi : P=3, 파이프라인 없음, FLASH 명령 페치 / 데이터 읽기마다 wait state (캐시 미스)
+  - 공통    : 예외 진입 12 + 복귀 10, 주변장치 접근 +--periph-ws, UDIV/SDIV 는 피연산자 크기로
+              2 ~ 12, hi 는 ISR 이 FPU 를 쓰면 지연 스태킹 17 추가
+  CCM (0x10000000) 은 0-wait 이므로 핫패스가 전부 CCM 이면 lo 와 hi 의 차이는 P / 파이프라인 뿐이다.
+  DWT 측정 (bench_target.py control_isr) 과 비교해 모델을 확인할 것 - 이 값은 예산용 근사.
+
+주변장치 레지스터는 메모리 + 간단한 동작 (ADC 자기 해제 명령 비트 / ADRDY, TIM SR rc_w0 / EGR UG,
+ADC ISR · EXTI PR rc_w1, GPIO BSRR / BRR → ODR). SysTick 은 --tick-insn 명령마다 uwTick 증가.
+SRAM / CCM 은 시작 시 난수로 채운다 (0 초기화되지 않는 .ccmbss 사용 오류가 드러남).
+
+사용 예:
+    cmake -S Tools/emu -B build/emu && cmake --build build/emu --target isr_cycles
+    python3 isr_cycles.py build/emu/isr_emu.elf -n 256
+    python3 isr_cycles.py isr_emu.elf --budget-pct 30 --require-ccm --json cyc.json --label $(git rev-parse --short HEAD)
+    python3 isr_cycles.py isr_emu.elf --baseline cyc_prev.json --tolerance 5
+    python3 isr_cycles.py --selftest        # 명령 분류 / 주변장치 모델 (Unicorn 불필요)
+
+종료 코드: 0 통과, 1 예산 / CCM / 기준선 초과 또는 실행 오류, 2 사용법.
+"""
+
+import argparse
+import json
+import random
+import struct
+import sys
+import time
+from bisect import bisect_right
+
+# ============== 메모리 맵 (STM32G431RBTX_FLASH.ld, RM0440) ==============
+FLASH_BASE, FLASH_SIZE = 0x08000000, 0x20000
+SRAM_BASE, SRAM_SIZE = 0x20000000, 0x8000
+CCM_BASE, CCM_SIZE = 0x10000000, 0x4000
+SYS_BASE, SYS_SIZE = 0xE0000000, 0x100000
+PERIPH_MAP = ((0x40000000, 0x20000),        # APB1, APB2
+              (0x40020000, 0x10000),        # AHB1 (DMA, RCC, FLASH, CRC)
+              (0x48000000, 0x2000),         # AHB2 GPIOA~G
+              (0x50000000, 0x2000))         # AHB2 ADC12, DAC
+
+TIM_BASES = (0x40000000, 0x40000400, 0x40000800, 0x40001000, 0x40001400,
+             0x40012C00, 0x40013400, 0x40014000, 0x40014400, 0x40014800)
+TIM6_BASE = 0x40001000
+ADC_BASES = (0x50000000, 0x50000100)
+GPIO_FIRST, GPIO_LAST = 0x48000000, 0x48001800
+EXTI_PR = (0x40010414, 0x40010434)
+DMA_IFCR = {0x40020004: 0x40020000, 0x40020404: 0x40020400}
+
+CLK_HZ = 170e6
+
+# ============== 사이클 상수 ==============
+EXC_ENTRY, EXC_EXIT = 12, 10
+LAZY_FP_STACK = 17
+P_LO, P_HI = 1, 3
+
+# 명령 종류
+ALU, LD, ST, MULTI, BR, BRC, DIV = range(7)
+
+
+class Insn:
+    __slots__ = ("size", "kind", "cyc", "fp", "rn", "rm", "signed")
+
+    def __init__(self, size, kind, cyc=1, fp=False, rn=0, rm=0, signed=False):
+        self.size, self.kind, self.cyc, self.fp = size, kind, cyc, fp
+        self.rn, self.rm, self.signed = rn, rm, signed
+
+
+def _popcount(v):
+    return bin(v).count("1")
+
+
+def decode(hw1, hw2):
+    """Thumb-2 명령 → Insn (길이, 종류, 기본 사이클). BR/BRC 의 P, LD/ST 파이프라인, DIV 는 호출 측"""
+    if (hw1 >> 11) < 0b11101:
+        return _decode16(hw1)
+    return _decode32(hw1, hw2)
+
+
+def _decode16(h):
+    top = h >> 10
+    if top == 0b010001:                             # 특수 데이터 처리 / BX
+        op = (h >> 8) & 3
+        if op == 3:
+            return Insn(2, BR)                      # BX / BLX
+        rd = ((h >> 4) & 8) | (h & 7)
+        if op != 1 and rd == 15:
+            return Insn(2, BR)                      # ADD / MOV PC
+        return Insn(2, ALU)
+    if (h >> 11) == 0b01001:
+        return Insn(2, LD, 2)                       # LDR literal
+    if (h >> 12) == 0b0101:
+        return Insn(2, LD if ((h >> 9) & 7) >= 3 else ST, 2)
+    if (h >> 13) == 0b011 or (h >> 12) in (0b1000, 0b1001):
+        return Insn(2, LD if (h >> 11) & 1 else ST, 2)
+    if (h >> 12) == 0b1011:
+        if (h & 0xF500) == 0xB100:
+            return Insn(2, BRC)                     # CBZ / CBNZ
+        if (h & 0xFE00) == 0xB400:
+            return Insn(2, MULTI, 1 + _popcount(h & 0x1FF))             # PUSH
+        if (h & 0xFE00) == 0xBC00:
+            n = _popcount(h & 0x1FF)
+            return Insn(2, BR if h & 0x100 else MULTI, 1 + n)          # POP (PC 포함이면 분기)
+        return Insn(2, ALU)                         # IT / 힌트 / CPS / 확장
+    if (h >> 12) == 0b1100:
+        return Insn(2, MULTI, 1 + _popcount(h & 0xFF))                 # LDM / STM
+    if (h >> 12) == 0b1101:
+        if ((h >> 9) & 7) == 0b111:
+            return Insn(2, ALU)                     # SVC / UDF
+        return Insn(2, BRC)                         # B<c>
+    if (h >> 11) == 0b11100:
+        return Insn(2, BR)                          # B
+    return Insn(2, ALU)
+
+
+def _decode32(h1, h2):
+    op1 = (h1 >> 11) & 3
+    if op1 == 0b01:
+        if (h1 & 0xFE40) == 0xE800:                 # LDM / STM / PUSH.W / POP.W
+            n = _popcount(h2)
+            if (h1 & 0x10) and (h2 & 0x8000):
+                return Insn(4, BR, 1 + n)
+            return Insn(4, MULTI, 1 + n)
+        if (h1 & 0xFE40) == 0xE840:
+            if (h1 & 0xFFF0) == 0xE8D0 and (h2 & 0xFFE0) == 0xF000:
+                return Insn(4, BR, 2)               # TBB / TBH
+            if (h1 & 0xFF40) in (0xE840, 0xE8C0) and (h1 & 0x0120) == 0:
+                return Insn(4, LD, 2)               # LDREX / STREX 류
+            return Insn(4, MULTI, 3)                # LDRD / STRD
+        if (h1 & 0xEC00) == 0xEC00:
+            return _decode_cp(h1, h2)
+        return Insn(4, ALU)                         # 데이터 처리 (시프트 레지스터)
+    if op1 == 0b10:
+        if not (h2 & 0x8000):
+            return Insn(4, ALU)                     # 데이터 처리 (즉값)
+        op = (h2 >> 12) & 5
+        if op == 0b000:
+            if ((h1 >> 7) & 7) != 0b111:
+                return Insn(4, BRC)                 # B<c>.W
+            return Insn(4, ALU)                     # MSR / MRS / 힌트 / 배리어
+        return Insn(4, BR)                          # B.W / BL
+    # op1 == 0b11
+    if (h1 & 0xFF00) in (0xF800, 0xF900):          # 로드 / 스토어 단일
+        load = (h1 >> 4) & 1
+        if load and ((h2 >> 12) & 0xF) == 15 and (h1 & 0xFF70) in (0xF850, 0xF8D0):
+            return Insn(4, BR, 2)                   # LDR PC
+        return Insn(4, LD if load else ST, 2)
+    if (h1 & 0xFFF0) in (0xFB90, 0xFBB0):
+        return Insn(4, DIV, 2, rn=h1 & 0xF, rm=h2 & 0xF, signed=(h1 & 0xFFF0) == 0xFB90)
+    if (h1 & 0xFC00) == 0xFC00:
+        return _decode_cp(h1, h2)
+    return Insn(4, ALU)                             # 곱셈 / 데이터 처리 (레지스터)
+
+
+def _decode_cp(h1, h2):
+    """코프로세서 공간 - FPU (cp10/11) 만 구분"""
+    if ((h2 >> 9) & 7) != 0b101:
+        return Insn(4, ALU)
+    if (h1 & 0xFE00) == 0xEC00:                    # 확장 레지스터 로드 / 스토어
+        if (h1 & 0xFFE0) == 0xEC40:
+            return Insn(4, ALU, 2, fp=True)         # VMOV 코어 2 ↔ S/D
+        load = (h1 >> 4) & 1
+        if (h1 & 0x0120) == 0x0100:                 # VLDR / VSTR
+            return Insn(4, LD if load else ST, 2, fp=True)
+        return Insn(4, MULTI, 1 + (h2 & 0xFF), fp=True)                # VLDM / VSTM / VPUSH / VPOP
+    if (h1 & 0xFF00) == 0xEE00:
+        if h2 & 0x10:
+            return Insn(4, ALU, 1, fp=True)         # VMOV 코어 ↔ S, VMRS / VMSR
+        opc1 = ((h1 >> 4) & 0x3) | ((h1 >> 5) & 0x4)
+        if opc1 in (0b000, 0b001, 0b101, 0b110):
+            return Insn(4, ALU, 3, fp=True)         # VMLA / VMLS / VNMLA / VNMLS / VFMA / VFNMA
+        if opc1 == 0b100:
+            return Insn(4, ALU, 14, fp=True)        # VDIV
+        if opc1 == 0b111 and (h1 & 0xF) == 0b0001 and ((h2 >> 6) & 3) == 0b11:
+            return Insn(4, ALU, 14, fp=True)        # VSQRT
+        return Insn(4, ALU, 1, fp=True)             # VADD / VSUB / VMUL / VNMUL / VMOV / VABS / VNEG / VCMP / VCVT
+    return Insn(4, ALU, 1, fp=True)
+
+
+def div_cycles(n, m, signed):
+    """UDIV / SDIV: 몫 비트 수에 따른 조기 종료 근사 (2 ~ 12)"""
+    if signed:
+        n = abs(n - (1 << 32) if n & 0x80000000 else n)
+        m = abs(m - (1 << 32) if m & 0x80000000 else m)
+    if m == 0 or n < m:
+        return 2
+    return min(12, 2 + ((n // m).bit_length() * 10 + 31) // 32)
+
+
+# ============== 주변장치 모델 ==============
+class Periph:
+    """주변장치 레지스터 = 워드 저장소 + 펌웨어가 기다리는 비트 동작"""
+
+    def __init__(self):
+        self.regs = {}
+
+    def read(self, addr, size):
+        word = self.regs.get(addr & ~3, 0)
+        sh = (addr & 3) * 8
+        return (word >> sh) & ((1 << (8 * size)) - 1)
+
+    def write(self, addr, size, value):
+        a = addr & ~3
+        sh = (addr & 3) * 8
+        mask = (((1 << (8 * size)) - 1) << sh) & 0xFFFFFFFF
+        wv = (value << sh) & mask
+        old = self.regs.get(a, 0)
+        self.regs[a] = self._apply(a, old, (old & ~mask) | wv, wv) & 0xFFFFFFFF
+
+    def _apply(self, a, old, new, wv):
+        base, off = a & ~0x3FF, a & 0x3FF
+        if base in TIM_BASES:
+            if off == 0x10:
+                return old & new                                       # SR rc_w0
+            if off == 0x14:
+                if wv & 1:
+                    self.regs[base + 0x10] = self.regs.get(base + 0x10, 0) | 1   # UG → UIF
+                return 0
+        adc = a & ~0xFF
+        if adc in ADC_BASES:
+            if a == adc:
+                return old & ~wv                                   # ISR rc_w1
+            if a == adc + 0x08:
+                if new & (1 << 31):
+                    new &= ~(1 << 31)                              # ADCAL 즉시 완료
+                if new & 0x2:
+                    new &= ~0x3                                    # ADDIS → ADEN 해제
+                if new & 0x1:
+                    self.regs[adc] = self.regs.get(adc, 0) | 0x1   # ADEN → ADRDY
+                if new & 0x10:
+                    new &= ~0x14                                   # ADSTP → ADSTART 해제
+                if new & 0x20:
+                    new &= ~0x28                                   # JADSTP → JADSTART 해제
+                return new
+        if GPIO_FIRST <= a < GPIO_LAST:
+            odr = (a & ~0x3FF) + 0x14
+            if off == 0x18:
+                self.regs[odr] = (self.regs.get(odr, 0) | (wv & 0xFFFF)) & ~(wv >> 16)
+                return 0
+            if off == 0x28:
+                self.regs[odr] = self.regs.get(odr, 0) & ~wv
+                return 0
+        if a in EXTI_PR:
+            return old & ~wv
+        if a in DMA_IFCR:
+            isr = DMA_IFCR[a]
+            self.regs[isr] = self.regs.get(isr, 0) & ~wv
+            return 0
+        return new
+
+
+# ============== ELF ==============
+class Elf:
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        d = self.data
+        if d[:4] != b"\x7fELF" or d[4] != 1 or d[5] != 1 or struct.unpack_from("<H", d, 18)[0] != 40:
+            raise ValueError("%s: ELF32 little-endian ARM 이 아님" % path)
+        self.entry = struct.unpack_from("<I", d, 24)[0]
+        phoff, shoff = struct.unpack_from("<II", d, 28)
+        phentsize, phnum, shentsize, shnum = struct.unpack_from("<HHHH", d, 42)
+        self.segments = []
+        for i in range(phnum):
+            p_type, off, _vaddr, paddr, filesz, _memsz, _flags, _align = \
+                struct.unpack_from("<8I", d, phoff + i * phentsize)
+            if p_type == 1 and filesz:
+                self.segments.append((paddr, d[off:off + filesz]))
+        secs = [struct.unpack_from("<10I", d, shoff + i * shentsize) for i in range(shnum)]
+        self.symbols = {}
+        self.funcs = []
+        for s in secs:
+            if s[1] != 2:                           # SHT_SYMTAB
+                continue
+            strtab = secs[s[6]]
+            for k in range(s[5] // 16):
+                name_off, value, size, info, _other, _shndx = struct.unpack_from("<IIIBBH", d, s[4] + k * 16)
+                end = d.index(b"\0", strtab[4] + name_off)
+                name = d[strtab[4] + name_off:end].decode("ascii", "replace")
+                if not name or (info & 0xF) not in (1, 2):
+                    continue
+                if (info & 0xF) == 2:
+                    self.funcs.append((value & ~1, size, name))
+                if name not in self.symbols or (info >> 4) == 1:
+                    self.symbols[name] = value
+        self.funcs.sort()
+        self._starts = [f[0] for f in self.funcs]
+
+    def sym(self, name):
+        if name not in self.symbols:
+            raise KeyError("심볼 없음: %s" % name)
+        return self.symbols[name]
+
+    def func_at(self, addr):
+        i = bisect_right(self._starts, addr) - 1
+        if i >= 0 and addr < self.funcs[i][0] + max(self.funcs[i][1], 2):
+            return self.funcs[i][2]
+        return "0x%08x" % addr
+
+
+# ============== 측정 ==============
+class Meter:
+    """TIM6 ISR 1 회 = 진입 주소 ~ 복귀 주소 (LR)"""
+
+    def __init__(self, elf, entry, flash_ws, periph_ws):
+        self.elf = elf
+        self.entry = entry & ~1
+        self.flash_ws = flash_ws
+        self.periph_ws = periph_ws
+        self.cache = {}
+        self.ret = None
+        self.runs = []
+        self.flash_funcs = {}
+        from unicorn import arm_const as A
+        self.regs = [getattr(A, "UC_ARM_REG_R%d" % i) for i in range(13)] + \
+                    [A.UC_ARM_REG_SP, A.UC_ARM_REG_LR, A.UC_ARM_REG_PC]
+
+    def begin(self, lr):
+        self.ret = lr & ~1
+        self.n = 0
+        self.lo = EXC_ENTRY + EXC_EXIT
+        self.hi = EXC_ENTRY + EXC_EXIT
+        self.fp = False
+        self.prev = None
+        self.prev_end = None
+        self.line = None
+        self.line_cyc = 0
+        self.flash_n = 0
+
+    def insn(self, uc, addr):
+        if self.ret is None:
+            if addr == self.entry:
+                from unicorn.arm_const import UC_ARM_REG_LR
+                self.begin(uc.reg_read(UC_ARM_REG_LR))
+            else:
+                return
+        taken = self.prev_end is not None and addr != self.prev_end
+        self._close_prev(taken)
+        if addr == self.ret:
+            self.runs.append((self.n, self.lo, self.hi + (LAZY_FP_STACK if self.fp else 0), self.flash_n))
+            self.ret = None
+            self.prev = self.prev_end = None
+            return
+
+        ins = self.cache.get(addr)
+        if ins is None:
+            raw = bytes(uc.mem_read(addr, 4))
+            hw1, hw2 = struct.unpack("<HH", raw)
+            ins = self.cache[addr] = decode(hw1, hw2)
+        cyc = ins.cyc
+        if ins.kind == DIV:
+            cyc = div_cycles(uc.reg_read(self.regs[ins.rn]), uc.reg_read(self.regs[ins.rm]), ins.signed)
+        lo = hi = cyc
+        if ins.kind in (LD, ST) and self.prev is not None and self.prev.kind in (LD, ST):
+            lo = 1                                  # 인접 단일 로드/스토어 파이프라인
+        if FLASH_BASE <= addr < FLASH_BASE + FLASH_SIZE:
+            self.flash_n += 1
+            name = self.elf.func_at(addr)
+            self.flash_funcs[name] = self.flash_funcs.get(name, 0) + 1
+            if taken or self.line is None:
+                hi += self.flash_ws                 # 분기 대상 라인 미스
+            elif (addr >> 3) != self.line:
+                hi += max(0, self.flash_ws - self.line_cyc)     # 순차 프리페치가 덜 가린 만큼
+            if (addr >> 3) != self.line:
+                self.line, self.line_cyc = addr >> 3, 0
+            self.line_cyc += hi
+        else:
+            self.line = None
+        self.n += 1
+        self.lo += lo
+        self.hi += hi
+        self.fp |= ins.fp
+        self.prev = ins
+        self.prev_end = addr + ins.size
+
+    def _close_prev(self, taken):
+        p = self.prev
+        if p is None:
+            return
+        if p.kind == BR or (p.kind == BRC and taken):
+            self.lo += P_LO
+            self.hi += P_HI
+
+    def mem(self, addr, is_read):
+        if self.ret is None:
+            return
+        if FLASH_BASE <= addr < FLASH_BASE + FLASH_SIZE and is_read:
+            self.hi += self.flash_ws                # 상수 / 리터럴 풀 (캐시 미스 가정)
+        elif addr >= 0x40000000 and addr < 0x60000000:
+            self.lo += self.periph_ws
+            self.hi += self.periph_ws
+
+
+def run(a):
+    from unicorn import (Uc, UcError, UC_ARCH_ARM, UC_MODE_THUMB, UC_MODE_MCLASS, UC_HOOK_CODE,
+                         UC_HOOK_MEM_READ, UC_HOOK_MEM_WRITE, UC_MEM_READ, UC_PROT_ALL)
+    from unicorn import arm_const as A
+
+    elf = Elf(a.elf)
+    uc = Uc(UC_ARCH_ARM, UC_MODE_THUMB | UC_MODE_MCLASS)
+    if hasattr(A, "UC_CPU_ARM_CORTEX_M4"):
+        uc.ctl_set_cpu_model(A.UC_CPU_ARM_CORTEX_M4)
+
+    rnd = random.Random(a.seed)
+    uc.mem_map(FLASH_BASE, FLASH_SIZE, UC_PROT_ALL)
+    for base, size in ((SRAM_BASE, SRAM_SIZE), (CCM_BASE, CCM_SIZE)):
+        uc.mem_map(base, size, UC_PROT_ALL)
+        uc.mem_write(base, bytes(rnd.getrandbits(8) for _ in range(size)))
+    try:
+        uc.mem_map(SYS_BASE, SYS_SIZE, UC_PROT_ALL)  # SCB / NVIC / SysTick / DWT 는 일반 메모리
+    except UcError:
+        pass
+    periph = Periph()
+    for base, size in PERIPH_MAP:
+        uc.mmio_map(base, size,
+                    lambda _uc, off, size, b: periph.read(b + off, size), base,
+                    lambda _uc, off, size, value, b: periph.write(b + off, size, value), base)
+    for paddr, blob in elf.segments:
+        uc.mem_write(paddr, blob)
+
+    sp, pc = struct.unpack("<II", bytes(uc.mem_read(FLASH_BASE, 8)))
+    uc.reg_write(A.UC_ARM_REG_SP, sp)
+
+    # main 진입: 실행 파라미터와 ADC DMA 버퍼 (Sense_Init 첫 샘플부터 정상 버스 전압)
+    main_addr = elf.sym("main") & ~1
+    mid = 1 << 11
+    vbus_code = int(round(a.vbus / 11.0 / 3.3 * 4095.0))
+
+    def on_main(uc_, addr, _size, _ud):
+        if addr != main_addr:
+            return
+        uc_.mem_write(elf.sym("emu_iter"), struct.pack("<I", a.iterations))
+        uc_.mem_write(elf.sym("emu_freq_hz"), struct.pack("<f", a.freq))
+        uc_.mem_write(elf.sym("emu_volt"), struct.pack("<f", a.volt))
+        uc_.mem_write(elf.sym("adc_dma_buf"), struct.pack("<II", mid | (mid << 16), vbus_code))
+    uc.hook_add(UC_HOOK_CODE, on_main, None, main_addr, main_addr)
+
+    tick = elf.sym("uwTick")
+    fail = {elf.sym(n) & ~1: n for n in ("Error_Handler", "HardFault_Handler", "Default_Handler")
+            if n in elf.symbols}
+
+    def go(until, limit):
+        """count 명령마다 멈춰 uwTick 증가 (HAL_Delay / 타임아웃 폴링 진행)"""
+        cur = pc
+        total = 0
+        while True:
+            uc.emu_start(cur | 1, until, count=a.tick_insn)
+            cur = uc.reg_read(A.UC_ARM_REG_PC)
+            if cur == until:
+                return cur
+            if cur in fail:
+                raise RuntimeError("%s 진입 (초기화 / 실행 실패)" % fail[cur])
+            t = struct.unpack("<I", bytes(uc.mem_read(tick, 4)))[0]
+            uc.mem_write(tick, struct.pack("<I", (t + 1) & 0xFFFFFFFF))
+            total += a.tick_insn
+            if total > limit:
+                raise RuntimeError("%d 명령 안에 %s 에 닿지 못함 (PC 0x%08x, %s)" %
+                                   (limit, hex(until), cur, elf.func_at(cur)))
+
+    try:
+        pc = go(elf.sym("Emu_Ready") & ~1, a.max_insn)
+
+        meter = Meter(elf, elf.sym(a.func), a.flash_ws, a.periph_ws)
+        uc.hook_add(UC_HOOK_CODE, lambda uc_, addr, _s, _u: meter.insn(uc_, addr))
+        uc.hook_add(UC_HOOK_MEM_READ | UC_HOOK_MEM_WRITE,
+                    lambda _uc, acc, addr, _s, _v, _u: meter.mem(addr, acc == UC_MEM_READ))
+        pc = go(elf.sym("Emu_Done") & ~1, a.max_insn + a.iterations * 100000)
+    except UcError as e:
+        cur = uc.reg_read(A.UC_ARM_REG_PC)
+        raise RuntimeError("에뮬레이션 오류 %s (PC 0x%08x, %s)" % (e, cur, elf.func_at(cur)))
+    return meter
+
+
+def report(a, meter):
+    runs = meter.runs
+    if len(runs) != a.iterations:
+        print("측정 %d 회 (요청 %d)" % (len(runs), a.iterations), file=sys.stderr)
+        return None
+    cols = list(zip(*runs))
+    stat = [(min(c), sum(c) / len(c), max(c)) for c in cols[:3]]
+    period = CLK_HZ / a.ctrl_hz
+    print("%s x %d  (%.1f Hz, %.2f V, flash ws %d, periph ws %d)" % (
+        a.func, len(runs), a.freq, a.volt, a.flash_ws, a.periph_ws))
+    print("%-10s %8s %10s %8s" % ("", "min", "avg", "max"))
+    for name, (mn, av, mx) in zip(("instr", "cycles lo", "cycles hi"), stat):
+        print("%-10s %8d %10.1f %8d" % (name, mn, av, mx))
+    print("budget     hi max %.1f%% / avg %.1f%% of the %.0f Hz control period (%d cyc)" % (
+        stat[2][2] * 100.0 / period, stat[2][1] * 100.0 / period, a.ctrl_hz, period))
+    flash_n = sum(cols[3])
+    if flash_n:
+        top = sorted(meter.flash_funcs.items(), key=lambda kv: -kv[1])[:8]
+        print("flash      %d instr in FLASH: %s" % (flash_n, ", ".join("%s %d" % kv for kv in top)))
+    else:
+        print("flash      0 instr (ISR 경로 전부 CCM / SRAM)")
+    return {"instr": stat[0], "lo": stat[1], "hi": stat[2], "flash": flash_n, "period": period}
+
+
+def selftest():
+    ok = True
+
+    def check(name, cond):
+        nonlocal ok
+        print("%s %s" % ("ok  " if cond else "FAIL", name))
+        ok &= bool(cond)
+
+    cases = [
+        ("BX LR",            0x4770, 0,      2, BR,    1),
+        ("PUSH {r7,lr}",     0xB580, 0,      2, MULTI, 3),
+        ("POP {r4,r7,pc}",   0xBD90, 0,      2, BR,    4),
+        ("LDR r0,[r3]",      0x6818, 0,      2, LD,    2),
+        ("STR r0,[r3]",      0x6018, 0,      2, ST,    2),
+        ("LDRB r0,[r1,r2]",  0x5C88, 0,      2, LD,    2),
+        ("STRH r0,[r1,r2]",  0x5288, 0,      2, ST,    2),
+        ("LDR r0,[pc,#4]",   0x4801, 0,      2, LD,    2),
+        ("BEQ",              0xD001, 0,      2, BRC,   1),
+        ("B",                0xE7FE, 0,      2, BR,    1),
+        ("CBZ r0",           0xB100, 0,      2, BRC,   1),
+        ("ADD pc,r0",        0x4487, 0,      2, BR,    1),
+        ("CPSID i",          0xB672, 0,      2, ALU,   1),
+        ("ADDS r0,#1",       0x3001, 0,      2, ALU,   1),
+        ("VADD.F32",         0xEE30, 0x0A20, 4, ALU,   1),
+        ("VMUL.F32",         0xEE20, 0x0A20, 4, ALU,   1),
+        ("VMLA.F32",         0xEE00, 0x0A81, 4, ALU,   3),
+        ("VFMA.F32",         0xEEA0, 0x0A81, 4, ALU,   3),
+        ("VDIV.F32",         0xEE80, 0x0A20, 4, ALU,   14),
+        ("VSQRT.F32",        0xEEB1, 0x0AC0, 4, ALU,   14),
+        ("VCVT.S32.F32",     0xEEBD, 0x0AC0, 4, ALU,   1),
+        ("VMOV s0,r0",       0xEE00, 0x0A10, 4, ALU,   1),
+        ("VMRS APSR",        0xEEF1, 0xFA10, 4, ALU,   1),
+        ("VLDR s0,[r0]",     0xED90, 0x0A00, 4, LD,    2),
+        ("VSTR s0,[r0]",     0xED80, 0x0A00, 4, ST,    2),
+        ("VPUSH {s16,s17}",  0xED2D, 0x8A02, 4, MULTI, 3),
+        ("UDIV",             0xFBB0, 0xF0F1, 4, DIV,   2),
+        ("SDIV",             0xFB90, 0xF0F1, 4, DIV,   2),
+        ("MUL.W",            0xFB00, 0xF001, 4, ALU,   1),
+        ("BL",               0xF000, 0xF800, 4, BR,    1),
+        ("BEQ.W",            0xF000, 0x8000, 4, BRC,   1),
+        ("B.W",              0xF000, 0xB800, 4, BR,    1),
+        ("MRS r0,PRIMASK",   0xF3EF, 0x8010, 4, ALU,   1),
+        ("MSR PRIMASK,r0",   0xF380, 0x8810, 4, ALU,   1),
+        ("LDR.W r0,[r1,#4]", 0xF8D1, 0x0004, 4, LD,    2),
+        ("STR.W r0,[r1,#4]", 0xF8C1, 0x0004, 4, ST,    2),
+        ("LDR.W pc,[r1,#4]", 0xF8D1, 0xF004, 4, BR,    2),
+        ("LDRD r2,r3,[r0]",  0xE9D0, 0x2300, 4, MULTI, 3),
+        ("PUSH.W {r4-r11,lr}", 0xE92D, 0x4FF0, 4, MULTI, 10),
+        ("POP.W {r4-r11,pc}",  0xE8BD, 0x8FF0, 4, BR,  10),
+        ("TBB [pc,r0]",      0xE8DF, 0xF000, 4, BR,    2),
+        ("AND.W r0,r1,#1",   0xF001, 0x0001, 4, ALU,   1),
+    ]
+    for name, h1, h2, size, kind, cyc in cases:
+        i = decode(h1, h2)
+        check("decode %-20s size %d kind %d cyc %d" % (name, i.size, i.kind, i.cyc),
+              (i.size, i.kind, i.cyc) == (size, kind, cyc))
+    check("fp flag VADD / not LDR", decode(0xEE30, 0x0A20).fp and not decode(0x6818, 0).fp)
+
+    check("div 100/7 early", div_cycles(100, 7, False) == 4)
+    check("div n<m", div_cycles(3, 7, False) == 2)
+    check("div 2^32-1 / 1 = 12", div_cycles(0xFFFFFFFF, 1, False) == 12)
+    check("sdiv -100/7", div_cycles((-100) & 0xFFFFFFFF, 7, True) == 4)
+
+    p = Periph()
+    p.write(TIM6_BASE + 0x10, 4, 0xFFFFFFFF)
+    check("TIM SR ignores 1 writes", p.read(TIM6_BASE + 0x10, 4) == 0)
+    p.write(TIM6_BASE + 0x14, 4, 1)
+    check("TIM EGR UG sets UIF", p.read(TIM6_BASE + 0x10, 4) == 1 and p.read(TIM6_BASE + 0x14, 4) == 0)
+    p.write(TIM6_BASE + 0x10, 4, 0xFFFFFFFE)
+    check("TIM SR rc_w0 clears UIF", p.read(TIM6_BASE + 0x10, 4) == 0)
+    adc = ADC_BASES[0]
+    p.write(adc + 0x08, 4, (1 << 31) | (1 << 28))
+    check("ADC ADCAL self-clears", p.read(adc + 0x08, 4) == (1 << 28))
+    p.write(adc + 0x08, 4, (1 << 28) | 1)
+    check("ADC ADEN sets ADRDY", p.read(adc, 4) & 1)
+    p.write(adc, 4, 1)
+    check("ADC ISR rc_w1", p.read(adc, 4) == 0)
+    p.write(adc + 0x08, 4, (1 << 28) | 1 | 0x8)
+    p.write(adc + 0x08, 4, (1 << 28) | 1 | 0x8 | 0x20)
+    check("ADC JADSTP clears JADSTART", p.read(adc + 0x08, 4) == (1 << 28) | 1)
+    gpio = GPIO_FIRST + 0x400
+    p.write(gpio + 0x18, 4, 1 << 5)
+    check("GPIO BSRR set", p.read(gpio + 0x14, 4) == 1 << 5)
+    p.write(gpio + 0x18, 2, 1 << 3)
+    p.write(gpio + 0x1A, 2, 1 << 5)
+    check("GPIO BSRR halfword set / reset", p.read(gpio + 0x14, 4) == 1 << 3)
+    p.write(gpio + 0x28, 4, 1 << 3)
+    check("GPIO BRR", p.read(gpio + 0x14, 4) == 0)
+    p.write(0x50000800, 1, 0xAB)
+    check("plain register byte write", p.read(0x50000800, 4) == 0xAB)
+
+    print("PASS" if ok else "FAIL")
+    return 0 if ok else 1
+
+
+def main():
+    ap = argparse.ArgumentParser(description="제어 ISR 명령어 / 사이클 추정 (Unicorn)")
+    ap.add_argument("elf", nargs="?", help="Tools/emu 빌드의 isr_emu.elf")
+    ap.add_argument("-n", "--iterations", type=int, default=256)
+    ap.add_argument("--func", default="TIM6_DAC_IRQHandler", help="잴 함수 (진입 ~ 복귀)")
+    ap.add_argument("--freq", type=float, default=20.0, help="오픈루프 전기 주파수 [Hz]")
+    ap.add_argument("--volt", type=float, default=1.5, help="오픈루프 전압 [V]")
+    ap.add_argument("--vbus", type=float, default=12.0, help="ADC 버스 전압 [V]")
+    ap.add_argument("--ctrl-hz", type=float, default=1000.0, help="제어 주기 (예산 비율 계산)")
+    ap.add_argument("--flash-ws", type=int, default=4, help="FLASH wait state (170 MHz: 4)")
+    ap.add_argument("--periph-ws", type=int, default=2, help="주변장치 접근당 추가 cycle (AHB-APB 브리지)")
+    ap.add_argument("--tick-insn", type=int, default=20000, help="uwTick 1 증가당 명령 수")
+    ap.add_argument("--max-insn", type=int, default=50000000, help="초기화 명령 수 상한")
+    ap.add_argument("--seed", type=int, default=1, help="SRAM / CCM 초기 난수")
+    ap.add_argument("--budget-pct", type=float, help="hi 최대가 제어 주기의 이 비율 [%%] 을 넘으면 실패")
+    ap.add_argument("--require-ccm", action="store_true", help="ISR 중 FLASH 명령이 하나라도 있으면 실패")
+    ap.add_argument("--json", help="결과 JSON 저장 경로 (bench_target.py 와 같은 형식)")
+    ap.add_argument("--label", default="", help="JSON context 라벨 (예: 커밋 해시)")
+    ap.add_argument("--baseline", help="비교할 이전 JSON")
+    ap.add_argument("--tolerance", type=float, default=5.0, help="평균 hi 사이클 증가 허용치 [%%]")
+    ap.add_argument("--selftest", action="store_true", help="명령 분류 / 주변장치 모델 검사 (Unicorn 불필요)")
+    a = ap.parse_args()
+
+    if a.selftest:
+        sys.exit(selftest())
+    if not a.elf or a.iterations < 1:
+        ap.print_usage(sys.stderr)
+        sys.exit(2)
+
+    try:
+        meter = run(a)
+    except ImportError:
+        print("unicorn 모듈 필요: pip install unicorn", file=sys.stderr)
+        sys.exit(1)
+    except (RuntimeError, KeyError, ValueError) as e:
+        print(e, file=sys.stderr)
+        sys.exit(1)
+    r = report(a, meter)
+    if r is None:
+        sys.exit(1)
+
+    fail = 0
+    if a.budget_pct is not None and r["hi"][2] > r["period"] * a.budget_pct / 100.0:
+        print("OVER budget: hi max %d > %.1f%% of %d cyc" % (r["hi"][2], a.budget_pct, r["period"]))
+        fail = 1
+    if a.require_ccm and r["flash"]:
+        print("FAIL ISR runs from FLASH")
+        fail = 1
+
+    if a.json:
+        doc = {"context": {"date": time.strftime("%Y-%m-%dT%H:%M:%S"), "label": a.label,
+                           "target": "STM32G431 (unicorn model)", "clk_hz": CLK_HZ,
+                           "flash_ws": a.flash_ws, "periph_ws": a.periph_ws},
+               "benchmarks": [{"name": "control_isr_emu", "iterations": a.iterations,
+                               "real_time": r["hi"][1] * 1e9 / CLK_HZ, "time_unit": "ns",
+                               "cpu_cycles": r["hi"][1], "min_cycles": r["hi"][0], "max_cycles": r["hi"][2],
+                               "cycles_lo": r["lo"][1], "instructions": r["instr"][1],
+                               "flash_instructions": r["flash"]}]}
+        with open(a.json, "w") as f:
+            json.dump(doc, f, indent=2)
+
+    if a.baseline:
+        with open(a.baseline) as f:
+            base = {b["name"]: b["cpu_cycles"] for b in json.load(f)["benchmarks"]}
+        prev = base.get("control_isr_emu", 0)
+        if prev > 0:
+            pct = (r["hi"][1] / prev - 1.0) * 100.0
+            flag = "  OVER" if pct > a.tolerance else ""
+            print("%-20s %8.1f → %8.1f cyc (%+.1f%%)%s" % ("control_isr_emu", prev, r["hi"][1], pct, flag))
+            fail |= bool(flag)
+    sys.exit(fail)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,90 @@
+/**
+ * @file    isr_emu.c
+ * @brief   제어 ISR 명령어 / 사이클 추정 하네스 (arm-none-eabi 빌드, Unicorn 에서 실행)
+ *
+ * 실제 링커 스크립트 (CCM 배치 포함) 와 스타트업으로 링크한 이미지를 isr_cycles.py 가
+ * 리셋 벡터부터 에뮬레이션한다. main.c 는 -Dmain=Fw_Main 으로 함께 링크해 핸들과
+ * Error_Handler 만 쓰고, 클럭 / CubeMX 주변장치 초기화는 건너뛴다 (주변장치 레지스터는
+ * isr_cycles.py 의 간단한 모델 - 자기 해제 비트, rc_w0 / rc_w1, BSRR).
+ *
+ *   Reset_Handler → SystemInit (FPU) → .data / .ccmram 복사, .bss 0 → main (이 파일)
+ *     → 제어 경로 초기화 (main.c USER CODE 2 와 같은 순서) → Emu_Ready()
+ *     → emu_iter 회: TIM6 UG → UIF, 텔레메트리 링 비움 → TIM6_DAC_IRQHandler()
+ *     → Emu_Done()
+ *
+ * isr_cycles.py 가 main 진입 시 emu_iter / emu_freq_hz / emu_volt 와 ADC DMA 버퍼를 쓰고,
+ * TIM6_DAC_IRQHandler 진입부터 복귀까지를 1 회로 센다. 링을 매 회 비우므로 텔레메트리는
+ * 항상 기록 경로 (Telem_Push 복사) 로 잰다. 스코프는 대기 상태 (운전 중 기본 경로).
+ */
+
+#include "main.h"
+#include "app_config.h"
+#include "param.h"
+#include "protect.h"
+#include "sense.h"
+#include "svpwm.h"
+#include "scope.h"
+#include "telemetry.h"
+#include "cpu_load.h"
+#include "stm32g4xx_it.h"
+
+extern ADC_HandleTypeDef hadc1;
+extern ADC_HandleTypeDef hadc2;
+extern DMA_HandleTypeDef hdma_adc1;
+extern UART_HandleTypeDef hlpuart1;
+extern TIM_HandleTypeDef htim3;
+extern TIM_HandleTypeDef htim6;
+
+/* isr_cycles.py 가 main 진입 시 덮어쓴다 */
+volatile uint32_t emu_iter = 256u;
+volatile float    emu_freq_hz = 20.0f;
+volatile float    emu_volt = 1.5f;
+
+/* 초기화 완료 / 측정 종료 지점 (isr_cycles.py 의 정지 주소) */
+__attribute__((noinline)) void Emu_Ready(void)
+{
+    __NOP();
+}
+
+__attribute__((noinline)) void Emu_Done(void)
+{
+    __NOP();
+}
+
+int main(void)
+{
+    // MX_xxx_Init 이 채우던 핸들 중 제어 경로가 쓰는 것만
+    hadc1.Instance = ADC1;
+    hadc2.Instance = ADC2;
+    hadc1.DMA_Handle = &hdma_adc1;
+    hdma_adc1.Instance = DMA1_Channel1;
+    hdma_adc1.Parent = &hadc1;
+    hlpuart1.Instance = LPUART1;
+    htim3.Instance = TIM3;
+    htim6.Instance = TIM6;
+
+    Param_Init();
+    Telem_Init(&hlpuart1);
+    Protect_Init(&htim3, &hadc1, &hadc2);
+    Sense_Init(&hadc1, &hadc2);
+    SVPWM_Init(&htim3);
+    Scope_Init();
+    HAL_TIM_Base_Start_IT(&htim6);
+    Protect_SetRun(1);
+#if CPU_LOAD_MONITOR
+    CpuLoad_Init(&htim6);
+#endif
+    if (!OpenLoop_SetSpeedVolt(emu_freq_hz, emu_volt)) Error_Handler();
+
+    Emu_Ready();
+
+    for (uint32_t n = 0; n < emu_iter; n++)
+    {
+        TIM6->EGR = TIM_EGR_UG;         // 업데이트 이벤트 → UIF (ISR 이 확인 / 클리어)
+        Telem_Init(&hlpuart1);
+        TIM6_DAC_IRQHandler();
+    }
+
+    Emu_Done();
+    for (;;) {}
+}
@@ -0,0 +1,486 @@
+#!/usr/bin/env python3
+"""
+motor_client.py - 명령 프로토콜 호스트 클라이언트 (Core/Src/cmd.c)
+
+요청: COBS( CMD SEQ PAYLOAD CRC_L CRC_H ) 00
+응답: 텔레메트리 프레임 TYPE=0x02, 페이로드 = CMD SEQ STATUS DATA...
+
+라이브러리 사용:
+    from motor_client import MotorClient
+    with MotorClient("/dev/ttyACM0") as m:
+        m.set_speed(200.0, 0.05)
+        m.set_mode(MotorClient.MODE_RUN)
+        print(m.param_read_u32(MotorClient.PARAM_TELEM_DECIM))
+
+명령행:
+    python3 motor_client.py /dev/ttyACM0 ping
+    python3 motor_client.py /dev/ttyACM0 speed 200 0.05
+    python3 motor_client.py /dev/ttyACM0 volt 200 1.5
+    python3 motor_client.py /dev/ttyACM0 mode run|stop
+    python3 motor_client.py /dev/ttyACM0 list
+    python3 motor_client.py /dev/ttyACM0 read 0x0001
+    python3 motor_client.py /dev/ttyACM0 write 0x0001 10 0x0010 250.0   # 일괄 커밋
+    python3 motor_client.py /dev/ttyACM0 save|reset                     # FLASH 저장 / 기본값 복원
+    python3 motor_client.py /dev/ttyACM0 id [static]                    # Rs, L, 자속, 전류 이득 식별
+    python3 motor_client.py /dev/ttyACM0 poles                          # 손으로 1회전 → 극쌍수
+    python3 motor_client.py /dev/ttyACM0 mech                           # J, B, Tc, 속도 이득 식별 (id 이후)
+    python3 motor_client.py /dev/ttyACM0 clear
+"""
+
+import argparse
+import struct
+import sys
+import time
+from collections import deque
+
+from telem_decode import FrameDecoder, crc16_ccitt
+
+TYPE_REPLY = 0x02
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for b in data:
+        if b == 0:
+            out.append(len(block) + 1)
+            out.extend(block)
+            block.clear()
+        else:
+            block.append(b)
+            if len(block) == 254:
+                out.append(0xFF)
+                out.extend(block)
+                block.clear()
+    out.append(len(block) + 1)
+    out.extend(block)
+    return bytes(out)
+
+
+def build_packet(cmd, seq, payload=b""):
+    body = bytes((cmd, seq & 0xFF)) + payload
+    crc = crc16_ccitt(body)
+    return cobs_encode(body + struct.pack("<H", crc)) + b"\x00"
+
+
+class CommandError(Exception):
+    pass
+
+
+class MotorClient:
+    CMD_PING = 0x01
+    CMD_SET_SPEED = 0x02
+    CMD_SET_SPEED_VOLT = 0x03
+    CMD_SET_MODE = 0x04
+    CMD_PARAM_READ = 0x05
+    CMD_PARAM_WRITE = 0x06
+    CMD_FAULT_CLEAR = 0x07
+    CMD_PARAM_COMMIT = 0x08
+    CMD_PARAM_DISCARD = 0x09
+    CMD_PARAM_INFO = 0x0A
+    CMD_CONFIG_SAVE = 0x0B
+    CMD_CONFIG_RESET = 0x0C
+    CMD_CONFIG_STATUS = 0x0D
+
+    MODE_STOP = 0
+    MODE_RUN = 1
+
+    # 파라미터 key (param.c 정의 테이블)
+    PARAM_TELEM_DECIM = 0x0001
+    PARAM_OL_FREQ_HZ = 0x0010
+    PARAM_OL_VOLTAGE = 0x0011
+    PARAM_OL_VOLT_V = 0x0012
+    PARAM_OL_VOLT_MODE = 0x0013
+    PARAM_V_NORM_MAX = 0x0020
+    PARAM_V_MOD_MAX = 0x0021
+    PARAM_CTRL_FREQ_HZ = 0x0030     # 읽기 전용 (TIM6 1 kHz, 쓰기는 범위 오류)
+    PARAM_PWM_PERIOD = 0x0031
+    PARAM_PWM_SPREAD = 0x0032
+    PARAM_PWM_ARR_LO = 0x0033
+    PARAM_PWM_SCH_F_LO = 0x0034
+    PARAM_PWM_SCH_F_HI = 0x0035
+    PARAM_MOTOR_RS = 0x0040
+    PARAM_MOTOR_LD = 0x0041
+    PARAM_MOTOR_LQ = 0x0042
+    PARAM_MOTOR_FLUX = 0x0043
+    PARAM_MOTOR_POLES = 0x0044
+    PARAM_CUR_KP = 0x0050
+    PARAM_CUR_KI = 0x0051
+
+    TYPE_U32 = 0
+    TYPE_F32 = 1
+
+    STATUS = {0: "OK", 1: "UNKNOWN", 2: "BAD_LEN", 3: "BAD_ARG", 4: "REJECTED", 5: "DEFERRED"}
+    ST_OK = 0
+    ST_DEFERRED = 5
+
+    def __init__(self, port, baud=2000000, timeout=0.5):
+        import serial  # pyserial
+        self.ser = serial.Serial(port, baud, timeout=0.02)
+        self.timeout = timeout
+        self.dec = FrameDecoder()
+        self.seq = 0
+        self.last_status = None
+        self.on_frame = None     # 응답 외 프레임 전달용 콜백 (None 이면 frames 에 보관)
+        self.pending = []        # 아직 대응되지 않은 응답
+        self.frames = deque(maxlen=4096)  # 응답 외 프레임 (read_frames 로 소비)
+
+    def close(self):
+        self.ser.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def request(self, cmd, payload=b"", accept=(0,)):
+        """명령 전송 후 같은 CMD/SEQ 응답 대기. 반환: 응답 DATA (STATUS 가 accept 밖이면 예외)
+
+        마지막 응답 STATUS 는 self.last_status 에 남는다.
+        """
+        self.seq = (self.seq + 1) & 0xFF
+        seq = self.seq
+        self.ser.write(build_packet(cmd, seq, payload))
+
+        deadline = time.monotonic() + self.timeout
+        while time.monotonic() < deadline:
+            self._poll()
+            for i, (ftype, p) in enumerate(self.pending):
+                if ftype == TYPE_REPLY and len(p) >= 3 and p[0] == cmd and p[1] == seq:
+                    del self.pending[i]
+                    self.last_status = p[2]
+                    if p[2] not in accept:
+                        raise CommandError("cmd 0x%02X: %s" % (cmd, self.STATUS.get(p[2], p[2])))
+                    return p[3:]
+        raise TimeoutError("cmd 0x%02X: no reply" % cmd)
+
+    def _poll(self):
+        for ftype, _, p in self.dec.feed(self.ser.read(4096)):
+            if ftype == TYPE_REPLY:
+                self.pending.append((ftype, p))
+            elif self.on_frame:
+                self.on_frame(ftype, p)
+            else:
+                self.frames.append((ftype, p))
+
+    def read_frames(self, timeout):
+        """응답 외 프레임 수신 (텔레메트리/스코프). (type, payload) 를 차례로 반환"""
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            while self.frames:
+                yield self.frames.popleft()
+            self._poll()
+
+    def ping(self):
+        d = self.request(self.CMD_PING)
+        state, first, causes, layout, version = struct.unpack("<BHHHI", d)
+        return {"state": state, "first_cause": first, "causes": causes,
+                "param_layout": layout, "param_version": version}
+
+    def set_speed(self, freq_hz, voltage):
+        self.request(self.CMD_SET_SPEED, struct.pack("<ff", freq_hz, voltage))
+
+    def set_speed_volt(self, freq_hz, volt):
+        self.request(self.CMD_SET_SPEED_VOLT, struct.pack("<ff", freq_hz, volt))
+
+    def set_mode(self, mode):
+        self.request(self.CMD_SET_MODE, struct.pack("<B", mode))
+
+    def param_read_raw(self, pid):
+        d = self.request(self.CMD_PARAM_READ, struct.pack("<H", pid))
+        _, value = struct.unpack("<HI", d)
+        return value
+
+    def param_read_u32(self, pid):
+        return self.param_read_raw(pid)
+
+    def param_read_f32(self, pid):
+        return struct.unpack("<f", struct.pack("<I", self.param_read_raw(pid)))[0]
+
+    def param_write_u32(self, pid, value):
+        """변경 예약 (param_commit 으로 적용)"""
+        self.request(self.CMD_PARAM_WRITE, struct.pack("<HI", pid, value))
+
+    def param_write_f32(self, pid, value):
+        """변경 예약 (param_commit 으로 적용)"""
+        self.request(self.CMD_PARAM_WRITE, struct.pack("<Hf", pid, value))
+
+    def param_commit(self):
+        """예약된 변경 일괄 적용, 새 버전 반환"""
+        return struct.unpack("<I", self.request(self.CMD_PARAM_COMMIT))[0]
+
+    def param_discard(self):
+        self.request(self.CMD_PARAM_DISCARD)
+
+    def param_list(self):
+        """레지스트리 전체 정의 조회 (index 0 부터 count 까지)"""
+        out = []
+        index, count = 0, 1
+        while index < count:
+            d = self.request(self.CMD_PARAM_INFO, struct.pack("<H", index))
+            count, key, ptype, mn, mx, df = struct.unpack("<HHBIII", d[:17])
+            name, _, unit = d[17:].partition(b"\0")
+            conv = (lambda v: struct.unpack("<f", struct.pack("<I", v))[0]) if ptype == self.TYPE_F32 else int
+            out.append({"key": key, "name": name.decode(), "unit": unit.decode(),
+                        "type": "f32" if ptype == self.TYPE_F32 else "u32",
+                        "min": conv(mn), "max": conv(mx), "default": conv(df),
+                        "value": conv(self.param_read_raw(key))})
+            index += 1
+        return out
+
+    def config_save(self, timeout=2.0):
+        """현재 적용값을 FLASH 에 저장하고 기록 완료까지 대기
+
+        페이지 삭제가 필요한데 드라이버 출력이 켜져 있으면 펌웨어가 DEFERRED 로 답한다.
+        이때는 기다리지 않고 "deferred": True 로 반환한다 (STOP 하면 기록이 이어진다).
+        """
+        self.request(self.CMD_CONFIG_SAVE, accept=(self.ST_OK, self.ST_DEFERRED))
+        if self.last_status == self.ST_DEFERRED:
+            st = self.config_status()
+            st["deferred"] = True
+            return st
+        t_end = time.time() + timeout
+        while time.time() < t_end:
+            st = self.config_status()
+            if not st["busy"]:
+                return st
+            time.sleep(0.01)
+        raise TimeoutError("config save pending (state %d) - stop the motor to allow page erase" % st["state"])
+
+    def config_reset(self):
+        """공장 초기화. 반환: True 이면 FLASH 기록이 드라이버 정지까지 미뤄짐"""
+        self.request(self.CMD_CONFIG_RESET, accept=(self.ST_OK, self.ST_DEFERRED))
+        return self.last_status == self.ST_DEFERRED
+
+    def config_status(self):
+        d = self.request(self.CMD_CONFIG_STATUS)
+        keys = ("state", "busy", "seq", "saves", "erases", "bad_records")
+        return dict(zip(keys, struct.unpack("<BBIIII", d)))
+
+    def fault_clear(self):
+        self.request(self.CMD_FAULT_CLEAR)
+
+    # ---- 파라미터 식별 (motor_id.c) ----
+    CMD_ID_START = 0x20
+    CMD_ID_ABORT = 0x21
+    CMD_ID_POLES = 0x22
+    CMD_ID_STATUS = 0x23
+
+    ID_STATES = ("idle", "align", "rs_lo", "rs_hi", "ld", "lq", "spin_ramp", "spin_meas",
+                 "compute", "done", "poles", "error")
+    ID_ERRORS = ("none", "fault", "no_current", "range", "abort")
+
+    def id_status(self):
+        d = self.request(self.CMD_ID_STATUS)
+        st, err, spin, poles, rs, ld, lq, flux, kp, ki = struct.unpack("<BBBBffffff", d)
+        return {"state": self.ID_STATES[st] if st < len(self.ID_STATES) else st,
+                "err": self.ID_ERRORS[err] if err < len(self.ID_ERRORS) else err,
+                "spin": spin, "poles": poles, "rs": rs, "ld": ld, "lq": lq,
+                "flux": flux, "kp": kp, "ki": ki}
+
+    def id_run(self, spin=True, timeout=10.0):
+        """식별 실행 후 결과 반환 (완료 후 출력 해제 + 드라이버 비활성)"""
+        self.request(self.CMD_ID_START, bytes([1 if spin else 0]))
+        t_end = time.time() + timeout
+        try:
+            while time.time() < t_end:
+                st = self.id_status()
+                if st["state"] in ("done", "error"):
+                    return st
+                time.sleep(0.1)
+            raise TimeoutError("identification did not finish")
+        finally:
+            self.request(self.CMD_ID_ABORT)
+            self.set_mode(self.MODE_STOP)
+
+    def id_poles_start(self):
+        """극쌍수 계수 시작 - 드라이버가 꺼지면 회전자를 손으로 정확히 1회전"""
+        self.request(self.CMD_ID_POLES, b"\x01")
+
+    def id_poles_finish(self):
+        return self.request(self.CMD_ID_POLES, b"\x00")[0]
+
+    # ---- 기계 파라미터 식별 (mech_id.c) ----
+    CMD_MECH_START = 0x24
+    CMD_MECH_STATUS = 0x25
+
+    MECH_STATES = ("idle", "align", "accel", "hold", "coast", "fit", "done", "error")
+    MECH_ERRORS = ("none", "fault", "no_motor", "range", "abort")
+
+    def mech_status(self):
+        d = self.request(self.CMD_MECH_STATUS)
+        st, err, cycle, _, n, dropped, j, b, tc, kp, ki = struct.unpack("<BBBBIIfffff", d)
+        return {"state": self.MECH_STATES[st] if st < len(self.MECH_STATES) else st,
+                "err": self.MECH_ERRORS[err] if err < len(self.MECH_ERRORS) else err,
+                "cycle": cycle, "samples": n, "dropped": dropped,
+                "j": j, "b": b, "tc": tc, "kp": kp, "ki": ki}
+
+    def mech_run(self, timeout=60.0):
+        """가속/관성 사이클 반복 후 결과 반환 (스코프 mech_speed/mech_iq 로 파형 확인 가능)"""
+        self.request(self.CMD_MECH_START)
+        t_end = time.time() + timeout
+        try:
+            while time.time() < t_end:
+                st = self.mech_status()
+                if st["state"] in ("done", "error"):
+                    return st
+                time.sleep(0.2)
+            raise TimeoutError("mechanical identification did not finish")
+        finally:
+            self.request(self.CMD_ID_ABORT)
+            self.set_mode(self.MODE_STOP)
+
+    # ---- 사이클 벤치마크 (bench.c) ----
+    CMD_BENCH = 0x30
+    CMD_BENCH_STATUS = 0x31
+    BENCH_KERNELS = ("svpwm_core_calc", "trig_lut_sincos", "trig_libm_sincos", "openloop_vector",
+                     "control_isr")
+    BENCH_CONTROL_ISR = 4
+    BENCH_ST_RUNNING, BENCH_ST_DONE = 1, 2
+
+    def bench_status(self):
+        d = self.request(self.CMD_BENCH_STATUS)
+        st, k, flags, clk, n, cmin, cmax, total, overhead = struct.unpack("<BBBIIIIII", d)
+        return {"state": st,
+                "kernel": self.BENCH_KERNELS[k] if k < len(self.BENCH_KERNELS) else k,
+                "ccmram": bool(flags & 1), "trig_lut": bool(flags & 2), "clk_hz": clk,
+                "iterations": n, "min_cyc": cmin, "max_cyc": cmax,
+                "avg_cyc": total / n if n else 0.0, "overhead_cyc": overhead}
+
+    def bench(self, kernel, iterations=1024, timeout=None):
+        """커널 1종 측정 → cycle 통계 (평균 = total / iterations)
+
+        펌웨어는 메인 루프에서 나눠 측정하므로 시작 후 완료까지 상태를 조회한다.
+        control_isr 은 제어 주기마다 1 회 (iterations ms 이상) - 구동 중에 측정할 것.
+        """
+        self.request(self.CMD_BENCH, struct.pack("<BH", kernel, iterations))
+        if timeout is None:
+            timeout = 2.0 + iterations * (0.002 if kernel == self.BENCH_CONTROL_ISR else 0.0001)
+        t_end = time.monotonic() + timeout
+        while True:
+            r = self.bench_status()
+            if r["state"] == self.BENCH_ST_DONE:
+                return r
+            if time.monotonic() > t_end:
+                raise TimeoutError("bench %d not finished in %.1f s" % (kernel, timeout))
+            time.sleep(0.01)
+
+    # ---- 스코프 (scope.c) ----
+    CMD_SCOPE_CONFIG = 0x10
+    CMD_SCOPE_TRIGGER = 0x11
+    CMD_SCOPE_ARM = 0x12
+    CMD_SCOPE_STOP = 0x13
+    CMD_SCOPE_STATUS = 0x14
+    CMD_SCOPE_UPLOAD = 0x15
+
+    def scope_config(self, sources, decim=1, pre_pct=25):
+        self.request(self.CMD_SCOPE_CONFIG,
+                     struct.pack("<BBH", len(sources), pre_pct, decim) + bytes(sources))
+
+    def scope_trigger(self, mode, ch=0, level=0.0):
+        self.request(self.CMD_SCOPE_TRIGGER, struct.pack("<BBf", mode, ch, level))
+
+    def scope_arm(self):
+        self.request(self.CMD_SCOPE_ARM)
+
+    def scope_stop(self):
+        self.request(self.CMD_SCOPE_STOP)
+
+    def scope_status(self):
+        d = self.request(self.CMD_SCOPE_STATUS)
+        keys = ("state", "nch", "depth", "pre", "start", "decim")
+        return dict(zip(keys, struct.unpack("<BBHHHI", d)))
+
+    def scope_upload(self, timeout=5.0):
+        """DONE 상태 캡처를 받아 word 리스트 반환 (가장 오래된 샘플부터 채널 순)"""
+        st = self.scope_status()
+        total = st["nch"] * st["depth"]
+        words = [None] * total
+        self.frames.clear()
+        self.request(self.CMD_SCOPE_UPLOAD)
+        got = 0
+        for ftype, p in self.read_frames(timeout):
+            if ftype != 0x03 or len(p) < 2:
+                continue
+            off = p[0] | (p[1] << 8)
+            for k, (w,) in enumerate(struct.iter_unpack("<I", p[2:])):
+                if off + k < total and words[off + k] is None:
+                    words[off + k] = w
+                    got += 1
+            if got == total:
+                return st, words
+        raise TimeoutError("scope upload: %d / %d words" % (got, total))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="모터 명령 클라이언트")
+    ap.add_argument("port")
+    ap.add_argument("--baud", type=int, default=2000000)
+    ap.add_argument("cmd", choices=("ping", "speed", "volt", "mode", "list", "read", "write", "save", "reset", "id", "poles", "mech", "clear"))
+    ap.add_argument("args", nargs="*")
+    a = ap.parse_args()
+
+    with MotorClient(a.port, a.baud) as m:
+        try:
+            if a.cmd == "ping":
+                print(m.ping())
+            elif a.cmd == "speed":
+                m.set_speed(float(a.args[0]), float(a.args[1]))
+            elif a.cmd == "volt":
+                m.set_speed_volt(float(a.args[0]), float(a.args[1]))
+            elif a.cmd == "mode":
+                m.set_mode(MotorClient.MODE_RUN if a.args[0] == "run" else MotorClient.MODE_STOP)
+            elif a.cmd == "read":
+                v = m.param_read_raw(int(a.args[0], 0))
+                print("0x%08X  u32=%d  f32=%g" % (v, v, struct.unpack("<f", struct.pack("<I", v))[0]))
+            elif a.cmd == "list":
+                for p in m.param_list():
+                    print("0x%04X %-12s %-4s %s = %s  [%s .. %s] def %s" % (
+                        p["key"], p["name"], p["unit"], p["type"], p["value"], p["min"], p["max"], p["default"]))
+            elif a.cmd == "write":
+                try:
+                    for pid, val in zip(a.args[0::2], a.args[1::2]):
+                        if "." in val or ("e" in val.lower() and not val.lower().startswith("0x")):
+                            m.param_write_f32(int(pid, 0), float(val))
+                        else:
+                            m.param_write_u32(int(pid, 0), int(val, 0))
+                except CommandError:
+                    m.param_discard()
+                    raise
+                print("version", m.param_commit())
+            elif a.cmd == "save":
+                st = m.config_save()
+                print(st)
+                if st.get("deferred"):
+                    print("save deferred: page erase waits until the driver is stopped (mode stop)")
+            elif a.cmd == "reset":
+                if m.config_reset():
+                    print("reset deferred: page erase waits until the driver is stopped (mode stop)")
+            elif a.cmd == "id":
+                r = m.id_run(spin=not (a.args and a.args[0] == "static"))
+                print("state %s err %s" % (r["state"], r["err"]))
+                print("Rs   = %.4f ohm" % r["rs"])
+                print("Ld   = %.3f mH  Lq = %.3f mH" % (r["ld"] * 1e3, r["lq"] * 1e3))
+                if r["spin"]:
+                    print("flux = %.5f Wb (line-line peak %.5f V/(rad/s) elec)" %
+                          (r["flux"], r["flux"] * 1.7320508))
+                print("Kp   = %.4f V/A  Ki = %.1f V/(A*s)" % (r["kp"], r["ki"]))
+            elif a.cmd == "poles":
+                m.id_poles_start()
+                input("rotate the rotor exactly one turn by hand, then press Enter ")
+                print("pole pairs", m.id_poles_finish())
+            elif a.cmd == "mech":
+                r = m.mech_run()
+                print("state %s err %s samples %d dropped %d" % (r["state"], r["err"], r["samples"], r["dropped"]))
+                print("J    = %.3e kg*m^2  B = %.3e N*m*s  Tc = %.3e N*m" % (r["j"], r["b"], r["tc"]))
+                print("Kp   = %.4g A*s/rad  Ki = %.4g A/rad" % (r["kp"], r["ki"]))
+            elif a.cmd == "clear":
+                m.fault_clear()
+        except (CommandError, TimeoutError) as e:
+            print(e, file=sys.stderr)
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+scope_capture.py - 온타겟 스코프 캡처/업로드 (Core/Src/scope.c)
+
+사용 예:
+    # CCR_A/B/C + 섹터, 전류 A 상승 에지 0.5A, 프리트리거 25%
+    python3 scope_capture.py /dev/ttyACM0 -c ccr_a ccr_b ccr_c sector ia \\
+            --trig rising --trig-ch 4 --level 0.5 --csv cap.csv
+
+    # 고장 트리거 (차단 전후 파형)
+    python3 scope_capture.py /dev/ttyACM0 -c ia ib vbus --trig fault --pre 75 --plot
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+from motor_client import MotorClient
+
+# Scope_Src_t 순서와 동일
+SOURCES = ["angle", "sector", "t1", "t2", "t0", "ccr_a", "ccr_b", "ccr_c",
+           "ia", "ib", "vbus", "raw_ia", "raw_ib", "mech_speed", "mech_iq"]
+FLOAT_SOURCES = {"angle", "t1", "t2", "t0", "ia", "ib", "vbus", "mech_speed", "mech_iq"}
+TRIG_MODES = {"none": 0, "level": 1, "rising": 2, "falling": 3, "fault": 4}
+ST_DONE = 1
+
+
+def to_value(name, w):
+    if name in FLOAT_SOURCES:
+        return struct.unpack("<f", struct.pack("<I", w))[0]
+    return w
+
+
+def main():
+    ap = argparse.ArgumentParser(description="온타겟 스코프 캡처")
+    ap.add_argument("port")
+    ap.add_argument("--baud", type=int, default=2000000)
+    ap.add_argument("-c", "--channels", nargs="+", default=["ccr_a", "ccr_b", "ccr_c", "sector", "ia", "ib"],
+                    choices=SOURCES)
+    ap.add_argument("--decim", type=int, default=1)
+    ap.add_argument("--pre", type=int, default=25, help="프리트리거 [%%]")
+    ap.add_argument("--trig", default="none", choices=TRIG_MODES.keys())
+    ap.add_argument("--trig-ch", type=int, default=0, help="트리거 채널 (-c 순서 인덱스)")
+    ap.add_argument("--level", type=float, default=0.0)
+    ap.add_argument("--wait", type=float, default=10.0, help="트리거 대기 [s]")
+    ap.add_argument("--csv")
+    ap.add_argument("--plot", action="store_true")
+    a = ap.parse_args()
+
+    names = a.channels
+    with MotorClient(a.port, a.baud) as m:
+        m.scope_config([SOURCES.index(n) for n in names], a.decim, a.pre)
+        m.scope_trigger(TRIG_MODES[a.trig], a.trig_ch, a.level)
+        m.scope_arm()
+
+        deadline = time.monotonic() + a.wait
+        while m.scope_status()["state"] != ST_DONE:
+            if time.monotonic() > deadline:
+                m.scope_stop()
+                print("trigger timeout", file=sys.stderr)
+                sys.exit(1)
+            time.sleep(0.05)
+
+        st, words = m.scope_upload()
+
+    nch, depth = st["nch"], st["depth"]
+    rows = [[to_value(names[c], words[s * nch + c]) for c in range(nch)] for s in range(depth)]
+    print("captured %d samples x %d ch, pre %d, decim %d" % (depth, nch, st["pre"], st["decim"]))
+
+    if a.csv:
+        with open(a.csv, "w") as f:
+            f.write("n," + ",".join(names) + "\n")
+            for s, r in enumerate(rows):
+                f.write("%d,%s\n" % (s - st["pre"], ",".join(str(v) for v in r)))
+
+    if a.plot:
+        import matplotlib.pyplot as plt
+        x = [s - st["pre"] for s in range(depth)]
+        fig, axes = plt.subplots(nch, 1, sharex=True, squeeze=False)
+        for c in range(nch):
+            axes[c][0].plot(x, [r[c] for r in rows], drawstyle="steps-post")
+            axes[c][0].set_ylabel(names[c])
+            axes[c][0].axvline(0, color="r", lw=0.5)
+        axes[-1][0].set_xlabel("sample (0 = trigger)")
+        plt.show()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,414 @@
+/**
+ * @file    cmd_fuzz.c
+ * @brief   명령 수신 경로 속성 검사 / 퍼징 하네스 (Core/Src/cmd.c COBS + CRC 파서)
+ *
+ * hal_host.c 의 LPUART1 DMA 원형 수신 (HalHost_UartRx) 으로 바이트를 넣고 Cmd_Process 를
+ * 그대로 돌린다. 하네스 안의 독립 참조 모델 (COBS 복원 + CRC-16/CCITT-FALSE) 이
+ * 구분자 (0x00) 마다 패킷 / CRC 오류 / COBS 오류를 예측하고 다음을 확인한다:
+ *   1. Cmd_Stats_t 의 packets / crc_errors / cobs_errors / rx_bytes 가 모델과 정확히 일치
+ *   2. 유효 패킷마다 응답 (TELEM_TYPE_REPLY) 이 순서대로 1 개, CMD / SEQ 일치
+ *      (LPUART1 송신을 HalHost_UartTxHook 에서 텔레메트리 프레임으로 다시 읽는다)
+ *   3. 링 덮어쓰기: 링보다 많이 밀리면 overruns 1 회 + rx_dropped, 다음 구분자부터 정상 복구.
+ *      정확히 링 크기만큼 밀린 경우 (head == tail) 는 한 바이트도 잃지 않음
+ * 위반 시 상태를 출력하고 abort() - 새니타이저 빌드로 UB 도 함께 잡는다.
+ *
+ * 속성 검사 입력: 유효 프레임 (무해한 명령, 무작위 SEQ / 페이로드), CRC 1 비트 오류,
+ * 길이 초과, 잘린 COBS 블록, 무작위 바이트를 무작위 크기로 쪼개 Cmd_Process 사이에 넣는다.
+ * libFuzzer 는 임의 입력을 그대로 스트림으로 넣으므로 모든 명령이 실행될 수 있어
+ * 응답 순서 (2) 는 텔레메트리 링이 넘치지 않았을 때만 본다.
+ *
+ * 빌드 / 실행 (Tools/sim/CMakeLists.txt, ASan / UBSan 펌웨어 오브젝트로 링크):
+ *   # 속성 검사 (gcc)
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target cmd_fuzz
+ *   ./cmd_fuzz --iter 200000 --seed 1
+ *
+ *   # libFuzzer (clang, 같은 플래그에 -fsanitize=fuzzer,address,undefined -DCMD_FUZZ_LIBFUZZER)
+ *   ./cmd_fuzz -max_total_time=60
+ */
+
+#include "fw_loop.h"
+#include "hal_host.h"
+#include "cmd.h"
+#include "config.h"
+#include "telemetry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 설정 ============== */
+#define FUZZ_REPLY_MAX      256u        // 확인 대기 응답 큐
+#define FUZZ_SEG_MAX        (CMD_MAX_PACKET + 16u)
+
+/* ============== 참조 모델 ============== */
+typedef struct {
+    uint8_t  buf[CMD_RX_RING_SIZE];     // 현재 구분자 앞 인코딩 바이트
+    uint32_t n;
+    uint8_t  skip;                      // 덮어쓰기 후 다음 구분자까지 버림
+    uint32_t rx_bytes, packets, crc_errors, cobs_errors;
+    uint8_t  exp_cmd[FUZZ_REPLY_MAX], exp_seq[FUZZ_REPLY_MAX];
+    uint32_t exp_head, exp_tail;
+} Fuzz_Model_t;
+
+static Fuzz_Model_t model;
+
+/* 송신 스트림에서 복원 중인 텔레메트리 프레임 */
+static uint8_t  tx_frame[TELEM_HDR_SIZE + TELEM_MAX_PAYLOAD + TELEM_CRC_SIZE];
+static uint32_t tx_n;
+static uint32_t replies;
+static uint8_t  check_replies = 1;
+
+static void Fuzz_Fail(const char *what)
+{
+    const Cmd_Stats_t *s = Cmd_GetStats();
+    fprintf(stderr, "FAIL %s\n", what);
+    fprintf(stderr, "  fw   : rx %u pkt %u crc %u cobs %u overrun %u dropped %u\n",
+            s->rx_bytes, s->packets, s->crc_errors, s->cobs_errors, s->overruns, s->rx_dropped);
+    fprintf(stderr, "  model: rx %u pkt %u crc %u cobs %u, replies %u pending %u\n",
+            model.rx_bytes, model.packets, model.crc_errors, model.cobs_errors,
+            replies, model.exp_head - model.exp_tail);
+    abort();
+}
+
+/* CRC-16/CCITT-FALSE (비트 단위, crc16.c 와 독립) */
+static uint16_t Fuzz_Crc(const uint8_t *p, uint32_t len)
+{
+    uint16_t crc = 0xFFFFu;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        crc ^= (uint16_t)p[i] << 8;
+        for (uint32_t k = 0; k < 8u; k++)
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+/**
+ * @brief 구분자 1 개 처리 - 인코딩 바이트를 복원해 결과 분류
+ */
+static void Fuzz_ModelDelimiter(void)
+{
+    if (model.n == 0u && !model.skip) return;
+    if (model.skip)
+    {
+        model.cobs_errors++;
+        model.skip = 0;
+        model.n = 0;
+        return;
+    }
+
+    uint8_t dec[CMD_RX_RING_SIZE];
+    uint32_t len = 0, i = 0;
+    uint8_t ok = 1;
+    while (i < model.n)
+    {
+        uint32_t code = model.buf[i++];
+        if (i + code - 1u > model.n) { ok = 0; break; }     // 잘린 블록
+        for (uint32_t k = 1; k < code; k++) dec[len++] = model.buf[i++];
+        if (code != 0xFFu && i < model.n) dec[len++] = 0x00u;
+    }
+    model.n = 0;
+
+    if (!ok || len > CMD_MAX_PACKET || len < 4u) { model.cobs_errors++; return; }
+    if (Fuzz_Crc(dec, len - 2u) != (uint16_t)(dec[len - 2u] | (dec[len - 1u] << 8)))
+    {
+        model.crc_errors++;
+        return;
+    }
+
+    model.packets++;
+    uint32_t slot = model.exp_head++ % FUZZ_REPLY_MAX;
+    model.exp_cmd[slot] = dec[0];
+    model.exp_seq[slot] = dec[1];
+}
+
+static void Fuzz_ModelFeed(const uint8_t *p, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (p[i] == 0x00u) Fuzz_ModelDelimiter();
+        else if (!model.skip && model.n < sizeof(model.buf)) model.buf[model.n++] = p[i];
+    }
+}
+
+/* ============== 송신 관찰 (응답 프레임) ============== */
+
+void HalHost_UartTxHook(const uint8_t *pData, uint16_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        uint8_t b = pData[i];
+        if ((tx_n == 0u && b != TELEM_SYNC0) || (tx_n == 1u && b != TELEM_SYNC1))
+        {
+            tx_n = 0;
+            if (b != TELEM_SYNC0) continue;
+        }
+        tx_frame[tx_n++] = b;
+        if (tx_n < TELEM_HDR_SIZE) continue;
+
+        uint32_t plen = tx_frame[4];
+        if (plen > TELEM_MAX_PAYLOAD) Fuzz_Fail("telemetry length");
+        if (tx_n < TELEM_HDR_SIZE + plen + TELEM_CRC_SIZE) continue;
+
+        uint16_t crc = (uint16_t)(tx_frame[TELEM_HDR_SIZE + plen] | (tx_frame[TELEM_HDR_SIZE + plen + 1u] << 8));
+        if (Fuzz_Crc(&tx_frame[2], 3u + plen) != crc) Fuzz_Fail("telemetry crc");
+        tx_n = 0;
+        if (tx_frame[2] != TELEM_TYPE_REPLY) continue;
+
+        replies++;
+        if (!check_replies) continue;
+        if (model.exp_tail == model.exp_head) Fuzz_Fail("reply without packet");
+        uint32_t slot = model.exp_tail++ % FUZZ_REPLY_MAX;
+        if (plen < 3u || tx_frame[5] != model.exp_cmd[slot] || tx_frame[6] != model.exp_seq[slot])
+            Fuzz_Fail("reply cmd / seq");
+    }
+}
+
+/* ============== 구동 ============== */
+
+static void Fuzz_Reset(void)
+{
+    Plant_Params_t par;
+    Plant_DefaultParams(&par);
+    FwLoop_Init(&par);
+    Config_Init();
+    Telem_Init(&hlpuart1);
+    Cmd_Init(&hlpuart1);
+
+    memset(&model, 0, sizeof(model));
+    tx_n = 0;
+    replies = 0;
+}
+
+/**
+ * @brief 수신 처리 후 응답을 모두 내보내고 모델과 비교
+ */
+static void Fuzz_Process(void)
+{
+    Cmd_Process();
+    do { Telem_Process(); } while (HalHost_UartPoll());
+
+    const Cmd_Stats_t *s = Cmd_GetStats();
+    if (s->packets != model.packets || s->crc_errors != model.crc_errors ||
+        s->cobs_errors != model.cobs_errors || s->rx_bytes != model.rx_bytes)
+        Fuzz_Fail("stats");
+    if (Telem_GetStats()->dropped != 0u) check_replies = 0;
+    if (check_replies && model.exp_tail != model.exp_head) Fuzz_Fail("missing reply");
+}
+
+/**
+ * @brief 바이트 주입 (모델 동시 갱신, 링 크기 이하)
+ */
+static void Fuzz_Inject(const uint8_t *p, uint32_t len)
+{
+    if (HalHost_UartRx(p, len) != len) Fuzz_Fail("uart rx");
+    Fuzz_ModelFeed(p, len);
+    model.rx_bytes += len;
+}
+
+/* ============== libFuzzer 진입점 ============== */
+/* 입력: 첫 바이트 = 조각 크기, 나머지 = 수신 스트림 */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (size < 2u) return 0;
+
+    Fuzz_Reset();
+    check_replies = 1;
+
+    const uint32_t chunk = (uint32_t)data[0] + 1u;
+    for (size_t i = 1; i < size; i += chunk)
+    {
+        uint32_t n = (size - i < chunk) ? (uint32_t)(size - i) : chunk;
+        Fuzz_Inject(&data[i], n);
+        Fuzz_Process();
+    }
+    // 마지막 패킷 마무리
+    const uint8_t z = 0x00u;
+    Fuzz_Inject(&z, 1u);
+    Fuzz_Process();
+    return 0;
+}
+
+#ifndef CMD_FUZZ_LIBFUZZER
+/* ============== 속성 검사 (단독 실행) ============== */
+static uint64_t rng_state;
+
+static uint32_t Fuzz_Rand(void)
+{
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (uint32_t)((rng_state * 2685821657736338717ull) >> 32);
+}
+
+/* 무해한 명령 (출력 / FLASH / 긴 실행 없음) + 미정의 코드 */
+static const uint8_t fuzz_cmds[] = {
+    CMD_PING, CMD_SET_SPEED, CMD_SET_SPEED_VOLT, CMD_SET_MODE, CMD_PARAM_READ, CMD_PARAM_WRITE,
+    CMD_FAULT_CLEAR, CMD_PARAM_DISCARD, CMD_PARAM_INFO, CMD_CONFIG_STATUS, CMD_ID_STATUS,
+    CMD_MECH_STATUS, CMD_SCOPE_STATUS, 0x40u, 0xFFu,
+};
+
+/**
+ * @brief COBS 인코딩 (구분자 포함)
+ * @return 인코딩 길이
+ */
+static uint32_t Fuzz_Cobs(const uint8_t *in, uint32_t len, uint8_t *out)
+{
+    uint32_t o = 1, code_pos = 0;
+    uint8_t code = 1;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (in[i] == 0x00u)
+        {
+            out[code_pos] = code;
+            code_pos = o++;
+            code = 1;
+            continue;
+        }
+        out[o++] = in[i];
+        if (++code == 0xFFu)
+        {
+            out[code_pos] = code;
+            code_pos = o++;
+            code = 1;
+        }
+    }
+    out[code_pos] = code;
+    out[o++] = 0x00u;
+    return o;
+}
+
+/**
+ * @brief 무작위 세그먼트 1 개 (구분자로 끝남)
+ * @return 길이
+ */
+static uint32_t Fuzz_Segment(uint8_t *out)
+{
+    uint8_t pkt[CMD_MAX_PACKET + 8u];
+    uint32_t len;
+    uint32_t kind = Fuzz_Rand() % 8u;
+
+    if (kind >= 6u)
+    {
+        // 무작위 바이트 (0 포함 가능 - 모델이 그대로 따라간다)
+        len = 1u + Fuzz_Rand() % FUZZ_SEG_MAX;
+        for (uint32_t i = 0; i < len; i++)
+            out[i] = (Fuzz_Rand() & 7u) ? (uint8_t)Fuzz_Rand() : 0x00u;
+        out[len - 1u] = 0x00u;
+        return len;
+    }
+
+    uint32_t arg_len = (kind == 5u) ? CMD_MAX_PACKET : Fuzz_Rand() % 12u;
+    pkt[0] = fuzz_cmds[Fuzz_Rand() % sizeof(fuzz_cmds)];
+    pkt[1] = (uint8_t)Fuzz_Rand();
+    for (uint32_t i = 0; i < arg_len; i++)
+        pkt[2u + i] = (Fuzz_Rand() & 3u) ? (uint8_t)Fuzz_Rand() : 0x00u;
+    if (pkt[0] == CMD_SET_MODE && arg_len == 1u) pkt[2] &= 1u;
+    len = 2u + arg_len;
+
+    uint16_t crc = Fuzz_Crc(pkt, len);
+    pkt[len++] = (uint8_t)(crc & 0xFFu);
+    pkt[len++] = (uint8_t)(crc >> 8);
+
+    if (kind == 4u)
+        pkt[Fuzz_Rand() % len] ^= (uint8_t)(1u << (Fuzz_Rand() % 8u));     // CRC 1 비트 오류
+
+    uint32_t n = Fuzz_Cobs(pkt, len, out);
+    if (kind == 3u && n > 3u)
+    {
+        // 블록 코드를 부풀려 잘린 블록으로
+        out[0] = (uint8_t)(out[0] + 1u + Fuzz_Rand() % 8u);
+        if (out[0] == 0x00u) out[0] = 0xFFu;
+    }
+    return n;
+}
+
+/**
+ * @brief 유효 PING 프레임
+ */
+static uint32_t Fuzz_Ping(uint8_t seq, uint8_t *out)
+{
+    uint8_t pkt[4] = { CMD_PING, seq, 0, 0 };
+    uint16_t crc = Fuzz_Crc(pkt, 2u);
+    pkt[2] = (uint8_t)(crc & 0xFFu);
+    pkt[3] = (uint8_t)(crc >> 8);
+    return Fuzz_Cobs(pkt, 4u, out);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t iter = 100000u;
+    uint64_t seed = 1u;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--iter") && i + 1 < argc)      iter = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--iter N] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed ? seed : 1u;
+
+    Fuzz_Reset();
+
+    /* 1. 무작위 세그먼트를 무작위 크기로 쪼개 주입 (Cmd_Process 사이 응답 수 제한) */
+    uint8_t seg[2u * FUZZ_SEG_MAX];
+    for (uint64_t n = 0; n < iter; n++)
+    {
+        uint32_t len = Fuzz_Segment(seg);
+        uint32_t off = 0;
+        while (off < len)
+        {
+            uint32_t part = 1u + Fuzz_Rand() % (len - off);
+            Fuzz_Inject(&seg[off], part);
+            off += part;
+            if (Fuzz_Rand() & 1u) Fuzz_Process();
+        }
+        Fuzz_Process();
+    }
+    const Cmd_Stats_t *s = Cmd_GetStats();
+    printf("stream   : %llu segments, %u bytes, %u packets, %u crc, %u cobs, %u replies\n",
+           (unsigned long long)iter, s->rx_bytes, s->packets, s->crc_errors, s->cobs_errors, replies);
+    if (s->packets == 0u || s->crc_errors == 0u || s->cobs_errors == 0u)
+        Fuzz_Fail("stream did not cover every outcome");
+
+    /* 2. 링이 정확히 가득 참 (head == tail): PING 으로 채우고 남는 자리는 빈 구분자 */
+    uint8_t ring[CMD_RX_RING_SIZE];
+    uint32_t fill = 0;
+    uint8_t seq = 0;
+    while (fill + 6u <= sizeof(ring)) fill += Fuzz_Ping(seq++, &ring[fill]);
+    memset(&ring[fill], 0, sizeof(ring) - fill);
+    uint32_t before = s->packets;
+    Fuzz_Inject(ring, sizeof(ring));
+    Fuzz_Process();
+    if (s->packets - before != seq || s->overruns != 0u) Fuzz_Fail("full ring");
+    printf("full ring: %u frames in %u bytes, none lost\n", (unsigned)seq, (unsigned)sizeof(ring));
+
+    /* 3. 덮어쓰기: 링 + 여분을 읽지 않고 밀어 넣은 뒤 복구 */
+    const uint32_t extra = 100u;
+    uint8_t junk[CMD_RX_RING_SIZE];
+    for (uint32_t i = 0; i < sizeof(junk); i++) junk[i] = (uint8_t)(1u + Fuzz_Rand() % 255u);
+    if (HalHost_UartRx(junk, sizeof(junk)) != sizeof(junk) || HalHost_UartRx(junk, extra) != extra)
+        Fuzz_Fail("uart rx");
+    Cmd_Process();
+    if (s->overruns != 1u || s->rx_dropped != sizeof(junk) + extra) Fuzz_Fail("overrun detect");
+    model.skip = 1;                     // 펌웨어처럼 다음 구분자까지 버림
+
+    uint8_t frame[8];
+    uint32_t flen = Fuzz_Ping(0xA5u, frame);
+    const uint8_t z = 0x00u;
+    before = s->packets;
+    Fuzz_Inject(&z, 1u);
+    Fuzz_Inject(frame, flen);
+    Fuzz_Process();
+    if (s->packets - before != 1u) Fuzz_Fail("overrun recovery");
+    printf("overrun  : %u bytes dropped, recovered at next delimiter\n", s->rx_dropped);
+
+    printf("PASS\n");
+    return 0;
+}
+#endif /* CMD_FUZZ_LIBFUZZER */
@@ -0,0 +1,266 @@
+/**
+ * @file    fault_sim.c
+ * @brief   고장 상태 머신 / 보호 재가동 검증 (fault.c 단독 + protect.c·cmd.c 호스트 링크)
+ *
+ * 1) fault.c 단독 (차단 콜백 호출 횟수 관찰)
+ *    - 최초 원인 / 시각 래치, 원인 누적, 차단 콜백은 진입 시 1 회
+ *    - 원인이 남아 있으면 해제 거부, 해제 후 FAULT_HOLDOFF_MS 전에는 OK 아님
+ *    - HOLDOFF 중 재발생 → 다시 TRIPPED (콜백 재호출), tick 랩어라운드
+ * 2) protect.c + cmd.c (fw_loop.c 로 펌웨어 그대로, 명령은 LPUART1 수신 경로로)
+ *    - COMP3 / ADC AWD 트립 → 드라이버 EN 즉시 LOW, 고장 중 RUN 거부
+ *    - COMP3 출력이 남아 있으면 FAULT_CLEAR 거부
+ *    - HOLDOFF 경과 후 AWD 재무장, RUN 지령이면 EN 재활성
+ *    - STOP 지령 중 고장 → 해제 / HOLDOFF 가 지나도 EN LOW 유지, RUN 으로만 재활성
+ *    - 식별 중 STOP → 식별 중단, 이후 스텝에서도 EN LOW
+ *
+ * 판정: 항목마다 ok / FAIL 출력, 하나라도 어긋나면 종료 코드 1.
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt, -Wall -Wextra -Werror, ctest 게이트에 포함):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target fault_sim
+ *
+ * 실행:
+ *   ./fault_sim
+ */
+
+#include "fw_loop.h"
+#include "hal_host.h"
+#include "fault.h"
+#include "protect.h"
+#include "cmd.h"
+#include "crc16.h"
+#include "telemetry.h"
+#include "motor_id.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* ============== 상태 ============== */
+static uint32_t shutdowns;          // 차단 콜백 호출 수 (1 단계)
+static uint8_t  fails;
+static uint8_t  seq;
+
+/* 마지막 응답 (TELEM_TYPE_REPLY) */
+static uint8_t  tx_frame[TELEM_HDR_SIZE + TELEM_MAX_PAYLOAD + TELEM_CRC_SIZE];
+static uint32_t tx_n;
+static int      reply_status = -1;
+
+static void FaultSim_Check(const char *what, uint8_t ok)
+{
+    printf("%-4s %s\n", ok ? "ok" : "FAIL", what);
+    if (!ok) fails++;
+}
+
+static void FaultSim_Shutdown(void)
+{
+    shutdowns++;
+}
+
+/* ============== 1) fault.c 단독 ============== */
+
+static void FaultSim_Fsm(void)
+{
+    const Fault_Info_t *f = Fault_GetInfo();
+    shutdowns = 0;
+    Fault_Init(FaultSim_Shutdown);
+
+    Fault_Raise(FAULT_NONE, 5u);
+    FaultSim_Check("FAULT_NONE is ignored", Fault_IsOk() && shutdowns == 0u);
+
+    Fault_Raise(FAULT_OC_HW, 10u);
+    FaultSim_Check("raise -> TRIPPED, shutdown once",
+                   f->state == FAULT_ST_TRIPPED && shutdowns == 1u && f->trip_count == 1u);
+
+    Fault_Raise(FAULT_VBUS_OV, 20u);
+    FaultSim_Check("second cause accumulates, first cause / time latched",
+                   f->first_cause == FAULT_OC_HW && f->causes == (FAULT_OC_HW | FAULT_VBUS_OV) &&
+                   f->trip_time == 10u && shutdowns == 1u && f->trip_count == 1u);
+
+    FaultSim_Check("clear rejected while a cause is active",
+                   !Fault_Clear(FAULT_OC_HW, 30u) && f->state == FAULT_ST_TRIPPED);
+
+    FaultSim_Check("clear accepted -> HOLDOFF",
+                   Fault_Clear(FAULT_NONE, 30u) && f->state == FAULT_ST_HOLDOFF && !Fault_IsOk());
+
+    Fault_Process(30u + FAULT_HOLDOFF_MS - 1u);
+    FaultSim_Check("still HOLDOFF 1 ms before the holdoff ends", f->state == FAULT_ST_HOLDOFF);
+
+    Fault_Process(30u + FAULT_HOLDOFF_MS);
+    FaultSim_Check("holdoff elapsed -> OK, causes cleared",
+                   Fault_IsOk() && f->causes == FAULT_NONE && f->first_cause == FAULT_NONE);
+
+    FaultSim_Check("clear rejected when not tripped", !Fault_Clear(FAULT_NONE, 200u));
+
+    Fault_Raise(FAULT_OC_SW_A, 300u);
+    Fault_Clear(FAULT_NONE, 310u);
+    Fault_Raise(FAULT_OC_SW_B, 320u);
+    FaultSim_Check("raise during HOLDOFF re-trips and calls shutdown again",
+                   f->state == FAULT_ST_TRIPPED && shutdowns == 3u && f->trip_count == 3u &&
+                   f->first_cause == FAULT_OC_SW_B);
+    Fault_Process(320u + 2u * FAULT_HOLDOFF_MS);
+    FaultSim_Check("TRIPPED is not left by time alone", f->state == FAULT_ST_TRIPPED);
+
+    Fault_Clear(FAULT_NONE, 0xFFFFFFF0u);
+    Fault_Process(0xFFFFFFF0u + FAULT_HOLDOFF_MS - 1u);
+    uint8_t held = (f->state == FAULT_ST_HOLDOFF);
+    Fault_Process(0xFFFFFFF0u + FAULT_HOLDOFF_MS);
+    FaultSim_Check("holdoff across tick wraparound", held && Fault_IsOk());
+}
+
+/* ============== 2) protect.c + cmd.c ============== */
+
+void HalHost_UartTxHook(const uint8_t *pData, uint16_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        uint8_t b = pData[i];
+        if ((tx_n == 0u && b != TELEM_SYNC0) || (tx_n == 1u && b != TELEM_SYNC1))
+        {
+            tx_n = 0;
+            if (b != TELEM_SYNC0) continue;
+        }
+        tx_frame[tx_n++] = b;
+        if (tx_n < TELEM_HDR_SIZE || tx_n < TELEM_HDR_SIZE + tx_frame[4] + TELEM_CRC_SIZE) continue;
+
+        if (tx_frame[2] == TELEM_TYPE_REPLY) reply_status = tx_frame[7];
+        tx_n = 0;
+    }
+}
+
+/**
+ * @brief 명령 1 개 (COBS + CRC) 를 수신 경로로 넣고 응답 상태 반환
+ * @return CMD_ST_xxx, 응답이 없으면 -1
+ */
+static int FaultSim_Cmd(uint8_t cmd, const uint8_t *arg, uint32_t arg_len)
+{
+    uint8_t pkt[CMD_MAX_PACKET];
+    uint8_t enc[CMD_MAX_PACKET + 4u];
+    uint32_t len = 0;
+
+    pkt[len++] = cmd;
+    pkt[len++] = seq++;
+    for (uint32_t i = 0; i < arg_len; i++) pkt[len++] = arg[i];
+    uint16_t crc = CRC16_Update(CRC16_INIT, pkt, len);
+    pkt[len++] = (uint8_t)(crc & 0xFFu);
+    pkt[len++] = (uint8_t)(crc >> 8);
+
+    // COBS (패킷이 254 바이트보다 짧으므로 0xFF 블록 없음)
+    uint32_t o = 1, code_pos = 0;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (pkt[i] == 0x00u)
+        {
+            enc[code_pos] = (uint8_t)(o - code_pos);
+            code_pos = o++;
+        }
+        else
+        {
+            enc[o++] = pkt[i];
+        }
+    }
+    enc[code_pos] = (uint8_t)(o - code_pos);
+    enc[o++] = 0x00u;
+
+    reply_status = -1;
+    HalHost_UartRx(enc, o);
+    Cmd_Process();
+    do { Telem_Process(); } while (HalHost_UartPoll());
+    HalHost_GpioSync();
+    return reply_status;
+}
+
+/* 제어 스텝 진행 (메인 루프처럼 텔레메트리를 비워 응답이 버려지지 않게) */
+static void FaultSim_Run(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        FwLoop_Tick();
+        do { Telem_Process(); } while (HalHost_UartPoll());
+    }
+}
+
+static int FaultSim_Mode(uint8_t mode)
+{
+    return FaultSim_Cmd(CMD_SET_MODE, &mode, 1u);
+}
+
+/* COMP3 EXTI 트립 (출력은 set 이 주어지는 동안 활성으로 남음) */
+static void FaultSim_TripComp(uint8_t active)
+{
+    if (active) COMP3->CSR |= COMP_CSR_VALUE;
+    EXTI->PR1 |= EXTI_IMR1_IM29;
+    Protect_COMP_IRQHandler();
+    EXTI->PR1 &= ~EXTI_IMR1_IM29;       // rc_w1 은 호스트 메모리로 흉내 낼 수 없어 직접 지움
+    HalHost_GpioSync();
+}
+
+static void FaultSim_Protect(void)
+{
+    Plant_Params_t par;
+    Plant_DefaultParams(&par);
+    FwLoop_Init(&par);
+    Telem_Init(&hlpuart1);
+    Cmd_Init(&hlpuart1);
+    const Fault_Info_t *f = Fault_GetInfo();
+
+    FaultSim_Run(10u);
+    FaultSim_Check("boot: RUN latched, driver enabled", Protect_IsRun() && HalHost_DriverEnabled());
+
+    /* COMP3 트립 → 해제 → HOLDOFF → RUN 재활성 */
+    FaultSim_TripComp(1u);
+    FaultSim_Check("COMP3 trip: EN low, OC_HW latched",
+                   !HalHost_DriverEnabled() && f->state == FAULT_ST_TRIPPED && f->first_cause == FAULT_OC_HW);
+    FaultSim_Check("RUN rejected while tripped",
+                   FaultSim_Mode(CMD_MODE_RUN) == CMD_ST_REJECTED && !HalHost_DriverEnabled());
+    FaultSim_Check("FAULT_CLEAR rejected while COMP3 output is high",
+                   FaultSim_Cmd(CMD_FAULT_CLEAR, NULL, 0u) == CMD_ST_REJECTED && f->state == FAULT_ST_TRIPPED);
+
+    COMP3->CSR &= ~COMP_CSR_VALUE;
+    FaultSim_Check("FAULT_CLEAR accepted after COMP3 output drops",
+                   FaultSim_Cmd(CMD_FAULT_CLEAR, NULL, 0u) == CMD_ST_OK && f->state == FAULT_ST_HOLDOFF);
+    FaultSim_Run(FAULT_HOLDOFF_MS - 1u);
+    FaultSim_Check("EN stays low during HOLDOFF", !HalHost_DriverEnabled());
+    FaultSim_Run(2u);
+    FaultSim_Check("holdoff elapsed with RUN: EN re-enabled", Fault_IsOk() && HalHost_DriverEnabled());
+
+    /* ADC AWD 트립 → 재무장 */
+    HAL_ADC_LevelOutOfWindowCallback(&hadc2);
+    HalHost_GpioSync();
+    FaultSim_Check("AWD B trip: EN low, AWD1 interrupt off",
+                   !HalHost_DriverEnabled() && f->first_cause == FAULT_OC_SW_B && !(ADC2->IER & ADC_IT_AWD1));
+    FaultSim_Cmd(CMD_FAULT_CLEAR, NULL, 0u);
+    FaultSim_Run(FAULT_HOLDOFF_MS + 1u);
+    FaultSim_Check("holdoff elapsed: AWD1 re-armed on both ADCs, EN re-enabled",
+                   (ADC1->IER & ADC_IT_AWD1) && (ADC2->IER & ADC_IT_AWD1) && HalHost_DriverEnabled());
+
+    /* STOP 지령은 고장 해제 후에도 유지 */
+    FaultSim_Check("STOP: EN low",
+                   FaultSim_Mode(CMD_MODE_STOP) == CMD_ST_OK && !HalHost_DriverEnabled() && !Protect_IsRun());
+    FaultSim_TripComp(0u);
+    FaultSim_Cmd(CMD_FAULT_CLEAR, NULL, 0u);
+    FaultSim_Run(2u * FAULT_HOLDOFF_MS);
+    FaultSim_Check("fault cleared while stopped: EN stays low",
+                   Fault_IsOk() && !HalHost_DriverEnabled() && !Protect_IsRun());
+    FaultSim_Check("RUN after clear: EN high",
+                   FaultSim_Mode(CMD_MODE_RUN) == CMD_ST_OK && HalHost_DriverEnabled());
+
+    /* 식별 중 STOP */
+    uint8_t spin = 0;
+    FaultSim_Check("ID_START accepted", FaultSim_Cmd(CMD_ID_START, &spin, 1u) == CMD_ST_OK && MotorId_IsActive());
+    FaultSim_Run(20u);
+    FaultSim_Mode(CMD_MODE_STOP);
+    FaultSim_Run(200u);
+    FaultSim_Check("STOP during identification: aborted, EN stays low",
+                   !MotorId_IsActive() && !HalHost_DriverEnabled());
+}
+
+int main(void)
+{
+    printf("-- fault.c state machine\n");
+    FaultSim_Fsm();
+    printf("-- protect.c / cmd.c on hal_host\n");
+    FaultSim_Protect();
+
+    if (fails) printf("FAIL %u check(s)\n", fails);
+    else       printf("PASS\n");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file    fw_loop.c
+ * @brief   펌웨어-플랜트 폐루프 구현 (호스트 시뮬레이션)
+ */
+
+#include "fw_loop.h"
+#include "hal_host.h"
+#include "app_config.h"
+#include "param.h"
+#include "fault.h"
+#include "protect.h"
+#include "sense.h"
+#include "svpwm.h"
+#include "motor_id.h"
+#include "mech_id.h"
+#include <string.h>
+
+/* ============== 상태 ============== */
+static Plant_t  plant;
+static uint32_t ticks = 0;
+static FwLoop_PeriodFn_t period_fn = NULL;
+static void    *period_ctx = NULL;
+static HalHost_Pwm_t pwm_last;
+
+/* ============== 내부 함수 ============== */
+
+/**
+ * @brief 플랜트 → ADC 원시값 / Hall (sense.c / protect.c 의 역변환)
+ */
+static void FwLoop_Sample(void)
+{
+    uint16_t ra, rb;
+    Plant_SampleAdc(&plant, &ra, &rb);
+
+    HalHost_AdcSet(ra, rb, Plant_AdcConvert(&plant, plant.p.vbus / VBUS_DIV_GAIN), 0u);
+    HalHost_SetHall(plant.hall);
+}
+
+/* ============== 공개 함수 ============== */
+
+void FwLoop_Init(const Plant_Params_t *pPar)
+{
+    HalHost_Init();
+    Plant_Init(&plant, pPar);
+    ticks = 0;
+    period_fn = NULL;
+    period_ctx = NULL;
+    memset(&pwm_last, 0, sizeof(pwm_last));
+
+    Param_Init();
+    FwLoop_Sample();                    // 정지 상태 변환값 (Sense_Init 첫 샘플)
+    Protect_Init(&htim3, &hadc1, &hadc2);
+    Sense_Init(&hadc1, &hadc2);
+    SVPWM_Init(&htim3);
+    HAL_TIM_Base_Start_IT(&htim6);
+    Protect_SetRun(1);
+    HalHost_GpioSync();
+}
+
+Plant_t* FwLoop_Plant(void)
+{
+    return &plant;
+}
+
+void FwLoop_SetPeriodHook(FwLoop_PeriodFn_t fn, void *ctx)
+{
+    period_fn = fn;
+    period_ctx = ctx;
+}
+
+void FwLoop_Tick(void)
+{
+    FwLoop_Sample();
+    host_tick++;
+    OpenLoop_Step();
+    HalHost_GpioSync();
+
+    Protect_Process();
+    MotorId_Process();
+    MechId_Process();
+    HalHost_GpioSync();
+
+    ticks++;
+    const double t_next = (double)ticks / (double)CONTROL_FREQ_HZ;
+    while (plant.t < t_next - 1e-9)
+    {
+        HalHost_PwmPeriod(&pwm_last);
+        if (HalHost_DriverEnabled())
+            Plant_RunPwmHalves(&plant, pwm_last.up, pwm_last.dn, pwm_last.arr, pwm_last.trig);
+        else
+            Plant_RunOff(&plant, pwm_last.arr);
+
+        // 단일 션트: 하강 구간 두 샘플 → 주입 그룹 (다음 정점 ISR 이 Sense_ShuntLatch 로 읽음)
+        if (plant.shunt[0].valid && plant.shunt[1].valid)
+            HalHost_AdcSetShunt(Plant_CurrentToAdc(&plant, plant.shunt[0].i_dc),
+                                Plant_CurrentToAdc(&plant, plant.shunt[1].i_dc));
+        if (period_fn != NULL) period_fn(&plant, period_ctx);
+    }
+}
+
+void FwLoop_Run(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+        FwLoop_Tick();
+}
+
+const HalHost_Pwm_t* FwLoop_Pwm(void)
+{
+    return &pwm_last;
+}
+
+uint32_t FwLoop_Ticks(void)
+{
+    return ticks;
+}
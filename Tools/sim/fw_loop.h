@@ -0,0 +1,68 @@
+/**
+ * @file    fw_loop.h
+ * @brief   펌웨어-플랜트 폐루프 헤더 (호스트 시뮬레이션)
+ *
+ * 펌웨어 소스 (svpwm.c, sense.c, protect.c, motor_id.c, mech_id.c ...) 를 hal_host.c 와
+ * 함께 링크하고, 제어 ISR (OpenLoop_Step) 과 TIM3 업데이트 ISR 을 plant.c 와 번갈아 돌린다.
+ *
+ *   제어 스텝 (1 ms, CONTROL_FREQ_HZ):
+ *     1) 플랜트 상전류 / 버스 전압 → ADC DMA 버퍼, Hall → GPIOB IDR
+ *     2) HAL tick +1, OpenLoop_Step() (TIM6 ISR 과 같은 호출)
+ *     3) 메인 루프 태스크 (Protect_Process, MotorId_Process, MechId_Process)
+ *     4) 다음 스텝 시각까지 TIM3 PWM 주기 진행 → Plant_RunPwmHalves / Plant_RunOff
+ *        (단일 션트 빌드는 하강 구간 DC 링크 샘플을 ADC1 주입 그룹으로 되돌림)
+ *
+ * 펌웨어 상태가 전역이라 한 프로세스에 폐루프 하나만 돌린다.
+ */
+
+#ifndef __FW_LOOP_H
+#define __FW_LOOP_H
+
+#include "plant.h"
+#include "hal_host.h"
+#include <stdint.h>
+
+/* ============== 타입 ============== */
+
+/* PWM 주기 관찰 콜백 (주기마다 플랜트 적분 직후) */
+typedef void (*FwLoop_PeriodFn_t)(const Plant_t *pl, void *ctx);
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 하네스 초기화 - main.c 의 USER CODE 2 순서 (통신/NVM 제외) + 플랜트
+ * @param pPar  플랜트 파라미터
+ */
+void FwLoop_Init(const Plant_Params_t *pPar);
+
+/**
+ * @brief 플랜트 상태
+ */
+Plant_t* FwLoop_Plant(void);
+
+/**
+ * @brief PWM 주기 관찰 콜백 등록 (NULL: 해제, FwLoop_Init 이 해제한다)
+ */
+void FwLoop_SetPeriodHook(FwLoop_PeriodFn_t fn, void *ctx);
+
+/**
+ * @brief 제어 스텝 1 회 + 다음 스텝까지 PWM 주기
+ */
+void FwLoop_Tick(void);
+
+/**
+ * @brief 제어 스텝 n 회
+ */
+void FwLoop_Run(uint32_t ticks);
+
+/**
+ * @brief 마지막으로 진행한 PWM 주기의 타이머 값 (주기 관찰 콜백 안에서 = 방금 적분한 주기)
+ */
+const HalHost_Pwm_t* FwLoop_Pwm(void);
+
+/**
+ * @brief 누적 제어 스텝 수
+ */
+uint32_t FwLoop_Ticks(void);
+
+#endif /* __FW_LOOP_H */
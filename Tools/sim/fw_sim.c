@@ -0,0 +1,151 @@
+/**
+ * @file    fw_sim.c
+ * @brief   펌웨어-플랜트 폐루프 오픈루프 시험 (호스트 CLI)
+ *
+ * plant_sim.c 는 OpenLoop_Step 을 흉내 낸 경로로 CCR 을 만들지만, 이 도구는 펌웨어
+ * 소스 (svpwm.c, sense.c, protect.c, param.c ...) 를 hal_host.c 와 함께 그대로 링크해
+ * 실제 OpenLoop_Step / TIM3 업데이트 ISR / Sense_Update 가 플랜트를 구동한다.
+ * 기동 램프는 motor_client 처럼 제어 스텝마다 OpenLoop_SetSpeedVolt 로 준다.
+ *
+ * 판정 (하나라도 어긋나면 종료 코드 1):
+ *   - 고장 없음, 드라이버 EN 유지
+ *   - 마지막 0.5 s 평균 기계 속도 = 2π·f / 극쌍수 (±1 %)
+ *   - Sense_GetState() 의 ia/ib = 같은 시점 플랜트 상전류 (±2 LSB)
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt, -Wall -Wextra -Werror, ctest 게이트에 포함):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target fw_sim
+ *
+ * 실행:
+ *   ./fw_sim --freq 20 --volt 1.5 --ramp 1 --time 3
+ *   ./fw_sim --freq 40 --volt 2.5 --ramp 2 --time 5 --out fw.csv
+ */
+
+#include "fw_loop.h"
+#include "hal_host.h"
+#include "app_config.h"
+#include "fault.h"
+#include "sense.h"
+#include "svpwm.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 설정 ============== */
+#define FWSIM_SPEED_TOL     0.01        // 속도 판정 ±1 %
+#define FWSIM_CUR_LSB       2.0f        // 전류 판정 [ADC LSB]
+#define FWSIM_AVG_S         0.5         // 속도 평균 구간 [s]
+
+static void FwSim_Usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [--freq HZ] [--volt V] [--ramp SEC] [--time SEC] [--out FILE]\n"
+        "          [--vbus V] [--rs OHM] [--ld H] [--lq H] [--flux WB] [--pp N] [--j KGM2] [--tl NM]\n",
+        argv0);
+}
+
+int main(int argc, char **argv)
+{
+    float freq = 20.0f, volt = 1.5f, ramp = 1.0f;
+    double time_s = 3.0;
+    const char *out_csv = NULL;
+    Plant_Params_t par;
+    Plant_DefaultParams(&par);
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a = argv[i];
+        if (i + 1 >= argc) { FwSim_Usage(argv[0]); return 2; }
+        const char *v = argv[++i];
+
+        if      (!strcmp(a, "--freq")) freq = (float)atof(v);
+        else if (!strcmp(a, "--volt")) volt = (float)atof(v);
+        else if (!strcmp(a, "--ramp")) ramp = (float)atof(v);
+        else if (!strcmp(a, "--time")) time_s = atof(v);
+        else if (!strcmp(a, "--out"))  out_csv = v;
+        else if (!strcmp(a, "--vbus")) par.vbus = (float)atof(v);
+        else if (!strcmp(a, "--rs"))   par.rs = (float)atof(v);
+        else if (!strcmp(a, "--ld"))   par.ld = (float)atof(v);
+        else if (!strcmp(a, "--lq"))   par.lq = (float)atof(v);
+        else if (!strcmp(a, "--flux")) par.flux = (float)atof(v);
+        else if (!strcmp(a, "--pp"))   par.pole_pairs = (uint32_t)atoi(v);
+        else if (!strcmp(a, "--j"))    par.j = (float)atof(v);
+        else if (!strcmp(a, "--tl"))   par.t_load = (float)atof(v);
+        else { FwSim_Usage(argv[0]); return 2; }
+    }
+    if (time_s <= FWSIM_AVG_S || ramp < 0.0f || ramp > time_s - FWSIM_AVG_S)
+    {
+        fprintf(stderr, "--time must exceed --ramp + %.1f s\n", FWSIM_AVG_S);
+        return 2;
+    }
+
+    FILE *out = NULL;
+    if (out_csv)
+    {
+        out = fopen(out_csv, "w");
+        if (!out) { perror(out_csv); return 1; }
+        fprintf(out, "t,ccr_a,ccr_b,ccr_c,ia,ib,sense_ia,sense_ib,omega_m,theta_e,angle\n");
+    }
+
+    FwLoop_Init(&par);
+    Plant_t *pl = FwLoop_Plant();
+
+    const uint32_t steps = (uint32_t)(time_s * CONTROL_FREQ_HZ);
+    const uint32_t avg_from = steps - (uint32_t)(FWSIM_AVG_S * CONTROL_FREQ_HZ);
+    const float lsb_a = ADC_VREF / ADC_FULL_SCALE / (CURR_SHUNT_OHM * CURR_AMP_GAIN);
+    double w_sum = 0.0;
+    float cur_err = 0.0f;
+    uint32_t w_n = 0;
+    uint8_t ok = 1;
+
+    for (uint32_t n = 0; n < steps; n++)
+    {
+        float t = (float)n / (float)CONTROL_FREQ_HZ;
+        float k = (ramp > 0.0f && t < ramp) ? t / ramp : 1.0f;
+        if (!OpenLoop_SetSpeedVolt(freq * k, volt * (0.2f + 0.8f * k)))
+        {
+            fprintf(stderr, "OpenLoop_SetSpeedVolt rejected %.3f Hz / %.3f V\n", freq * k, volt);
+            return 1;
+        }
+
+        // 이번 스텝이 읽을 샘플 = 지금 플랜트 전류
+        const float ia = pl->ia, ib = pl->ib;
+        FwLoop_Tick();
+
+        const Sense_State_t *s = Sense_GetState();
+        float e = fmaxf(fabsf(s->ia - ia), fabsf(s->ib - ib));
+        if (e > cur_err) cur_err = e;
+
+        if (n >= avg_from)
+        {
+            w_sum += pl->omega_m;
+            w_n++;
+        }
+        if (out)
+        {
+            const SVPWM_State_t *st = SVPWM_GetState();
+            fprintf(out, "%.4f,%u,%u,%u,%.4f,%.4f,%.4f,%.4f,%.3f,%.4f,%.4f\n",
+                    pl->t, st->CCR_A, st->CCR_B, st->CCR_C, ia, ib, s->ia, s->ib,
+                    pl->omega_m, pl->theta_e, g_angle);
+        }
+    }
+    if (out) fclose(out);
+
+    const double w_sync = 2.0 * M_PI * freq / (double)pl->p.pole_pairs;
+    const double w_avg = w_sum / (double)w_n;
+    const double w_err = fabs(w_avg - w_sync) / w_sync;
+
+    printf("control steps   : %u (%u Hz)\n", FwLoop_Ticks(), CONTROL_FREQ_HZ);
+    printf("pwm periods     : %llu\n", (unsigned long long)pl->periods);
+    printf("fault           : 0x%04x, driver %s\n", Fault_GetInfo()->causes,
+           HalHost_DriverEnabled() ? "on" : "off");
+    printf("speed           : %.3f rad/s (sync %.3f, err %.3f %%)\n", w_avg, w_sync, 100.0 * w_err);
+    printf("sense vs plant  : max %.2f mA (%.2f LSB)\n", 1e3f * cur_err, cur_err / lsb_a);
+
+    if (!Fault_IsOk() || !HalHost_DriverEnabled())  { printf("FAIL fault / driver\n"); ok = 0; }
+    if (!(w_err <= FWSIM_SPEED_TOL))                 { printf("FAIL speed\n"); ok = 0; }
+    if (!(cur_err <= FWSIM_CUR_LSB * lsb_a))         { printf("FAIL current sense\n"); ok = 0; }
+    if (ok) printf("PASS\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file    core_cm4.h
+ * @brief   호스트 빌드용 CMSIS core_cm4.h 가림막 (Tools/sim 펌웨어 링크 시험)
+ *
+ * -ITools/sim/hal 을 -IDrivers/CMSIS/Include 보다 앞에 두면 장치 헤더의
+ * #include "core_cm4.h" 가 이 파일을 먼저 찾는다.
+ *   1) cmsis_gcc.h 의 인클루드 가드를 미리 정의 → ARM 인라인 어셈블리 제외
+ *   2) 컴파일러 매크로 / 펌웨어가 쓰는 내장 함수를 호스트 구현으로 제공
+ *   3) 원래 core_cm4.h 를 읽고 DWT 를 호스트 구조체로 바꾼다
+ * 인터럽트 마스크는 단일 스레드 시뮬레이션이므로 값만 기억한다.
+ */
+
+#ifndef __HOST_CORE_CM4_H
+#define __HOST_CORE_CM4_H
+
+#include <stdint.h>
+
+/* ============== cmsis_gcc.h 대체 ============== */
+#define __CMSIS_GCC_H
+
+#define __ASM                       __asm
+#define __INLINE                    inline
+#define __STATIC_INLINE             static inline
+#define __STATIC_FORCEINLINE        __attribute__((always_inline)) static inline
+#define __NO_RETURN                 __attribute__((__noreturn__))
+#define __USED                      __attribute__((used))
+#define __WEAK                      __attribute__((weak))
+#define __PACKED                    __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT             struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION              union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)                __attribute__((aligned(x)))
+#define __RESTRICT                  __restrict
+#define __COMPILER_BARRIER()        __asm volatile("" ::: "memory")
+
+/* ============== 내장 함수 (호스트) ============== */
+extern uint32_t host_primask;
+extern uint32_t host_basepri;
+
+__STATIC_INLINE void     __disable_irq(void)            { host_primask = 1u; }
+__STATIC_INLINE void     __enable_irq(void)             { host_primask = 0u; }
+__STATIC_INLINE uint32_t __get_PRIMASK(void)            { return host_primask; }
+__STATIC_INLINE void     __set_PRIMASK(uint32_t v)      { host_primask = v & 1u; }
+__STATIC_INLINE uint32_t __get_BASEPRI(void)            { return host_basepri; }
+__STATIC_INLINE void     __set_BASEPRI(uint32_t v)      { host_basepri = v & 0xFFu; }
+__STATIC_INLINE void     __set_BASEPRI_MAX(uint32_t v)
+{
+    v &= 0xFFu;
+    if (v != 0u && (host_basepri == 0u || v < host_basepri)) host_basepri = v;
+}
+
+#define __DMB()                     __sync_synchronize()
+#define __DSB()                     __sync_synchronize()
+#define __ISB()                     __sync_synchronize()
+#define __NOP()                     ((void)0)
+#define __WFI()                     ((void)0)
+#define __WFE()                     ((void)0)
+#define __SEV()                     ((void)0)
+#define __CLZ(x)                    ((uint8_t)((x) ? __builtin_clz(x) : 32))
+#define __REV(x)                    __builtin_bswap32(x)
+
+__STATIC_INLINE uint32_t __RBIT(uint32_t v)
+{
+    uint32_t r = 0;
+    for (uint32_t i = 0; i < 32u; i++) { r = (r << 1) | (v & 1u); v >>= 1; }
+    return r;
+}
+
+/* ============== 원래 헤더 ============== */
+#include_next "core_cm4.h"
+
+/* 사이클 카운터: 시뮬레이션이 CYCCNT 를 직접 진행시킨다 */
+extern DWT_Type host_dwt;
+extern CoreDebug_Type host_coredebug;
+extern SysTick_Type host_systick;
+#undef  DWT
+#define DWT                         (&host_dwt)
+#undef  CoreDebug
+#define CoreDebug                   (&host_coredebug)
+#undef  SysTick
+#define SysTick                     (&host_systick)
+
+#endif /* __HOST_CORE_CM4_H */
@@ -0,0 +1,472 @@
+/**
+ * @file    hal_host.c
+ * @brief   호스트 HAL 대체 구현 (Tools/sim 펌웨어 링크 시험)
+ *
+ * 펌웨어가 실제로 호출하는 HAL 함수만 구현한다. 새 HAL 호출이 생기면 링크 오류로
+ * 드러나므로 여기에 같은 수준 (레지스터 한두 개 + 상태) 으로 추가한다.
+ */
+
+#include "hal_host.h"
+#include "main.h"
+#include "svpwm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 주변장치 / 코어 ============== */
+TIM_TypeDef          host_tim1, host_tim3, host_tim6;
+ADC_TypeDef          host_adc1, host_adc2;
+ADC_Common_TypeDef   host_adc12_common;
+DAC_TypeDef          host_dac3;
+COMP_TypeDef         host_comp3;
+EXTI_TypeDef         host_exti;
+FLASH_TypeDef        host_flash;
+DMA_Channel_TypeDef  host_dma1_ch4;
+USART_TypeDef        host_lpuart1;
+GPIO_TypeDef         host_gpioa, host_gpiob, host_gpioc;
+RCC_TypeDef          host_rcc;
+DWT_Type             host_dwt;
+CoreDebug_Type       host_coredebug;
+SysTick_Type         host_systick;
+uint32_t             host_primask;
+uint32_t             host_basepri;
+
+uint32_t SystemCoreClock = 170000000u;
+volatile uint32_t host_tick;
+
+/* ADC / LPUART DMA 채널 (main.c 의 MX_DMA_Init 배치와 무관, 레지스터 보관용) */
+static DMA_Channel_TypeDef host_dma1_ch1, host_dma1_ch2, host_dma1_ch3;
+
+/* ============== main.c 와 같은 핸들 ============== */
+TIM_HandleTypeDef  htim3;
+TIM_HandleTypeDef  htim6;
+ADC_HandleTypeDef  hadc1;
+ADC_HandleTypeDef  hadc2;
+DMA_HandleTypeDef  hdma_adc1;
+UART_HandleTypeDef hlpuart1;
+DMA_HandleTypeDef  hdma_lpuart1_rx;
+DMA_HandleTypeDef  hdma_lpuart1_tx;
+
+/* ============== FLASH NVM (링커 심볼 _snvm / _envm) ============== */
+uint8_t host_nvm[HAL_HOST_NVM_SIZE] __attribute__((aligned(FLASH_PAGE_SIZE)));
+__asm__(".globl _snvm\n.set _snvm, host_nvm\n"
+        ".globl _envm\n.set _envm, host_nvm + 8192\n");
+_Static_assert(HAL_HOST_NVM_SIZE == 8192u, "_envm offset above must match HAL_HOST_NVM_SIZE");
+
+/* ============== 내부 상태 ============== */
+static volatile uint32_t *adc_dma_dst = NULL;   // MultiModeStart_DMA 버퍼
+static uint32_t  adc_val[2];                    // 연속 변환 최신값 (DMA 시작 전에도 보관)
+static uint8_t  *uart_rx_buf = NULL;            // Receive_DMA 버퍼 (원형)
+static uint32_t  uart_rx_size = 0;
+static uint32_t  uart_rx_pos = 0;
+static UART_HandleTypeDef *uart_tx_busy = NULL;
+static uint8_t   adc_inj_on = 0;                // InjectedStart (단일 션트 CC4 트리거)
+
+/* TIM3 프리로드 사본 (UEV 에서 ARR / CCR 이 옮겨진 값) */
+static uint32_t tim3_arr_act;
+static uint32_t tim3_ccr_act[3];
+
+/* ============================================================
+ * 하네스 인터페이스
+ * ============================================================ */
+
+void HalHost_Init(void)
+{
+    htim3.Instance = TIM3;
+    htim3.Init.Prescaler = 0;
+    htim3.Init.CounterMode = TIM_COUNTERMODE_CENTERALIGNED1;
+    htim3.Init.Period = 8499;
+    htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    TIM3->ARR = htim3.Init.Period;
+    TIM3->CR1 = TIM_CR1_CMS_0 | TIM_CR1_ARPE;
+    tim3_arr_act = TIM3->ARR;
+    memset(tim3_ccr_act, 0, sizeof(tim3_ccr_act));
+
+    htim6.Instance = TIM6;
+    htim6.Init.Prescaler = 170 - 1;
+    htim6.Init.Period = 999;
+
+    hdma_adc1.Instance = &host_dma1_ch1;
+    hadc1.Instance = ADC1;
+    hadc1.DMA_Handle = &hdma_adc1;
+    hadc2.Instance = ADC2;
+
+    hdma_lpuart1_rx.Instance = &host_dma1_ch2;
+    hdma_lpuart1_tx.Instance = &host_dma1_ch3;
+    hlpuart1.Instance = LPUART1;
+    hlpuart1.hdmarx = &hdma_lpuart1_rx;
+    hlpuart1.hdmatx = &hdma_lpuart1_tx;
+    hdma_lpuart1_rx.Parent = &hlpuart1;
+    hdma_lpuart1_tx.Parent = &hlpuart1;
+    hlpuart1.gState = HAL_UART_STATE_READY;
+    hlpuart1.RxState = HAL_UART_STATE_READY;
+    uart_tx_busy = NULL;
+    uart_rx_buf = NULL;
+
+    adc_dma_dst = NULL;
+    adc_val[0] = adc_val[1] = 0u;
+    adc_inj_on = 0;
+
+    memset(host_nvm, 0xFF, sizeof(host_nvm));
+    host_tick = 0;
+    host_primask = 0;
+    host_basepri = 0;
+}
+
+void HalHost_GpioSync(void)
+{
+    GPIO_TypeDef *ports[3] = { GPIOA, GPIOB, GPIOC };
+    for (uint32_t k = 0; k < 3u; k++)
+    {
+        uint32_t bsrr = ports[k]->BSRR;
+        ports[k]->ODR = (ports[k]->ODR & ~(bsrr >> 16)) | (bsrr & 0xFFFFu);
+        ports[k]->BSRR = 0;
+    }
+}
+
+uint8_t HalHost_DriverEnabled(void)
+{
+    HalHost_GpioSync();
+    return (GPO_DRIVER_EN_GPIO_Port->ODR & GPO_DRIVER_EN_Pin) ? 1u : 0u;
+}
+
+void HalHost_SetHall(uint8_t level)
+{
+    if (level) GPE_HALL_W_GPIO_Port->IDR |= GPE_HALL_W_Pin;
+    else       GPE_HALL_W_GPIO_Port->IDR &= ~(uint32_t)GPE_HALL_W_Pin;
+}
+
+void HalHost_AdcSet(uint16_t ia, uint16_t ib, uint16_t vbus, uint16_t resv)
+{
+    adc_val[0] = (uint32_t)ia | ((uint32_t)ib << 16);
+    adc_val[1] = (uint32_t)vbus | ((uint32_t)resv << 16);
+    if (adc_dma_dst == NULL) return;
+    adc_dma_dst[0] = adc_val[0];
+    adc_dma_dst[1] = adc_val[1];
+}
+
+/* UEV: 프리로드 → 실제 값, 업데이트 인터럽트 */
+static void HalHost_Tim3Uev(uint8_t dir_down)
+{
+    TIM_TypeDef *tim = TIM3;
+
+    if (dir_down) tim->CR1 |= TIM_CR1_DIR;
+    else          tim->CR1 &= ~(uint32_t)TIM_CR1_DIR;
+
+    tim3_arr_act = tim->ARR;
+    tim3_ccr_act[0] = tim->CCR1;
+    tim3_ccr_act[1] = tim->CCR2;
+    tim3_ccr_act[2] = tim->CCR3;
+
+    tim->SR |= TIM_SR_UIF;
+    if (tim->DIER & TIM_DIER_UIE)
+    {
+#if SVPWM_PERIOD_ISR
+        SVPWM_PeriodIRQHandler();
+#endif
+    }
+
+    // 주입 변환 완료 플래그는 rc_w1 - 호스트 메모리에서는 1 을 써도 남으므로 정점 ISR 이 읽은 뒤 지운다
+    if (dir_down) ADC1->ISR &= ~(uint32_t)(ADC_ISR_JEOC | ADC_ISR_JEOS);
+}
+
+static uint16_t HalHost_Ccr16(uint32_t v)
+{
+    return (uint16_t)((v > 0xFFFFu) ? 0xFFFFu : v);
+}
+
+void HalHost_PwmPeriod(HalHost_Pwm_t *pPwm)
+{
+    TIM_TypeDef *tim = TIM3;
+
+    HalHost_Tim3Uev(0);                 // 바닥: 이번 주기 ARR / 상승 구간 CCR
+    pPwm->arr = tim3_arr_act;
+    for (uint32_t k = 0; k < 3u; k++)
+        pPwm->up[k] = HalHost_Ccr16(tim3_ccr_act[k]);
+
+    // CC4 (하강 카운트 일치) → ADC 주입 트리거, 두 번째 값은 CC4 DMA 가 CCR4 에 다시 쓴 값
+    pPwm->trig[0] = pPwm->trig[1] = 0xFFFFu;
+    if (adc_inj_on)
+    {
+        pPwm->trig[0] = HalHost_Ccr16(tim->CCR4);
+        if ((tim->DIER & TIM_DIER_CC4DE) && host_dma1_ch4.CMAR != 0u)
+            pPwm->trig[1] = HalHost_Ccr16(*(volatile uint32_t *)(uintptr_t)host_dma1_ch4.CMAR);
+    }
+
+    HalHost_Tim3Uev(1);                 // 정점: 하강 구간 CCR, 업데이트 ISR 이 다음 주기 값을 기록
+    for (uint32_t k = 0; k < 3u; k++)
+        pPwm->dn[k] = HalHost_Ccr16(tim3_ccr_act[k]);
+    HalHost_GpioSync();
+}
+
+void HalHost_AdcSetShunt(uint16_t j1, uint16_t j2)
+{
+    ADC1->JDR1 = j1;
+    ADC1->JDR2 = j2;
+    ADC1->ISR |= ADC_ISR_JEOC | ADC_ISR_JEOS;
+}
+
+uint8_t HalHost_UartPoll(void)
+{
+    UART_HandleTypeDef *h = uart_tx_busy;
+    if (h == NULL) return 0;
+    uart_tx_busy = NULL;
+    h->gState = HAL_UART_STATE_READY;
+    HAL_UART_TxCpltCallback(h);
+    return 1;
+}
+
+uint32_t HalHost_UartRx(const uint8_t *pData, uint32_t len)
+{
+    if (uart_rx_buf == NULL || uart_rx_size == 0u) return 0;
+    DMA_Channel_TypeDef *ch = hlpuart1.hdmarx->Instance;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        uart_rx_buf[uart_rx_pos] = pData[i];
+        uart_rx_pos = (uart_rx_pos + 1u) % uart_rx_size;
+
+        // 반 링 / 링 끝 (HT / TC) → HAL_DMA_IRQHandler 가 부르는 UART 콜백
+        if (uart_rx_pos == uart_rx_size / 2u && (ch->CCR & DMA_IT_HT))
+            HAL_UART_RxHalfCpltCallback(&hlpuart1);
+        else if (uart_rx_pos == 0u && (ch->CCR & DMA_IT_TC))
+            HAL_UART_RxCpltCallback(&hlpuart1);
+    }
+    // 원형 DMA: CNDTR = 남은 전송 수 (0 이 되면 바로 size 로 재장전)
+    hlpuart1.hdmarx->Instance->CNDTR = uart_rx_size - uart_rx_pos;
+    return len;
+}
+
+__attribute__((weak)) void HalHost_UartTxHook(const uint8_t *pData, uint16_t len)
+{
+    (void)pData;
+    (void)len;
+}
+
+/* ============================================================
+ * HAL - 시스템 / GPIO / NVIC
+ * ============================================================ */
+
+uint32_t HAL_GetTick(void)
+{
+    return host_tick;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    host_tick += Delay;
+}
+
+void Error_Handler(void)
+{
+    fprintf(stderr, "Error_Handler\n");
+    abort();
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    HalHost_GpioSync();
+    // 출력 핀은 ODR 를 되읽는다 (드라이버 EN 상태 확인용)
+    return ((GPIOx->IDR | GPIOx->ODR) & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    HalHost_GpioSync();
+    if (PinState != GPIO_PIN_RESET) GPIOx->ODR |= GPIO_Pin;
+    else                            GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    (void)IRQn; (void)PreemptPriority; (void)SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    (void)IRQn;
+}
+
+/* ============================================================
+ * HAL - TIM
+ * ============================================================ */
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    htim->Instance->CCER |= (TIM_CCER_CC1E << (Channel & 0x1Fu));
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, const TIM_OC_InitTypeDef *sConfig,
+                                            uint32_t Channel)
+{
+    (void)htim; (void)sConfig; (void)Channel;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_ConfigOCrefClear(TIM_HandleTypeDef *htim,
+                                           const TIM_ClearInputConfigTypeDef *sClearInputConfig,
+                                           uint32_t Channel)
+{
+    (void)htim; (void)sClearInputConfig; (void)Channel;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->DIER |= TIM_DIER_UIE;
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+/* ============================================================
+ * HAL - ADC
+ * ============================================================ */
+
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef *hadc, uint32_t SingleDiff)
+{
+    (void)hadc; (void)SingleDiff;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_MultiModeStart_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length)
+{
+    (void)hadc;
+    if (Length < 2u) return HAL_ERROR;
+    adc_dma_dst = (volatile uint32_t *)pData;
+    adc_dma_dst[0] = adc_val[0];        // 연속 변환: 시작 직후 첫 결과
+    adc_dma_dst[1] = adc_val[1];
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_AnalogWDGConfig(ADC_HandleTypeDef *hadc, const ADC_AnalogWDGConfTypeDef *pAnalogWDGConfig)
+{
+    (void)hadc; (void)pAnalogWDGConfig;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_InjectedConfigChannel(ADC_HandleTypeDef *hadc,
+                                                  const ADC_InjectionConfTypeDef *pConfigInjected)
+{
+    (void)hadc; (void)pConfigInjected;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_InjectedStart(ADC_HandleTypeDef *hadc)
+{
+    (void)hadc;
+    adc_inj_on = 1;
+    return HAL_OK;
+}
+
+/* ============================================================
+ * HAL - DMA
+ * ============================================================ */
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength)
+{
+    hdma->Instance->CPAR = DstAddress;
+    hdma->Instance->CMAR = SrcAddress;
+    hdma->Instance->CNDTR = DataLength;
+    return HAL_OK;
+}
+
+/* ============================================================
+ * HAL - UART
+ * ============================================================ */
+
+static HAL_StatusTypeDef HalHost_UartTx(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    if (uart_tx_busy != NULL) return HAL_BUSY;
+    if (pData == NULL || Size == 0u) return HAL_ERROR;
+
+    HalHost_UartTxHook(pData, Size);
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    uart_tx_busy = huart;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    return HalHost_UartTx(huart, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    return HalHost_UartTx(huart, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    uart_rx_buf = pData;
+    uart_rx_size = Size;
+    uart_rx_pos = 0;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    if (huart->hdmarx != NULL)
+    {
+        // HAL 처럼 원형 수신 HT / TC 인터럽트 활성
+        huart->hdmarx->Instance->CNDTR = Size;
+        huart->hdmarx->Instance->CCR |= DMA_IT_HT | DMA_IT_TC;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    (void)huart; (void)pData; (void)Size;
+    return HAL_OK;
+}
+
+/* ============================================================
+ * HAL - FLASH (host_nvm)
+ * ============================================================ */
+
+/* FLASH 주소 → host_nvm 오프셋 (_snvm = host_nvm, 32비트 주소 공간 안에서 계산) */
+static uint8_t *HalHost_FlashPtr(uint32_t addr, uint32_t len)
+{
+    uint32_t ofs = addr - (uint32_t)(uintptr_t)host_nvm;
+    if (ofs >= HAL_HOST_NVM_SIZE || len > HAL_HOST_NVM_SIZE - ofs) return NULL;
+    return &host_nvm[ofs];
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+    uint8_t *p = HalHost_FlashPtr(Address, 8u);
+    if (TypeProgram != FLASH_TYPEPROGRAM_DOUBLEWORD || p == NULL || (Address & 7u)) return HAL_ERROR;
+
+    // 삭제되지 않은 더블워드 재기록은 PROGERR
+    for (uint32_t i = 0; i < 8u; i++)
+        if (p[i] != 0xFFu) return HAL_ERROR;
+    memcpy(p, &Data, 8u);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError)
+{
+    uint32_t addr = FLASH_BASE + pEraseInit->Page * FLASH_PAGE_SIZE;
+    uint8_t *p = HalHost_FlashPtr(addr, pEraseInit->NbPages * FLASH_PAGE_SIZE);
+    if (p == NULL)
+    {
+        *PageError = pEraseInit->Page;
+        return HAL_ERROR;
+    }
+    memset(p, 0xFF, pEraseInit->NbPages * FLASH_PAGE_SIZE);
+    *PageError = 0xFFFFFFFFu;
+    return HAL_OK;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file    hal_host.h
+ * @brief   호스트 HAL 대체 - 펌웨어 소스를 그대로 링크해 플랜트/시험 하네스와 연결
+ *
+ * main.c 와 같은 이름의 핸들 (htim3, hadc1, hlpuart1 ...) 과 주변장치 구조체를 제공하고,
+ * 펌웨어가 호출하는 HAL 함수를 최소한의 레지스터 동작으로 흉내 낸다.
+ *
+ *   TIM3  : 중앙정렬 프리로드 (정점/바닥 UEV 에서 ARR/CCR 이동) + 업데이트 ISR 호출
+ *   ADC   : MultiModeStart_DMA 버퍼에 하네스가 원시값 기록 (HalHost_AdcSet),
+ *           단일 션트 주입 그룹은 JDR1/JDR2 (HalHost_AdcSetShunt)
+ *   GPIO  : WritePin/ODR, BSRR 직접 쓰기는 HalHost_GpioSync 에서 ODR 로 반영
+ *   FLASH : _snvm ~ _envm 을 호스트 배열로 (Program/Erase)
+ *   UART  : 송신 데이터는 HalHost_UartTxHook 로 전달, 완료 콜백은 HalHost_UartPoll,
+ *           수신은 HalHost_UartRx 로 DMA 원형 버퍼에 기록 (HT / TC 콜백 포함)
+ *
+ * 주소를 uint32_t 로 다루는 펌웨어 코드 (DMA, FLASH) 때문에 -no-pie 로 링크해
+ * 전역 변수를 4GB 아래에 둔다 (힙/스택 주소를 넘기지 말 것).
+ *
+ * 빌드 플래그는 Tools/sim/CMakeLists.txt 의 hal_flags 한 곳 (-Wall -Wextra -Werror):
+ *   -fno-pie -no-pie -DSTM32G431xx -DUSE_HAL_DRIVER -DCONTROL_IN_CCMRAM=0
+ *   -ITools/sim -ITools/sim/hal (CMSIS 보다 앞) -iquote Core/Inc
+ *   -isystem Drivers/STM32G4xx_HAL_Driver/Inc, CMSIS Device / Include (벤더 헤더 경고 제외)
+ *   (Core/Inc 는 -iquote - Core/Inc/sched.h 가 시스템 <sched.h> 를 가리지 않게)
+ * 펌웨어 코드의 포인터 ↔ 주소 변환은 uintptr_t 를 거친다 (64비트 호스트에서 경고 없이).
+ */
+
+#ifndef __HAL_HOST_H
+#define __HAL_HOST_H
+
+#include "main.h"          // stm32g4xx_hal.h 는 -I 검색으로 (같은 폴더 우선 검색이면 include_next 가 어긋남)
+#include <stdint.h>
+
+/* ============== 설정 ============== */
+#define HAL_HOST_NVM_SIZE       (4u * FLASH_PAGE_SIZE)  // STM32G431.ld NVM 영역과 같은 4 페이지
+
+/* ============== 타입 ============== */
+
+/* TIM3 PWM 1 주기 (HalHost_PwmPeriod) */
+typedef struct {
+    uint32_t arr;       // ARR
+    uint16_t up[3];     // 상승 구간 CCR1~3
+    uint16_t dn[3];     // 하강 구간 CCR1~3
+    uint16_t trig[2];   // 하강 카운트 CC4 일치 CNT (0xFFFF: 없음, ADC 주입 시작 전에도)
+} HalHost_Pwm_t;
+
+/* ============== main.c 와 같은 핸들 ============== */
+extern TIM_HandleTypeDef  htim3;
+extern TIM_HandleTypeDef  htim6;
+extern ADC_HandleTypeDef  hadc1;
+extern ADC_HandleTypeDef  hadc2;
+extern DMA_HandleTypeDef  hdma_adc1;
+extern UART_HandleTypeDef hlpuart1;
+extern DMA_HandleTypeDef  hdma_lpuart1_rx;
+extern DMA_HandleTypeDef  hdma_lpuart1_tx;
+
+/* 호스트 시각 (HAL_GetTick) [ms] */
+extern volatile uint32_t host_tick;
+
+/* FLASH NVM 영역 */
+extern uint8_t host_nvm[HAL_HOST_NVM_SIZE];
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 주변장치/핸들 초기화 (MX_xxx_Init 에 해당하는 최소 설정)
+ */
+void HalHost_Init(void);
+
+/**
+ * @brief BSRR 직접 쓰기를 ODR 에 반영 (펌웨어 호출 뒤마다)
+ */
+void HalHost_GpioSync(void);
+
+/**
+ * @brief 드라이버 EN 출력 (GPO_DRIVER_EN ODR)
+ */
+uint8_t HalHost_DriverEnabled(void);
+
+/**
+ * @brief Hall W 입력 레벨 설정 (GPE_HALL_W IDR)
+ */
+void HalHost_SetHall(uint8_t level);
+
+/**
+ * @brief ADC DMA 버퍼 기록 (ADC1/ADC2 듀얼 정규 동시, sense.c 배치)
+ */
+void HalHost_AdcSet(uint16_t ia, uint16_t ib, uint16_t vbus, uint16_t resv);
+
+/**
+ * @brief TIM3 PWM 1 주기 진행 (바닥 → 정점 → 바닥)
+ * @param pPwm  이번 주기에 실제로 나간 ARR / 반주기 CCR1~3 / CC4 트리거
+ *
+ * 업데이트 인터럽트가 켜져 있으면 각 UEV 에서 SVPWM_PeriodIRQHandler 를 호출한다.
+ * 상승 구간 CCR 은 바닥 UEV, 하강 구간 CCR 은 정점 UEV 에서 옮겨진 값 (단일 션트만 다르다).
+ */
+void HalHost_PwmPeriod(HalHost_Pwm_t *pPwm);
+
+/**
+ * @brief ADC1 주입 그룹 결과 기록 (단일 션트 랭크 1/2, JEOS) - 다음 정점 ISR 이 읽는다
+ */
+void HalHost_AdcSetShunt(uint16_t j1, uint16_t j2);
+
+/**
+ * @brief 송신 DMA 완료 처리 → HAL_UART_TxCpltCallback
+ * @return 1: 완료 콜백 호출, 0: 송신 중 아님
+ */
+uint8_t HalHost_UartPoll(void);
+
+/**
+ * @brief 수신 DMA 버퍼에 바이트 주입 (원형, CNDTR 감소, 반 링 / 링 끝에서 HT / TC 콜백)
+ * @return 주입한 바이트 수 (수신 시작 전이면 0)
+ */
+uint32_t HalHost_UartRx(const uint8_t *pData, uint32_t len);
+
+/**
+ * @brief 송신 데이터 관찰 (약한 심볼 - 하네스가 재정의)
+ */
+void HalHost_UartTxHook(const uint8_t *pData, uint16_t len);
+
+#endif /* __HAL_HOST_H */
@@ -0,0 +1,69 @@
+/**
+ * @file    stm32g4xx_hal.h
+ * @brief   호스트 빌드용 HAL 가림막 (Tools/sim 펌웨어 링크 시험)
+ *
+ * 원래 HAL 헤더 (Core/Inc/stm32g4xx_hal_conf.h 포함) 를 그대로 읽은 뒤,
+ * 펌웨어가 직접 만지는 주변장치 포인터만 호스트 구조체로 바꾼다.
+ * HAL 함수 본체는 hal_host.c (레지스터 모델 최소한 + 호출 기록).
+ */
+
+#ifndef __HOST_STM32G4XX_HAL_H
+#define __HOST_STM32G4XX_HAL_H
+
+#include_next <stm32g4xx_hal.h>
+
+/* ============== 주변장치 (호스트 메모리) ============== */
+extern TIM_TypeDef          host_tim1, host_tim3, host_tim6;
+extern ADC_TypeDef          host_adc1, host_adc2;
+extern ADC_Common_TypeDef   host_adc12_common;
+extern DAC_TypeDef          host_dac3;
+extern COMP_TypeDef         host_comp3;
+extern EXTI_TypeDef         host_exti;
+extern FLASH_TypeDef        host_flash;
+extern DMA_Channel_TypeDef  host_dma1_ch4;
+extern USART_TypeDef        host_lpuart1;
+extern GPIO_TypeDef         host_gpioa, host_gpiob, host_gpioc;
+extern RCC_TypeDef          host_rcc;
+
+#undef  TIM1
+#define TIM1            (&host_tim1)
+#undef  TIM3
+#define TIM3            (&host_tim3)
+#undef  TIM6
+#define TIM6            (&host_tim6)
+#undef  ADC1
+#define ADC1            (&host_adc1)
+#undef  ADC2
+#define ADC2            (&host_adc2)
+#undef  ADC12_COMMON
+#define ADC12_COMMON    (&host_adc12_common)
+#undef  DAC3
+#define DAC3            (&host_dac3)
+#undef  COMP3
+#define COMP3           (&host_comp3)
+#undef  EXTI
+#define EXTI            (&host_exti)
+#undef  FLASH
+#define FLASH           (&host_flash)
+#undef  DMA1_Channel4
+#define DMA1_Channel4   (&host_dma1_ch4)
+#undef  LPUART1
+#define LPUART1         (&host_lpuart1)
+#undef  GPIOA
+#define GPIOA           (&host_gpioa)
+#undef  GPIOB
+#define GPIOB           (&host_gpiob)
+#undef  GPIOC
+#define GPIOC           (&host_gpioc)
+#undef  RCC
+#define RCC             (&host_rcc)
+
+/* ============== 64비트 호스트 보정 ==============
+ * TIM_FLAG_xxx / TIM_IT_xxx 는 UL 상수라 호스트에서 ~ 결과가 64비트 → SR 대입이 잘린다
+ * (-Woverflow). 타깃 (UL = 32비트) 과 같은 값이 되도록 먼저 32비트로 */
+#undef  __HAL_TIM_CLEAR_FLAG
+#define __HAL_TIM_CLEAR_FLAG(__HANDLE__, __FLAG__)  ((__HANDLE__)->Instance->SR = ~(uint32_t)(__FLAG__))
+#undef  __HAL_TIM_CLEAR_IT
+#define __HAL_TIM_CLEAR_IT(__HANDLE__, __INTERRUPT__) ((__HANDLE__)->Instance->SR = ~(uint32_t)(__INTERRUPT__))
+
+#endif /* __HOST_STM32G4XX_HAL_H */
@@ -0,0 +1,170 @@
+/**
+ * @file    mech_id_sim.c
+ * @brief   mech_id.c 식별 결과 검증 (펌웨어-플랜트 폐루프, 호스트 CLI)
+ *
+ * 전기 상수 (PARAM_MOTOR_xxx) 를 플랜트 참값으로 넣어 motor_id 가 끝난 상태를 만든 뒤,
+ * fw_loop.c 로 mech_id.c 를 실제 OpenLoop_Step / 드라이버 EN 콜백 경로와 함께 돌리고
+ * 식별된 J / B / Tc 를 플랜트 참값과 비교한다.
+ *
+ * 기본 시험 조건:
+ *   - J 2e-5 kg·m² (부하 장착, 회전자만의 10 배) : 가속 토크가 iq 수십 mA 가 되어야
+ *     ADC 1 LSB (≈ 0.8 mA) 와 Vbus 양자화 오차가 묻힌다 (무부하 2e-6 이면 iq ≈ 2 mA, J 약 −20 %)
+ *   - ID_V_DC 는 레지스트리 기본값 : J 3e-5 이상은 그 전압에서 오픈루프 동기를 잃는다
+ *   - 전류 ADC 잡음 1 LSB rms, 플랜트 데드타임 = SVPWM_DRIVER_DEADTIME_NS
+ *
+ * 허용 오차와 한계:
+ *   - J ±5 % : 토크를 전압으로 역산하므로 데드타임 모델에 민감하다 (펌웨어 값을
+ *     ±50 ns 틀리면 J 가 +3 / −9 %). 남는 −3 % 안팎은 데드타임 부호를 스텝 경계
+ *     전류 보간으로 정하는 근사와 1 ms 단위 Hall 타이밍에서 온다
+ *   - 마찰 ±10 % : 정속 / 관성 정지 구간의 토크가 작아 상대 오차가 크다
+ *
+ * 판정 (하나라도 어긋나면 종료 코드 1):
+ *   - 식별 완료 (MECH_DONE), 고장 없음, 링 넘침 없음
+ *   - J 가 참값 ±5 % (--tol), 마찰 토크 B·ω_ref + Tc 가 참값 ±(--tol-fric, 기본 10 %)
+ *   - 레지스트리 PARAM_MECH_xxx 에 결과가 적용됨
+ *
+ * 마찰은 B·ω 와 Tc 를 따로 보면 서로 바뀌어도 토크가 같아 조건이 나쁘므로
+ * 최고 속도에서의 합으로 판정하고, 각각은 참고로 출력한다.
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt, -Wall -Wextra -Werror, ctest 게이트에 포함):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target mech_id_sim
+ *
+ * 실행:
+ *   ./mech_id_sim
+ *   ./mech_id_sim --j 1e-5 --b 2e-5 --tc 5e-4 --tol 0.08
+ */
+
+#include "fw_loop.h"
+#include "hal_host.h"
+#include "app_config.h"
+#include "fault.h"
+#include "param.h"
+#include "mech_id.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 설정 ============== */
+#define MECHSIM_TOL_DEFAULT     0.05f   // J 판정 ±5 %
+#define MECHSIM_TOL_FRIC        0.10f   // 마찰 토크 판정 ±10 %
+#define MECHSIM_TIMEOUT_S       60.0f   // 식별 전체 시간 상한 [s]
+#define MECHSIM_J               2.0e-5f // 부하 장착 관성 [kg·m²]
+#define MECHSIM_ADC_NOISE       1.0f    // 전류 ADC 잡음 [LSB rms]
+
+static void MechSim_Usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [--tol FRAC] [--tol-fric FRAC] [--vdc V] [--fspin HZ]\n"
+        "          [--vbus V] [--rs OHM] [--ld H] [--lq H] [--flux WB] [--pp N]\n"
+        "          [--j KGM2] [--b NMS] [--tc NM] [--tl NM] [--noise LSB]\n",
+        argv0);
+}
+
+/* 참값 대비 상대 오차 출력, 허용 밖이면 0 (tol < 0: 참고 출력만) */
+static uint8_t MechSim_Check(const char *name, float est, float ref, float tol)
+{
+    float err = (ref != 0.0f) ? (est - ref) / ref : 0.0f;
+    uint8_t ok = (tol < 0.0f || fabsf(err) <= tol) ? 1u : 0u;
+    printf("%-8s : %.6g (plant %.6g, err %+.3f %%) %s\n", name, est, ref, 100.0f * err, ok ? "" : "FAIL");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    float tol = MECHSIM_TOL_DEFAULT, tol_fric = MECHSIM_TOL_FRIC;
+    float v_dc = -1.0f, f_spin = -1.0f;
+    Plant_Params_t par;
+    Plant_DefaultParams(&par);
+    par.j = MECHSIM_J;
+    par.adc_noise_lsb = MECHSIM_ADC_NOISE;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a = argv[i];
+        if (i + 1 >= argc) { MechSim_Usage(argv[0]); return 2; }
+        const char *v = argv[++i];
+
+        if      (!strcmp(a, "--tol"))      tol = (float)atof(v);
+        else if (!strcmp(a, "--tol-fric")) tol_fric = (float)atof(v);
+        else if (!strcmp(a, "--vdc"))      v_dc = (float)atof(v);
+        else if (!strcmp(a, "--fspin"))    f_spin = (float)atof(v);
+        else if (!strcmp(a, "--vbus"))     par.vbus = (float)atof(v);
+        else if (!strcmp(a, "--rs"))       par.rs = (float)atof(v);
+        else if (!strcmp(a, "--ld"))       par.ld = (float)atof(v);
+        else if (!strcmp(a, "--lq"))       par.lq = (float)atof(v);
+        else if (!strcmp(a, "--flux"))     par.flux = (float)atof(v);
+        else if (!strcmp(a, "--pp"))       par.pole_pairs = (uint32_t)atoi(v);
+        else if (!strcmp(a, "--j"))        par.j = (float)atof(v);
+        else if (!strcmp(a, "--b"))        par.b = (float)atof(v);
+        else if (!strcmp(a, "--tc"))       par.tc = (float)atof(v);
+        else if (!strcmp(a, "--tl"))       par.t_load = (float)atof(v);
+        else if (!strcmp(a, "--noise"))    par.adc_noise_lsb = (float)atof(v);
+        else { MechSim_Usage(argv[0]); return 2; }
+    }
+
+    FwLoop_Init(&par);
+
+    /* motor_id 결과 자리에 플랜트 참값 */
+    Param_Batch_t b;
+    Param_BatchInit(&b);
+    if (!Param_BatchStageF(&b, PARAM_MOTOR_RS, par.rs) ||
+        !Param_BatchStageF(&b, PARAM_MOTOR_LD, par.ld) ||
+        !Param_BatchStageF(&b, PARAM_MOTOR_LQ, par.lq) ||
+        !Param_BatchStageF(&b, PARAM_MOTOR_FLUX, par.flux) ||
+        !Param_BatchStageU(&b, PARAM_MOTOR_POLES, par.pole_pairs) ||
+        (v_dc   >= 0.0f && !Param_BatchStageF(&b, PARAM_ID_V_DC, v_dc)) ||
+        (f_spin >= 0.0f && !Param_BatchStageF(&b, PARAM_ID_SPIN_HZ, f_spin)))
+    {
+        fprintf(stderr, "motor / identification parameter out of range\n");
+        return 2;
+    }
+    Param_BatchCommit(&b);
+
+    if (!MechId_Start())
+    {
+        fprintf(stderr, "MechId_Start rejected (err %u)\n", MechId_GetResult()->err);
+        return 1;
+    }
+
+    const uint32_t limit = (uint32_t)(MECHSIM_TIMEOUT_S * (float)CONTROL_FREQ_HZ);
+    const MechId_Result_t *r = MechId_GetResult();
+    uint32_t n = 0;
+    while (n < limit)
+    {
+        FwLoop_Tick();
+        n++;
+        r = MechId_GetResult();
+        if (r->state == MECH_DONE || r->state == MECH_ERROR) break;
+    }
+
+    printf("steps           : %u (%.3f s)\n", n, (double)n / (double)CONTROL_FREQ_HZ);
+    printf("state / err     : %u / %u, fault 0x%04x\n", r->state, r->err, Fault_GetInfo()->causes);
+    printf("samples         : %u (dropped %u)\n", r->samples, r->dropped);
+    printf("estimate        : J %.4g, B %.4g, Tc %.4g\n", r->J, r->B, r->Tc);
+    if (r->state != MECH_DONE || !Fault_IsOk())
+    {
+        printf("FAIL identification did not complete\n");
+        return 1;
+    }
+
+    const float w_ref = 6.2831853f * Param_Get(PARAM_ID_SPIN_HZ).f / (float)par.pole_pairs;
+    uint8_t ok = (r->dropped == 0u) ? 1u : 0u;
+    if (!ok) printf("FAIL samples dropped\n");
+    ok &= MechSim_Check("J", r->J, par.j, tol);
+    ok &= MechSim_Check("B*w+Tc", r->B * w_ref + r->Tc, par.b * w_ref + par.tc + par.t_load, tol_fric);
+    MechSim_Check("B", r->B, par.b, -1.0f);
+    MechSim_Check("Tc", r->Tc, par.tc + par.t_load, -1.0f);
+    printf("kp / ki         : %.4g A/(rad/s), %.4g A/rad\n", r->kp, r->ki);
+
+    if (Param_Get(PARAM_MECH_J).f != r->J || Param_Get(PARAM_MECH_B).f != r->B ||
+        Param_Get(PARAM_MECH_TC).f != r->Tc)
+    {
+        printf("FAIL result not committed to the registry\n");
+        ok = 0;
+    }
+
+    if (ok) printf("PASS\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file    motor_id_sim.c
+ * @brief   motor_id.c 식별 결과 검증 (펌웨어-플랜트 폐루프, 호스트 CLI)
+ *
+ * fw_loop.c 로 motor_id.c 를 실제 OpenLoop_Step / sense.c 경로와 함께 돌리고,
+ * 식별된 Rs / Ld / Lq / 자속을 플랜트 참값과 비교한다.
+ *
+ * 기본 시험 조건 (레지스트리 기본값이 아니라 plant.c 기본 모터에 맞춘 값):
+ *   - ID_V_DC 2 V, ID_V_HF 0.5 V : L 측정 중 전류가 0 을 지나지 않게 (V_dc/2 > V_hf),
+ *     데드타임 전압 오차가 리플 차분에서 상쇄되고 DC 전류 단차가 ADC 100 LSB 이상
+ *   - ID_V_SPIN 4 V @ 50 Hz : 역기전력 (ω·ψ = 2.5 V) 보다 커야 동기 유지
+ *   - J 1e-4 kg·m² (부하 장착) : Lq 측정의 β축 교번 토크가 회전자를 흔들어 생기는
+ *     역기전력 오차 ≈ 1.5·pp²·ψ² / (J·ω²·Lq) 가 1 % 아래 (무부하 2e-6 이면 약 5 %)
+ *   - 전류 ADC 잡음 1 LSB rms : 실제 보드처럼 양자화를 평균으로 분해 (잡음이 없으면
+ *     정지 측정의 같은 코드가 반복되어 1 LSB 가 그대로 오차가 된다)
+ *
+ * 판정 (하나라도 어긋나면 종료 코드 1):
+ *   - 식별 완료 (MID_DONE), 고장 없음
+ *   - Rs, Ld, Lq (--spin 1 이면 자속까지) 가 참값 ±1 % (--tol)
+ *   - 레지스트리 PARAM_MOTOR_xxx 에 결과가 적용됨
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt, -Wall -Wextra -Werror, ctest 게이트에 포함):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target motor_id_sim
+ *
+ * 실행:
+ *   ./motor_id_sim
+ *   ./motor_id_sim --ld 1.5e-3 --lq 2.5e-3 --rs 3 --flux 0.01
+ */
+
+#include "fw_loop.h"
+#include "hal_host.h"
+#include "app_config.h"
+#include "fault.h"
+#include "param.h"
+#include "motor_id.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 설정 ============== */
+#define MIDSIM_TOL_DEFAULT  0.01f       // 판정 ±1 %
+#define MIDSIM_TIMEOUT_S    10.0f       // 식별 전체 시간 상한 [s]
+#define MIDSIM_V_DC         2.0f        // PARAM_ID_V_DC [V]
+#define MIDSIM_V_HF         0.5f        // PARAM_ID_V_HF [V]
+#define MIDSIM_V_SPIN       4.0f        // PARAM_ID_V_SPIN [V]
+#define MIDSIM_J            1.0e-4f     // 부하 장착 관성 [kg·m²]
+#define MIDSIM_ADC_NOISE    1.0f        // 전류 ADC 잡음 [LSB rms]
+
+static void MidSim_Usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [--spin 0|1] [--tol FRAC] [--vdc V] [--vhf V] [--vspin V] [--fspin HZ]\n"
+        "          [--vbus V] [--rs OHM] [--ld H] [--lq H] [--flux WB] [--pp N] [--j KGM2] [--noise LSB]\n",
+        argv0);
+}
+
+/* 참값 대비 상대 오차 출력, 허용 밖이면 0 */
+static uint8_t MidSim_Check(const char *name, float est, float ref, float tol)
+{
+    float err = (ref != 0.0f) ? (est - ref) / ref : 0.0f;
+    uint8_t ok = (fabsf(err) <= tol) ? 1u : 0u;
+    printf("%-5s : %.6g (plant %.6g, err %+.3f %%) %s\n", name, est, ref, 100.0f * err, ok ? "" : "FAIL");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t spin = 1;
+    float tol = MIDSIM_TOL_DEFAULT;
+    float v_dc = MIDSIM_V_DC, v_hf = MIDSIM_V_HF, v_spin = MIDSIM_V_SPIN, f_spin = -1.0f;
+    Plant_Params_t par;
+    Plant_DefaultParams(&par);
+    par.j = MIDSIM_J;
+    par.adc_noise_lsb = MIDSIM_ADC_NOISE;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a = argv[i];
+        if (i + 1 >= argc) { MidSim_Usage(argv[0]); return 2; }
+        const char *v = argv[++i];
+
+        if      (!strcmp(a, "--spin"))  spin = (uint8_t)atoi(v);
+        else if (!strcmp(a, "--tol"))   tol = (float)atof(v);
+        else if (!strcmp(a, "--vdc"))   v_dc = (float)atof(v);
+        else if (!strcmp(a, "--vhf"))   v_hf = (float)atof(v);
+        else if (!strcmp(a, "--vspin")) v_spin = (float)atof(v);
+        else if (!strcmp(a, "--fspin")) f_spin = (float)atof(v);
+        else if (!strcmp(a, "--vbus"))  par.vbus = (float)atof(v);
+        else if (!strcmp(a, "--rs"))    par.rs = (float)atof(v);
+        else if (!strcmp(a, "--ld"))    par.ld = (float)atof(v);
+        else if (!strcmp(a, "--lq"))    par.lq = (float)atof(v);
+        else if (!strcmp(a, "--flux"))  par.flux = (float)atof(v);
+        else if (!strcmp(a, "--pp"))    par.pole_pairs = (uint32_t)atoi(v);
+        else if (!strcmp(a, "--j"))     par.j = (float)atof(v);
+        else if (!strcmp(a, "--noise")) par.adc_noise_lsb = (float)atof(v);
+        else { MidSim_Usage(argv[0]); return 2; }
+    }
+
+    FwLoop_Init(&par);
+
+    /* 식별 전압 / 주파수는 motor_client 처럼 레지스트리로 (--fspin 은 지정했을 때만) */
+    Param_Batch_t b;
+    Param_BatchInit(&b);
+    if ((v_dc   >= 0.0f && !Param_BatchStageF(&b, PARAM_ID_V_DC, v_dc)) ||
+        (v_hf   >= 0.0f && !Param_BatchStageF(&b, PARAM_ID_V_HF, v_hf)) ||
+        (v_spin >= 0.0f && !Param_BatchStageF(&b, PARAM_ID_V_SPIN, v_spin)) ||
+        (f_spin >= 0.0f && !Param_BatchStageF(&b, PARAM_ID_SPIN_HZ, f_spin)))
+    {
+        fprintf(stderr, "identification parameter out of range\n");
+        return 2;
+    }
+    Param_BatchCommit(&b);
+
+    if (!MotorId_Start(spin))
+    {
+        fprintf(stderr, "MotorId_Start rejected\n");
+        return 1;
+    }
+
+    const uint32_t limit = (uint32_t)(MIDSIM_TIMEOUT_S * (float)CONTROL_FREQ_HZ);
+    const MotorId_Result_t *r = MotorId_GetResult();
+    uint32_t n = 0;
+    while (n < limit)
+    {
+        FwLoop_Tick();
+        n++;
+        r = MotorId_GetResult();
+        if (r->state == MID_DONE || r->state == MID_ERROR) break;
+    }
+
+    printf("steps           : %u (%.3f s)\n", n, (double)n / (double)CONTROL_FREQ_HZ);
+    printf("state / err     : %u / %u, fault 0x%04x\n", r->state, r->err, Fault_GetInfo()->causes);
+    if (r->state != MID_DONE || !Fault_IsOk())
+    {
+        printf("FAIL identification did not complete\n");
+        return 1;
+    }
+
+    uint8_t ok = 1;
+    ok &= MidSim_Check("rs", r->rs, par.rs, tol);
+    ok &= MidSim_Check("ld", r->ld, par.ld, tol);
+    ok &= MidSim_Check("lq", r->lq, par.lq, tol);
+    if (spin)
+        ok &= MidSim_Check("flux", r->flux, par.flux, tol);
+    printf("kp / ki         : %.4g V/A, %.4g V/(A*s)\n", r->kp, r->ki);
+
+    if (Param_Get(PARAM_MOTOR_RS).f != r->rs || Param_Get(PARAM_MOTOR_LD).f != r->ld ||
+        Param_Get(PARAM_MOTOR_LQ).f != r->lq || (spin && Param_Get(PARAM_MOTOR_FLUX).f != r->flux))
+    {
+        printf("FAIL result not committed to the registry\n");
+        ok = 0;
+    }
+
+    if (ok) printf("PASS\n");
+    return ok ? 0 : 1;
+}
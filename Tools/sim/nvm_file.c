@@ -0,0 +1,136 @@
+/**
+ * @file    nvm_file.c
+ * @brief   파일 기반 Nvm_Port_t 구현 (호스트)
+ */
+
+#include "nvm_file.h"
+#include <stdio.h>
+#include <string.h>
+
+static FILE    *fp = NULL;
+static int32_t  cut_left = -1;          // 전원 차단까지 남은 program 수 (-1: 없음)
+static uint8_t  erase_ok = 1;
+static uint32_t ecc_ofs = 0, ecc_len = 0;
+
+static uint8_t NvmFile_Read(uint32_t ofs, void *dst, uint32_t len);
+static uint8_t NvmFile_Program(uint32_t ofs, uint64_t dw);
+static uint8_t NvmFile_Erase(uint32_t page);
+static uint8_t NvmFile_EraseAllowed(void);
+
+static Nvm_Port_t file_port = {
+    .read          = NvmFile_Read,
+    .program       = NvmFile_Program,
+    .erase         = NvmFile_Erase,
+    .erase_allowed = NvmFile_EraseAllowed,
+};
+
+/* ============================================================
+ * Public 함수
+ * ============================================================ */
+
+const Nvm_Port_t* NvmFile_Open(const char *path, uint32_t page_size, uint32_t page_count)
+{
+    const long size = (long)page_size * (long)page_count;
+
+    NvmFile_Close();
+    fp = fopen(path, "r+b");
+    if (fp != NULL)
+    {
+        fseek(fp, 0, SEEK_END);
+        if (ftell(fp) != size)
+        {
+            fclose(fp);
+            fp = NULL;
+        }
+    }
+    if (fp == NULL)
+    {
+        fp = fopen(path, "w+b");
+        if (fp == NULL) return NULL;
+        for (long i = 0; i < size; i++) fputc(0xFF, fp);
+        fflush(fp);
+    }
+
+    file_port.page_size = page_size;
+    file_port.page_count = page_count;
+    cut_left = -1;
+    erase_ok = 1;
+    ecc_len = 0;
+    return &file_port;
+}
+
+void NvmFile_Close(void)
+{
+    if (fp != NULL) fclose(fp);
+    fp = NULL;
+}
+
+void NvmFile_SetEraseAllowed(uint8_t allowed)
+{
+    erase_ok = allowed;
+}
+
+void NvmFile_PowerCutAfter(int32_t n)
+{
+    cut_left = n;
+}
+
+void NvmFile_SetEcc(uint32_t ofs, uint32_t len)
+{
+    ecc_ofs = ofs;
+    ecc_len = len;
+}
+
+void NvmFile_Peek(uint32_t ofs, void *dst, uint32_t len)
+{
+    fseek(fp, (long)ofs, SEEK_SET);
+    if (fread(dst, 1, len, fp) != len) memset(dst, 0xFF, len);
+}
+
+void NvmFile_Poke(uint32_t ofs, const void *src, uint32_t len)
+{
+    fseek(fp, (long)ofs, SEEK_SET);
+    fwrite(src, 1, len, fp);
+    fflush(fp);
+}
+
+/* ============================================================
+ * Private 함수 (Nvm_Port_t)
+ * ============================================================ */
+
+static uint8_t NvmFile_Read(uint32_t ofs, void *dst, uint32_t len)
+{
+    if (ofs + len > file_port.page_size * file_port.page_count) return 0;
+    NvmFile_Peek(ofs, dst, len);
+    return (ecc_len != 0u && ofs < ecc_ofs + ecc_len && ecc_ofs < ofs + len) ? 0u : 1u;
+}
+
+static uint8_t NvmFile_Program(uint32_t ofs, uint64_t dw)
+{
+    if ((ofs & 7u) != 0u || ofs + 8u > file_port.page_size * file_port.page_count) return 0;
+    if (cut_left == 0) return 0;
+
+    uint64_t cur;
+    NvmFile_Peek(ofs, &cur, 8u);
+    if (cur != 0xFFFFFFFFFFFFFFFFull) return 0;     // 삭제되지 않은 위치 (PROGERR)
+
+    NvmFile_Poke(ofs, &dw, 8u);
+    if (cut_left > 0) cut_left--;
+    return 1;
+}
+
+static uint8_t NvmFile_Erase(uint32_t page)
+{
+    if (page >= file_port.page_count || cut_left == 0) return 0;
+
+    uint8_t ff[256];
+    memset(ff, 0xFF, sizeof(ff));
+    for (uint32_t i = 0; i < file_port.page_size; i += sizeof(ff))
+        NvmFile_Poke(page * file_port.page_size + i, ff, sizeof(ff));
+    return 1;
+}
+
+static uint8_t NvmFile_EraseAllowed(void)
+{
+    return erase_ok;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file    nvm_file.h
+ * @brief   파일 기반 Nvm_Port_t (호스트) - nvm.c 를 그대로 돌려 저장/복구 검증
+ *
+ * FLASH 와 같은 제약을 흉내 낸다:
+ *   - program 은 8 byte 정렬, 삭제 상태(0xFF) double-word 에만 (아니면 실패, PROGERR)
+ *   - erase 는 페이지 전체를 0xFF 로
+ * 시험용으로 전원 차단 (N 번째 program 부터 실패), ECC 오류 구간, 페이지 삭제 금지,
+ * 원시 읽기/쓰기 (비트 손상 주입) 를 제공한다.
+ */
+
+#ifndef __NVM_FILE_H
+#define __NVM_FILE_H
+
+#include "nvm.h"
+#include <stdint.h>
+
+/**
+ * @brief 파일 열기 (없거나 크기가 다르면 삭제 상태로 새로 만듦)
+ * @return 포트 (실패 시 NULL)
+ */
+const Nvm_Port_t* NvmFile_Open(const char *path, uint32_t page_size, uint32_t page_count);
+
+/**
+ * @brief 파일 닫기 (다시 열면 "재부팅")
+ */
+void NvmFile_Close(void);
+
+/**
+ * @brief 페이지 삭제 허용 (펌웨어의 드라이버 출력 비활성에 해당)
+ */
+void NvmFile_SetEraseAllowed(uint8_t allowed);
+
+/**
+ * @brief 전원 차단 흉내 - 앞으로 n 번 program 성공 후 모두 실패 (n < 0: 해제)
+ */
+void NvmFile_PowerCutAfter(int32_t n);
+
+/**
+ * @brief 읽기 ECC 오류 구간 (len 0: 해제)
+ */
+void NvmFile_SetEcc(uint32_t ofs, uint32_t len);
+
+/**
+ * @brief 원시 읽기 / 쓰기 (FLASH 규칙 무시 - 손상 주입용)
+ */
+void NvmFile_Peek(uint32_t ofs, void *dst, uint32_t len);
+void NvmFile_Poke(uint32_t ofs, const void *src, uint32_t len);
+
+#endif /* __NVM_FILE_H */
@@ -0,0 +1,439 @@
+/**
+ * @file    nvm_sim.c
+ * @brief   nvm.c 저장 / 손상 복구 검증 (파일 기반 포트, 호스트 CLI)
+ *
+ * nvm_file.c 포트로 nvm.c 를 그대로 돌리고 "재부팅" (파일 다시 열기 + Nvm_Init) 마다
+ * 하네스 모델과 비교한다. 모델은 저장이 끝날 때 파일에서 읽은 레코드 이미지를 보관하고,
+ * 현재 파일 내용이 이미지와 같은 레코드 (손상 / 삭제되지 않음) 중 seq 최대를 기대값으로 한다.
+ *
+ * 판정 (하나라도 어긋나면 종료 코드 1):
+ *   - 저장 완료 후 상태의 seq = 파일에 실제로 기록된 헤더 seq, 재부팅 후에도 같음
+ *   - 재부팅 후 Nvm_Load = 기대 레코드 데이터 (없으면 valid 0)
+ *   - 페이지 순환 (삭제 수 > 페이지 수) 중에도 항상 최신 유지
+ *   - 기록 중 전원 차단 (모든 double-word 위치): 직전 레코드 유지, 이후 저장 정상
+ *   - 페이지 중간 헤더 손상 뒤 레코드, 다른 페이지 레코드 모두 찾음
+ *   - ECC 오류 / CRC 오류 레코드는 버리고 이전 레코드
+ *   - 페이지 삭제 금지 중 저장은 NVM_SAVE_DEFERRED, 허용되면 기록 완료
+ *   - 무작위 저장 + 비트 손상 / 반쯤 삭제된 페이지 / 전원 차단 반복
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt, -Wall -Wextra -Werror, ctest 게이트에 포함):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target nvm_sim
+ *
+ * 실행:
+ *   ./nvm_sim
+ *   ./nvm_sim --rounds 2000 --seed 7 --file /tmp/nvm.bin
+ */
+
+#include "nvm.h"
+#include "nvm_file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 설정 ============== */
+#define NVMSIM_PAGE         2048u       // STM32G431 FLASH 페이지
+#define NVMSIM_PAGES        4u          // STM32G431.ld NVM 영역
+#define NVMSIM_REC_MAX      512u        // 모델이 보관하는 레코드 수
+#define NVMSIM_PROCESS_MAX  4096u       // 저장 1 회 Nvm_Process 호출 상한
+
+/* nvm.c 레코드 크기 (헤더 + 데이터 + 커밋) */
+#define NVMSIM_REC_SIZE(len)    (8u + (((len) + 7u) & ~7u) + 8u)
+
+typedef struct {
+    uint32_t ofs, size, seq, len;
+    uint8_t  image[NVMSIM_REC_SIZE(NVM_MAX_PAYLOAD)];
+} NvmSim_Rec_t;
+
+static const char   *path = "nvm_sim.bin";
+static const Nvm_Port_t *port;
+static NvmSim_Rec_t  recs[NVMSIM_REC_MAX];
+static uint32_t      n_recs;
+static uint32_t      fails;
+static uint64_t      rng_state = 1u;
+
+static uint32_t NvmSim_Rand(void)
+{
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (uint32_t)((rng_state * 2685821657736338717ull) >> 32);
+}
+
+static void NvmSim_Check(const char *what, uint8_t ok)
+{
+    if (!ok)
+    {
+        printf("FAIL %s\n", what);
+        fails++;
+    }
+}
+
+/* ============== 모델 ============== */
+
+static uint8_t NvmSim_Intact(const NvmSim_Rec_t *r)
+{
+    uint8_t cur[sizeof(r->image)];
+    NvmFile_Peek(r->ofs, cur, r->size);
+    return memcmp(cur, r->image, r->size) == 0;
+}
+
+/* 파일에 남아 있는 (그대로인) 레코드 중 seq 최대 */
+static const NvmSim_Rec_t* NvmSim_Expected(void)
+{
+    const NvmSim_Rec_t *best = NULL;
+    for (uint32_t i = 0; i < n_recs; i++)
+        if (NvmSim_Intact(&recs[i]) && (best == NULL || (int32_t)(recs[i].seq - best->seq) > 0))
+            best = &recs[i];
+    return best;
+}
+
+static void NvmSim_Track(uint32_t ofs, uint32_t len)
+{
+    // 삭제 / 손상된 레코드 정리
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n_recs; i++)
+        if (NvmSim_Intact(&recs[i])) recs[k++] = recs[i];
+    n_recs = k;
+    if (n_recs == NVMSIM_REC_MAX)
+    {
+        memmove(&recs[0], &recs[1], (NVMSIM_REC_MAX - 1u) * sizeof(recs[0]));
+        n_recs--;
+    }
+
+    NvmSim_Rec_t *r = &recs[n_recs++];
+    r->ofs = ofs;
+    r->len = len;
+    r->size = NVMSIM_REC_SIZE(len);
+    NvmFile_Peek(ofs, r->image, r->size);
+    memcpy(&r->seq, &r->image[4], 4);
+}
+
+/* ============== 구동 ============== */
+
+static void NvmSim_Reboot(void)
+{
+    port = NvmFile_Open(path, NVMSIM_PAGE, NVMSIM_PAGES);
+    if (port == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", path);
+        exit(2);
+    }
+    Nvm_Init(port);
+}
+
+/**
+ * @brief 저장 1 회 (끝날 때까지 Nvm_Process)
+ * @return Nvm_Save 결과, 완료되면 모델에 추가
+ */
+static uint8_t NvmSim_Save(const uint8_t *data, uint32_t len)
+{
+    uint8_t r = Nvm_Save(data, len);
+    if (r == NVM_SAVE_REJECTED) return r;
+
+    for (uint32_t i = 0; i < NVMSIM_PROCESS_MAX && Nvm_IsBusy(); i++)
+        Nvm_Process();
+
+    const Nvm_Status_t *st = Nvm_GetStatus();
+    if (st->state == NVM_ST_IDLE)
+    {
+        uint32_t size = NVMSIM_REC_SIZE(len);
+        NvmSim_Track(st->wr_ofs - size, len);
+        NvmSim_Check("status seq = seq written in the record header", st->seq == recs[n_recs - 1u].seq);
+        uint8_t buf[NVM_MAX_PAYLOAD];
+        NvmSim_Check("load right after save", Nvm_Load(buf, sizeof(buf)) == len && !memcmp(buf, data, len));
+    }
+    return r;
+}
+
+static uint32_t NvmSim_RandomData(uint8_t *buf)
+{
+    uint32_t len = 1u + NvmSim_Rand() % NVM_MAX_PAYLOAD;
+    for (uint32_t i = 0; i < len; i++) buf[i] = (uint8_t)NvmSim_Rand();
+    return len;
+}
+
+/**
+ * @brief 현재 Nvm 상태 / 최신 레코드가 기대값과 같은지
+ */
+static uint8_t NvmSim_Compare(const char *what, const NvmSim_Rec_t *exp)
+{
+    const Nvm_Status_t *st = Nvm_GetStatus();
+    uint8_t buf[NVM_MAX_PAYLOAD];
+    uint32_t n = Nvm_Load(buf, sizeof(buf));
+
+    uint8_t ok;
+    if (exp == NULL)
+        ok = (!st->valid && n == 0u);
+    else
+        ok = (st->valid && st->seq == exp->seq && n == exp->len && !memcmp(buf, &exp->image[8], n));
+
+    if (!ok)
+    {
+        printf("FAIL %s: expected seq %d len %d, got valid %u seq %u len %u (bad %u)\n", what,
+               exp ? (int)exp->seq : -1, exp ? (int)exp->len : -1, st->valid, st->seq, n, st->bad_records);
+        fails++;
+    }
+    return ok;
+}
+
+/**
+ * @brief 재부팅 후 최신 레코드가 모델 기대값과 같은지
+ */
+static uint8_t NvmSim_Verify(const char *what)
+{
+    NvmSim_Reboot();
+    return NvmSim_Compare(what, NvmSim_Expected());
+}
+
+/* 파일을 지우고 빈 상태에서 시작 */
+static void NvmSim_Fresh(void)
+{
+    remove(path);
+    n_recs = 0;
+    NvmSim_Reboot();
+}
+
+/* ============== 시나리오 ============== */
+
+static void NvmSim_Basic(void)
+{
+    uint8_t buf[NVM_MAX_PAYLOAD];
+    NvmSim_Fresh();
+    NvmSim_Verify("empty area");
+
+    uint32_t saves = 0, erases = 0;             // erases: 재부팅 전 누계
+    while (erases + Nvm_GetStatus()->erases <= 2u * NVMSIM_PAGES)
+    {
+        uint32_t len = NvmSim_RandomData(buf);
+        NvmSim_Check("save queued with erase allowed", NvmSim_Save(buf, len) == NVM_SAVE_QUEUED);
+        saves++;
+        if ((saves % 7u) == 0u)
+        {
+            erases += Nvm_GetStatus()->erases;
+            if (!NvmSim_Verify("reboot during page rotation")) return;
+        }
+    }
+    NvmSim_Verify("after page rotation");
+    NvmSim_Check("seq counts every save across reboots", Nvm_GetStatus()->seq == saves);
+    printf("rotation : %u saves, latest seq %u\n", saves, Nvm_GetStatus()->seq);
+}
+
+static void NvmSim_PowerCut(void)
+{
+    uint8_t buf[NVM_MAX_PAYLOAD];
+    uint32_t cuts = 0;
+    NvmSim_Fresh();
+
+    for (uint32_t len = 1; len <= NVM_MAX_PAYLOAD; len += 37u)
+    {
+        uint32_t dws = NVMSIM_REC_SIZE(len) / 8u;
+        for (uint32_t k = 0; k < dws; k++)
+        {
+            NvmSim_Save(buf, NvmSim_RandomData(buf));       // 기준 레코드
+
+            NvmFile_PowerCutAfter((int32_t)k);
+            for (uint32_t i = 0; i < len; i++) buf[i] = (uint8_t)NvmSim_Rand();
+            Nvm_Save(buf, len);
+            for (uint32_t i = 0; i < NVMSIM_PROCESS_MAX && Nvm_IsBusy(); i++)
+                Nvm_Process();
+            cuts++;
+            if (!NvmSim_Verify("power cut during record write")) return;
+        }
+    }
+    NvmSim_Save(buf, NvmSim_RandomData(buf));
+    NvmSim_Verify("save after power cuts");
+    printf("powercut : %u cuts, previous record kept each time\n", cuts);
+}
+
+static void NvmSim_Corrupt(void)
+{
+    uint8_t buf[NVM_MAX_PAYLOAD];
+    NvmSim_Fresh();
+
+    // 한 페이지에 작은 레코드 6 개, 두 번째 헤더 손상 → 뒤의 레코드가 최신으로 남아야 함
+    for (uint32_t i = 0; i < 6u; i++)
+    {
+        memset(buf, (int)(0x10u + i), 40u);
+        NvmSim_Save(buf, 40u);
+    }
+    uint8_t b = 0x5Au;
+    NvmFile_Poke(recs[1].ofs + 2u, &b, 1u);                 // magic 깨짐
+    NvmSim_Verify("corrupt header in the middle of a page");
+    NvmSim_Check("bad record counted", Nvm_GetStatus()->bad_records == 1u);
+
+    // 길이 필드 손상 (다른 유효 길이로) - 경계가 어긋나도 뒤 레코드는 찾음
+    uint16_t bogus = 200u;
+    NvmFile_Poke(recs[2].ofs, &bogus, 2u);
+    NvmSim_Verify("corrupt length field");
+
+    // 최신 레코드 데이터 손상 (CRC) → 이전 레코드
+    NvmFile_Poke(recs[5].ofs + 8u + 3u, &b, 1u);
+    NvmSim_Verify("latest record CRC error falls back");
+
+    // 그 뒤에 저장하면 손상 구간 뒤에 기록되고 최신이 됨
+    memset(buf, 0x77, 64u);
+    NvmSim_Save(buf, 64u);
+    NvmSim_Verify("save after corruption");
+
+    // 최신 레코드 데이터 ECC 오류 → 이전 레코드 (손상 구간 앞의 #4)
+    const NvmSim_Rec_t *last = &recs[n_recs - 1u];
+    NvmSim_Reboot();
+    NvmFile_SetEcc(last->ofs + 8u, 8u);
+    Nvm_Init(port);
+    const NvmSim_Rec_t *prev = NULL;
+    for (uint32_t i = 0; i < n_recs - 1u; i++)
+        if (NvmSim_Intact(&recs[i]) && (prev == NULL || recs[i].seq > prev->seq)) prev = &recs[i];
+    NvmSim_Compare("latest record ECC error falls back", prev);
+
+    // 첫 페이지 앞 절반이 지워진 채 (삭제 중 차단 흉내) 다른 페이지에 최신이 있는 경우
+    NvmSim_Fresh();
+    while (Nvm_GetStatus()->wr_ofs < NVMSIM_PAGE + 512u)
+        NvmSim_Save(buf, NvmSim_RandomData(buf));
+    memset(buf, 0xFF, sizeof(buf));
+    for (uint32_t i = 0; i < NVMSIM_PAGE / 2u; i += sizeof(buf))
+        NvmFile_Poke(i, buf, sizeof(buf));
+    NvmSim_Verify("half-erased older page");
+
+    // 최신 페이지의 첫 레코드 헤더 손상 - 그 페이지 나머지가 최신
+    for (uint32_t i = 0; i < n_recs; i++)
+    {
+        if (recs[i].ofs == NVMSIM_PAGE)
+        {
+            NvmFile_Poke(recs[i].ofs + 4u, &b, 1u);         // seq 손상 → CRC 오류
+            break;
+        }
+    }
+    NvmSim_Verify("first record of the newest page corrupt");
+    printf("corrupt  : header / length / CRC / ECC / half-erased page recovered\n");
+}
+
+static void NvmSim_Deferred(void)
+{
+    uint8_t buf[NVM_MAX_PAYLOAD];
+    NvmSim_Fresh();
+    NvmFile_SetEraseAllowed(0);                             // 운전 중
+
+    uint8_t r = NVM_SAVE_QUEUED;
+    uint32_t saves = 0;
+    while (r == NVM_SAVE_QUEUED && saves < 1000u)
+    {
+        r = NvmSim_Save(buf, NvmSim_RandomData(buf));
+        saves++;
+    }
+    NvmSim_Check("save needing an erase is deferred while erase is blocked", r == NVM_SAVE_DEFERRED);
+    const NvmSim_Rec_t *old = NvmSim_Expected();
+
+    for (uint32_t i = 0; i < 100u; i++) Nvm_Process();
+    NvmSim_Check("deferred save waits in ERASE", Nvm_GetStatus()->state == NVM_ST_ERASE && Nvm_IsBusy());
+    NvmSim_Check("second save rejected while deferred", Nvm_Save(buf, 8u) == NVM_SAVE_REJECTED);
+    NvmSim_Check("erases while blocked", Nvm_GetStatus()->erases == 0u);
+    NvmSim_Compare("previous record still loads while deferred", old);
+
+    // 정지 → 삭제 허용, 같은 요청이 기록됨
+    NvmFile_SetEraseAllowed(1);
+    for (uint32_t i = 0; i < NVMSIM_PROCESS_MAX && Nvm_IsBusy(); i++) Nvm_Process();
+    const Nvm_Status_t *st = Nvm_GetStatus();
+    NvmSim_Check("deferred save completes once erase is allowed", st->state == NVM_ST_IDLE && st->erases == 1u);
+    NvmSim_Check("deferred record seq", st->seq == saves);
+
+    // 완료된 레코드를 모델에 추가 (길이는 상태에서)
+    NvmSim_Track(st->wr_ofs - NVMSIM_REC_SIZE(st->len), st->len);
+    NvmSim_Verify("deferred record after reboot");
+    printf("deferred : save #%u deferred until erase allowed, then written\n", saves);
+}
+
+/**
+ * @brief 무작위 저장 / 손상 / 전원 차단 반복
+ */
+static void NvmSim_Random(uint32_t rounds)
+{
+    uint8_t buf[NVM_MAX_PAYLOAD];
+    uint32_t flips = 0, halves = 0, cuts = 0;
+    NvmSim_Fresh();
+
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+        uint32_t n = 1u + NvmSim_Rand() % 8u;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint32_t len = NvmSim_RandomData(buf);
+            if ((NvmSim_Rand() % 16u) == 0u)
+            {
+                // 기록 중 전원 차단 후 재부팅
+                NvmFile_PowerCutAfter((int32_t)(NvmSim_Rand() % (NVMSIM_REC_SIZE(len) / 8u)));
+                Nvm_Save(buf, len);
+                for (uint32_t k = 0; k < NVMSIM_PROCESS_MAX && Nvm_IsBusy(); k++) Nvm_Process();
+                cuts++;
+                if (!NvmSim_Verify("random power cut")) return;
+                continue;
+            }
+            if (NvmSim_Save(buf, len) != NVM_SAVE_QUEUED || Nvm_GetStatus()->state != NVM_ST_IDLE)
+            {
+                NvmSim_Check("random save completes", 0);
+                return;
+            }
+            for (uint32_t k = NvmSim_Rand() % 3u; k > 0u; k--) Nvm_Process();    // 미리 삭제 기회
+        }
+
+        uint32_t what = NvmSim_Rand() % 8u;
+        if (what < 3u && n_recs > 0u)
+        {
+            // 남아 있는 레코드 하나에 비트 오류
+            NvmSim_Rec_t *r = &recs[NvmSim_Rand() % n_recs];
+            if (NvmSim_Intact(r))
+            {
+                uint32_t at = r->ofs + NvmSim_Rand() % r->size;
+                uint8_t v;
+                NvmFile_Peek(at, &v, 1u);
+                v ^= (uint8_t)(1u << (NvmSim_Rand() % 8u));
+                NvmFile_Poke(at, &v, 1u);
+                flips++;
+            }
+        }
+        else if (what == 3u)
+        {
+            // 최신이 아닌 페이지 앞 절반 삭제 (삭제 중 차단)
+            uint32_t pg = NvmSim_Rand() % NVMSIM_PAGES;
+            if (pg != Nvm_GetStatus()->wr_ofs / NVMSIM_PAGE)
+            {
+                memset(buf, 0xFF, sizeof(buf));
+                for (uint32_t i = 0; i < NVMSIM_PAGE / 2u; i += sizeof(buf))
+                    NvmFile_Poke(pg * NVMSIM_PAGE + i, buf, sizeof(buf));
+                halves++;
+            }
+        }
+        if (!NvmSim_Verify("random round")) return;
+    }
+    printf("random   : %u rounds, %u bit flips, %u half-erased pages, %u power cuts, seq %u\n",
+           rounds, flips, halves, cuts, Nvm_GetStatus()->seq);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rounds = 500u;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--rounds") && i + 1 < argc)     rounds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)  rng_state = strtoull(argv[++i], NULL, 0) | 1u;
+        else if (!strcmp(argv[i], "--file") && i + 1 < argc)  path = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--rounds N] [--seed S] [--file PATH]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    NvmSim_Basic();
+    NvmSim_PowerCut();
+    NvmSim_Corrupt();
+    NvmSim_Deferred();
+    NvmSim_Random(rounds);
+
+    NvmFile_Close();
+    remove(path);
+    if (fails) printf("FAIL %u check(s)\n", fails);
+    else       printf("PASS\n");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,354 @@
+/**
+ * @file    plant.c
+ * @brief   3상 인버터 + PMSM 플랜트 모델 구현 (호스트 시뮬레이션)
+ *
+ * PWM 1 주기를 세 상의 스위칭 시점으로 나누고, 각 구간 (극 전압 일정) 을
+ * RK4 로 적분한다. 모터는 회전자 dq 좌표, 상태 = [id, iq, ωm, θm].
+ *
+ *   did/dt = (vd - Rs·id + ωe·Lq·iq) / Ld
+ *   diq/dt = (vq - Rs·iq - ωe·Ld·id - ωe·ψ) / Lq
+ *   Te     = 1.5·p·(ψ·iq + (Ld - Lq)·id·iq)
+ *   J·dωm/dt = Te - B·ωm - Tc·sign(ωm) - TL·sign(ωm)
+ */
+
+#include "plant.h"
+#include <math.h>
+#include <stddef.h>
+
+/* ============== 상수 ============== */
+#define PLANT_PI            3.14159265358979f
+#define PLANT_TWO_PI        6.28318530717959f
+#define PLANT_SQRT3         1.73205080756888f
+#define PLANT_ADC_FS        4095.0f
+
+/* ============== 내부 타입 ============== */
+typedef struct {
+    float id, iq, wm, th;
+} Plant_X_t;
+
+/* ============== 내부 함수 ============== */
+
+/**
+ * @brief 상태 미분 (정지 좌표 전압 입력)
+ */
+static Plant_X_t Plant_Deriv(const Plant_Params_t *p, const Plant_X_t *x, float valpha, float vbeta)
+{
+    const float pp = (float)p->pole_pairs;
+    const float th_e = pp * x->th;
+    const float we = pp * x->wm;
+    const float c = cosf(th_e), s = sinf(th_e);
+
+    const float vd =  valpha * c + vbeta * s;
+    const float vq = -valpha * s + vbeta * c;
+
+    Plant_X_t d;
+    d.id = (vd - p->rs * x->id + we * p->lq * x->iq) / p->ld;
+    d.iq = (vq - p->rs * x->iq - we * p->ld * x->id - we * p->flux) / p->lq;
+
+    const float te = 1.5f * pp * (p->flux * x->iq + (p->ld - p->lq) * x->id * x->iq);
+    float tl = 0.0f;
+    if (x->wm > 0.0f)      tl =  (p->tc + p->t_load);
+    else if (x->wm < 0.0f) tl = -(p->tc + p->t_load);
+    d.wm = (te - p->b * x->wm - tl) / p->j;
+    d.th = x->wm;
+    return d;
+}
+
+static Plant_X_t Plant_Axpy(const Plant_X_t *x, const Plant_X_t *k, float h)
+{
+    Plant_X_t r = { x->id + h * k->id, x->iq + h * k->iq, x->wm + h * k->wm, x->th + h * k->th };
+    return r;
+}
+
+/**
+ * @brief 전기각 / Hall 갱신 (적분 스텝마다 - 에지 누락 방지)
+ */
+static void Plant_UpdateHall(Plant_t *pl)
+{
+    const Plant_Params_t *p = &pl->p;
+
+    float th_e = fmodf((float)p->pole_pairs * pl->theta_m, PLANT_TWO_PI);
+    if (th_e < 0.0f) th_e += PLANT_TWO_PI;
+    pl->theta_e = th_e;
+
+    float h = fmodf(th_e + p->hall_offset, PLANT_TWO_PI);
+    if (h < 0.0f) h += PLANT_TWO_PI;
+    uint8_t hall = (h < PLANT_PI) ? 1u : 0u;
+    if (hall != pl->hall) pl->hall_edges++;
+    pl->hall = hall;
+}
+
+/**
+ * @brief 상전류 / 토크 출력 갱신 (구간 끝)
+ */
+static void Plant_UpdateOutputs(Plant_t *pl)
+{
+    const Plant_Params_t *p = &pl->p;
+    const float pp = (float)p->pole_pairs;
+    const float th_e = pl->theta_e;
+
+    const float c = cosf(th_e), s = sinf(th_e);
+    const float ialpha = pl->id * c - pl->iq * s;
+    const float ibeta  = pl->id * s + pl->iq * c;
+    pl->ia = ialpha;
+    pl->ib = -0.5f * ialpha + 0.5f * PLANT_SQRT3 * ibeta;
+    pl->ic = -pl->ia - pl->ib;
+
+    pl->te = 1.5f * pp * (p->flux * pl->iq + (p->ld - p->lq) * pl->id * pl->iq);
+}
+
+/**
+ * @brief 극 전압 일정 구간 적분 (max_step 이하로 분할한 RK4)
+ * @param off  1: 인버터 꺼짐 - 전류 0 유지, 기계계만 적분
+ */
+static void Plant_Integrate(Plant_t *pl, float dt, float valpha, float vbeta, uint8_t off)
+{
+    const Plant_Params_t *p = &pl->p;
+    if (dt <= 0.0f) return;
+
+    uint32_t n = (uint32_t)ceilf(dt / p->max_step_s);
+    if (n == 0u) n = 1u;
+    const float h = dt / (float)n;
+
+    Plant_X_t x = { pl->id, pl->iq, pl->omega_m, pl->theta_m };
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Plant_X_t k1 = Plant_Deriv(p, &x, valpha, vbeta);
+        if (off) k1.id = k1.iq = 0.0f;
+        Plant_X_t t  = Plant_Axpy(&x, &k1, 0.5f * h);
+        Plant_X_t k2 = Plant_Deriv(p, &t, valpha, vbeta);
+        if (off) k2.id = k2.iq = 0.0f;
+        t = Plant_Axpy(&x, &k2, 0.5f * h);
+        Plant_X_t k3 = Plant_Deriv(p, &t, valpha, vbeta);
+        if (off) k3.id = k3.iq = 0.0f;
+        t = Plant_Axpy(&x, &k3, h);
+        Plant_X_t k4 = Plant_Deriv(p, &t, valpha, vbeta);
+        if (off) k4.id = k4.iq = 0.0f;
+
+        const float w0 = x.wm;
+        x.id += h / 6.0f * (k1.id + 2.0f * k2.id + 2.0f * k3.id + k4.id);
+        x.iq += h / 6.0f * (k1.iq + 2.0f * k2.iq + 2.0f * k3.iq + k4.iq);
+        x.wm += h / 6.0f * (k1.wm + 2.0f * k2.wm + 2.0f * k3.wm + k4.wm);
+        x.th += h / 6.0f * (k1.th + 2.0f * k2.th + 2.0f * k3.th + k4.th);
+
+        /* 정지 마찰: 속도가 0 을 지나고 구동 토크가 마찰을 못 넘으면 정지 유지 */
+        if ((w0 > 0.0f && x.wm < 0.0f) || (w0 < 0.0f && x.wm > 0.0f) || w0 == 0.0f)
+        {
+            const float te = 1.5f * (float)p->pole_pairs *
+                             (p->flux * x.iq + (p->ld - p->lq) * x.id * x.iq);
+            if (fabsf(te) <= p->tc + p->t_load) x.wm = 0.0f;
+        }
+
+        if (x.th >= PLANT_TWO_PI)  x.th -= PLANT_TWO_PI;
+        else if (x.th < 0.0f)      x.th += PLANT_TWO_PI;
+
+        pl->id = x.id;
+        pl->iq = x.iq;
+        pl->omega_m = x.wm;
+        pl->theta_m = x.th;
+        Plant_UpdateHall(pl);
+    }
+    Plant_UpdateOutputs(pl);
+    pl->steps += n;
+    pl->t += (double)dt;
+}
+
+/* ============== 공개 함수 ============== */
+
+void Plant_DefaultParams(Plant_Params_t *pPar)
+{
+    pPar->vbus        = 12.0f;
+    pPar->f_tim_hz    = 170e6f;
+    pPar->deadtime_s  = 300e-9f;        // L6234 내부 데드타임
+
+    pPar->rs          = 5.0f;
+    pPar->ld          = 2.0e-3f;
+    pPar->lq          = 2.0e-3f;
+    pPar->flux        = 0.008f;
+    pPar->pole_pairs  = 7u;
+
+    pPar->j           = 2.0e-6f;
+    pPar->b           = 1.0e-6f;
+    pPar->tc          = 1.0e-4f;
+    pPar->t_load      = 0.0f;
+
+    pPar->shunt_ohm   = 0.01f;          // sense.h CURR_SHUNT_OHM
+    pPar->amp_gain    = 50.0f;          // sense.h CURR_AMP_GAIN
+    pPar->adc_vref    = 3.3f;           // sense.h ADC_VREF
+    pPar->hall_offset = 0.0f;
+    pPar->adc_noise_lsb = 0.0f;
+
+    pPar->max_step_s  = 10e-6f;         // τe = L/R 400µs 대비 충분 (1µs 와 속도/전류 차 < 0.1%)
+}
+
+void Plant_Init(Plant_t *pl, const Plant_Params_t *pPar)
+{
+    pl->p = *pPar;
+    if (pl->p.max_step_s <= 0.0f) pl->p.max_step_s = 10e-6f;
+
+    pl->t = 0.0;
+    pl->id = pl->iq = 0.0f;
+    pl->omega_m = 0.0f;
+    pl->theta_m = 0.0f;
+    pl->hall_edges = 0u;
+    pl->adc_rng = 0x2545F491u;
+    pl->steps = 0u;
+    pl->periods = 0u;
+    pl->shunt[0].valid = 0u;
+    pl->shunt[1].valid = 0u;
+
+    Plant_UpdateHall(pl);
+    Plant_UpdateOutputs(pl);
+    pl->hall_edges = 0u;                // 초기 레벨 설정은 에지가 아님
+}
+
+void Plant_RunPwm(Plant_t *pl, uint16_t ccr_a, uint16_t ccr_b, uint16_t ccr_c, uint32_t arr)
+{
+    const uint16_t ccr[3] = { ccr_a, ccr_b, ccr_c };
+    Plant_RunPwmHalves(pl, ccr, ccr, arr, NULL);
+}
+
+void Plant_RunPwmHalves(Plant_t *pl, const uint16_t up[3], const uint16_t dn[3], uint32_t arr,
+                        const uint16_t trig[2])
+{
+    const Plant_Params_t *p = &pl->p;
+    const float T = 2.0f * (float)(arr + 1u) / p->f_tim_hz;
+    const float t_tick = 0.5f * T / (float)(arr + 1u);
+    const float i_ph[3] = { pl->ia, pl->ib, pl->ic };
+
+    /* 상별 ON 구간: [0, t_fall) ∪ [t_rise, T) (중앙정렬, 주기 시작 = CNT 0)
+     * 상승 구간은 CNT < up 동안, 하강 구간은 CNT < dn 동안 ON */
+    float t_fall[3], t_rise[3];
+    for (uint32_t k = 0; k < 3u; k++)
+    {
+        float d_up = (float)up[k] / (float)(arr + 1u);
+        float d_dn = (float)dn[k] / (float)(arr + 1u);
+        if (d_up > 1.0f) d_up = 1.0f;
+        if (d_dn > 1.0f) d_dn = 1.0f;
+        t_fall[k] = 0.5f * d_up * T;
+        t_rise[k] = T - 0.5f * d_dn * T;
+        if (t_fall[k] <= 0.0f && t_rise[k] >= T) continue;     // 항상 OFF
+        if (t_fall[k] >= 0.5f * T && t_rise[k] <= 0.5f * T)
+        {
+            t_fall[k] = T;      t_rise[k] = T;          // 항상 ON
+            continue;
+        }
+
+        /* 데드타임 동안은 다이오드 도통: 전류가 나가면 (i>0) 하단, 들어오면 상단 */
+        if (i_ph[k] > 0.0f)
+        {
+            t_rise[k] += p->deadtime_s;
+            if (t_rise[k] > T) t_rise[k] = T;
+        }
+        else if (i_ph[k] < 0.0f)
+        {
+            t_fall[k] += p->deadtime_s;
+            if (t_fall[k] >= t_rise[k]) { t_fall[k] = T; t_rise[k] = T; }
+        }
+    }
+
+    /* DC 링크 샘플 시각: 하강 카운트 CNT = trig (ARR+1 이상이면 샘플 없음) */
+    float t_smp[2] = { T, T };
+    for (uint32_t n = 0; n < 2u; n++)
+    {
+        pl->shunt[n].valid = 0u;
+        if (trig != NULL && trig[n] <= arr)
+            t_smp[n] = T - (float)trig[n] * t_tick;
+    }
+
+    /* 구간 경계 정렬 */
+    float edge[10] = { 0.0f, t_fall[0], t_rise[0], t_fall[1], t_rise[1], t_fall[2], t_rise[2],
+                       t_smp[0], t_smp[1], T };
+    for (uint32_t i = 1; i < 10u; i++)
+    {
+        float v = edge[i];
+        uint32_t j = i;
+        while (j > 0u && edge[j - 1u] > v) { edge[j] = edge[j - 1u]; j--; }
+        edge[j] = v;
+    }
+
+    for (uint32_t i = 0; i < 9u; i++)
+    {
+        const float t0 = edge[i], t1 = edge[i + 1u];
+        if (t1 - t0 <= 0.0f) continue;
+
+        const float tm = 0.5f * (t0 + t1);
+        float v[3];
+        for (uint32_t k = 0; k < 3u; k++)
+            v[k] = (tm < t_fall[k] || tm >= t_rise[k]) ? p->vbus : 0.0f;
+
+        /* 이 구간 시작이 샘플 시각이면 상단 ON 상 전류 합 = DC 링크 전류 */
+        for (uint32_t n = 0; n < 2u; n++)
+        {
+            if (t_smp[n] != t0) continue;
+            Plant_ShuntSample_t *sm = &pl->shunt[n];
+            sm->i_ph[0] = pl->ia;
+            sm->i_ph[1] = pl->ib;
+            sm->i_ph[2] = pl->ic;
+            sm->i_dc = 0.0f;
+            for (uint32_t k = 0; k < 3u; k++)
+                if (v[k] > 0.0f) sm->i_dc += sm->i_ph[k];
+            sm->valid = 1u;
+        }
+
+        /* 중성점 전압은 αβ 에서 상쇄 */
+        const float valpha = (2.0f * v[0] - v[1] - v[2]) * (1.0f / 3.0f);
+        const float vbeta  = (v[1] - v[2]) * (1.0f / PLANT_SQRT3);
+        Plant_Integrate(pl, t1 - t0, valpha, vbeta, 0u);
+    }
+    pl->periods++;
+}
+
+void Plant_RunOff(Plant_t *pl, uint32_t arr)
+{
+    const float T = 2.0f * (float)(arr + 1u) / pl->p.f_tim_hz;
+
+    pl->shunt[0].valid = 0u;
+    pl->shunt[1].valid = 0u;
+
+    // 역기전력 선간 피크 < Vbus 이면 다이오드 환류 전류는 τe 안에 소멸 → 0 으로 근사
+    pl->id = 0.0f;
+    pl->iq = 0.0f;
+    Plant_Integrate(pl, T, 0.0f, 0.0f, 1u);
+    pl->periods++;
+}
+
+/* 표준 정규 난수 (xorshift32 + Box-Muller) */
+static float Plant_Gauss(uint32_t *pState)
+{
+    float u[2];
+    for (uint32_t k = 0; k < 2u; k++)
+    {
+        uint32_t x = *pState;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        *pState = x;
+        u[k] = ((float)(x >> 8) + 0.5f) * (1.0f / 16777216.0f);
+    }
+    return sqrtf(-2.0f * logf(u[0])) * cosf(PLANT_TWO_PI * u[1]);
+}
+
+void Plant_SampleAdc(Plant_t *pl, uint16_t *pRawA, uint16_t *pRawB)
+{
+    uint16_t ra = Plant_CurrentToAdc(pl, pl->ia);
+    uint16_t rb = Plant_CurrentToAdc(pl, pl->ib);
+    if (pRawA != NULL) *pRawA = ra;
+    if (pRawB != NULL) *pRawB = rb;
+}
+
+uint16_t Plant_CurrentToAdc(Plant_t *pl, float i)
+{
+    const Plant_Params_t *p = &pl->p;
+    return Plant_AdcConvert(pl, 0.5f * p->adc_vref + i * p->shunt_ohm * p->amp_gain);
+}
+
+uint16_t Plant_AdcConvert(Plant_t *pl, float v_in)
+{
+    const Plant_Params_t *p = &pl->p;
+    float c = v_in * (PLANT_ADC_FS / p->adc_vref) + 0.5f;
+    if (p->adc_noise_lsb > 0.0f) c += p->adc_noise_lsb * Plant_Gauss(&pl->adc_rng);
+    if (c < 0.0f) c = 0.0f;
+    if (c > PLANT_ADC_FS) c = PLANT_ADC_FS;
+    return (uint16_t)c;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file    plant.h
+ * @brief   3상 인버터 + PMSM 플랜트 모델 헤더 (호스트 시뮬레이션)
+ *
+ * 하드웨어 의존성이 없는 순수 로직 - 펌웨어가 TIM3 에 쓰는 CCR 을 입력으로
+ * PWM 주기 내부 스위칭 시점 단위로 적분하고, ADC 원시값/Hall 을 돌려준다.
+ */
+
+#ifndef __PLANT_H
+#define __PLANT_H
+
+#include <stdint.h>
+
+/* ============== 타입 정의 ============== */
+typedef struct {
+    /* 인버터 (TIM3 중앙정렬 PWM1, CNT < CCR 동안 상단 ON) */
+    float    vbus;          // DC 버스 전압 [V]
+    float    f_tim_hz;      // 타이머 클럭 [Hz]
+    float    deadtime_s;    // 데드타임 [s] (드라이버 내부, 전류 방향에 따라 전압 오차)
+
+    /* 모터 (회전자 dq 모델) */
+    float    rs;            // 상저항 [Ω]
+    float    ld;            // d축 인덕턴스 [H]
+    float    lq;            // q축 인덕턴스 [H]
+    float    flux;          // 영구자석 쇄교자속 [Wb] (상, 피크)
+    uint32_t pole_pairs;    // 극쌍수
+
+    /* 기계 */
+    float    j;             // 관성 [kg·m²]
+    float    b;             // 점성 마찰 [N·m·s/rad]
+    float    tc;            // 쿨롱 마찰 [N·m]
+    float    t_load;        // 부하 토크 [N·m] (회전 방향 반대)
+
+    /* 센서 (sense.h 와 같은 값) */
+    float    shunt_ohm;     // 션트 [Ω]
+    float    amp_gain;      // INA240 이득 [V/V]
+    float    adc_vref;      // ADC 기준 [V]
+    float    hall_offset;   // Hall W 전기각 오프셋 [rad] (θe + offset ∈ [0, π) 에서 1)
+    float    adc_noise_lsb; // 전류 ADC 입력 잡음 [LSB rms] (0 = 없음, 실제 보드는 1~3 LSB)
+
+    float    max_step_s;    // 적분 최대 간격 [s] (스위칭 구간을 이 이하로 분할)
+} Plant_Params_t;
+
+/* DC 링크 션트 샘플 (단일 션트 보드, 하강 구간 트리거 시점) */
+typedef struct {
+    uint8_t  valid;         // 이번 주기에 샘플 시점이 있었음
+    float    i_dc;          // DC 링크 전류 [A] (상단 ON 상 전류 합, 모터로 나가는 방향 +)
+    float    i_ph[3];       // 같은 시점 상전류 [A]
+} Plant_ShuntSample_t;
+
+typedef struct {
+    Plant_Params_t p;
+
+    /* 상태 */
+    double   t;             // 시뮬레이션 시각 [s]
+    float    id, iq;        // dq 전류 [A]
+    float    omega_m;       // 기계 각속도 [rad/s]
+    float    theta_m;       // 기계각 [rad] (0 ~ 2π)
+
+    /* 출력 (주기 끝 값) */
+    float    ia, ib, ic;    // 상전류 [A] (모터로 들어가는 방향 +)
+    float    te;            // 전자기 토크 [N·m]
+    float    theta_e;       // 전기각 [rad]
+    uint8_t  hall;          // Hall W 레벨
+    uint32_t hall_edges;    // Hall W 에지 누적
+    uint32_t adc_rng;       // ADC 잡음 난수 상태 (Plant_Init 에서 고정 시드 → 재현 가능)
+    Plant_ShuntSample_t shunt[2];   // 마지막 주기 DC 링크 샘플 (Plant_RunPwmHalves trig 순서)
+
+    /* 통계 */
+    uint64_t steps;         // 적분 스텝 수
+    uint64_t periods;       // PWM 주기 수
+} Plant_t;
+
+/* ============== 함수 선언 ============== */
+
+/**
+ * @brief 기본 파라미터 (SimpleFOC 보드 + 소형 짐벌 모터 수준)
+ */
+void Plant_DefaultParams(Plant_Params_t *pPar);
+
+/**
+ * @brief 플랜트 초기화 (정지, 전류 0)
+ */
+void Plant_Init(Plant_t *pl, const Plant_Params_t *pPar);
+
+/**
+ * @brief PWM 1 주기 시뮬레이션
+ * @param ccr_a ~ ccr_c  비교값 (ARR+1 이상 = 100% ON)
+ * @param arr            TIM3 ARR (주기 = 2·(ARR+1) / f_tim)
+ */
+void Plant_RunPwm(Plant_t *pl, uint16_t ccr_a, uint16_t ccr_b, uint16_t ccr_c, uint32_t arr);
+
+/**
+ * @brief PWM 1 주기 시뮬레이션 - 반주기별 CCR (단일 션트 에지 이동) + DC 링크 샘플
+ * @param up    상승 구간 CCR (A, B, C) - 주기 시작 (바닥) 부터 CNT < up 동안 ON
+ * @param dn    하강 구간 CCR (A, B, C) - 정점 이후 CNT < dn 동안 ON
+ * @param arr   TIM3 ARR
+ * @param trig  하강 카운트 샘플 시점 CNT [2] (ARR+1 이상 = 없음, NULL = 샘플 없음)
+ *
+ * 샘플은 pl->shunt[] 에 남는다 (ADC 샘플링 창 길이는 무시하고 트리거 순간 값).
+ */
+void Plant_RunPwmHalves(Plant_t *pl, const uint16_t up[3], const uint16_t dn[3], uint32_t arr,
+                        const uint16_t trig[2]);
+
+/**
+ * @brief 인버터 꺼짐 (드라이버 EN LOW, 전 상 하이 임피던스) 으로 PWM 1 주기 시간 진행
+ * @param arr  TIM3 ARR (주기 길이만 사용)
+ *
+ * 전류는 0 으로 두고 관성 / 마찰만 적분한다 (기계 식별 관성 구간).
+ */
+void Plant_RunOff(Plant_t *pl, uint32_t arr);
+
+/**
+ * @brief 현재 상전류 → ADC 원시값 (INA240, 12bit, sense.c 의 역변환)
+ *
+ * adc_noise_lsb > 0 이면 가우스 잡음을 더한 뒤 양자화한다 (평균이 LSB 아래로 분해됨).
+ */
+void Plant_SampleAdc(Plant_t *pl, uint16_t *pRawA, uint16_t *pRawB);
+
+/**
+ * @brief 전류 → 션트 앰프 ADC 원시값 (Plant_SampleAdc 와 같은 변환, DC 링크 샘플용)
+ */
+uint16_t Plant_CurrentToAdc(Plant_t *pl, float i);
+
+/**
+ * @brief ADC 입력 전압 → 원시값 (Plant_SampleAdc 와 같은 잡음 / 양자화)
+ * @param v_in  ADC 핀 전압 [V] (분압 후)
+ */
+uint16_t Plant_AdcConvert(Plant_t *pl, float v_in);
+
+#endif /* __PLANT_H */
@@ -0,0 +1,281 @@
+/**
+ * @file    plant_sim.c
+ * @brief   인버터 + PMSM 플랜트 시뮬레이터 (호스트 CLI)
+ *
+ * 펌웨어와 같은 변조 커널 (svpwm_core.c) 이 만든 CCR, 또는 telem_decode.py --csv
+ * 로 기록한 CCR 열을 plant.c 에 넣고 상전류 / ADC 원시값 / Hall / 속도를 기록한다.
+ * 실시간보다 훨씬 빠르게 돌아가므로 하드웨어 없이 변조/개루프 변경을 확인할 수 있다.
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt, -Wall -Wextra -Werror, ctest 게이트에 포함):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target plant_sim
+ *
+ * 실행:
+ *   ./plant_sim openloop --freq 20 --volt 1.5 --ramp 2 --time 5 --out ol.csv
+ *   ./plant_sim replay log.csv --ctrl-hz 1000 --out replay.csv
+ *   ./plant_sim openloop --vbus 24 --rs 0.5 --ld 0.4e-3 --lq 0.5e-3 --tl 0.01 --time 10
+ *
+ * 출력 CSV: t,ccr_a,ccr_b,ccr_c,ia,ib,ic,id,iq,raw_ia,raw_ib,hall,theta_e,omega_m,te
+ * (제어 스텝마다 1 행, --decim N 으로 N 스텝마다)
+ */
+
+#define _GNU_SOURCE
+#include "plant.h"
+#include "svpwm_core.h"
+#include "fast_trig.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* ============== 설정 ============== */
+#define SIM_ARR_DEFAULT     8499u       // SVPWM_ARR (10kHz @ 170MHz)
+#define SIM_CTRL_HZ         1000.0      // TIM6 제어 주기
+#define SIM_LINE_MAX        512
+
+typedef enum {
+    SIM_MODE_OPENLOOP = 0,
+    SIM_MODE_REPLAY
+} Sim_Mode_t;
+
+typedef struct {
+    Sim_Mode_t  mode;
+    const char *in_csv;
+    const char *out_csv;
+    uint32_t    arr;
+    double      ctrl_hz;
+    double      time_s;         // openloop 시뮬레이션 시간
+    float       freq_hz;        // openloop 전기 주파수
+    float       volt;           // openloop 상전압 피크 [V]
+    float       ramp_s;         // openloop 주파수 램프 시간
+    uint32_t    decim;
+} Sim_Config_t;
+
+/* ============== 출력 ============== */
+static void Sim_WriteHeader(FILE *f)
+{
+    fprintf(f, "t,ccr_a,ccr_b,ccr_c,ia,ib,ic,id,iq,raw_ia,raw_ib,hall,theta_e,omega_m,te\n");
+}
+
+static void Sim_WriteRow(FILE *f, Plant_t *pl, const uint16_t ccr[3])
+{
+    uint16_t ra, rb;
+    Plant_SampleAdc(pl, &ra, &rb);
+    fprintf(f, "%.6f,%u,%u,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%u,%u,%u,%.4f,%.3f,%.6f\n",
+            pl->t, ccr[0], ccr[1], ccr[2], pl->ia, pl->ib, pl->ic, pl->id, pl->iq,
+            ra, rb, pl->hall, pl->theta_e, pl->omega_m, pl->te);
+}
+
+/**
+ * @brief 제어 스텝 1 회분 (1/ctrl_hz) 동안 CCR 유지, PWM 주기 단위로 적분
+ * @param pAcc  PWM 주기 누적 (ctrl_hz 가 PWM 주파수를 나누지 못할 때의 나머지)
+ */
+static void Sim_HoldCcr(Plant_t *pl, const Sim_Config_t *cfg, const uint16_t ccr[3], double *pAcc)
+{
+    const double f_pwm = (double)pl->p.f_tim_hz / (2.0 * (double)(cfg->arr + 1u));
+    *pAcc += f_pwm / cfg->ctrl_hz;
+    while (*pAcc >= 1.0)
+    {
+        Plant_RunPwm(pl, ccr[0], ccr[1], ccr[2], cfg->arr);
+        *pAcc -= 1.0;
+    }
+}
+
+/* ============== 모드 ============== */
+
+/**
+ * @brief OpenLoop_Step 과 같은 경로: 각도 누적 → sin/cos → SvpwmCore_Calc
+ */
+static uint32_t Sim_OpenLoop(Plant_t *pl, const Sim_Config_t *cfg, FILE *out)
+{
+    const uint32_t steps = (uint32_t)(cfg->time_s * cfg->ctrl_hz);
+    const float scale = (float)(cfg->arr + 1u);
+    const float v_norm = cfg->volt / pl->p.vbus;
+    float angle = 0.0f;
+    double acc = 0.0;
+    SVPWM_State_t st;
+
+    for (uint32_t n = 0; n < steps; n++)
+    {
+        float t = (float)n / (float)cfg->ctrl_hz;
+        float f = (cfg->ramp_s > 0.0f && t < cfg->ramp_s) ? cfg->freq_hz * t / cfg->ramp_s : cfg->freq_hz;
+        float v = (cfg->ramp_s > 0.0f && t < cfg->ramp_s) ? v_norm * (0.2f + 0.8f * t / cfg->ramp_s) : v_norm;
+
+        angle += TWO_PI * f / (float)cfg->ctrl_hz;
+        if (angle >= TWO_PI) angle -= TWO_PI;
+
+        float s, c;
+        FastTrig_SinCos(angle, &s, &c);
+        SvpwmCore_Calc(v * c, v * s, scale, cfg->arr + 1u, &st);
+
+        const uint16_t ccr[3] = { st.CCR_A, st.CCR_B, st.CCR_C };
+        Sim_HoldCcr(pl, cfg, ccr, &acc);
+        if (out && (n % cfg->decim) == 0u) Sim_WriteRow(out, pl, ccr);
+    }
+    return steps;
+}
+
+static int Sim_FindColumn(char *hdr, const char *name)
+{
+    int idx = 0;
+    for (char *tok = strtok(hdr, ",\r\n"); tok; tok = strtok(NULL, ",\r\n"), idx++)
+        if (!strcmp(tok, name)) return idx;
+    return -1;
+}
+
+/**
+ * @brief 기록된 CCR 재생 (telem_decode.py --csv 형식, 헤더로 열 검색)
+ */
+static uint32_t Sim_Replay(Plant_t *pl, const Sim_Config_t *cfg, FILE *out)
+{
+    FILE *f = fopen(cfg->in_csv, "r");
+    if (!f) { perror(cfg->in_csv); return 0; }
+
+    char line[SIM_LINE_MAX], hdr[SIM_LINE_MAX];
+    if (!fgets(line, sizeof(line), f)) { fclose(f); return 0; }
+
+    int col[4];
+    const char *names[4] = { "ccr_a", "ccr_b", "ccr_c", "vbus" };
+    for (uint32_t k = 0; k < 4u; k++)
+    {
+        strcpy(hdr, line);
+        col[k] = Sim_FindColumn(hdr, names[k]);
+    }
+    if (col[0] < 0 || col[1] < 0 || col[2] < 0)
+    {
+        fprintf(stderr, "%s: ccr_a/ccr_b/ccr_c 열 없음\n", cfg->in_csv);
+        fclose(f);
+        return 0;
+    }
+
+    uint32_t n = 0;
+    double acc = 0.0;
+    while (fgets(line, sizeof(line), f))
+    {
+        double v[32];
+        int cnt = 0;
+        for (char *tok = strtok(line, ",\r\n"); tok && cnt < 32; tok = strtok(NULL, ",\r\n"))
+            v[cnt++] = atof(tok);
+        if (cnt <= col[0] || cnt <= col[1] || cnt <= col[2]) continue;
+
+        if (col[3] >= 0 && col[3] < cnt && v[col[3]] > 1.0) pl->p.vbus = (float)v[col[3]];
+
+        const uint16_t ccr[3] = { (uint16_t)v[col[0]], (uint16_t)v[col[1]], (uint16_t)v[col[2]] };
+        Sim_HoldCcr(pl, cfg, ccr, &acc);
+        if (out && (n % cfg->decim) == 0u) Sim_WriteRow(out, pl, ccr);
+        n++;
+    }
+    fclose(f);
+    return n;
+}
+
+/* ============== 메인 ============== */
+static void Sim_Usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s openloop [--freq HZ] [--volt V] [--ramp SEC] [--time SEC] [options]\n"
+        "       %s replay FILE.csv [options]\n"
+        "options: --out FILE --decim N --arr N --ctrl-hz HZ --step SEC\n"
+        "         --vbus V --deadtime SEC --rs OHM --ld H --lq H --flux WB --pp N\n"
+        "         --j KGM2 --b NMS --tc NM --tl NM --hall-offset RAD\n",
+        argv0, argv0);
+}
+
+static double Sim_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    Sim_Config_t cfg = {
+        .mode = SIM_MODE_OPENLOOP, .in_csv = NULL, .out_csv = NULL,
+        .arr = SIM_ARR_DEFAULT, .ctrl_hz = SIM_CTRL_HZ, .time_s = 5.0,
+        .freq_hz = 20.0f, .volt = 1.5f, .ramp_s = 1.0f, .decim = 1u,
+    };
+    Plant_Params_t par;
+    Plant_DefaultParams(&par);
+
+    if (argc < 2) { Sim_Usage(argv[0]); return 2; }
+    int i = 2;
+    if (!strcmp(argv[1], "openloop"))
+        cfg.mode = SIM_MODE_OPENLOOP;
+    else if (!strcmp(argv[1], "replay") && argc >= 3)
+    {
+        cfg.mode = SIM_MODE_REPLAY;
+        cfg.in_csv = argv[2];
+        i = 3;
+    }
+    else { Sim_Usage(argv[0]); return 2; }
+
+    for (; i < argc; i++)
+    {
+        const char *a = argv[i];
+        if (i + 1 >= argc) { Sim_Usage(argv[0]); return 2; }
+        const char *v = argv[++i];
+
+        if      (!strcmp(a, "--out"))         cfg.out_csv = v;
+        else if (!strcmp(a, "--decim"))       cfg.decim = (uint32_t)atoi(v);
+        else if (!strcmp(a, "--arr"))         cfg.arr = (uint32_t)atoi(v);
+        else if (!strcmp(a, "--ctrl-hz"))     cfg.ctrl_hz = atof(v);
+        else if (!strcmp(a, "--time"))        cfg.time_s = atof(v);
+        else if (!strcmp(a, "--freq"))        cfg.freq_hz = (float)atof(v);
+        else if (!strcmp(a, "--volt"))        cfg.volt = (float)atof(v);
+        else if (!strcmp(a, "--ramp"))        cfg.ramp_s = (float)atof(v);
+        else if (!strcmp(a, "--step"))        par.max_step_s = (float)atof(v);
+        else if (!strcmp(a, "--vbus"))        par.vbus = (float)atof(v);
+        else if (!strcmp(a, "--deadtime"))    par.deadtime_s = (float)atof(v);
+        else if (!strcmp(a, "--rs"))          par.rs = (float)atof(v);
+        else if (!strcmp(a, "--ld"))          par.ld = (float)atof(v);
+        else if (!strcmp(a, "--lq"))          par.lq = (float)atof(v);
+        else if (!strcmp(a, "--flux"))        par.flux = (float)atof(v);
+        else if (!strcmp(a, "--pp"))          par.pole_pairs = (uint32_t)atoi(v);
+        else if (!strcmp(a, "--j"))           par.j = (float)atof(v);
+        else if (!strcmp(a, "--b"))           par.b = (float)atof(v);
+        else if (!strcmp(a, "--tc"))          par.tc = (float)atof(v);
+        else if (!strcmp(a, "--tl"))          par.t_load = (float)atof(v);
+        else if (!strcmp(a, "--hall-offset")) par.hall_offset = (float)atof(v);
+        else { Sim_Usage(argv[0]); return 2; }
+    }
+    if (cfg.decim == 0u) cfg.decim = 1u;
+    if (cfg.arr == 0u || cfg.arr > 0xFFFFu || cfg.ctrl_hz <= 0.0 || par.vbus <= 0.0f)
+    {
+        fprintf(stderr, "invalid --arr / --ctrl-hz / --vbus\n");
+        return 2;
+    }
+
+    FILE *out = NULL;
+    if (cfg.out_csv)
+    {
+        out = fopen(cfg.out_csv, "w");
+        if (!out) { perror(cfg.out_csv); return 1; }
+        Sim_WriteHeader(out);
+    }
+
+    FastTrig_Init();
+    Plant_t pl;
+    Plant_Init(&pl, &par);
+
+    double t0 = Sim_Now();
+    uint32_t n = (cfg.mode == SIM_MODE_OPENLOOP) ? Sim_OpenLoop(&pl, &cfg, out) : Sim_Replay(&pl, &cfg, out);
+    double wall = Sim_Now() - t0;
+
+    if (out) fclose(out);
+    if (n == 0u) return 1;
+
+    const float pp = (float)pl.p.pole_pairs;
+    printf("control steps   : %u (%.0f Hz)\n", n, cfg.ctrl_hz);
+    printf("pwm periods     : %llu (ARR %u, %.0f Hz)\n", (unsigned long long)pl.periods, cfg.arr,
+           (double)pl.p.f_tim_hz / (2.0 * (cfg.arr + 1u)));
+    printf("rk4 steps       : %llu\n", (unsigned long long)pl.steps);
+    printf("simulated       : %.3f s\n", pl.t);
+    printf("wall            : %.3f s (%.1fx real time)\n", wall, wall > 0.0 ? pl.t / wall : 0.0);
+    printf("final speed     : %.2f rad/s mech (%.2f Hz elec)\n", pl.omega_m,
+           pl.omega_m * pp / (2.0 * M_PI));
+    printf("final id/iq     : %.3f / %.3f A\n", pl.id, pl.iq);
+    printf("hall edges      : %u\n", pl.hall_edges);
+    return 0;
+}
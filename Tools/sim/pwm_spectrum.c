@@ -0,0 +1,633 @@
+/**
+ * @file    pwm_spectrum.c
+ * @brief   PWM 선간 전압 스펙트럼 / THD 분석 (호스트)
+ *
+ * CCR 열 (기록 CSV 또는 펌웨어 변조 경로 합성) 로부터 선간 전압 vab(t) 를
+ * 타이머 틱 단위 스위칭 시점으로 재구성하고 FFT 로 분석한다.
+ *   - 샘플 = 샘플 구간 평균 (상별 누적 ON 시간의 차분, 앨리어싱 없는 박스 필터)
+ *   - 창 = 기본파 정수 주기 (직사각 창, 누설 없음)
+ *   - 보고: 기본파 크기, THD, WTHD (1/n 가중, 전류 리플 지표),
+ *           기저대역 (< f_pwm/2) 고조파, 반송파 그룹 k·f_pwm ± f_pwm/2 측대역 에너지,
+ *           f_pwm/2 이상에서 RBW 창 안 최대 rms (EMI 수신기 피크에 해당)
+ *
+ * 주기 확산 (--spread, SVPWM_SPREAD): 펌웨어 TIM3 업데이트 ISR 과 같은 LFSR / CCR 환산
+ * (SvpwmCore_SpreadArr / SvpwmCore_SpreadCcr) 으로 주기마다 ARR 을 바꿔 재구성한다.
+ * --spread 0,10 처럼 주면 고정 주기 대비 피크 감소량을 함께 출력한다.
+ *
+ * 데드타임 (게이트 드라이버) 은 상전류 방향으로 에지를 민다 (plant.c 와 같은 모델):
+ *   i > 0: 상승 에지 지연 (ON 짧아짐), i < 0: 하강 에지 지연 (ON 길어짐)
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt, -Wall -Wextra -Werror, ctest 게이트에 포함):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target pwm_spectrum
+ *   (DPWM: 변조 방식은 svpwm_config.h 컴파일 설정 - 별도 빌드 디렉터리에
+ *    -DCMAKE_C_FLAGS=-DSVPWM_MODULATION=SVPWM_MOD_DPWM_MIN)
+ *
+ * 실행:
+ *   ./pwm_spectrum synth --f1 50 --m 0.5 --arr 8499,4249 --deadtime 0,300e-9 --json out.json
+ *   ./pwm_spectrum csv log.csv --row-hz 1000 --f1 20 --cycles 4 --start 5
+ *   ./pwm_spectrum synth --spread 0,5,10,20 --rbw 200
+ */
+
+#define _GNU_SOURCE
+#include "svpwm_core.h"
+#include "fast_trig.h"
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 설정 ============== */
+#define SPEC_TIM_CLK_HZ     ((double)SVPWM_TIM_CLK_HZ)
+#define SPEC_LIST_MAX       16u
+#define SPEC_CARRIER_GROUPS 4u
+#define SPEC_LINE_MAX       512
+
+typedef struct {
+    /* 입력 */
+    const char *csv;            // NULL: 합성
+    double   row_hz;            // CSV 행 / 합성 제어 주기 [Hz] (TIM6, PARAM_TELEM_DECIM 반영)
+    double   start_s;           // CSV 분석 시작 시각 [s] (기동 구간 제외)
+    double   f1;                // 기본파 [Hz]
+    double   m;                 // 합성 변조 지수 (정규화 |V|, 선형 영역 1/√3)
+    double   phi_deg;           // 합성 전류 지연각 [°] (데드타임 방향)
+    double   vbus;              // [V]
+    uint32_t cycles;            // 분석 창 (기본파 주기 수)
+    uint32_t log2n;             // FFT 크기 2^log2n
+    double   f_max;             // THD 적분 상한 [Hz] (0: 나이퀴스트)
+    double   rbw;               // 피크 검출 대역폭 [Hz]
+    const char *json;
+} Spec_Config_t;
+
+typedef struct {
+    uint32_t arr;
+    double   deadtime;
+    uint32_t spread;            // PARAM_PWM_SPREAD [%]
+    double   v1;                // 기본파 피크 [V]
+    double   v1_cmd;            // 지령 기본파 피크 [V] (합성)
+    double   thd;               // [%]
+    double   wthd;              // [%]
+    double   base;              // 기저대역 고조파 / V1 [%]
+    double   side[SPEC_CARRIER_GROUPS];     // 반송파 그룹 rms / V1 [%]
+    double   peak;              // f_pwm/2 이상 RBW 창 최대 rms [V]
+    double   peak_f;            // 그 창의 중심 [Hz]
+} Spec_Result_t;
+
+/* ============== CCR 열 ============== */
+typedef struct {
+    uint16_t *ccr[3];
+    float    *cur[3];           // 상전류 부호 (데드타임 방향), NULL 가능
+    uint32_t  n;
+} Spec_Seq_t;
+
+static int Spec_SeqAlloc(Spec_Seq_t *pSeq, uint32_t n)
+{
+    for (uint32_t k = 0; k < 3u; k++)
+    {
+        pSeq->ccr[k] = calloc(n, sizeof(uint16_t));
+        pSeq->cur[k] = calloc(n, sizeof(float));
+        if (!pSeq->ccr[k] || !pSeq->cur[k]) return -1;
+    }
+    pSeq->n = n;
+    return 0;
+}
+
+static void Spec_SeqFree(Spec_Seq_t *pSeq)
+{
+    for (uint32_t k = 0; k < 3u; k++)
+    {
+        free(pSeq->ccr[k]);
+        free(pSeq->cur[k]);
+    }
+}
+
+/**
+ * @brief 합성: OpenLoop_Step 경로 (각도 누적 → FastTrig → SvpwmCore_Calc), 제어 주기마다 1 행
+ */
+static int Spec_Synth(const Spec_Config_t *cfg, uint32_t arr, Spec_Seq_t *pSeq, double *pV1Cmd)
+{
+    const uint32_t n = (uint32_t)ceil((double)cfg->cycles / cfg->f1 * cfg->row_hz) + 1u;
+    if (Spec_SeqAlloc(pSeq, n) != 0) return -1;
+
+    const float scale = (float)(arr + 1u);
+    const double phi = cfg->phi_deg * M_PI / 180.0;
+    float angle = 0.0f;
+    SVPWM_State_t st;
+
+    for (uint32_t r = 0; r < n; r++)
+    {
+        float s, c;
+        FastTrig_SinCos(angle, &s, &c);
+        SvpwmCore_Calc((float)cfg->m * c, (float)cfg->m * s, scale, arr + 1u, &st);
+        pSeq->ccr[0][r] = st.CCR_A;
+        pSeq->ccr[1][r] = st.CCR_B;
+        pSeq->ccr[2][r] = st.CCR_C;
+        for (uint32_t k = 0; k < 3u; k++)
+            pSeq->cur[k][r] = (float)cos((double)angle - phi - 2.0 * M_PI / 3.0 * k);
+
+        angle += (float)(2.0 * M_PI * cfg->f1 / cfg->row_hz);
+        if (angle >= TWO_PI) angle -= TWO_PI;
+    }
+
+    /* 선간 기본파 피크 = √3 · m · Vbus */
+    *pV1Cmd = sqrt(3.0) * cfg->m * cfg->vbus;
+    return 0;
+}
+
+static int Spec_Column(const char *hdr, const char *name)
+{
+    char buf[SPEC_LINE_MAX];
+    strncpy(buf, hdr, sizeof(buf) - 1u);
+    buf[sizeof(buf) - 1u] = '\0';
+    int idx = 0;
+    for (char *tok = strtok(buf, ",\r\n"); tok; tok = strtok(NULL, ",\r\n"), idx++)
+        if (!strcmp(tok, name)) return idx;
+    return -1;
+}
+
+/**
+ * @brief 기록 CSV 읽기 (telem_decode.py --csv / plant_sim --out): ccr_a..c 필수,
+ *        ia/ib 가 있으면 데드타임 방향에 사용
+ */
+static int Spec_LoadCsv(const Spec_Config_t *cfg, Spec_Seq_t *pSeq)
+{
+    FILE *f = fopen(cfg->csv, "r");
+    if (!f) { perror(cfg->csv); return -1; }
+
+    char line[SPEC_LINE_MAX];
+    if (!fgets(line, sizeof(line), f)) { fclose(f); return -1; }
+    const int c_a = Spec_Column(line, "ccr_a"), c_b = Spec_Column(line, "ccr_b"), c_c = Spec_Column(line, "ccr_c");
+    const int c_ia = Spec_Column(line, "ia"), c_ib = Spec_Column(line, "ib");
+    if (c_a < 0 || c_b < 0 || c_c < 0)
+    {
+        fprintf(stderr, "%s: ccr_a/ccr_b/ccr_c 열 없음\n", cfg->csv);
+        fclose(f);
+        return -1;
+    }
+    if (c_ia < 0 || c_ib < 0)
+        fprintf(stderr, "%s: ia/ib 열 없음 - 데드타임 방향은 +로 가정\n", cfg->csv);
+
+    uint32_t cap = 4096, n = 0;
+    uint32_t skip = (uint32_t)(cfg->start_s * cfg->row_hz + 0.5);
+    if (Spec_SeqAlloc(pSeq, cap) != 0) { fclose(f); return -1; }
+
+    while (fgets(line, sizeof(line), f))
+    {
+        double v[32];
+        int cnt = 0;
+        for (char *tok = strtok(line, ",\r\n"); tok && cnt < 32; tok = strtok(NULL, ",\r\n"))
+            v[cnt++] = atof(tok);
+        if (cnt <= c_a || cnt <= c_b || cnt <= c_c) continue;
+        if (skip > 0u) { skip--; continue; }
+
+        if (n == cap)
+        {
+            cap *= 2u;
+            for (uint32_t k = 0; k < 3u; k++)
+            {
+                pSeq->ccr[k] = realloc(pSeq->ccr[k], cap * sizeof(uint16_t));
+                pSeq->cur[k] = realloc(pSeq->cur[k], cap * sizeof(float));
+                if (!pSeq->ccr[k] || !pSeq->cur[k]) { fclose(f); return -1; }
+            }
+        }
+        pSeq->ccr[0][n] = (uint16_t)v[c_a];
+        pSeq->ccr[1][n] = (uint16_t)v[c_b];
+        pSeq->ccr[2][n] = (uint16_t)v[c_c];
+        float ia = (c_ia >= 0 && c_ia < cnt) ? (float)v[c_ia] : 1.0f;
+        float ib = (c_ib >= 0 && c_ib < cnt) ? (float)v[c_ib] : 1.0f;
+        pSeq->cur[0][n] = ia;
+        pSeq->cur[1][n] = ib;
+        pSeq->cur[2][n] = (c_ia >= 0 && c_ib >= 0) ? -ia - ib : 1.0f;
+        n++;
+    }
+    fclose(f);
+    pSeq->n = n;
+    return (n > 0u) ? 0 : -1;
+}
+
+/* ============== 파형 재구성 ============== */
+
+/**
+ * @brief PWM 주기 열 (2·(ARR_k+1) 틱, CNT 0 에서 시작)
+ *
+ * 고정 주기면 모든 ARR_k = ARR. 확산이면 펌웨어 업데이트 ISR 과 같은 LFSR 열
+ * (SVPWM_SPREAD_LFSR_SEED 부터) 로 주기마다 ARR_k 를 고른다.
+ */
+typedef struct {
+    double   *start;            // 주기 시작 [tick] (n + 1 개, 마지막 = 끝)
+    uint32_t *arr;              // ARR_k
+    uint32_t  n;
+} Spec_Periods_t;
+
+static int Spec_PeriodsInit(Spec_Periods_t *pPer, uint32_t arr, uint32_t spread, double t_end_ticks)
+{
+    const uint32_t span = arr * spread / 100u;
+    const uint32_t n = (uint32_t)(t_end_ticks / (2.0 * (double)(arr - span + 1u))) + 2u;
+    pPer->start = malloc((n + 1u) * sizeof(double));
+    pPer->arr = malloc(n * sizeof(uint32_t));
+    if (!pPer->start || !pPer->arr) return -1;
+
+    uint16_t lfsr = SVPWM_SPREAD_LFSR_SEED;
+    pPer->start[0] = 0.0;
+    for (uint32_t k = 0; k < n; k++)
+    {
+        pPer->arr[k] = span ? SvpwmCore_SpreadArr(&lfsr, arr, span) : arr;
+        pPer->start[k + 1u] = pPer->start[k] + 2.0 * (double)(pPer->arr[k] + 1u);
+    }
+    pPer->n = n;
+    return 0;
+}
+
+static void Spec_PeriodsFree(Spec_Periods_t *pPer)
+{
+    free(pPer->start);
+    free(pPer->arr);
+}
+
+/** @brief t 를 포함하는 주기 번호 (이진 탐색) */
+static uint32_t Spec_PeriodAt(const Spec_Periods_t *pPer, double t)
+{
+    uint32_t lo = 0, hi = pPer->n;
+    while (hi - lo > 1u)
+    {
+        uint32_t mid = (lo + hi) / 2u;
+        if (pPer->start[mid] <= t) lo = mid;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief 상 x 의 [0, t) 누적 ON 시간 [tick]
+ *
+ * PWM 주기 k 에서 ON = [0, fall) ∪ [rise, P_k). CCR 은 프리로드로 주기 경계에서 바뀌며,
+ * 주기 k 는 그 시작 시각의 제어 행을 ARR_k 로 환산해 쓴다.
+ */
+typedef struct {
+    const Spec_Seq_t *seq;
+    const Spec_Periods_t *per;
+    uint32_t phase;
+    uint32_t arr;               // 기준 ARR (제어 루프가 보는 주기)
+    double   dt_ticks;
+    double   ticks_per_row;
+    double  *prefix;            // 주기별 누적 ON 시간 [tick]
+} Spec_Phase_t;
+
+static void Spec_PeriodEdges(const Spec_Phase_t *ph, uint32_t k, double *pFall, double *pRise)
+{
+    uint32_t row = (uint32_t)(ph->per->start[k] / ph->ticks_per_row);
+    if (row >= ph->seq->n) row = ph->seq->n - 1u;
+    const uint32_t arr_k = ph->per->arr[k];
+    const double a1 = (double)(arr_k + 1u), period = 2.0 * a1;
+    uint16_t c = ph->seq->ccr[ph->phase][row];
+    if (arr_k != ph->arr)
+        c = SvpwmCore_SpreadCcr(c, ph->arr, ((arr_k + 1u) << 16) / (ph->arr + 1u), arr_k);
+    double ccr = (double)c;
+    float  cur = ph->seq->cur[ph->phase][row];
+
+    if (ccr <= 0.0)  { *pFall = 0.0;    *pRise = period; return; }     // 항상 OFF
+    if (ccr >= a1)   { *pFall = period; *pRise = period; return; }     // 항상 ON
+
+    double fall = ccr, rise = period - ccr;
+    if (cur > 0.0f)
+        rise = fmin(rise + ph->dt_ticks, period);
+    else if (cur < 0.0f)
+    {
+        fall += ph->dt_ticks;
+        if (fall >= rise) { fall = period; rise = period; }
+    }
+    *pFall = fall;
+    *pRise = rise;
+}
+
+static int Spec_PhaseInit(Spec_Phase_t *ph, const Spec_Seq_t *seq, const Spec_Periods_t *per,
+                          uint32_t phase, uint32_t arr, double deadtime, double row_hz)
+{
+    ph->seq = seq;
+    ph->per = per;
+    ph->phase = phase;
+    ph->arr = arr;
+    ph->dt_ticks = deadtime * SPEC_TIM_CLK_HZ;
+    ph->ticks_per_row = SPEC_TIM_CLK_HZ / row_hz;
+    ph->prefix = malloc((per->n + 1u) * sizeof(double));
+    if (!ph->prefix) return -1;
+
+    ph->prefix[0] = 0.0;
+    for (uint32_t k = 0; k < per->n; k++)
+    {
+        double fall, rise;
+        Spec_PeriodEdges(ph, k, &fall, &rise);
+        double period = per->start[k + 1u] - per->start[k];
+        ph->prefix[k + 1u] = ph->prefix[k] + fall + (period - rise);
+    }
+    return 0;
+}
+
+static double Spec_OnTime(const Spec_Phase_t *ph, double t)
+{
+    uint32_t k = Spec_PeriodAt(ph->per, t);
+    double tau = t - ph->per->start[k];
+    double fall, rise;
+    Spec_PeriodEdges(ph, k, &fall, &rise);
+    return ph->prefix[k] + fmin(tau, fall) + fmax(0.0, tau - rise);
+}
+
+/* ============== FFT (radix-2, 반복형) ============== */
+static void Spec_Fft(double complex *x, uint32_t log2n)
+{
+    const uint32_t n = 1u << log2n;
+
+    for (uint32_t i = 1, j = 0; i < n; i++)
+    {
+        uint32_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) { double complex t = x[i]; x[i] = x[j]; x[j] = t; }
+    }
+
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        const uint32_t half = len >> 1;
+        const double complex wl = cexp(-2.0 * M_PI * I / (double)len);
+        /* 회전 인자를 한 번 만들어 모든 블록에 사용 (안쪽 루프는 연속 접근) */
+        double complex *w = malloc(half * sizeof(double complex));
+        w[0] = 1.0;
+        for (uint32_t k = 1; k < half; k++)
+            w[k] = (k % 64u == 0u) ? cexp(-2.0 * M_PI * I * (double)k / (double)len) : w[k - 1u] * wl;
+
+        for (uint32_t i = 0; i < n; i += len)
+        {
+            double complex *a = x + i, *b = x + i + half;
+            for (uint32_t k = 0; k < half; k++)
+            {
+                double complex t = w[k] * b[k];
+                b[k] = a[k] - t;
+                a[k] = a[k] + t;
+            }
+        }
+        free(w);
+    }
+}
+
+/* ============== 분석 1 회 ============== */
+static int Spec_Analyze(const Spec_Config_t *cfg, const Spec_Seq_t *seq, Spec_Result_t *pRes)
+{
+    const uint32_t n = 1u << cfg->log2n;
+    const double t_win = (double)cfg->cycles / cfg->f1;
+    const double t_win_ticks = t_win * SPEC_TIM_CLK_HZ;
+    const double dts = t_win_ticks / (double)n;
+
+    if ((double)seq->n / cfg->row_hz < t_win * 0.999)
+    {
+        fprintf(stderr, "sequence %.4f s shorter than window %.4f s\n", (double)seq->n / cfg->row_hz, t_win);
+        return -1;
+    }
+
+    Spec_Periods_t per;
+    if (Spec_PeriodsInit(&per, pRes->arr, pRes->spread, t_win_ticks) != 0) return -1;
+    Spec_Phase_t ph[3];
+    for (uint32_t k = 0; k < 3u; k++)
+        if (Spec_PhaseInit(&ph[k], seq, &per, k, pRes->arr, pRes->deadtime, cfg->row_hz) != 0)
+            return -1;
+
+    /* vab 샘플 = 구간 평균 */
+    double complex *x = malloc((size_t)n * sizeof(double complex));
+    if (!x) return -1;
+    double ha0 = 0.0, hb0 = 0.0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double t1 = (double)(i + 1u) * dts;
+        double ha1 = Spec_OnTime(&ph[0], t1), hb1 = Spec_OnTime(&ph[1], t1);
+        x[i] = cfg->vbus * ((ha1 - ha0) - (hb1 - hb0)) / dts;
+        ha0 = ha1;
+        hb0 = hb1;
+    }
+    for (uint32_t k = 0; k < 3u; k++)
+        free(ph[k].prefix);
+    Spec_PeriodsFree(&per);
+
+    Spec_Fft(x, cfg->log2n);
+
+    /* 단측 피크 진폭: |X[k]|·2/N */
+    const double df = 1.0 / t_win;
+    const double f_pwm = SPEC_TIM_CLK_HZ / (2.0 * (double)(pRes->arr + 1u));
+    const double f_nyq = 0.5 * (double)n * df;
+    const double f_max = (cfg->f_max > 0.0 && cfg->f_max < f_nyq) ? cfg->f_max : f_nyq;
+    const uint32_t k1 = cfg->cycles;
+
+    double v1 = 2.0 * cabs(x[k1]) / (double)n;
+    double h2 = 0.0, w2 = 0.0, base2 = 0.0;
+    double side2[SPEC_CARRIER_GROUPS] = { 0 };
+    for (uint32_t k = 1; k < n / 2u; k++)
+    {
+        double f = (double)k * df;
+        if (f > f_max) break;
+        if (k == k1) continue;
+
+        double a = 2.0 * cabs(x[k]) / (double)n;
+        double a2 = a * a;
+        double h = f / cfg->f1;
+        h2 += a2;
+        w2 += a2 / (h * h);
+        if (f < 0.5 * f_pwm)
+            base2 += a2;
+        else
+        {
+            uint32_t g = (uint32_t)floor(f / f_pwm + 0.5);
+            if (g >= 1u && g <= SPEC_CARRIER_GROUPS) side2[g - 1u] += a2;
+        }
+    }
+
+    /* RBW 창 (bin 수 w) 이동 합의 최대 - f_pwm/2 ~ f_max */
+    const uint32_t w = (cfg->rbw > df) ? (uint32_t)(cfg->rbw / df + 0.5) : 1u;
+    const uint32_t k_lo = (uint32_t)ceil(0.5 * f_pwm / df);
+    const uint32_t k_hi = (uint32_t)fmin(f_max / df, (double)(n / 2u - 1u));
+    double win = 0.0, peak2 = 0.0;
+    uint32_t peak_k = k_lo;
+    for (uint32_t k = k_lo; k <= k_hi; k++)
+    {
+        double a = 2.0 * cabs(x[k]) / (double)n;
+        win += a * a;
+        if (k >= k_lo + w)
+        {
+            double b = 2.0 * cabs(x[k - w]) / (double)n;
+            win -= b * b;
+        }
+        if (win > peak2) { peak2 = win; peak_k = (k >= k_lo + w / 2u) ? k - w / 2u : k_lo; }
+    }
+    free(x);
+    pRes->peak = sqrt(0.5 * peak2);
+    pRes->peak_f = (double)peak_k * df;
+
+    pRes->v1 = v1;
+    pRes->thd = (v1 > 0.0) ? 100.0 * sqrt(h2) / v1 : 0.0;
+    pRes->wthd = (v1 > 0.0) ? 100.0 * sqrt(w2) / v1 : 0.0;
+    pRes->base = (v1 > 0.0) ? 100.0 * sqrt(base2) / v1 : 0.0;
+    for (uint32_t g = 0; g < SPEC_CARRIER_GROUPS; g++)
+        pRes->side[g] = (v1 > 0.0) ? 100.0 * sqrt(side2[g]) / v1 : 0.0;
+
+    if (fmod(f_pwm, df) > 1e-6 * df && df - fmod(f_pwm, df) > 1e-6 * df)
+        fprintf(stderr, "note: f_pwm %.1f Hz not a multiple of bin %.3f Hz (carrier leakage)\n", f_pwm, df);
+    return 0;
+}
+
+/* ============== 메인 ============== */
+static int Spec_ParseList(const char *s, double *out, uint32_t *pN)
+{
+    char buf[256];
+    strncpy(buf, s, sizeof(buf) - 1u);
+    buf[sizeof(buf) - 1u] = '\0';
+    *pN = 0;
+    for (char *tok = strtok(buf, ","); tok && *pN < SPEC_LIST_MAX; tok = strtok(NULL, ","))
+        out[(*pN)++] = atof(tok);
+    return (*pN > 0u) ? 0 : -1;
+}
+
+static const char *Spec_ModName(void)
+{
+#if SVPWM_MODULATION == SVPWM_MOD_DPWM_MIN
+    return "dpwm_min";
+#elif SVPWM_MODULATION == SVPWM_MOD_DPWM_MAX
+    return "dpwm_max";
+#else
+    return "symmetric";
+#endif
+}
+
+static void Spec_Usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s synth [--f1 HZ] [--m MOD] [--phi DEG] [options]\n"
+        "       %s csv FILE [--row-hz HZ] [--start SEC] [--f1 HZ] [options]\n"
+        "options: --arr N[,N..] --deadtime SEC[,SEC..] --vbus V --cycles N --log2n N\n"
+        "         --fmax HZ --spread PCT[,PCT..] --rbw HZ --json FILE\n", argv0, argv0);
+}
+
+int main(int argc, char **argv)
+{
+    Spec_Config_t cfg = {
+        .csv = NULL, .row_hz = 1000.0, .start_s = 0.0, .f1 = 50.0, .m = 0.5, .phi_deg = 30.0, .vbus = 12.0,
+        .cycles = 5, .log2n = 20, .f_max = 0.0, .rbw = 200.0, .json = NULL,
+    };
+    double arr_list[SPEC_LIST_MAX] = { (double)SVPWM_ARR }, dt_list[SPEC_LIST_MAX] = { 0.0 };
+    double sp_list[SPEC_LIST_MAX] = { 0.0 };
+    uint32_t n_arr = 1, n_dt = 1, n_sp = 1;
+
+    if (argc < 2) { Spec_Usage(argv[0]); return 2; }
+    int i = 2;
+    if (!strcmp(argv[1], "csv") && argc >= 3) { cfg.csv = argv[2]; i = 3; }
+    else if (strcmp(argv[1], "synth") != 0)   { Spec_Usage(argv[0]); return 2; }
+
+    for (; i < argc; i++)
+    {
+        if (i + 1 >= argc) { Spec_Usage(argv[0]); return 2; }
+        const char *o = argv[i], *v = argv[++i];
+        int rc = 0;
+        if      (!strcmp(o, "--row-hz"))   cfg.row_hz = atof(v);
+        else if (!strcmp(o, "--start"))    cfg.start_s = atof(v);
+        else if (!strcmp(o, "--f1"))       cfg.f1 = atof(v);
+        else if (!strcmp(o, "--m"))        cfg.m = atof(v);
+        else if (!strcmp(o, "--phi"))      cfg.phi_deg = atof(v);
+        else if (!strcmp(o, "--vbus"))     cfg.vbus = atof(v);
+        else if (!strcmp(o, "--cycles"))   cfg.cycles = (uint32_t)atoi(v);
+        else if (!strcmp(o, "--log2n"))    cfg.log2n = (uint32_t)atoi(v);
+        else if (!strcmp(o, "--fmax"))     cfg.f_max = atof(v);
+        else if (!strcmp(o, "--rbw"))      cfg.rbw = atof(v);
+        else if (!strcmp(o, "--json"))     cfg.json = v;
+        else if (!strcmp(o, "--arr"))      rc = Spec_ParseList(v, arr_list, &n_arr);
+        else if (!strcmp(o, "--deadtime")) rc = Spec_ParseList(v, dt_list, &n_dt);
+        else if (!strcmp(o, "--spread"))   rc = Spec_ParseList(v, sp_list, &n_sp);
+        else { Spec_Usage(argv[0]); return 2; }
+        if (rc != 0) { Spec_Usage(argv[0]); return 2; }
+    }
+    if (cfg.f1 <= 0.0 || cfg.row_hz <= 0.0 || cfg.cycles == 0u || cfg.log2n < 8u || cfg.log2n > 26u)
+    {
+        fprintf(stderr, "invalid --f1 / --row-hz / --cycles / --log2n\n");
+        return 2;
+    }
+
+    FastTrig_Init();
+
+    FILE *json = NULL;
+    if (cfg.json)
+    {
+        json = fopen(cfg.json, "w");
+        if (!json) { perror(cfg.json); return 1; }
+        fprintf(json, "{\n  \"context\": {\"modulation\": \"%s\", \"source\": \"%s\", \"f1\": %g, "
+                      "\"m\": %g, \"vbus\": %g, \"row_hz\": %g, \"cycles\": %u, \"fft_n\": %u},\n"
+                      "  \"results\": [\n",
+                Spec_ModName(), cfg.csv ? cfg.csv : "synth", cfg.f1, cfg.m, cfg.vbus, cfg.row_hz,
+                cfg.cycles, 1u << cfg.log2n);
+    }
+
+    printf("modulation %s, f1 %.2f Hz, %u cycles, FFT %u points\n",
+           Spec_ModName(), cfg.f1, cfg.cycles, 1u << cfg.log2n);
+    printf("%6s %8s %6s %9s %9s %8s %8s %8s", "arr", "dt[ns]", "sprd%", "V1[V]", "V1cmd", "THD%", "WTHD%", "base%");
+    for (uint32_t g = 0; g < SPEC_CARRIER_GROUPS; g++)
+        printf("   %ufsw%%", g + 1u);
+    printf(" %9s %8s %7s\n", "peak[V]", "@[Hz]", "dB");
+
+    Spec_Seq_t csv_seq = { 0 };
+    if (cfg.csv && Spec_LoadCsv(&cfg, &csv_seq) != 0) return 1;
+
+    uint32_t count = 0;
+    for (uint32_t a = 0; a < n_arr; a++)
+        for (uint32_t d = 0; d < n_dt; d++)
+        {
+          double peak_ref = 0.0;        // 목록 첫 확산 값의 피크 (감소량 기준)
+          for (uint32_t p = 0; p < n_sp; p++)
+          {
+            Spec_Result_t res = { .arr = (uint32_t)arr_list[a], .deadtime = dt_list[d],
+                                  .spread = (uint32_t)sp_list[p], .v1_cmd = 0.0 };
+            if (res.arr == 0u || res.arr > 0xFFFFu) { fprintf(stderr, "invalid arr\n"); return 2; }
+            if (res.spread > SVPWM_SPREAD_MAX_PCT ||
+                (uint64_t)res.arr * (100u + res.spread) / 100u > 0xFFFFu)
+            {
+                fprintf(stderr, "invalid spread (0..%u %%, ARR_k <= 65535)\n", SVPWM_SPREAD_MAX_PCT);
+                return 2;
+            }
+
+            Spec_Seq_t synth_seq = { 0 };
+            const Spec_Seq_t *seq = &csv_seq;
+            if (!cfg.csv)
+            {
+                if (Spec_Synth(&cfg, res.arr, &synth_seq, &res.v1_cmd) != 0) return 1;
+                seq = &synth_seq;
+            }
+            int rc = Spec_Analyze(&cfg, seq, &res);
+            if (!cfg.csv) Spec_SeqFree(&synth_seq);
+            if (rc != 0) return 1;
+
+            if (p == 0u) peak_ref = res.peak;
+            const double peak_db = (peak_ref > 0.0 && res.peak > 0.0) ? 20.0 * log10(res.peak / peak_ref) : 0.0;
+
+            printf("%6u %8.0f %6u %9.4f %9.4f %8.3f %8.4f %8.4f", res.arr, res.deadtime * 1e9, res.spread,
+                   res.v1, res.v1_cmd, res.thd, res.wthd, res.base);
+            for (uint32_t g = 0; g < SPEC_CARRIER_GROUPS; g++)
+                printf(" %8.3f", res.side[g]);
+            printf(" %9.4f %8.0f %7.2f\n", res.peak, res.peak_f, peak_db);
+
+            if (json)
+            {
+                fprintf(json, "%s    {\"arr\": %u, \"f_pwm\": %.3f, \"deadtime_s\": %g, \"spread_pct\": %u, "
+                              "\"v1\": %.6f, \"v1_cmd\": %.6f, \"thd_pct\": %.5f, \"wthd_pct\": %.5f, "
+                              "\"baseband_pct\": %.5f, \"sideband_pct\": [%.5f, %.5f, %.5f, %.5f], "
+                              "\"peak_v\": %.6f, \"peak_hz\": %.1f, \"peak_db\": %.3f, \"rbw_hz\": %g}",
+                        count ? ",\n" : "", res.arr, SPEC_TIM_CLK_HZ / (2.0 * (res.arr + 1u)), res.deadtime,
+                        res.spread, res.v1, res.v1_cmd, res.thd, res.wthd, res.base,
+                        res.side[0], res.side[1], res.side[2], res.side[3],
+                        res.peak, res.peak_f, peak_db, cfg.rbw);
+            }
+            count++;
+          }
+        }
+
+    if (cfg.csv) Spec_SeqFree(&csv_seq);
+    if (json)
+    {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+    }
+    return 0;
+}
@@ -0,0 +1,388 @@
+/**
+ * @file    pwm_timer.c
+ * @brief   TIM3 중앙정렬 프리로드 모델 - PWM 주기 전환 (스케줄 / 확산) 글리치 검사 (호스트)
+ *
+ * 이벤트 단위 타이머 모델:
+ *   - 중앙정렬 모드 1, ARR / CCR 프리로드. UEV 는 정점과 바닥 (반주기 = ARR+1 틱,
+ *     plant.c / pwm_spectrum.c 와 같은 관례) 에서 나고 그때 프리로드가 옮겨진다.
+ *   - 제어 ISR (TIM6, 1 kHz, 우선순위 1): 스텝 시작 후 --t-sched 에 주기 선택,
+ *     --t-run 에 CCR 계산/기록, --t-busy 동안 점유. 시작 시각에 --jitter 만큼 흔들림.
+ *   - 업데이트 ISR (TIM3, 우선순위 2): UEV 후 --isr-lat 에 실행, 제어 ISR 이 돌고 있으면
+ *     끝날 때까지 대기. 실행 시점의 DIR 로 정점 여부 판단 (펌웨어와 같음).
+ *
+ * 전략:
+ *   direct   : 이전 펌웨어 - 주기 선택에서 ARR 을 바로 쓰고 CCR 은 계산 뒤에 기록
+ *   deferred : 현재 펌웨어 (svpwm.c SVPWM_SetPeriod / SVPWM_PeriodIRQHandler) - 기준 CCR 만
+ *              갱신하고 ARR/CCR 은 업데이트 ISR 이 정점에서 SvpwmCore_NextPeriod 로 기록
+ *
+ * 주기 (바닥 → 바닥) 마다 검사:
+ *   비대칭 : 상승/하강 구간의 ARR 또는 CCR 이 다름
+ *   ON 비율 : 상별 (CCR_up + CCR_dn) / (ARR_up + ARR_dn + 2) 가 직전 두 지령의
+ *            CCR / (ARR+1) 어느 쪽과도 1 틱 이상 다름 (옛 CCR 이 새 ARR 로 나간 주기)
+ * deferred 에서 글리치가 하나라도 있으면 종료 코드 1.
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt, -Wall -Wextra -Werror, ctest 게이트에 포함):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target pwm_timer
+ *
+ * 실행:
+ *   ./pwm_timer                                       # 0 → 400 Hz → 0 램프, 5 ↔ 20 kHz
+ *   ./pwm_timer --spread 10 --jitter 20 --seed 7
+ *   ./pwm_timer --mode deferred --isr-lat 30          # 업데이트 ISR 지연이 반주기를 넘는 경우
+ */
+
+#define _GNU_SOURCE
+#include "svpwm_core.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 설정 ============== */
+#define TM_TIM_CLK_HZ       ((double)SVPWM_TIM_CLK_HZ)
+#define TM_CTRL_HZ          1000.0          // TIM6 (PSC 169, ARR 999)
+
+typedef enum {
+    TM_DIRECT = 0,
+    TM_DEFERRED
+} Tm_Mode_t;
+
+typedef struct {
+    double   time_s;            // 램프 0 → f_max → 0 전체 길이
+    double   f_max;             // 지령 전기 주파수 최대 [Hz]
+    double   f_lo, f_hi;        // PARAM_PWM_SCH_F_LO / F_HI
+    uint32_t arr_lo, arr_hi;    // PARAM_PWM_ARR_LO / PARAM_PWM_PERIOD
+    uint32_t spread;            // PARAM_PWM_SPREAD [%]
+    double   m;                 // 변조 지수
+    double   t_sched, t_run, t_busy;    // 제어 ISR 안 시각 [s]
+    double   jitter;            // 제어 ISR 시작 흔들림 [s]
+    double   isr_lat;           // 업데이트 ISR 진입 지연 [s]
+    uint64_t seed;
+} Tm_Config_t;
+
+typedef struct {
+    uint64_t periods;
+    uint64_t changes;           // 기준 주기 변경 횟수
+    uint64_t asym;              // 비대칭 주기
+    uint64_t duty;              // ON 비율 글리치 주기
+    uint64_t late;              // 정점 UEV 의 업데이트 ISR 이 바닥을 지나 실행 (기록 한 주기 미룸)
+    double   duty_err_max;      // 최대 ON 비율 오차 [%]
+    uint32_t arr_min, arr_max;  // 실제 나간 ARR 범위
+} Tm_Result_t;
+
+/* ============== 타이머 / 펌웨어 상태 ============== */
+typedef struct {
+    /* TIM3 */
+    uint32_t arr_pre, arr_act;
+    uint16_t ccr_pre[3], ccr_act[3];
+    uint8_t  uie;
+    uint8_t  dir;               // 0: 상승, 1: 하강 (현재 반주기)
+
+    /* 펌웨어 (svpwm.c) */
+    uint32_t pwm_period;
+    SVPWM_Period_t next;
+    uint8_t  own;
+    float    angle;
+
+    /* 지령 이력 (ON 비율 검사) */
+    double   cmd_t[2];          // [0] 최신
+    double   cmd_duty[2][3];
+} Tm_State_t;
+
+static uint64_t rng_state;
+
+static double Tm_Uniform(void)
+{
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (double)((rng_state * 2685821657736338717ull) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double Tm_Freq(const Tm_Config_t *cfg, double t)
+{
+    const double t3 = cfg->time_s / 3.0;
+    if (t < t3)           return cfg->f_max * t / t3;
+    if (t < 2.0 * t3)     return cfg->f_max;
+    if (t < cfg->time_s)  return cfg->f_max * (cfg->time_s - t) / t3;
+    return 0.0;
+}
+
+/* ============== 제어 ISR (TIM6) ============== */
+
+/** @brief 주기 선택 - svpwm.c OpenLoop_PwmSchedule / SVPWM_SetPeriod */
+static void Tm_Schedule(const Tm_Config_t *cfg, Tm_Mode_t mode, Tm_State_t *s, double t, Tm_Result_t *pRes)
+{
+    uint32_t arr = SvpwmCore_SchedArr((float)Tm_Freq(cfg, t), (float)cfg->f_lo, (float)cfg->f_hi,
+                                      cfg->arr_lo, cfg->arr_hi);
+    uint32_t d = (arr > s->pwm_period) ? arr - s->pwm_period : s->pwm_period - arr;
+    if (d < SVPWM_SCHED_HYST_TICKS && arr != cfg->arr_lo && arr != cfg->arr_hi) return;
+    if (arr == s->pwm_period) return;
+    pRes->changes++;
+
+    if (mode == TM_DIRECT)
+    {
+        s->pwm_period = arr;
+        s->arr_pre = arr;                       // __HAL_TIM_SET_AUTORELOAD
+        return;
+    }
+
+    const uint32_t a1 = s->pwm_period + 1u;
+    for (uint32_t k = 0; k < 3u; k++)
+    {
+        uint32_t c = s->next.ccr[k];
+        s->next.ccr[k] = (c >= a1) ? (uint16_t)(arr + 1u)
+                                   : (uint16_t)(((uint64_t)c * (arr + 1u) + a1 / 2u) / a1);
+    }
+    s->pwm_period = arr;
+    s->next.arr = arr;
+    s->next.span = arr * cfg->spread / 100u;     // SVPWM_SPREAD
+    if (!s->own) { s->own = 1; s->uie = 1; }    // SVPWM_PeriodArm
+}
+
+/** @brief 전압 지령 → CCR - SVPWM_Run / SVPWM_UpdatePWM */
+static void Tm_Run(const Tm_Config_t *cfg, Tm_Mode_t mode, Tm_State_t *s, double t)
+{
+    SVPWM_State_t st;
+    const uint32_t a1 = s->pwm_period + 1u;
+    SvpwmCore_Calc((float)cfg->m * cosf(s->angle), (float)cfg->m * sinf(s->angle), (float)a1, a1, &st);
+    s->angle += (float)(2.0 * M_PI * Tm_Freq(cfg, t) / TM_CTRL_HZ);
+    if (s->angle >= TWO_PI) s->angle -= TWO_PI;
+
+    const uint16_t ccr[3] = { st.CCR_A, st.CCR_B, st.CCR_C };
+    s->cmd_t[1] = s->cmd_t[0];
+    s->cmd_t[0] = t;
+    for (uint32_t k = 0; k < 3u; k++)
+    {
+        s->cmd_duty[1][k] = s->cmd_duty[0][k];
+        s->cmd_duty[0][k] = (double)ccr[k] / (double)a1;
+    }
+
+    if (mode == TM_DEFERRED)
+    {
+        memcpy(s->next.ccr, ccr, sizeof(ccr));
+        if (s->own) return;
+    }
+    memcpy(s->ccr_pre, ccr, sizeof(ccr));
+}
+
+/* ============== 업데이트 ISR (TIM3) ============== */
+
+/** @brief SVPWM_PeriodIRQHandler */
+static void Tm_PeriodIsr(Tm_State_t *s)
+{
+    if (!s->uie || !s->dir) return;
+
+    s->arr_pre = SvpwmCore_NextPeriod(&s->next, s->ccr_pre);
+    if (s->next.span == 0u)
+    {
+        s->uie = 0;
+        s->own = 0;
+    }
+}
+
+/* ============== 주기 검사 ============== */
+static void Tm_CheckPeriod(const Tm_State_t *s, uint32_t arr_up, const uint16_t ccr_up[3], double t_start,
+                           Tm_Result_t *pRes)
+{
+    const uint32_t arr_dn = s->arr_act;
+    pRes->periods++;
+    if (arr_dn < pRes->arr_min) pRes->arr_min = arr_dn;
+    if (arr_dn > pRes->arr_max) pRes->arr_max = arr_dn;
+
+    int asym = (arr_up != arr_dn);
+    int bad = 0;
+    const double len = (double)(arr_up + arr_dn + 2u);
+    const double tol = 1.0 / (double)((arr_up < arr_dn ? arr_up : arr_dn) + 1u) + 1e-9;
+    for (uint32_t k = 0; k < 3u; k++)
+    {
+        if (ccr_up[k] != s->ccr_act[k]) asym = 1;
+
+        double on = fmin((double)ccr_up[k], arr_up + 1.0) + fmin((double)s->ccr_act[k], arr_dn + 1.0);
+        double duty = on / len;
+        double err = INFINITY;
+        for (uint32_t h = 0; h < 2u; h++)
+            if (s->cmd_t[h] <= t_start)
+                err = fmin(err, fabs(duty - s->cmd_duty[h][k]));
+        if (err > tol) bad = 1;
+        if (100.0 * err > pRes->duty_err_max) pRes->duty_err_max = 100.0 * err;
+    }
+    pRes->asym += (uint64_t)asym;
+    pRes->duty += (uint64_t)bad;
+}
+
+/* ============== 시뮬레이션 ============== */
+static void Tm_Simulate(const Tm_Config_t *cfg, Tm_Mode_t mode, Tm_Result_t *pRes)
+{
+    memset(pRes, 0, sizeof(*pRes));
+    pRes->arr_min = 0xFFFFFFFFu;
+    rng_state = cfg->seed ? cfg->seed : 1u;
+
+    Tm_State_t s;
+    memset(&s, 0, sizeof(s));
+    s.arr_pre = s.arr_act = cfg->arr_hi;
+    s.pwm_period = cfg->arr_hi;
+    s.next.arr = cfg->arr_hi;
+    s.next.lfsr = SVPWM_SPREAD_LFSR_SEED;
+    if (mode == TM_DEFERRED)
+    {
+        s.next.span = cfg->arr_hi * cfg->spread / 100u;
+        s.own = s.uie = (s.next.span != 0u);
+    }
+    s.cmd_t[0] = s.cmd_t[1] = 0.0;          // SVPWM_Init: CCR 0
+
+    /* 시각 [tick] */
+    const double T6 = TM_TIM_CLK_HZ / TM_CTRL_HZ;
+    const double t_end = cfg->time_s * TM_TIM_CLK_HZ;
+    const double d_sched = cfg->t_sched * TM_TIM_CLK_HZ, d_run = cfg->t_run * TM_TIM_CLK_HZ;
+    const double d_busy = cfg->t_busy * TM_TIM_CLK_HZ, d_lat = cfg->isr_lat * TM_TIM_CLK_HZ;
+
+    double t_uev = s.arr_act + 1.0;         // 다음 UEV (첫 반주기는 상승)
+    double t_half = 0.0;                    // 현재 반주기 시작
+    double t_period = 0.0;                  // 현재 주기 (바닥) 시작
+    double t6 = T6 * Tm_Uniform();          // 다음 제어 ISR 시작
+    double t6_busy_end = -1.0;
+    int    t6_stage = 0;                    // 0: 대기, 1: 주기 선택 전, 2: CCR 기록 전
+    double t6_start = 0.0;
+    double t3 = INFINITY;                   // 대기 중인 업데이트 ISR 실행 시각 (UIF)
+    int    t3_top = 0;                      // 정점 UEV 가 세운 UIF (바닥 전에 실행돼야 함)
+
+    uint32_t arr_up = s.arr_act;
+    uint16_t ccr_up[3] = { 0 };
+
+    while (t_half < t_end)
+    {
+        /* 다음 이벤트 */
+        double t_ev6 = (t6_stage == 0) ? t6 : (t6_stage == 1) ? t6_start + d_sched : t6_start + d_run;
+        double t_ev3 = t3;
+        if (t_ev3 < t6_busy_end && t_ev3 >= t6_start) t_ev3 = t6_busy_end;    // 선점 대기
+
+        if (t_uev <= t_ev6 && t_uev <= t_ev3)
+        {
+            /* UEV: 프리로드 이동, 방향 전환 */
+            if (s.dir == 0)
+            {
+                arr_up = s.arr_act;
+                memcpy(ccr_up, s.ccr_act, sizeof(ccr_up));
+            }
+            else
+            {
+                Tm_CheckPeriod(&s, arr_up, ccr_up, t_period, pRes);
+                t_period = t_uev;
+            }
+            s.arr_act = s.arr_pre;
+            memcpy(s.ccr_act, s.ccr_pre, sizeof(s.ccr_act));
+            s.dir ^= 1u;
+            t_half = t_uev;
+            t_uev += s.arr_act + 1.0;
+            if (s.uie && !isfinite(t3))
+            {
+                t3 = t_half + d_lat;
+                t3_top = s.dir;
+            }
+        }
+        else if (t_ev6 <= t_ev3)
+        {
+            if (t6_stage == 0)
+            {
+                t6_start = t6 + cfg->jitter * TM_TIM_CLK_HZ * Tm_Uniform();
+                t6_busy_end = t6_start + d_busy;
+                t6 += T6;
+                t6_stage = 1;
+            }
+            else if (t6_stage == 1)
+            {
+                Tm_Schedule(cfg, mode, &s, t_ev6 / TM_TIM_CLK_HZ, pRes);
+                t6_stage = 2;
+            }
+            else
+            {
+                Tm_Run(cfg, mode, &s, t_ev6);
+                t6_stage = 0;
+            }
+        }
+        else
+        {
+            t3 = INFINITY;
+            if (t3_top && !s.dir) pRes->late++;
+            Tm_PeriodIsr(&s);
+        }
+    }
+}
+
+/* ============== 메인 ============== */
+static void Tm_Usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [--mode direct|deferred|both] [--time S] [--f-max HZ] [--f-lo HZ] [--f-hi HZ]\n"
+        "          [--arr-lo N] [--arr-hi N] [--spread PCT] [--m MOD] [--t-sched US] [--t-run US]\n"
+        "          [--t-busy US] [--jitter US] [--isr-lat US] [--seed N]\n", argv0);
+}
+
+int main(int argc, char **argv)
+{
+    Tm_Config_t cfg = {
+        .time_s = 3.0, .f_max = 400.0, .f_lo = 50.0, .f_hi = 300.0, .arr_lo = 16999u, .arr_hi = 4249u,
+        .spread = 0u, .m = 0.5, .t_sched = 2e-6, .t_run = 8e-6, .t_busy = 12e-6, .jitter = 2e-6,
+        .isr_lat = 1e-6, .seed = 1u,
+    };
+    int mode_mask = 3;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 >= argc) { Tm_Usage(argv[0]); return 2; }
+        const char *o = argv[i], *v = argv[++i];
+        if (!strcmp(o, "--mode"))
+        {
+            if      (!strcmp(v, "direct"))   mode_mask = 1;
+            else if (!strcmp(v, "deferred")) mode_mask = 2;
+            else if (!strcmp(v, "both"))     mode_mask = 3;
+            else { Tm_Usage(argv[0]); return 2; }
+        }
+        else if (!strcmp(o, "--time"))     cfg.time_s = atof(v);
+        else if (!strcmp(o, "--f-max"))    cfg.f_max = atof(v);
+        else if (!strcmp(o, "--f-lo"))     cfg.f_lo = atof(v);
+        else if (!strcmp(o, "--f-hi"))     cfg.f_hi = atof(v);
+        else if (!strcmp(o, "--arr-lo"))   cfg.arr_lo = (uint32_t)atoi(v);
+        else if (!strcmp(o, "--arr-hi"))   cfg.arr_hi = (uint32_t)atoi(v);
+        else if (!strcmp(o, "--spread"))   cfg.spread = (uint32_t)atoi(v);
+        else if (!strcmp(o, "--m"))        cfg.m = atof(v);
+        else if (!strcmp(o, "--t-sched"))  cfg.t_sched = atof(v) * 1e-6;
+        else if (!strcmp(o, "--t-run"))    cfg.t_run = atof(v) * 1e-6;
+        else if (!strcmp(o, "--t-busy"))   cfg.t_busy = atof(v) * 1e-6;
+        else if (!strcmp(o, "--jitter"))   cfg.jitter = atof(v) * 1e-6;
+        else if (!strcmp(o, "--isr-lat"))  cfg.isr_lat = atof(v) * 1e-6;
+        else if (!strcmp(o, "--seed"))     cfg.seed = strtoull(v, NULL, 0);
+        else { Tm_Usage(argv[0]); return 2; }
+    }
+    if (cfg.arr_lo < 1u || cfg.arr_hi < 1u || cfg.spread > SVPWM_SPREAD_MAX_PCT ||
+        (uint64_t)(cfg.arr_lo > cfg.arr_hi ? cfg.arr_lo : cfg.arr_hi) * (100u + cfg.spread) / 100u > 0xFFFFu ||
+        !(cfg.t_sched <= cfg.t_run && cfg.t_run <= cfg.t_busy) || cfg.time_s <= 0.0)
+    {
+        fprintf(stderr, "invalid arr / spread / ISR timing\n");
+        return 2;
+    }
+
+    printf("ramp 0 -> %.0f -> 0 Hz over %.2f s, ARR %u (%.0f Hz) @ <= %.0f Hz .. %u (%.0f Hz) @ >= %.0f Hz, "
+           "spread %u %%\n",
+           cfg.f_max, cfg.time_s, cfg.arr_lo, TM_TIM_CLK_HZ / (2.0 * (cfg.arr_lo + 1u)), cfg.f_lo,
+           cfg.arr_hi, TM_TIM_CLK_HZ / (2.0 * (cfg.arr_hi + 1u)), cfg.f_hi, cfg.spread);
+    printf("%-9s %9s %8s %8s %8s %6s %10s %8s %8s\n",
+           "mode", "periods", "changes", "asym", "duty", "late", "err_max%", "arr_min", "arr_max");
+
+    int fail = 0;
+    static const char *const names[] = { "direct", "deferred" };
+    for (int m = 0; m < 2; m++)
+    {
+        if (!(mode_mask & (1 << m))) continue;
+        Tm_Result_t res;
+        Tm_Simulate(&cfg, (Tm_Mode_t)m, &res);
+        printf("%-9s %9llu %8llu %8llu %8llu %6llu %10.4f %8u %8u\n", names[m],
+               (unsigned long long)res.periods, (unsigned long long)res.changes,
+               (unsigned long long)res.asym, (unsigned long long)res.duty, (unsigned long long)res.late,
+               res.duty_err_max, res.arr_min, res.arr_max);
+        if (m == TM_DEFERRED && (res.asym != 0u || res.duty != 0u)) fail = 1;
+    }
+    return fail;
+}
@@ -0,0 +1,279 @@
+/**
+ * @file    svpwm_cfg_sim.c
+ * @brief   svpwm_config.h 설정별 폐루프 시험 (호스트 CLI)
+ *
+ * svpwm_config.h 의 변조 방식 / 단일 션트 설정은 컴파일 상수라 설정마다 따로 빌드해
+ * 돌린다. fw_loop.c 로 실제 OpenLoop_Step → SVPWM → TIM3 업데이트 ISR 경로가 플랜트를
+ * 구동하고, PWM 주기마다 타이머에 실제로 나간 반주기 CCR / 트리거를 검사한다.
+ *
+ * 판정 (하나라도 어긋나면 종료 코드 1):
+ *   - 고장 없음, 드라이버 EN 유지, 마지막 0.5 s 평균 속도 = 동기 속도 (±1 %)
+ *   - 모든 주기: 반주기 CCR ∈ [0, ARR+1]
+ *   - 영벡터 배분 (주기 평균 CCR, 전 상 0 인 정지 출력 제외):
+ *       SYMMETRIC : 최대 + 최소 = ARR+1 (±1, 가운데 정렬)
+ *       DPWM_MIN  : 최소 상 = 0      (그 상은 주기 내내 LOW)
+ *       DPWM_MAX  : 최대 상 = ARR+1  (그 상은 주기 내내 HIGH)
+ *     PWM1 은 CNT < CCR 동안 HIGH 이고 CNT 는 0 ~ ARR 이므로 CCR = ARR 이면 정점에서
+ *     1 tick (5.9 ns) LOW 가 남는다. 드라이버 데드타임 (300 ns) 보다 짧아 전압에는 거의
+ *     안 보이지만 고정 상이 주기마다 두 번 스위칭해 DPWM 의 이득 (스위칭 1/3 감소) 이
+ *     사라지므로 상한은 ARR+1 이다.
+ *   - 전류 (Sense_GetState ia/ib):
+ *       상별 션트 : 같은 시점 플랜트 상전류 (±2 LSB)
+ *       단일 션트 : 샘플 창이 맞으면 (트리거 시점에 켜진 상이 hi 하나 / hi+md) 그 시점
+ *                   플랜트 상전류로 복원한 값 (±2 LSB), 유효 샘플 주기 비율 ≥ 90 %
+ *   - 단일 션트 주입 정지 (실행 후): JADSTP 가 풀리지 않으면 래치가 대기를 끊고 1 회 세며,
+ *     풀린 뒤 다음 래치에서 주입 변환을 재시작
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt - 설정마다 펌웨어 오브젝트 / 실행 파일 하나, ctest 가 네 설정을 모두 돌린다):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target svpwm_cfg_sim \
+ *       svpwm_cfg_sim_dpwm_min svpwm_cfg_sim_dpwm_max svpwm_cfg_sim_shunt
+ *
+ * 실행:
+ *   ./svpwm_cfg_sim
+ *   ./svpwm_cfg_sim --freq 40 --volt 3 --ramp 2 --time 4
+ */
+
+#include "fw_loop.h"
+#include "hal_host.h"
+#include "app_config.h"
+#include "fault.h"
+#include "sense.h"
+#include "svpwm.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 설정 ============== */
+#define CFGSIM_SPEED_TOL    0.01        // 속도 판정 ±1 %
+#define CFGSIM_CUR_LSB      2.0f        // 전류 판정 [ADC LSB]
+#define CFGSIM_AVG_S        0.5         // 속도 평균 구간 [s]
+#define CFGSIM_SHUNT_MIN    0.90f       // 단일 션트 유효 샘플 주기 비율 하한
+
+#if SVPWM_SINGLE_SHUNT
+#define CFGSIM_NAME_SENSE   "single shunt"
+#else
+#define CFGSIM_NAME_SENSE   "phase shunts"
+#endif
+
+#if SVPWM_MODULATION == SVPWM_MOD_DPWM_MIN
+#define CFGSIM_NAME_MOD     "DPWM_MIN"
+#elif SVPWM_MODULATION == SVPWM_MOD_DPWM_MAX
+#define CFGSIM_NAME_MOD     "DPWM_MAX"
+#else
+#define CFGSIM_NAME_MOD     "SYMMETRIC"
+#endif
+
+/* 주기 검사 누적 */
+typedef struct {
+    uint32_t periods;       // 드라이버 ON 주기
+    uint32_t bad_range;     // CCR > ARR+1
+    uint32_t bad_split;     // 영벡터 배분 위반
+    uint32_t shunt_valid;   // 샘플 창 확보 주기
+    uint32_t bad_window;    // 트리거 시점 ON 상이 기대와 다름
+    /* 단일 션트 기대 전류: pending = 방금 주기 샘플, latched = 다음 정점 ISR 이 래치한 값 */
+    uint8_t  pend_ok, latch_ok;
+    float    pend[2], latch[2];
+} CfgSim_Stat_t;
+
+static void CfgSim_Usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [--freq HZ] [--volt V] [--ramp SEC] [--time SEC]\n"
+        "          [--vbus V] [--rs OHM] [--ld H] [--lq H] [--flux WB] [--pp N] [--j KGM2]\n",
+        argv0);
+}
+
+/**
+ * @brief PWM 주기 관찰: 반주기 CCR 범위, 영벡터 배분, 단일 션트 샘플 창
+ */
+static void CfgSim_OnPeriod(const Plant_t *pl, void *ctx)
+{
+    CfgSim_Stat_t *st = (CfgSim_Stat_t *)ctx;
+    const HalHost_Pwm_t *pw = FwLoop_Pwm();
+
+    // 이 주기 정점 ISR 이 직전 주기 샘플을 래치했다
+    if (st->pend_ok)
+    {
+        st->latch[0] = st->pend[0];
+        st->latch[1] = st->pend[1];
+        st->latch_ok = 1u;
+    }
+    st->pend_ok = 0u;
+
+    if (!HalHost_DriverEnabled()) return;
+    st->periods++;
+
+    const uint32_t full = pw->arr + 1u;
+    uint32_t c[3];
+    for (uint32_t k = 0; k < 3u; k++)
+    {
+        if (pw->up[k] > full || pw->dn[k] > full) st->bad_range++;
+        c[k] = (uint32_t)pw->up[k] + pw->dn[k];        // 주기 평균 ×2
+    }
+    uint32_t c_max = c[0], c_min = c[0];
+    for (uint32_t k = 1; k < 3u; k++)
+    {
+        if (c[k] > c_max) c_max = c[k];
+        if (c[k] < c_min) c_min = c[k];
+    }
+    if (c_max == 0u) return;        // SVPWM_Stop 출력 (단일 션트는 ISR 기록이라 첫 주기가 아직 이 값)
+#if SVPWM_MODULATION == SVPWM_MOD_DPWM_MIN
+    if (c_min != 0u) st->bad_split++;
+#elif SVPWM_MODULATION == SVPWM_MOD_DPWM_MAX
+    if (c_max != 2u * full) st->bad_split++;
+#else
+    if (abs((int32_t)(c_max + c_min) - 2 * (int32_t)full) > 2) st->bad_split++;
+#endif
+
+#if SVPWM_SINGLE_SHUNT
+    if (pw->trig[0] > pw->arr || !pl->shunt[0].valid || !pl->shunt[1].valid) return;
+    st->shunt_valid++;
+
+    // 하강 구간 상 순서: 샘플 1 = hi 만 ON (+i_hi), 샘플 2 = hi + md ON (-i_lo)
+    uint32_t hi = 0u, lo = 0u;
+    for (uint32_t k = 1; k < 3u; k++)
+    {
+        if (pw->dn[k] > pw->dn[hi]) hi = k;
+        if (pw->dn[k] < pw->dn[lo]) lo = k;
+    }
+    const Plant_ShuntSample_t *s1 = &pl->shunt[0], *s2 = &pl->shunt[1];
+    if (fabsf(s1->i_dc - s1->i_ph[hi]) > 1e-6f || fabsf(s2->i_dc + s2->i_ph[lo]) > 1e-6f)
+    {
+        st->bad_window++;
+        return;
+    }
+
+    float iph[3];
+    iph[hi] = s1->i_ph[hi];
+    iph[lo] = s2->i_ph[lo];
+    iph[3u - hi - lo] = -iph[hi] - iph[lo];
+    st->pend[0] = iph[0];
+    st->pend[1] = iph[1];
+    st->pend_ok = 1u;
+#else
+    (void)pl;
+#endif
+}
+
+int main(int argc, char **argv)
+{
+    float freq = 20.0f, volt = 1.5f, ramp = 1.0f;
+    double time_s = 3.0;
+    Plant_Params_t par;
+    Plant_DefaultParams(&par);
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a = argv[i];
+        if (i + 1 >= argc) { CfgSim_Usage(argv[0]); return 2; }
+        const char *v = argv[++i];
+
+        if      (!strcmp(a, "--freq"))  freq = (float)atof(v);
+        else if (!strcmp(a, "--volt"))  volt = (float)atof(v);
+        else if (!strcmp(a, "--ramp"))  ramp = (float)atof(v);
+        else if (!strcmp(a, "--time"))  time_s = atof(v);
+        else if (!strcmp(a, "--vbus"))  par.vbus = (float)atof(v);
+        else if (!strcmp(a, "--rs"))    par.rs = (float)atof(v);
+        else if (!strcmp(a, "--ld"))    par.ld = (float)atof(v);
+        else if (!strcmp(a, "--lq"))    par.lq = (float)atof(v);
+        else if (!strcmp(a, "--flux"))  par.flux = (float)atof(v);
+        else if (!strcmp(a, "--pp"))    par.pole_pairs = (uint32_t)atoi(v);
+        else if (!strcmp(a, "--j"))     par.j = (float)atof(v);
+        else { CfgSim_Usage(argv[0]); return 2; }
+    }
+    if (time_s <= CFGSIM_AVG_S || ramp < 0.0f || ramp > time_s - CFGSIM_AVG_S)
+    {
+        fprintf(stderr, "--time must exceed --ramp + %.1f s\n", CFGSIM_AVG_S);
+        return 2;
+    }
+
+    FwLoop_Init(&par);
+    Plant_t *pl = FwLoop_Plant();
+    CfgSim_Stat_t st;
+    memset(&st, 0, sizeof(st));
+    FwLoop_SetPeriodHook(CfgSim_OnPeriod, &st);
+
+    const uint32_t steps = (uint32_t)(time_s * CONTROL_FREQ_HZ);
+    const uint32_t avg_from = steps - (uint32_t)(CFGSIM_AVG_S * CONTROL_FREQ_HZ);
+    const float lsb_a = ADC_VREF / ADC_FULL_SCALE / (CURR_SHUNT_OHM * CURR_AMP_GAIN);
+    double w_sum = 0.0;
+    float cur_err = 0.0f;
+    uint32_t w_n = 0, cur_n = 0;
+    uint8_t ok = 1;
+
+    for (uint32_t n = 0; n < steps; n++)
+    {
+        float t = (float)n / (float)CONTROL_FREQ_HZ;
+        float k = (ramp > 0.0f && t < ramp) ? t / ramp : 1.0f;
+        if (!OpenLoop_SetSpeedVolt(freq * k, volt * (0.2f + 0.8f * k)))
+        {
+            fprintf(stderr, "OpenLoop_SetSpeedVolt rejected %.3f Hz / %.3f V\n", freq * k, volt);
+            return 1;
+        }
+
+        // 이번 스텝 Sense_Update 가 읽을 값: 상별 = 지금 플랜트 전류, 단일 = 래치된 샘플
+#if SVPWM_SINGLE_SHUNT
+        const uint8_t ref_ok = st.latch_ok;
+        const float ia = st.latch[0], ib = st.latch[1];
+#else
+        const uint8_t ref_ok = 1u;
+        const float ia = pl->ia, ib = pl->ib;
+#endif
+        FwLoop_Tick();
+
+        if (ref_ok)
+        {
+            const Sense_State_t *s = Sense_GetState();
+            float e = fmaxf(fabsf(s->ia - ia), fabsf(s->ib - ib));
+            if (e > cur_err) cur_err = e;
+            cur_n++;
+        }
+        if (n >= avg_from)
+        {
+            w_sum += pl->omega_m;
+            w_n++;
+        }
+    }
+
+    const double w_sync = 2.0 * M_PI * freq / (double)pl->p.pole_pairs;
+    const double w_avg = w_sum / (double)w_n;
+    const double w_err = fabs(w_avg - w_sync) / w_sync;
+
+    printf("config          : %s, %s, ARR %u\n", CFGSIM_NAME_MOD, CFGSIM_NAME_SENSE, (unsigned)SVPWM_ARR);
+    printf("pwm periods     : %u on (ccr range %u, zero split %u)\n",
+           st.periods, st.bad_range, st.bad_split);
+    printf("fault           : 0x%04x, driver %s\n", Fault_GetInfo()->causes,
+           HalHost_DriverEnabled() ? "on" : "off");
+    printf("speed           : %.3f rad/s (sync %.3f, err %.3f %%)\n", w_avg, w_sync, 100.0 * w_err);
+    printf("sense vs plant  : max %.2f mA (%.2f LSB, %u steps)\n", 1e3f * cur_err, cur_err / lsb_a, cur_n);
+
+    if (!Fault_IsOk() || !HalHost_DriverEnabled())  { printf("FAIL fault / driver\n"); ok = 0; }
+    if (!(w_err <= CFGSIM_SPEED_TOL))                { printf("FAIL speed\n"); ok = 0; }
+    if (st.periods == 0u || st.bad_range != 0u)      { printf("FAIL ccr range\n"); ok = 0; }
+    if (st.bad_split != 0u)                          { printf("FAIL zero-vector split\n"); ok = 0; }
+    if (cur_n == 0u || !(cur_err <= CFGSIM_CUR_LSB * lsb_a)) { printf("FAIL current sense\n"); ok = 0; }
+#if SVPWM_SINGLE_SHUNT
+    const float valid = (st.periods > 0u) ? (float)st.shunt_valid / (float)st.periods : 0.0f;
+    printf("shunt windows   : %.1f %% valid, %u misplaced\n", 100.0f * valid, st.bad_window);
+    if (st.bad_window != 0u)                         { printf("FAIL shunt sample window\n"); ok = 0; }
+    if (!(valid >= CFGSIM_SHUNT_MIN))                { printf("FAIL shunt valid ratio\n"); ok = 0; }
+
+    // 시퀀스 어긋남 (JEOC 만) + 풀리지 않는 JADSTP (호스트 ADC 는 스스로 지우지 않음)
+    const uint32_t to0 = Sense_GetShuntStopTimeouts();
+    ADC1->CR &= ~(uint32_t)ADC_CR_JADSTART;
+    ADC1->ISR = ADC_ISR_JEOC;
+    Sense_ShuntLatch(0);
+    const uint8_t stuck_ok = (to0 == 0u && Sense_GetShuntStopTimeouts() == 1u &&
+                              !(ADC1->CR & ADC_CR_JADSTART));
+    ADC1->CR &= ~(uint32_t)ADC_CR_JADSTP;
+    Sense_ShuntLatch(0);
+    const uint8_t restart_ok = (ADC1->CR & ADC_CR_JADSTART) ? 1u : 0u;
+    printf("shunt stop wait : %u timeout, restart %s\n", (unsigned)Sense_GetShuntStopTimeouts(),
+           restart_ok ? "ok" : "missing");
+    if (!stuck_ok || !restart_ok)                    { printf("FAIL shunt stop timeout\n"); ok = 0; }
+#endif
+    if (ok) printf("PASS\n");
+    return ok ? 0 : 1;
+}
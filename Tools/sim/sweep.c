@@ -0,0 +1,456 @@
+/**
+ * @file    sweep.c
+ * @brief   오픈루프 기동 파라미터 스윕 러너 (펌웨어-플랜트 폐루프 배치 시뮬레이션)
+ *
+ * 파라미터 격자의 조합마다 fw_loop.c 폐루프 1 개를 작업자 프로세스 풀에서
+ * 병렬로 돌리고, 속도 도달 시간 / 탈조 / 피크 전류 / 리플을 CSV·JSON 으로 낸다.
+ *
+ * 제어 경로는 펌웨어 그대로다: svpwm.c / svpwm_core.c / sense.c / protect.c 를
+ * hal_host.c 와 링크해 OpenLoop_Step 이 각도 적분, 전압 정규화, V_MOD_MAX 제한,
+ * CCR 계산을 한다. 기동 램프와 V/f 곡선 (V = v0 + vf·f) 은 motor_client 처럼
+ * 제어 스텝마다 OpenLoop_SetSpeedVolt 로 준다.
+ * 펌웨어 상태가 전역이라 스레드가 아닌 fork 작업자로 나누고, 결과는 공유 매핑에 쓴다.
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt, -Wall -Wextra -Werror, ctest 게이트에 포함):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target sweep
+ *
+ * 실행:
+ *   ./sweep --freq 20:100:20 --ramp 0.5,1,2 --v0 0.5,1 --vf 0.02:0.06:0.01 --csv out.csv
+ *   ./sweep --freq 50 --ramp 1 --tl 0:0.004:0.001 --j 2e-6,1e-5 --json out.json --workers 8
+ *
+ * 격자 축: 값 1 개, "a,b,c" 목록, "start:stop:step" 범위
+ *   --freq  목표 전기 주파수 [Hz]      --ramp  0 → 목표 주파수 램프 시간 [s]
+ *   --v0    V/f 곡선 오프셋 (부스트) [V] --vf    V/f 기울기 [V/Hz]
+ *   --tl    부하 토크 [N·m]            --j     관성 [kg·m²]
+ */
+
+#define _GNU_SOURCE
+#include "fw_loop.h"
+#include "app_config.h"
+#include "fault.h"
+#include "param.h"
+#include "svpwm.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/* ============== 설정 ============== */
+#define SWEEP_AXIS_MAX      256u
+#define SWEEP_SPEED_BAND    0.05f       // 속도 도달 판정 ±5 %
+#define SWEEP_SPEED_WIN     100u        // 속도 도달 판정 이동 평균 [제어 스텝] (오픈루프 진동 제거)
+#define SWEEP_STALL_RATIO   0.5f        // 종료 평균 속도 < 동기 속도의 50 % 면 정지
+#define SWEEP_TAIL_RATIO    0.2f        // 리플 측정 구간 (시뮬레이션 마지막 20 %)
+
+/* ============== 격자 ============== */
+typedef enum {
+    AX_FREQ = 0, AX_RAMP, AX_V0, AX_VF, AX_TL, AX_J, AX_COUNT
+} Sweep_Axis_t;
+
+static const char *axis_name[AX_COUNT] = { "freq", "ramp", "v0", "vf", "tl", "j" };
+
+typedef struct {
+    float    v[SWEEP_AXIS_MAX];
+    uint32_t n;
+} Sweep_Values_t;
+
+typedef struct {
+    float in[AX_COUNT];
+
+    /* 지표 */
+    float t_speed;          // 평균 속도가 동기 속도 ±5 % 에 들어와 끝까지 유지한 시각 [s] (-1: 미도달)
+    uint32_t slips;         // 탈조 횟수 (지령각 - 회전자각 누적 2π 당 1 회)
+    uint8_t  stalled;       // 종료 시 정지 또는 마지막 구간에서 탈조 계속
+    float i_peak;           // 상전류 피크 [A] (PWM 주기 끝 샘플)
+    float i_rms_tail;       // 마지막 구간 상전류 RMS [A]
+    float i_ripple_tail;    // 마지막 구간 |i_dq| 피크-피크 [A]
+    float w_ripple_tail;    // 마지막 구간 속도 표준편차 / 동기 속도 [%]
+    float w_final;          // 종료 기계 속도 [rad/s]
+    uint16_t fault;         // 종료 시 고장 원인 (Fault_Info_t.causes)
+} Sweep_Job_t;
+
+/* PWM 주기 관찰 (FwLoop_SetPeriodHook) */
+typedef struct {
+    Sweep_Job_t *job;
+    uint8_t  tail;          // 리플 측정 구간
+    double   i2_sum;
+    uint32_t i_cnt;
+    float    idq_min, idq_max;
+} Sweep_Period_t;
+
+typedef struct {
+    Plant_Params_t base;
+    uint32_t arr;
+    float    time_s;
+    float    v_mod_max;
+} Sweep_Common_t;
+
+static Sweep_Common_t common;
+static Sweep_Job_t *jobs;           // 작업자 프로세스와 공유 (MAP_SHARED)
+static uint32_t job_count;
+
+/**
+ * @brief 축 값 파싱: "a", "a,b,c", "start:stop:step"
+ */
+static int Sweep_ParseAxis(const char *s, Sweep_Values_t *pOut)
+{
+    pOut->n = 0;
+    float a, b, c;
+    if (sscanf(s, "%f:%f:%f", &a, &b, &c) == 3)
+    {
+        if (c <= 0.0f || b < a) return -1;
+        for (float x = a; x <= b + 0.5f * c && pOut->n < SWEEP_AXIS_MAX; x = a + c * (float)pOut->n)
+            pOut->v[pOut->n++] = x;
+        return 0;
+    }
+
+    char buf[512];
+    strncpy(buf, s, sizeof(buf) - 1u);
+    buf[sizeof(buf) - 1u] = '\0';
+    for (char *tok = strtok(buf, ","); tok && pOut->n < SWEEP_AXIS_MAX; tok = strtok(NULL, ","))
+    {
+        char *end;
+        pOut->v[pOut->n] = strtof(tok, &end);
+        if (end == tok) return -1;
+        pOut->n++;
+    }
+    return (pOut->n > 0u) ? 0 : -1;
+}
+
+/* ============== 시뮬레이션 1 회 ============== */
+static void Sweep_OnPeriod(const Plant_t *pl, void *ctx)
+{
+    Sweep_Period_t *pp = ctx;
+
+    float ipk = fmaxf(fabsf(pl->ia), fmaxf(fabsf(pl->ib), fabsf(pl->ic)));
+    if (ipk > pp->job->i_peak) pp->job->i_peak = ipk;
+    if (!pp->tail) return;
+
+    pp->i2_sum += (double)(pl->ia * pl->ia + pl->ib * pl->ib + pl->ic * pl->ic) / 3.0;
+    pp->i_cnt++;
+    float idq = sqrtf(pl->id * pl->id + pl->iq * pl->iq);
+    if (idq < pp->idq_min) pp->idq_min = idq;
+    if (idq > pp->idq_max) pp->idq_max = idq;
+}
+
+static void Sweep_RunJob(Sweep_Job_t *pJob)
+{
+    Plant_Params_t par = common.base;
+    par.t_load = pJob->in[AX_TL];
+    par.j      = pJob->in[AX_J];
+
+    FwLoop_Init(&par);
+    const Plant_t *pl = FwLoop_Plant();
+
+    /* 범위는 main 에서 검사했다 */
+    Param_Batch_t b;
+    Param_BatchInit(&b);
+    Param_BatchStageU(&b, PARAM_PWM_PERIOD, common.arr);
+    Param_BatchStageF(&b, PARAM_V_MOD_MAX, common.v_mod_max);
+    Param_BatchCommit(&b);
+
+    Sweep_Period_t pp = { .job = pJob, .tail = 0, .i2_sum = 0.0, .i_cnt = 0,
+                          .idq_min = 1e9f, .idq_max = 0.0f };
+    FwLoop_SetPeriodHook(Sweep_OnPeriod, &pp);
+
+    const float f_target = pJob->in[AX_FREQ];
+    const float ramp_s   = pJob->in[AX_RAMP];
+    const float w_sync   = TWO_PI * f_target / (float)par.pole_pairs;
+    const uint32_t steps = (uint32_t)(common.time_s * (float)CONTROL_FREQ_HZ);
+    const uint32_t tail0 = (uint32_t)((float)steps * (1.0f - SWEEP_TAIL_RATIO));
+
+    double lead = 0.0;              // 지령각 - 회전자 전기각 누적 [rad]
+    float th_prev = pl->theta_e;
+
+    pJob->t_speed = -1.0f;
+    pJob->slips = 0;
+    pJob->i_peak = 0.0f;
+
+    double w_sum = 0.0, w2_sum = 0.0;
+    uint32_t w_cnt = 0;
+    float w_win[SWEEP_SPEED_WIN] = { 0 };
+    float w_win_sum = 0.0f;
+    float w_avg = 0.0f;
+    uint32_t slips_tail0 = 0;
+
+    for (uint32_t n = 0; n < steps; n++)
+    {
+        const float t = (float)n / (float)CONTROL_FREQ_HZ;
+        const float f = (ramp_s > 0.0f && t < ramp_s) ? f_target * t / ramp_s : f_target;
+
+        OpenLoop_SetSpeedVolt(f, pJob->in[AX_V0] + pJob->in[AX_VF] * f);
+        pp.tail = (n >= tail0) ? 1u : 0u;
+
+        const float ang_prev = g_angle;
+        FwLoop_Tick();
+
+        /* 탈조: 지령각 (g_angle) 과 회전자 전기각의 스텝당 변화 (|Δ| < π 가정) 차 누적 */
+        float d_cmd = g_angle - ang_prev;
+        if (d_cmd > PI)        d_cmd -= TWO_PI;
+        else if (d_cmd < -PI)  d_cmd += TWO_PI;
+        float d_rot = pl->theta_e - th_prev;
+        if (d_rot > PI)        d_rot -= TWO_PI;
+        else if (d_rot < -PI)  d_rot += TWO_PI;
+        th_prev = pl->theta_e;
+        lead += (double)(d_cmd - d_rot);
+        while (lead > (double)TWO_PI)
+        {
+            lead -= (double)TWO_PI;
+            pJob->slips++;
+        }
+
+        /* 속도 도달: 이동 평균이 밴드에 진입한 시각 기록, 벗어나면 취소 */
+        const uint32_t wi = n % SWEEP_SPEED_WIN;
+        w_win_sum += pl->omega_m - w_win[wi];
+        w_win[wi] = pl->omega_m;
+        w_avg = w_win_sum / (float)SWEEP_SPEED_WIN;
+        if (w_sync > 0.0f && n >= SWEEP_SPEED_WIN &&
+            fabsf(w_avg - w_sync) <= SWEEP_SPEED_BAND * w_sync)
+        {
+            if (pJob->t_speed < 0.0f) pJob->t_speed = t;
+        }
+        else
+            pJob->t_speed = -1.0f;
+
+        if (n == tail0) slips_tail0 = pJob->slips;
+        if (n >= tail0)
+        {
+            w_sum += pl->omega_m;
+            w2_sum += (double)pl->omega_m * pl->omega_m;
+            w_cnt++;
+        }
+    }
+
+    pJob->w_final = pl->omega_m;
+    pJob->fault = Fault_GetInfo()->causes;
+    pJob->stalled = (w_avg < SWEEP_STALL_RATIO * w_sync || pJob->slips != slips_tail0 ||
+                     !Fault_IsOk()) ? 1u : 0u;
+    pJob->i_rms_tail = (pp.i_cnt > 0u) ? (float)sqrt(pp.i2_sum / pp.i_cnt) : 0.0f;
+    pJob->i_ripple_tail = (pp.i_cnt > 0u) ? pp.idq_max - pp.idq_min : 0.0f;
+    if (w_cnt > 0u && w_sync > 0.0f)
+    {
+        double mean = w_sum / w_cnt;
+        double var = w2_sum / w_cnt - mean * mean;
+        pJob->w_ripple_tail = (float)(100.0 * sqrt(var > 0.0 ? var : 0.0) / w_sync);
+    }
+    else
+        pJob->w_ripple_tail = 0.0f;
+}
+
+/* ============== 작업자 풀 ============== */
+
+/**
+ * @brief 작업자 프로세스 - 작업 k = id, id + n, id + 2n ... (펌웨어 전역 상태는 프로세스마다)
+ */
+static void Sweep_Worker(uint32_t id, uint32_t n)
+{
+    for (uint32_t k = id; k < job_count; k += n)
+    {
+        Sweep_RunJob(&jobs[k]);
+
+        if (id == 0u)
+        {
+            fprintf(stderr, "\r%u / %u", k + 1u, job_count);
+            fflush(stderr);
+        }
+    }
+}
+
+/* ============== 보고서 ============== */
+static void Sweep_WriteCsv(FILE *f)
+{
+    for (uint32_t a = 0; a < AX_COUNT; a++)
+        fprintf(f, "%s,", axis_name[a]);
+    fprintf(f, "t_speed,slips,stalled,i_peak,i_rms_tail,i_ripple_tail,w_ripple_pct,w_final,fault\n");
+
+    for (uint32_t k = 0; k < job_count; k++)
+    {
+        const Sweep_Job_t *j = &jobs[k];
+        for (uint32_t a = 0; a < AX_COUNT; a++)
+            fprintf(f, "%g,", j->in[a]);
+        fprintf(f, "%.4f,%u,%u,%.4f,%.4f,%.4f,%.3f,%.3f,0x%04x\n", j->t_speed, j->slips, j->stalled,
+                j->i_peak, j->i_rms_tail, j->i_ripple_tail, j->w_ripple_tail, j->w_final, j->fault);
+    }
+}
+
+static void Sweep_WriteJson(FILE *f, double wall)
+{
+    const Plant_Params_t *p = &common.base;
+    fprintf(f, "{\n  \"context\": {\"time_s\": %g, \"arr\": %u, \"ctrl_hz\": %u, \"vbus\": %g, "
+               "\"rs\": %g, \"ld\": %g, \"lq\": %g, \"flux\": %g, \"pole_pairs\": %u, "
+               "\"deadtime_s\": %g, \"wall_s\": %.3f},\n  \"runs\": [\n",
+            common.time_s, common.arr, CONTROL_FREQ_HZ, p->vbus, p->rs, p->ld, p->lq, p->flux,
+            p->pole_pairs, p->deadtime_s, wall);
+
+    for (uint32_t k = 0; k < job_count; k++)
+    {
+        const Sweep_Job_t *j = &jobs[k];
+        fprintf(f, "    {");
+        for (uint32_t a = 0; a < AX_COUNT; a++)
+            fprintf(f, "\"%s\": %g, ", axis_name[a], j->in[a]);
+        fprintf(f, "\"t_speed\": %.4f, \"slips\": %u, \"stalled\": %s, \"i_peak\": %.4f, "
+                   "\"i_rms_tail\": %.4f, \"i_ripple_tail\": %.4f, \"w_ripple_pct\": %.3f, "
+                   "\"w_final\": %.3f, \"fault\": %u}%s\n",
+                j->t_speed, j->slips, j->stalled ? "true" : "false", j->i_peak, j->i_rms_tail,
+                j->i_ripple_tail, j->w_ripple_tail, j->w_final, j->fault, (k + 1u < job_count) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+/* ============== 메인 ============== */
+static void Sweep_Usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [--freq AX] [--ramp AX] [--v0 AX] [--vf AX] [--tl AX] [--j AX]\n"
+        "          [--time SEC] [--workers N] [--csv FILE] [--json FILE]\n"
+        "          [--arr N] [--vmod MAX] [--step SEC] [--vbus V] [--deadtime SEC]\n"
+        "          [--rs OHM] [--ld H] [--lq H] [--flux WB] [--pp N] [--b NMS] [--tc NM]\n"
+        "AX: value | a,b,c | start:stop:step\n", argv0);
+}
+
+static double Sweep_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    static Sweep_Values_t ax[AX_COUNT];
+    const char *csv = NULL, *json = NULL;
+    long workers = sysconf(_SC_NPROCESSORS_ONLN);
+
+    /* ARR / 변조 상한 기본값과 범위는 펌웨어 파라미터 정의 그대로 */
+    Param_Init();
+    Plant_DefaultParams(&common.base);
+    common.arr = Param_GetDesc(PARAM_PWM_PERIOD)->def.u;
+    common.time_s = 3.0f;
+    common.v_mod_max = Param_GetDesc(PARAM_V_MOD_MAX)->def.f;
+
+    /* 기본 격자 (1 점) */
+    const float ax_def[AX_COUNT] = { 30.0f, 1.0f, 0.5f, 0.03f, 0.0f, common.base.j };
+    for (uint32_t a = 0; a < AX_COUNT; a++)
+    {
+        ax[a].v[0] = ax_def[a];
+        ax[a].n = 1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 >= argc) { Sweep_Usage(argv[0]); return 2; }
+        const char *o = argv[i], *v = argv[++i];
+        int matched = 0;
+
+        for (uint32_t a = 0; a < AX_COUNT; a++)
+        {
+            if (o[0] == '-' && o[1] == '-' && !strcmp(o + 2, axis_name[a]))
+            {
+                if (Sweep_ParseAxis(v, &ax[a]) != 0) { fprintf(stderr, "bad axis %s\n", o); return 2; }
+                matched = 1;
+            }
+        }
+        if (matched) continue;
+
+        if      (!strcmp(o, "--time"))     common.time_s = (float)atof(v);
+        else if (!strcmp(o, "--workers"))  workers = atol(v);
+        else if (!strcmp(o, "--csv"))      csv = v;
+        else if (!strcmp(o, "--json"))     json = v;
+        else if (!strcmp(o, "--arr"))      common.arr = (uint32_t)atoi(v);
+        else if (!strcmp(o, "--vmod"))     common.v_mod_max = (float)atof(v);
+        else if (!strcmp(o, "--step"))     common.base.max_step_s = (float)atof(v);
+        else if (!strcmp(o, "--vbus"))     common.base.vbus = (float)atof(v);
+        else if (!strcmp(o, "--deadtime")) common.base.deadtime_s = (float)atof(v);
+        else if (!strcmp(o, "--rs"))       common.base.rs = (float)atof(v);
+        else if (!strcmp(o, "--ld"))       common.base.ld = (float)atof(v);
+        else if (!strcmp(o, "--lq"))       common.base.lq = (float)atof(v);
+        else if (!strcmp(o, "--flux"))     common.base.flux = (float)atof(v);
+        else if (!strcmp(o, "--pp"))       common.base.pole_pairs = (uint32_t)atoi(v);
+        else if (!strcmp(o, "--b"))        common.base.b = (float)atof(v);
+        else if (!strcmp(o, "--tc"))       common.base.tc = (float)atof(v);
+        else { Sweep_Usage(argv[0]); return 2; }
+    }
+    Param_Batch_t chk;
+    Param_BatchInit(&chk);
+    if (!Param_BatchStageU(&chk, PARAM_PWM_PERIOD, common.arr) ||
+        !Param_BatchStageF(&chk, PARAM_V_MOD_MAX, common.v_mod_max) ||
+        common.time_s <= 0.0f || common.base.vbus <= 0.0f)
+    {
+        fprintf(stderr, "invalid --arr / --vmod / --time / --vbus (arr %u..%u, vmod <= %g)\n",
+                Param_GetDesc(PARAM_PWM_PERIOD)->min.u, Param_GetDesc(PARAM_PWM_PERIOD)->max.u,
+                Param_GetDesc(PARAM_V_MOD_MAX)->max.f);
+        return 2;
+    }
+    if (workers < 1) workers = 1;
+
+    /* 격자 전개 (마지막 축이 가장 빠르게 변함) */
+    job_count = 1;
+    for (uint32_t a = 0; a < AX_COUNT; a++)
+        job_count *= ax[a].n;
+    jobs = mmap(NULL, job_count * sizeof(Sweep_Job_t), PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (jobs == MAP_FAILED) { perror("mmap"); return 1; }
+
+    for (uint32_t k = 0; k < job_count; k++)
+    {
+        uint32_t r = k;
+        for (int a = AX_COUNT - 1; a >= 0; a--)
+        {
+            jobs[k].in[a] = ax[a].v[r % ax[a].n];
+            r /= ax[a].n;
+        }
+    }
+
+    if ((uint32_t)workers > job_count) workers = (long)job_count;
+    fflush(NULL);
+
+    double t0 = Sweep_Now();
+    for (long i = 0; i < workers; i++)
+    {
+        pid_t pid = fork();
+        if (pid < 0) { perror("fork"); return 1; }
+        if (pid == 0)
+        {
+            Sweep_Worker((uint32_t)i, (uint32_t)workers);
+            _exit(0);
+        }
+    }
+    int failed = 0, status;
+    while (wait(&status) > 0)
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) failed = 1;
+    double wall = Sweep_Now() - t0;
+    if (failed) { fprintf(stderr, "\nworker failed\n"); return 1; }
+    fprintf(stderr, "\r%u runs, %ld workers, %.2f s wall (%.1fx real time aggregate)\n",
+            job_count, workers, wall,
+            wall > 0.0 ? (double)job_count * common.time_s / wall : 0.0);
+
+    if (csv)
+    {
+        FILE *f = fopen(csv, "w");
+        if (!f) { perror(csv); return 1; }
+        Sweep_WriteCsv(f);
+        fclose(f);
+    }
+    if (json)
+    {
+        FILE *f = fopen(json, "w");
+        if (!f) { perror(json); return 1; }
+        Sweep_WriteJson(f, wall);
+        fclose(f);
+    }
+    if (!csv && !json)
+        Sweep_WriteCsv(stdout);
+
+    uint32_t stalled = 0;
+    for (uint32_t k = 0; k < job_count; k++)
+        stalled += jobs[k].stalled;
+    fprintf(stderr, "stalled: %u / %u\n", stalled, job_count);
+
+    munmap(jobs, job_count * sizeof(Sweep_Job_t));
+    return 0;
+}
@@ -0,0 +1,299 @@
+/**
+ * @file    telem_loop.c
+ * @brief   텔레메트리 루프백 검증 (제어 ISR → 링 → LPUART1 DMA 심 → 디코더)
+ *
+ * fw_loop.c 로 제어 스텝 (OpenLoop_Step → Telem_PushCtrl) 을 그대로 돌리고, 메인 루프
+ * 생산자 (Telem_Send, REPLY 프레임) 를 섞는다. LPUART1 송신은 선로 시간을 흉내 낸다:
+ * DMA 전송 N byte 는 N × 10 / baud 초 뒤에 완료 콜백 (HAL_UART_TxCpltCallback) 을 부르고,
+ * 그 사이 제어 스텝이 링을 계속 채운다. 선로로 나간 바이트는 하네스의 독립 디코더
+ * (동기 / 길이 / CRC-16 CCITT-FALSE) 가 다시 읽는다.
+ *
+ * 판정 (항목마다 ok / FAIL, 하나라도 어긋나면 종료 코드 1):
+ *   1. 2 Mbaud, 매 스텝 샘플: 버림 0, 기록한 프레임 모두 수신, CRC 오류 / 동기 손실 0,
+ *      SEQ 연속, 제어 샘플 tick 연속, 기록 → 선로 끝 지연 ≤ 2 제어 주기
+ *   2. 115200 baud 과부하: 버림은 Telem_Stats_t.dropped 로만 나타나고 나간 프레임은 온전,
+ *      SEQ 연속 (버린 프레임은 번호를 쓰지 않음), 빠진 tick + REPLY 수 = dropped,
+ *      선로 점유율 ≥ 95 %
+ *   3. 115200 baud, 5 스텝마다 샘플: 버림 0, tick 간격 5
+ *
+ * 빌드 (Tools/sim/CMakeLists.txt, -Wall -Wextra -Werror, ctest 게이트에 포함):
+ *   cmake -S Tools/sim -B build/sim && cmake --build build/sim --target telem_loop
+ *
+ * 실행 (1 의 선로 바이트를 저장해 호스트 디코더로도 확인):
+ *   ./telem_loop --ticks 5000 --out telem_loop.bin
+ *   python3 Tools/telem_decode.py --file telem_loop.bin --stats --strict
+ */
+
+#include "fw_loop.h"
+#include "hal_host.h"
+#include "app_config.h"
+#include "param.h"
+#include "telemetry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 설정 ============== */
+#define LOOP_BAUD_FAST      2000000u    // LPUART1 (main.c)
+#define LOOP_BAUD_SLOW      115200u     // 이전 설정 (과부하 확인)
+#define LOOP_REPLY_MS       10u         // 메인 루프 REPLY 프레임 간격 [스텝]
+
+/* ============== 선로 / 디코더 상태 ============== */
+typedef struct {
+    uint32_t baud;
+    double   now;                       // 현재 시각 [s]
+    double   line_free;                 // 진행 중 전송이 끝나는 시각 [s]
+    uint8_t  busy;
+    uint64_t wire_bytes;
+
+    uint8_t  frame[TELEM_HDR_SIZE + TELEM_MAX_PAYLOAD + TELEM_CRC_SIZE];
+    uint32_t n;
+    uint32_t frames, ctrl, replies, crc_errors, skipped, seq_gaps;
+    int      last_seq;
+    uint32_t tick_first, tick_last, tick_missing, tick_bad_step;
+    uint32_t reply_next, reply_missing;
+    uint32_t decim;
+    double   lat_max;                   // 제어 샘플 기록 → 선로 끝 [s]
+} Loop_Wire_t;
+
+static Loop_Wire_t wire;
+static FILE   *out;
+static uint8_t fails;
+
+static void Loop_Check(const char *what, uint8_t ok)
+{
+    printf("%-4s %s\n", ok ? "ok" : "FAIL", what);
+    if (!ok) fails++;
+}
+
+/* CRC-16/CCITT-FALSE (비트 단위, crc16.c 와 독립) */
+static uint16_t Loop_Crc(const uint8_t *p, uint32_t len)
+{
+    uint16_t crc = 0xFFFFu;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        crc ^= (uint16_t)p[i] << 8;
+        for (uint32_t k = 0; k < 8u; k++)
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+/**
+ * @brief 완성된 프레임 1 개 확인 (t_end: 마지막 바이트가 선로를 떠난 시각)
+ */
+static void Loop_Frame(uint32_t plen, double t_end)
+{
+    uint8_t seq = wire.frame[3];
+    if (wire.last_seq >= 0 && seq != (uint8_t)(wire.last_seq + 1)) wire.seq_gaps++;
+    wire.last_seq = seq;
+    wire.frames++;
+
+    const uint8_t *pl = &wire.frame[TELEM_HDR_SIZE];
+    if (wire.frame[2] == TELEM_TYPE_CTRL && plen == sizeof(Telem_Ctrl_t))
+    {
+        Telem_Ctrl_t s;
+        memcpy(&s, pl, sizeof(s));
+        if (wire.ctrl == 0u)
+        {
+            wire.tick_first = s.tick;
+        }
+        else
+        {
+            uint32_t step = s.tick - wire.tick_last;
+            if (step % wire.decim != 0u || step == 0u) wire.tick_bad_step++;
+            else wire.tick_missing += step / wire.decim - 1u;
+        }
+        wire.tick_last = s.tick;
+        wire.ctrl++;
+
+        // 기록 시각 = 첫 샘플 기준 스텝 수 × 제어 주기 (첫 샘플은 스텝 0 에 기록)
+        double t_push = (double)(s.tick - wire.tick_first) / CONTROL_FREQ_HZ;
+        if (t_end - t_push > wire.lat_max) wire.lat_max = t_end - t_push;
+    }
+    else if (wire.frame[2] == TELEM_TYPE_REPLY && plen == 4u)
+    {
+        uint32_t k;
+        memcpy(&k, pl, 4u);
+        if (k != wire.reply_next) wire.reply_missing += k - wire.reply_next;
+        wire.reply_next = k + 1u;
+        wire.replies++;
+    }
+}
+
+/* ============== LPUART1 송신 심 ============== */
+
+void HalHost_UartTxHook(const uint8_t *pData, uint16_t len)
+{
+    double start = (wire.line_free > wire.now) ? wire.line_free : wire.now;
+    wire.line_free = start + (double)len * 10.0 / wire.baud;
+    wire.busy = 1;
+    wire.wire_bytes += len;
+    if (out != NULL) fwrite(pData, 1, len, out);
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        uint8_t b = pData[i];
+        if ((wire.n == 0u && b != TELEM_SYNC0) || (wire.n == 1u && b != TELEM_SYNC1))
+        {
+            wire.skipped += wire.n + 1u;
+            wire.n = 0;
+            continue;
+        }
+        wire.frame[wire.n++] = b;
+        if (wire.n < TELEM_HDR_SIZE) continue;
+
+        uint32_t plen = wire.frame[4];
+        if (plen > TELEM_MAX_PAYLOAD)
+        {
+            wire.skipped += wire.n;
+            wire.n = 0;
+            continue;
+        }
+        if (wire.n < TELEM_HDR_SIZE + plen + TELEM_CRC_SIZE) continue;
+
+        uint16_t crc = (uint16_t)(wire.frame[TELEM_HDR_SIZE + plen] | (wire.frame[TELEM_HDR_SIZE + plen + 1u] << 8));
+        if (Loop_Crc(&wire.frame[2], 3u + plen) != crc) wire.crc_errors++;
+        else Loop_Frame(plen, start + (double)(i + 1u) * 10.0 / wire.baud);
+        wire.n = 0;
+    }
+}
+
+/**
+ * @brief 다음 스텝 시각까지 선로 진행 - 끝난 전송마다 완료 콜백 (콜백이 다음 구간 시작)
+ */
+static void Loop_Advance(double t)
+{
+    while (wire.busy && wire.line_free <= t)
+    {
+        wire.now = wire.line_free;
+        wire.busy = 0;
+        HalHost_UartPoll();
+    }
+    wire.now = t;
+}
+
+/* ============== 시나리오 ============== */
+
+typedef struct {
+    uint32_t pushed, dropped, ring_max;
+    double   seconds;
+} Loop_Result_t;
+
+/**
+ * @brief 제어 스텝 ticks 회 + 링 비움
+ */
+static Loop_Result_t Loop_Run(uint32_t baud, uint32_t decim, uint32_t ticks, FILE *pOut)
+{
+    Plant_Params_t par;
+    Plant_DefaultParams(&par);
+    FwLoop_Init(&par);
+    Telem_Init(&hlpuart1);
+    Param_StageU(PARAM_TELEM_DECIM, decim);
+    Param_Commit();
+
+    memset(&wire, 0, sizeof(wire));
+    wire.baud = baud;
+    wire.decim = decim;
+    wire.last_seq = -1;
+    out = pOut;
+
+    uint32_t reply_k = 0;
+    const double dt = 1.0 / CONTROL_FREQ_HZ;
+    for (uint32_t k = 0; k < ticks; k++)
+    {
+        wire.now = k * dt;
+        FwLoop_Tick();                              // 제어 ISR 생산자
+
+        if ((k % LOOP_REPLY_MS) == 0u)              // 메인 루프 생산자 (버려진 번호는 수신 측 간격)
+        {
+            Telem_Send(TELEM_TYPE_REPLY, &reply_k, 4u);
+            reply_k++;
+        }
+        Telem_Process();                            // SCHED_TELEM_PERIOD_MS
+        Loop_Advance((k + 1u) * dt);
+    }
+
+    // 남은 링 비우기 (생산 정지 후) - 처리량은 마지막 바이트까지의 시간으로
+    while (wire.busy)
+    {
+        Loop_Advance(wire.line_free);
+        Telem_Process();
+    }
+    double t_end = (wire.now > ticks * dt) ? wire.now : ticks * dt;
+    out = NULL;
+
+    // 마지막 수신 뒤에 버려진 프레임까지 (제어 샘플은 decim 스텝마다 1 개 기록 시도)
+    wire.tick_missing = ticks / decim - wire.ctrl;
+    wire.reply_missing += reply_k - wire.reply_next;
+
+    const Telem_Stats_t *st = Telem_GetStats();
+    Loop_Result_t r = { st->frames, st->dropped, st->ring_max, t_end };
+    return r;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t ticks = 5000u;
+    const char *out_path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--ticks") && i + 1 < argc)    ticks = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc) out_path = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--ticks N] [--out FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    /* 1. 정상 - 2 Mbaud, 매 스텝 */
+    FILE *f = NULL;
+    if (out_path != NULL && (f = fopen(out_path, "wb")) == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", out_path);
+        return 2;
+    }
+    Loop_Result_t r = Loop_Run(LOOP_BAUD_FAST, 1u, ticks, f);
+    if (f != NULL) fclose(f);
+
+    double util = (double)wire.wire_bytes * 10.0 / LOOP_BAUD_FAST / r.seconds;
+    printf("2 Mbaud  : %u frames, %.1f kB/s (%.1f %% of line), ring max %u / %u, latency max %.0f us\n",
+           wire.frames, wire.wire_bytes / r.seconds / 1000.0, util * 100.0, r.ring_max,
+           TELEM_RING_SIZE, wire.lat_max * 1e6);
+    Loop_Check("2 Mbaud: no frame dropped", r.dropped == 0u);
+    Loop_Check("2 Mbaud: every pushed frame received", wire.frames == r.pushed && wire.n == 0u);
+    Loop_Check("2 Mbaud: no CRC error / sync loss", wire.crc_errors == 0u && wire.skipped == 0u);
+    Loop_Check("2 Mbaud: frame SEQ contiguous", wire.seq_gaps == 0u);
+    Loop_Check("2 Mbaud: one control sample per step", wire.ctrl == ticks && wire.tick_missing == 0u &&
+                                                       wire.tick_bad_step == 0u);
+    Loop_Check("2 Mbaud: main-loop replies interleaved intact", wire.replies == (ticks + LOOP_REPLY_MS - 1u) / LOOP_REPLY_MS &&
+                                                                wire.reply_missing == 0u);
+    Loop_Check("2 Mbaud: push to wire latency <= 2 control periods", wire.lat_max <= 2.0 / CONTROL_FREQ_HZ);
+
+    /* 2. 과부하 - 115200 baud, 매 스텝 */
+    r = Loop_Run(LOOP_BAUD_SLOW, 1u, ticks, NULL);
+    util = (double)wire.wire_bytes * 10.0 / LOOP_BAUD_SLOW / r.seconds;
+    printf("115200   : %u frames sent, %u dropped, %.1f kB/s (%.1f %% of line)\n",
+           wire.frames, r.dropped, wire.wire_bytes / r.seconds / 1000.0, util * 100.0);
+    Loop_Check("115200: overload drops frames", r.dropped > 0u);
+    Loop_Check("115200: every pushed frame received intact", wire.frames == r.pushed && wire.n == 0u &&
+                                                              wire.crc_errors == 0u && wire.skipped == 0u);
+    Loop_Check("115200: SEQ contiguous (dropped frames take no number)", wire.seq_gaps == 0u);
+    Loop_Check("115200: missing ticks + replies = dropped", wire.tick_bad_step == 0u &&
+                                                             wire.tick_missing + wire.reply_missing == r.dropped);
+    Loop_Check("115200: line kept >= 95 % busy", util >= 0.95);
+
+    /* 3. 115200 baud, 5 스텝마다 */
+    r = Loop_Run(LOOP_BAUD_SLOW, 5u, ticks, NULL);
+    printf("115200/5 : %u frames, %.1f kB/s, ring max %u\n",
+           wire.frames, wire.wire_bytes / r.seconds / 1000.0, r.ring_max);
+    Loop_Check("115200 decim 5: no frame dropped", r.dropped == 0u && wire.frames == r.pushed);
+    Loop_Check("115200 decim 5: tick step 5", wire.tick_missing == 0u && wire.tick_bad_step == 0u &&
+                                             wire.ctrl == ticks / 5u);
+
+    printf(fails ? "FAIL\n" : "PASS\n");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,299 @@
+/**
+ * @file    svpwm_bench.c
+ * @brief   변조/삼각함수 커널 호스트 마이크로벤치마크
+ *
+ * svpwm_core.c, fast_trig.c 를 그대로 포함해 (static 함수까지) 측정한다.
+ * 입력은 실제 제어 루프와 같은 형태의 스트림 (각도 램프 × 크기, 과변조 일부 포함).
+ *
+ * 빌드 (저장소 루트에서):
+ *   gcc -O2 -std=gnu11 -DCONTROL_IN_CCMRAM=0 -ICore/Inc Tools/svpwm_bench.c -lm -o svpwm_bench
+ *
+ * 실행:
+ *   ./svpwm_bench                         # 표 출력
+ *   ./svpwm_bench --json out.json         # Google Benchmark 형식 JSON 추가 저장
+ *   ./svpwm_bench --filter trig --min-time 0.5 --reps 9 --label $(git rev-parse --short HEAD)
+ *
+ * 결과는 호스트 CPU 기준 상대 비교용 - 타깃 사이클은 isr_latency / cpu_load 로 측정.
+ */
+
+#define _GNU_SOURCE
+#include "../Core/Src/svpwm_core.c"
+#include "../Core/Src/fast_trig.c"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* ============== 입력 스트림 ============== */
+#define STREAM_LEN      4096u                   // 2의 거듭제곱
+#define STREAM_MASK     (STREAM_LEN - 1u)
+#define BENCH_SCALE     ((float)(PWM_ARR_BENCH + 1u))
+#define PWM_ARR_BENCH   8499u
+
+static float in_angle[STREAM_LEN];
+static float in_va[STREAM_LEN];
+static float in_vb[STREAM_LEN];
+static SVPWM_State_t in_times[STREAM_LEN];      // CalcCCR 입력 (CalcTimes 결과)
+
+static volatile uint32_t sink_u;
+static volatile float    sink_f;
+
+/**
+ * @brief 입력 스트림 생성 - 200Hz 전기 주파수 / 10kHz 스텝 각도 램프,
+ *        크기는 선형 영역 위주로 1/8 은 과변조
+ */
+static void Bench_MakeStream(void)
+{
+    float angle = 0.0f;
+    for (uint32_t i = 0; i < STREAM_LEN; i++)
+    {
+        angle += TWO_PI * 200.0f / 10000.0f * 7.3f;    // 섹터를 고르게 지나도록 큰 증분
+        if (angle >= TWO_PI) angle -= TWO_PI;
+
+        float amp = ((i & 7u) == 7u) ? 0.8f : 0.05f + 0.5f * (float)(i % 97u) / 97.0f;
+        in_angle[i] = angle;
+        in_va[i] = amp * cosf(angle);
+        in_vb[i] = amp * sinf(angle);
+        SVPWM_CalcTimes(in_va[i], in_vb[i], &in_times[i]);
+    }
+}
+
+/* ============== 커널 ============== */
+typedef void (*Bench_Fn_t)(uint64_t n);
+
+static void K_GetSector(uint64_t n)
+{
+    uint32_t acc = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        uint32_t k = (uint32_t)i & STREAM_MASK;
+        acc += SVPWM_GetSector(in_va[k], in_vb[k]);
+    }
+    sink_u = acc;
+}
+
+static void K_CalcTimes(uint64_t n)
+{
+    SVPWM_State_t st;
+    float acc = 0.0f;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        uint32_t k = (uint32_t)i & STREAM_MASK;
+        SVPWM_CalcTimes(in_va[k], in_vb[k], &st);
+        acc += st.T1;
+    }
+    sink_f = acc;
+}
+
+static void K_CalcCCR(uint64_t n)
+{
+    SVPWM_State_t st;
+    uint32_t acc = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        st = in_times[(uint32_t)i & STREAM_MASK];
+        SVPWM_CalcCCR(&st, BENCH_SCALE, PWM_ARR_BENCH + 1u);
+        acc += st.CCR_A;
+    }
+    sink_u = acc;
+}
+
+static void K_CoreCalc(uint64_t n)
+{
+    SVPWM_State_t st;
+    uint32_t acc = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        uint32_t k = (uint32_t)i & STREAM_MASK;
+        SvpwmCore_Calc(in_va[k], in_vb[k], BENCH_SCALE, PWM_ARR_BENCH + 1u, &st);
+        acc += st.CCR_B;
+    }
+    sink_u = acc;
+}
+
+static void K_TrigLibm(uint64_t n)
+{
+    float acc = 0.0f;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        float a = in_angle[(uint32_t)i & STREAM_MASK];
+        acc += cosf(a) + sinf(a);
+    }
+    sink_f = acc;
+}
+
+static void K_TrigLut(uint64_t n)
+{
+    float acc = 0.0f;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        float s, c;
+        FastTrig_SinCos(in_angle[(uint32_t)i & STREAM_MASK], &s, &c);
+        acc += c + s;
+    }
+    sink_f = acc;
+}
+
+/* SVPWM_Run 의 계산 경로 (OpenLoop_Step: 각도 → sin/cos → 커널), 타이머 쓰기 제외 */
+static void K_OpenLoopVector(uint64_t n)
+{
+    SVPWM_State_t st;
+    uint32_t acc = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        uint32_t k = (uint32_t)i & STREAM_MASK;
+        float s, c;
+        FastTrig_SinCos(in_angle[k], &s, &c);
+        SvpwmCore_Calc(0.5f * c, 0.5f * s, BENCH_SCALE, PWM_ARR_BENCH + 1u, &st);
+        acc += st.CCR_C;
+    }
+    sink_u = acc;
+}
+
+static const struct {
+    const char *name;
+    Bench_Fn_t  fn;
+} kernels[] = {
+    { "svpwm_get_sector",   K_GetSector      },
+    { "svpwm_calc_times",   K_CalcTimes      },
+    { "svpwm_calc_ccr",     K_CalcCCR        },
+    { "svpwm_core_calc",    K_CoreCalc       },
+    { "trig_libm_sincos",   K_TrigLibm       },
+    { "trig_lut_sincos",    K_TrigLut        },
+    { "openloop_vector",    K_OpenLoopVector },
+};
+#define KERNEL_COUNT    (sizeof(kernels) / sizeof(kernels[0]))
+
+/* ============== 측정 ============== */
+typedef struct {
+    uint64_t iterations;
+    double   ns_op;         // 반복 측정 중앙값
+    double   ns_min;
+    double   ns_max;
+} Bench_Result_t;
+
+static double Bench_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int Bench_CmpDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 반복 수를 min_time 이상 걸리도록 늘린 뒤 reps 회 측정
+ */
+static Bench_Result_t Bench_Run(Bench_Fn_t fn, double min_time, int reps)
+{
+    uint64_t n = 1024;
+    for (;;)
+    {
+        double t0 = Bench_Now();
+        fn(n);
+        double dt = Bench_Now() - t0;
+        if (dt >= min_time || n >= (1ull << 40)) break;
+        n = (dt > 1e-6) ? (uint64_t)((double)n * min_time * 1.2 / dt) + 1u : n * 16u;
+    }
+
+    double ns[64];
+    if (reps > 64) reps = 64;
+    for (int r = 0; r < reps; r++)
+    {
+        double t0 = Bench_Now();
+        fn(n);
+        ns[r] = (Bench_Now() - t0) * 1e9 / (double)n;
+    }
+    qsort(ns, (size_t)reps, sizeof(double), Bench_CmpDouble);
+
+    Bench_Result_t res = { n, ns[reps / 2], ns[0], ns[reps - 1] };
+    return res;
+}
+
+/* ============== JSON (Google Benchmark 형식) ============== */
+static void Bench_WriteJson(FILE *f, const char *label, const char *names[],
+                            const Bench_Result_t *res, uint32_t count, int reps)
+{
+    char date[32];
+    time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    fprintf(f, "{\n  \"context\": {\n");
+    fprintf(f, "    \"date\": \"%s\",\n", date);
+    fprintf(f, "    \"label\": \"%s\",\n", label ? label : "");
+    fprintf(f, "    \"compiler\": \"%s\",\n", __VERSION__);
+    fprintf(f, "    \"repetitions\": %d,\n", reps);
+    fprintf(f, "    \"stream_len\": %u,\n", STREAM_LEN);
+    fprintf(f, "    \"trig_lut_size\": %u\n", TRIG_LUT_SIZE);
+    fprintf(f, "  },\n  \"benchmarks\": [\n");
+    for (uint32_t i = 0; i < count; i++)
+    {
+        fprintf(f, "    {\"name\": \"%s\", \"iterations\": %llu, \"real_time\": %.4f, "
+                   "\"min_time\": %.4f, \"max_time\": %.4f, \"time_unit\": \"ns\", "
+                   "\"items_per_second\": %.1f}%s\n",
+                names[i], (unsigned long long)res[i].iterations, res[i].ns_op,
+                res[i].ns_min, res[i].ns_max, 1e9 / res[i].ns_op,
+                (i + 1u < count) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+static void Bench_Usage(const char *argv0)
+{
+    fprintf(stderr, "usage: %s [--json FILE] [--filter SUBSTR] [--min-time SEC] [--reps N] [--label TEXT]\n",
+            argv0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *json = NULL;
+    const char *filter = NULL;
+    const char *label = NULL;
+    double min_time = 0.2;
+    int reps = 5;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--json") && i + 1 < argc)          json = argv[++i];
+        else if (!strcmp(argv[i], "--filter") && i + 1 < argc)   filter = argv[++i];
+        else if (!strcmp(argv[i], "--label") && i + 1 < argc)    label = argv[++i];
+        else if (!strcmp(argv[i], "--min-time") && i + 1 < argc) min_time = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--reps") && i + 1 < argc)     reps = atoi(argv[++i]);
+        else { Bench_Usage(argv[0]); return 2; }
+    }
+    if (reps < 1) reps = 1;
+
+    FastTrig_Init();
+    Bench_MakeStream();
+
+    const char *names[KERNEL_COUNT];
+    Bench_Result_t res[KERNEL_COUNT];
+    uint32_t count = 0;
+
+    printf("%-20s %14s %12s %14s\n", "kernel", "iterations", "ns/op", "ops/s");
+    for (uint32_t k = 0; k < KERNEL_COUNT; k++)
+    {
+        if (filter && !strstr(kernels[k].name, filter)) continue;
+
+        res[count] = Bench_Run(kernels[k].fn, min_time, reps);
+        names[count] = kernels[k].name;
+        printf("%-20s %14llu %12.3f %14.0f\n", names[count],
+               (unsigned long long)res[count].iterations, res[count].ns_op, 1e9 / res[count].ns_op);
+        count++;
+    }
+
+    if (json)
+    {
+        FILE *f = fopen(json, "w");
+        if (!f) { perror(json); return 1; }
+        Bench_WriteJson(f, label, names, res, count, reps);
+        fclose(f);
+    }
+    return 0;
+}
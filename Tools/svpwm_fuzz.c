@@ -0,0 +1,281 @@
+/**
+ * @file    svpwm_fuzz.c
+ * @brief   SVPWM 변조 커널 속성 검사 / 퍼징 하네스 (Core/Src/svpwm_core.c)
+ *
+ * 모든 입력 (NaN, ±Inf, 비정규화 수, 과변조 포함) 에서 확인하는 불변식:
+ *   1. CCR_A/B/C <= ccr_max (ARR+1 = 100% ON), 섹터 0~6
+ *   2. T1, T2, T0 유한, >= 0, T1 + T2 + T0 = 1
+ *   3. 선형 영역 (|V| < 1/√3) 에서 선간 평균 전압 (CCR 차 / (ARR+1)) 이 지령과 일치
+ *      vab = 1.5·Vα - (√3/2)·Vβ,  vbc = √3·Vβ   (±2 LSB + 데드타임 최소 펄스)
+ *   4. (SVPWM_SINGLE_SHUNT) 반주기 CCR: 상승 + 하강 = 2·CCR, 범위 안. 샘플이 유효하면
+ *      두 트리거의 샘플 구간에 에지가 없고 안정 시간 확보, 그 순간의 스위칭 상태로
+ *      무작위 상전류 (합 0) 가 정확히 복원됨
+ * 위반 시 입력을 출력하고 abort() - 새니타이저 빌드로 UB 도 함께 잡는다.
+ *
+ * 빌드 / 실행 (저장소 루트에서):
+ *   # 속성 검사 (gcc, 무작위 비트 패턴 + 특수값 + 선형 영역 스윕)
+ *   gcc -O1 -g -std=gnu11 -fsanitize=address,undefined,float-cast-overflow -fno-sanitize-recover=all \
+ *       -DCONTROL_IN_CCMRAM=0 -ICore/Inc Tools/svpwm_fuzz.c -lm -o svpwm_fuzz
+ *   ./svpwm_fuzz --iter 10000000 --seed 1
+ *   (짧은 반복은 Tools/sim/CMakeLists.txt ctest 게이트에 포함)
+ *
+ *   # libFuzzer (clang)
+ *   clang -O1 -g -fsanitize=fuzzer,address,undefined,float-cast-overflow -DSVPWM_FUZZ_LIBFUZZER \
+ *       -DCONTROL_IN_CCMRAM=0 -ICore/Inc Tools/svpwm_fuzz.c -lm -o svpwm_fuzz
+ *   ./svpwm_fuzz -max_total_time=60
+ *
+ *   # 변조 방식 / 데드타임 설정별로 -D SVPWM_MODULATION=SVPWM_MOD_DPWM_MIN 등
+ *   # 단일 션트 에지 이동: -DSVPWM_SINGLE_SHUNT=1
+ */
+
+#include "../Core/Src/svpwm_core.c"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============== 설정 ============== */
+#define FUZZ_ARR_MIN        4249u       // PARAM_PWM_PERIOD 범위
+#define FUZZ_ARR_MAX        16999u
+#define FUZZ_LINEAR_MARGIN  0.999f      // 선형 영역 경계 (float 반올림 여유)
+#define FUZZ_T_TOL          1e-5f
+
+#if SVPWM_SINGLE_SHUNT
+static uint64_t shunt_valid;         // 선형 영역에서 샘플 창을 확보한 입력 수
+#endif
+
+/* ============== 검사 ============== */
+static uint32_t Fuzz_Rand(void);
+
+static void Fuzz_Fail(const char *what, float va, float vb, uint32_t arr, const SVPWM_State_t *st)
+{
+    fprintf(stderr, "FAIL %s: va=%a (%g) vb=%a (%g) arr=%u -> s%u T1=%g T2=%g T0=%g ccr=%u %u %u\n",
+            what, (double)va, (double)va, (double)vb, (double)vb, arr, st->sector,
+            (double)st->T1, (double)st->T2, (double)st->T0, st->CCR_A, st->CCR_B, st->CCR_C);
+    abort();
+}
+
+/**
+ * @brief 입력 1 개 검사
+ * @return 선형 영역 검사를 수행했으면 1
+ */
+static int Fuzz_Check(float va, float vb, uint32_t arr)
+{
+    const float scale = (float)(arr + 1u);
+    const uint32_t ccr_max = arr + 1u;
+    SVPWM_State_t st;
+    memset(&st, 0xA5, sizeof(st));
+
+    SvpwmCore_Calc(va, vb, scale, ccr_max, &st);
+
+    /* 1. 범위 */
+    if (st.CCR_A > ccr_max || st.CCR_B > ccr_max || st.CCR_C > ccr_max)
+        Fuzz_Fail("ccr range", va, vb, arr, &st);
+    if (st.sector > 6u)
+        Fuzz_Fail("sector", va, vb, arr, &st);
+
+#if SVPWM_SINGLE_SHUNT
+    /* 4. 단일 션트 */
+    const uint16_t avg[3] = { st.CCR_A, st.CCR_B, st.CCR_C };
+    const SVPWM_Shunt_t *sh = &st.shunt;
+    for (uint32_t k = 0; k < 3u; k++)
+        if ((uint32_t)sh->up[k] + sh->dn[k] != 2u * avg[k] || sh->up[k] > ccr_max || sh->dn[k] > ccr_max)
+            Fuzz_Fail("shunt half-period ccr", va, vb, arr, &st);
+
+    if (sh->map & SVPWM_SHUNT_VALID)
+    {
+        const uint32_t p1 = sh->map & 3u, p2 = (sh->map >> 2) & 3u;
+        if (p1 > 2u || p2 > 2u || p1 == p2 ||
+            sh->trig[0] > arr - SVPWM_SHUNT_TMIN_TICKS || sh->trig[1] < SVPWM_SHUNT_TS_TICKS ||
+            sh->trig[0] < sh->trig[1] + SVPWM_SHUNT_TMIN_TICKS)
+            Fuzz_Fail("shunt trigger", va, vb, arr, &st);
+
+        // 하강 카운트: CNT < dn 이면 HIGH. 샘플 [trig - TS, trig] 와 앞선 안정 구간에 에지 없음
+        const uint32_t t_set = SVPWM_SHUNT_TMIN_TICKS - SVPWM_SHUNT_TS_TICKS;
+        int32_t cur[3], smp[2] = { 0, 0 };
+        uint32_t r = Fuzz_Rand();
+        cur[0] = (int32_t)(r & 0x3FFu) - 512;
+        cur[1] = (int32_t)((r >> 10) & 0x3FFu) - 512;
+        cur[2] = -cur[0] - cur[1];
+        for (uint32_t j = 0; j < 2u; j++)
+        {
+            const uint32_t t = sh->trig[j];
+            for (uint32_t k = 0; k < 3u; k++)
+            {
+                if (sh->dn[k] + SVPWM_SHUNT_TS_TICKS > t && sh->dn[k] < t + t_set)
+                    Fuzz_Fail("shunt window", va, vb, arr, &st);
+                if (t < sh->dn[k]) smp[j] += cur[k];
+            }
+        }
+        int32_t rec[3];
+        rec[p1] = smp[0];
+        rec[p2] = -smp[1];
+        rec[3u - p1 - p2] = smp[1] - smp[0];
+        if (rec[0] != cur[0] || rec[1] != cur[1] || rec[2] != cur[2])
+            Fuzz_Fail("shunt reconstruction", va, vb, arr, &st);
+    }
+    else if (sh->trig[0] != SVPWM_SHUNT_TRIG_OFF || sh->trig[1] != SVPWM_SHUNT_TRIG_OFF ||
+             memcmp(sh->up, avg, sizeof(avg)) || memcmp(sh->dn, avg, sizeof(avg)))
+        Fuzz_Fail("shunt fallback", va, vb, arr, &st);
+#endif
+
+    /* 2. 시간 비율 */
+    if (!isfinite(st.T1) || !isfinite(st.T2) || !isfinite(st.T0) ||
+        st.T1 < 0.0f || st.T2 < 0.0f || st.T0 < 0.0f ||
+        fabsf(st.T1 + st.T2 + st.T0 - 1.0f) > FUZZ_T_TOL)
+        Fuzz_Fail("times", va, vb, arr, &st);
+
+    /* 3. 선형 영역 선간 전압 */
+    if (!isfinite(va) || !isfinite(vb))
+        return 0;
+    const float mag = sqrtf(va * va + vb * vb);
+    if (!(mag < SQRT3_INV * FUZZ_LINEAR_MARGIN))
+        return 0;
+
+    const float tol = (2.0f + 2.0f * (float)SVPWM_DT_TICKS) / scale + 1e-5f;
+    const float vab = 1.5f * va - SQRT3_HALF * vb;
+    const float vbc = SQRT3 * vb;
+    const float dab = ((float)st.CCR_A - (float)st.CCR_B) / scale;
+    const float dbc = ((float)st.CCR_B - (float)st.CCR_C) / scale;
+    if (fabsf(dab - vab) > tol || fabsf(dbc - vbc) > tol)
+        Fuzz_Fail("line voltage", va, vb, arr, &st);
+#if SVPWM_SINGLE_SHUNT
+    shunt_valid += (st.shunt.map & SVPWM_SHUNT_VALID) ? 1u : 0u;
+#endif
+    return 1;
+}
+
+/* ============== libFuzzer 진입점 ============== */
+/* 입력: f32 Vα, f32 Vβ, (선택) u16 ARR 오프셋 */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (size < 8u) return 0;
+
+    float va, vb;
+    memcpy(&va, data, 4);
+    memcpy(&vb, data + 4, 4);
+    uint32_t arr = FUZZ_ARR_MIN;
+    if (size >= 10u)
+        arr += (uint32_t)(data[8] | (data[9] << 8)) % (FUZZ_ARR_MAX - FUZZ_ARR_MIN + 1u);
+
+    Fuzz_Check(va, vb, arr);
+    return 0;
+}
+
+#ifndef SVPWM_FUZZ_LIBFUZZER
+/* ============== 속성 검사 (단독 실행) ============== */
+static uint64_t rng_state;
+
+static uint32_t Fuzz_Rand(void)
+{
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (uint32_t)((rng_state * 2685821657736338717ull) >> 32);
+}
+
+static float Fuzz_Uniform(void)
+{
+    return (float)(Fuzz_Rand() >> 8) * (1.0f / 16777216.0f);
+}
+
+static float Fuzz_Bits(void)
+{
+    uint32_t u = Fuzz_Rand();
+    float f;
+    memcpy(&f, &u, 4);
+    return f;
+}
+
+static uint32_t Fuzz_Arr(void)
+{
+    return FUZZ_ARR_MIN + Fuzz_Rand() % (FUZZ_ARR_MAX - FUZZ_ARR_MIN + 1u);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t iter = 1000000u;
+    uint64_t seed = 1u;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--iter") && i + 1 < argc)      iter = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--iter N] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    rng_state = seed ? seed : 1u;
+
+    uint64_t checked = 0, linear = 0;
+
+    /* 특수값 전 조합 */
+    const float special[] = {
+        0.0f, -0.0f, NAN, -NAN, INFINITY, -INFINITY, 1e-45f, -1e-45f, 1.17549435e-38f,
+        3.4028235e38f, -3.4028235e38f, 1e20f, -1e20f, 1.0f, -1.0f, SQRT3_INV, -SQRT3_INV,
+        0.5f, -0.5f, SQRT3_HALF, -SQRT3_HALF, 0.25f, 1e-7f,
+    };
+    const uint32_t n_special = sizeof(special) / sizeof(special[0]);
+    for (uint32_t i = 0; i < n_special; i++)
+        for (uint32_t j = 0; j < n_special; j++)
+        {
+            linear += (uint64_t)Fuzz_Check(special[i], special[j], FUZZ_ARR_MIN);
+            linear += (uint64_t)Fuzz_Check(special[i], special[j], FUZZ_ARR_MAX);
+            checked += 2u;
+        }
+
+    /* 섹터 경계 (k·60°) 근방 */
+    for (uint32_t k = 0; k < 6u; k++)
+        for (int d = -4; d <= 4; d++)
+        {
+            float th = (float)k * (PI / 3.0f) + (float)d * 1e-6f;
+            float m = 0.5f;
+            linear += (uint64_t)Fuzz_Check(m * cosf(th), m * sinf(th), Fuzz_Arr());
+            checked++;
+        }
+
+    /* 무작위: 비트 패턴 1/4, 과변조 1/4, 선형 영역 1/2 */
+    for (uint64_t n = 0; n < iter; n++)
+    {
+        float va, vb;
+        switch (Fuzz_Rand() & 3u)
+        {
+            case 0:
+                va = Fuzz_Bits();
+                vb = Fuzz_Bits();
+                break;
+            case 1:
+            {
+                float th = TWO_PI * Fuzz_Uniform();
+                float m = SQRT3_INV + 2.0f * Fuzz_Uniform();
+                va = m * cosf(th);
+                vb = m * sinf(th);
+                break;
+            }
+            default:
+            {
+                float th = TWO_PI * Fuzz_Uniform();
+                float m = SQRT3_INV * Fuzz_Uniform();
+                va = m * cosf(th);
+                vb = m * sinf(th);
+                break;
+            }
+        }
+        linear += (uint64_t)Fuzz_Check(va, vb, Fuzz_Arr());
+        checked++;
+    }
+
+    printf("ok: %llu inputs (%llu linear-region line-voltage checks), seed %llu, modulation %d, dt %u ticks\n",
+           (unsigned long long)checked, (unsigned long long)linear, (unsigned long long)seed,
+           SVPWM_MODULATION, (unsigned)SVPWM_DT_TICKS);
+#if SVPWM_SINGLE_SHUNT
+    printf("single shunt: tmin %u ticks, %.2f%% of linear-region inputs sampled\n",
+           (unsigned)SVPWM_SHUNT_TMIN_TICKS, linear ? 100.0 * (double)shunt_valid / (double)linear : 0.0);
+#endif
+    return 0;
+}
+#endif /* SVPWM_FUZZ_LIBFUZZER */
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""
+svpwm_golden.py - SVPWM 변조 커널 골든 벡터 기록/비교 (Core/Src/svpwm_core.c)
+
+svpwm_core.c 는 HAL 의존성이 없으므로 호스트 gcc 로 공유 라이브러리를 빌드해
+ctypes 로 호출한다. 입력 스윕:
+    - 각도 0 ~ 360° 균등 분할
+    - 섹터 경계 (k·60°) 정확히 및 ±1e-5 rad
+    - 크기 0 ~ 1/√3 (선형 영역), 1/√3 초과 (과변조)
+
+골든 파일은 기본 설정 (svpwm_config.h 기본값, ARR 8499) 으로 기록해 저장소에 둔다
+(Tools/svpwm_golden.bin). 커널을 바꾼 뒤에는 check 만 돌리면 되고, 불일치가
+하나라도 있으면 종료 코드 1. 출력이 바뀌는 게 의도된 수정이면 같은 커밋에서
+다시 기록하고 커밋 메시지에 바뀐 동작을 적는다.
+
+사용 예:
+    # 저장소 골든 파일과 비교 (비트 단위 일치)
+    python3 Tools/svpwm_golden.py check
+
+    # 의도된 출력 변경 후 다시 기록
+    python3 Tools/svpwm_golden.py record
+
+    # 최적화 커널 비교 (CCR ±1 LSB, 시간 비율 1e-5 허용)
+    python3 Tools/svpwm_golden.py check --lsb 1 --ttol 1e-5
+
+    # 다른 커널 소스 / 컴파일 설정과 비교
+    python3 Tools/svpwm_golden.py record dpwm.bin -D SVPWM_MODULATION=SVPWM_MOD_DPWM_MIN
+    python3 Tools/svpwm_golden.py check dpwm.bin --src my_core.c -D SVPWM_MODULATION=SVPWM_MOD_DPWM_MIN
+
+파일 형식 (little-endian):
+    헤더   : "SVG1" u32 count u32 ccr_max f32 scale
+    레코드 : f32 valpha f32 vbeta u8 sector f32 t1 f32 t2 f32 t0 u16 ccr_a u16 ccr_b u16 ccr_c
+"""
+
+import argparse
+import ctypes
+import math
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+CORE_SRC = os.path.join(ROOT, "Core", "Src", "svpwm_core.c")
+CORE_INC = os.path.join(ROOT, "Core", "Inc")
+GOLDEN_DEFAULT = os.path.join(ROOT, "Tools", "svpwm_golden.bin")
+
+MAGIC = b"SVG1"
+HDR_FMT = "<4sIIf"
+REC_FMT = "<ffBfffHHH"
+HDR_SIZE = struct.calcsize(HDR_FMT)
+REC_SIZE = struct.calcsize(REC_FMT)
+
+ARR_DEFAULT = 8499
+
+
+class State(ctypes.Structure):
+    # SVPWM_State_t
+    _fields_ = [("sector", ctypes.c_uint8), ("T1", ctypes.c_float), ("T2", ctypes.c_float),
+                ("T0", ctypes.c_float), ("CCR_A", ctypes.c_uint16), ("CCR_B", ctypes.c_uint16),
+                ("CCR_C", ctypes.c_uint16)]
+
+
+def build_kernel(src, defines):
+    """커널을 공유 라이브러리로 빌드 (CCM 배치 속성 제거)"""
+    out = os.path.join(tempfile.mkdtemp(prefix="svpwm_"), "svpwm_core.so")
+    cmd = ["gcc", "-O2", "-shared", "-fPIC", "-std=gnu11", "-ffp-contract=off",
+           "-DCONTROL_IN_CCMRAM=0", "-I" + CORE_INC, src, "-o", out]
+    cmd[1:1] = ["-D" + d for d in defines]
+    subprocess.check_call(cmd)
+    lib = ctypes.CDLL(out)
+    lib.SvpwmCore_Calc.argtypes = [ctypes.c_float, ctypes.c_float, ctypes.c_float,
+                                   ctypes.c_uint32, ctypes.POINTER(State)]
+    lib.SvpwmCore_Calc.restype = None
+    return lib
+
+
+def sweep_inputs(n_angle):
+    """(valpha, vbeta) 입력 목록 - float32 로 반올림해 파일 값과 일치시킴"""
+    amps = [0.0, 0.01, 0.1, 0.25, 0.4, 0.5, 0.55, 1.0 / math.sqrt(3.0),
+            0.6, 0.7, 0.8, 1.0, 1.2]
+    angles = [2.0 * math.pi * k / n_angle for k in range(n_angle)]
+    for k in range(6):
+        b = k * math.pi / 3.0
+        angles += [b, b - 1e-5, b + 1e-5]
+
+    f32 = lambda x: struct.unpack("<f", struct.pack("<f", x))[0]
+    out = []
+    for a in amps:
+        for th in angles:
+            out.append((f32(a * math.cos(th)), f32(a * math.sin(th))))
+    return out
+
+
+def run(lib, inputs, scale, ccr_max):
+    st = State()
+    for va, vb in inputs:
+        lib.SvpwmCore_Calc(va, vb, scale, ccr_max, ctypes.byref(st))
+        yield (va, vb, st.sector, st.T1, st.T2, st.T0, st.CCR_A, st.CCR_B, st.CCR_C)
+
+
+def cmd_record(a):
+    lib = build_kernel(a.src, a.define)
+    scale, ccr_max = float(a.arr + 1), a.arr + 1
+    recs = list(run(lib, sweep_inputs(a.angles), scale, ccr_max))
+    with open(a.file, "wb") as f:
+        f.write(struct.pack(HDR_FMT, MAGIC, len(recs), ccr_max, scale))
+        for r in recs:
+            f.write(struct.pack(REC_FMT, *r))
+    print("recorded %d vectors (%d bytes) → %s" % (len(recs), HDR_SIZE + len(recs) * REC_SIZE, a.file))
+
+
+def cmd_check(a):
+    with open(a.file, "rb") as f:
+        data = f.read()
+    magic, count, ccr_max, scale = struct.unpack_from(HDR_FMT, data)
+    if magic != MAGIC or len(data) != HDR_SIZE + count * REC_SIZE:
+        sys.exit("bad golden file")
+    gold = [struct.unpack_from(REC_FMT, data, HDR_SIZE + i * REC_SIZE) for i in range(count)]
+
+    lib = build_kernel(a.src, a.define)
+    got = run(lib, [(g[0], g[1]) for g in gold], scale, ccr_max)
+
+    bad = 0
+    worst_lsb = 0
+    worst_t = 0.0
+    for g, r in zip(gold, got):
+        d_lsb = max(abs(g[6 + i] - r[6 + i]) for i in range(3))
+        d_t = max(abs(g[3 + i] - r[3 + i]) for i in range(3)) if g[2] == r[2] else 0.0
+        worst_lsb = max(worst_lsb, d_lsb)
+        worst_t = max(worst_t, d_t)
+        # 섹터 경계에서는 섹터 번호(T1/T2 역할)가 달라도 CCR 이 같으면 허용
+        if d_lsb > a.lsb or d_t > a.ttol:
+            bad += 1
+            if bad <= a.show:
+                print("mismatch va=% .6f vb=% .6f  gold s%d %5d %5d %5d  got s%d %5d %5d %5d" % (
+                    g[0], g[1], g[2], g[6], g[7], g[8], r[2], r[6], r[7], r[8]))
+
+    print("%d vectors, %d mismatches (worst %d LSB, %.2e time ratio)" % (count, bad, worst_lsb, worst_t))
+    sys.exit(1 if bad else 0)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="SVPWM 커널 골든 벡터 기록/비교")
+    sub = ap.add_subparsers(dest="cmd", required=True)
+    for name in ("record", "check"):
+        p = sub.add_parser(name)
+        p.add_argument("file", nargs="?", default=GOLDEN_DEFAULT,
+                       help="골든 벡터 파일 (기본: Tools/svpwm_golden.bin)")
+        p.add_argument("--src", default=CORE_SRC, help="커널 소스 (기본: Core/Src/svpwm_core.c)")
+        p.add_argument("-D", dest="define", action="append", default=[],
+                       help="컴파일 정의 (svpwm_config.h 설정 등)")
+    rec = sub.choices["record"]
+    rec.add_argument("--arr", type=int, default=ARR_DEFAULT, help="TIM3 ARR")
+    rec.add_argument("--angles", type=int, default=720, help="한 바퀴 각도 분할 수")
+    chk = sub.choices["check"]
+    chk.add_argument("--lsb", type=int, default=0, help="CCR 허용 오차 [LSB]")
+    chk.add_argument("--ttol", type=float, default=0.0, help="T0/T1/T2 허용 오차")
+    chk.add_argument("--show", type=int, default=20, help="출력할 불일치 수")
+    a = ap.parse_args()
+
+    if a.cmd == "record":
+        cmd_record(a)
+    else:
+        cmd_check(a)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""
+telem_decode.py - 텔레메트리 프레임 수신/디코더 (Core/Src/telemetry.c)
+
+프레임: A5 5A TYPE SEQ LEN PAYLOAD[LEN] CRC_L CRC_H
+        CRC-16/CCITT-FALSE (init 0xFFFF, poly 0x1021), 범위 = TYPE ~ PAYLOAD
+
+사용 예:
+    python3 telem_decode.py /dev/ttyACM0                 # 샘플 출력
+    python3 telem_decode.py COM5 --csv log.csv           # CSV 저장
+    python3 telem_decode.py /dev/ttyACM0 --stats         # 처리량/무결성만 출력
+    python3 telem_decode.py /dev/ttyACM0 --load          # CPU 부하 / 제어 오버런만 출력
+    python3 telem_decode.py --file capture.bin --stats   # 저장된 원시 바이트 분석
+    python3 telem_decode.py --file telem_loop.bin --stats --strict   # Tools/sim/telem_loop.c 루프백
+
+의존성: pyserial (직렬 포트 사용 시)
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+SYNC0 = 0xA5
+SYNC1 = 0x5A
+HDR_SIZE = 5
+CRC_SIZE = 2
+MAX_PAYLOAD = 64
+
+TYPE_CTRL = 0x01
+
+# Telem_Ctrl_t (packed, little-endian)
+CTRL_FMT = "<IffffHHH"
+CTRL_FIELDS = ("tick", "angle", "ia", "ib", "vbus", "ccr_a", "ccr_b", "ccr_c")
+CTRL_SIZE = struct.calcsize(CTRL_FMT)
+
+TYPE_LOAD = 0x04
+
+# CpuLoad_Frame_t (packed, little-endian) - 점유율 [‰] 은 CpuLoad_Ctx_t 순서
+LOAD_CTX = ("main", "idle", "control", "protect", "comms", "systick", "pwm")
+LOAD_FMT = "<I%dHIIHHI" % len(LOAD_CTX)
+LOAD_SIZE = struct.calcsize(LOAD_FMT)
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class FrameDecoder:
+    """바이트 스트림 → (type, seq, payload) 프레임. 동기 손실 시 1 바이트씩 재탐색."""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.frames = 0
+        self.crc_errors = 0
+        self.seq_gaps = 0
+        self.skipped = 0
+        self.last_seq = None
+
+    def feed(self, data):
+        self.buf.extend(data)
+        out = []
+        while True:
+            i = self.buf.find(bytes((SYNC0, SYNC1)))
+            if i < 0:
+                # 마지막 바이트가 SYNC0 일 수 있으므로 남겨둠
+                keep = 1 if self.buf[-1:] == bytes((SYNC0,)) else 0
+                self.skipped += len(self.buf) - keep
+                del self.buf[:len(self.buf) - keep]
+                break
+            if i > 0:
+                self.skipped += i
+                del self.buf[:i]
+            if len(self.buf) < HDR_SIZE:
+                break
+            ftype, seq, length = self.buf[2], self.buf[3], self.buf[4]
+            if length > MAX_PAYLOAD:
+                self.skipped += 1
+                del self.buf[:1]
+                continue
+            total = HDR_SIZE + length + CRC_SIZE
+            if len(self.buf) < total:
+                break
+            crc_rx = self.buf[total - 2] | (self.buf[total - 1] << 8)
+            if crc16_ccitt(self.buf[2:HDR_SIZE + length]) != crc_rx:
+                self.crc_errors += 1
+                self.skipped += 1
+                del self.buf[:1]
+                continue
+            payload = bytes(self.buf[HDR_SIZE:HDR_SIZE + length])
+            del self.buf[:total]
+
+            if self.last_seq is not None and seq != ((self.last_seq + 1) & 0xFF):
+                self.seq_gaps += 1
+            self.last_seq = seq
+            self.frames += 1
+            out.append((ftype, seq, payload))
+        return out
+
+
+def decode_ctrl(payload):
+    if len(payload) != CTRL_SIZE:
+        return None
+    return dict(zip(CTRL_FIELDS, struct.unpack(CTRL_FMT, payload)))
+
+
+def decode_load(payload):
+    if len(payload) != LOAD_SIZE:
+        return None
+    v = struct.unpack(LOAD_FMT, payload)
+    n = len(LOAD_CTX)
+    return {"window_cyc": v[0], "load_pm": dict(zip(LOAD_CTX, v[1:1 + n])),
+            "period_cyc": v[n + 1], "ctrl_max_cyc": v[n + 2], "ctrl_budget_pm": v[n + 3],
+            "ctrl_overruns": v[n + 4], "overruns_total": v[n + 5]}
+
+
+def format_load(s):
+    pm = s["load_pm"]
+    return ("load %s | ctrl max %d/%d cyc (%.1f%%) overrun %d (total %d)" % (
+        " ".join("%s %.1f%%" % (k, pm[k] / 10.0) for k in LOAD_CTX),
+        s["ctrl_max_cyc"], s["period_cyc"], s["ctrl_budget_pm"] / 10.0,
+        s["ctrl_overruns"], s["overruns_total"]))
+
+
+def open_source(args):
+    if args.file:
+        return open(args.file, "rb")
+    import serial  # pyserial
+    return serial.Serial(args.port, args.baud, timeout=0.1)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="LPUART1 텔레메트리 디코더")
+    ap.add_argument("port", nargs="?", help="직렬 포트 (예: /dev/ttyACM0, COM5)")
+    ap.add_argument("--baud", type=int, default=2000000)
+    ap.add_argument("--file", help="원시 바이트 파일에서 읽기")
+    ap.add_argument("--csv", help="제어 샘플 CSV 저장 경로")
+    ap.add_argument("--stats", action="store_true", help="샘플 대신 1초마다 통계만 출력")
+    ap.add_argument("--load", action="store_true", help="CPU 부하 프레임만 출력")
+    ap.add_argument("--strict", action="store_true",
+                    help="CRC 오류 / SEQ 간격 / 버린 바이트가 있으면 종료 코드 1 (루프백 검증용)")
+    args = ap.parse_args()
+
+    if not args.port and not args.file:
+        ap.error("port 또는 --file 필요")
+
+    src = open_source(args)
+    dec = FrameDecoder()
+    csv = open(args.csv, "w") if args.csv else None
+    if csv:
+        csv.write(",".join(CTRL_FIELDS) + "\n")
+
+    t0 = t_last = time.monotonic()
+    rx_bytes = 0
+    last_frames = 0
+    try:
+        while True:
+            data = src.read(4096)
+            if not data:
+                if args.file:
+                    break
+                continue
+            rx_bytes += len(data)
+
+            for ftype, seq, payload in dec.feed(data):
+                if ftype == TYPE_LOAD:
+                    s = decode_load(payload)
+                    if s is not None and not args.stats:
+                        print(format_load(s))
+                    continue
+                if ftype != TYPE_CTRL:
+                    if not args.stats and not args.load:
+                        print("type=0x%02X seq=%3d len=%d %s" % (ftype, seq, len(payload), payload.hex()))
+                    continue
+                s = decode_ctrl(payload)
+                if s is None:
+                    continue
+                if csv:
+                    csv.write(",".join(str(s[k]) for k in CTRL_FIELDS) + "\n")
+                if not args.stats and not args.load:
+                    print("%10d ang=%6.3f ia=%7.3f ib=%7.3f vbus=%6.2f ccr=%4d %4d %4d" % (
+                        s["tick"], s["angle"], s["ia"], s["ib"], s["vbus"],
+                        s["ccr_a"], s["ccr_b"], s["ccr_c"]))
+
+            now = time.monotonic()
+            if args.stats and now - t_last >= 1.0:
+                dt = now - t_last
+                print("rx %7.1f kB/s  frames %6.0f/s  crc_err %d  seq_gap %d  skipped %d" % (
+                    rx_bytes / (now - t0) / 1000.0, (dec.frames - last_frames) / dt,
+                    dec.crc_errors, dec.seq_gaps, dec.skipped))
+                t_last = now
+                last_frames = dec.frames
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if csv:
+            csv.close()
+        src.close()
+
+    print("frames %d  crc_err %d  seq_gap %d  skipped %d bytes" % (
+        dec.frames, dec.crc_errors, dec.seq_gaps, dec.skipped), file=sys.stderr)
+    if args.strict and (dec.frames == 0 or dec.crc_errors or dec.seq_gaps or dec.skipped):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()